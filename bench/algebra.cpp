@@ -0,0 +1,62 @@
+/*
+Time to merge two ft::set: one insert per element of the smaller set against
+the join based union_with, with 1 to max threads, for equal sizes and for a
+small set merged into a large one (where union_with does O(m log(n / m + 1))
+work instead of visiting every element).
+Use: ./bench_algebra [ elements [ max threads ] ]
+*/
+
+#include <iostream>
+#include <iomanip>
+#include "../containers/set.hpp"
+#include "../containers/vector.hpp"
+#include <cstdlib>
+#include <time.h>
+
+static double now_ns(void){
+	struct timespec ts;
+	clock_gettime(CLOCK_MONOTONIC, &ts);
+	return (ts.tv_sec * 1e9 + ts.tv_nsec);
+}
+
+static void run(const ft::vector<int> &big, const ft::vector<int> &small, size_t max){
+	ft::set<int> a(big.begin(), big.end(), ft::parallel(1));
+	ft::set<int> b(small.begin(), small.end(), ft::parallel(1));
+
+	std::cout << small.size() << " into " << big.size() << " elements, ms" << std::endl;
+	{
+		ft::set<int> into(a);
+		double start = now_ns();
+		for (ft::set<int>::iterator it = b.begin(); it != b.end(); ++it)
+			into.insert(*it);
+		std::cout << "insert loop     " << std::fixed << std::setprecision(1)
+			<< std::setw(10) << (now_ns() - start) / 1e6 << "  (" << into.size() << " keys)" << std::endl;
+	}
+	for (size_t threads = 1; threads <= max; threads *= 2){
+		ft::set<int> into(a);
+		ft::set<int> other(b);
+		double start = now_ns();
+		into.union_with(other, ft::parallel(threads));
+		std::cout << "union_with, " << std::setw(2) << threads << " th" << std::setw(8)
+			<< (now_ns() - start) / 1e6 << "  (" << into.size() << " keys)" << std::endl;
+	}
+}
+
+int main(int argc, char **argv){
+	long n = argc > 1 ? atol(argv[1]) : 1000000;
+	size_t max = argc > 2 ? atoi(argv[2]) : 8;
+	ft::vector<int> big;
+	ft::vector<int> same;
+	ft::vector<int> small;
+	unsigned int seed = 1;
+
+	for (long i = 0; i < n; i++){
+		big.push_back(rand_r(&seed));
+		same.push_back(rand_r(&seed));
+	}
+	for (long i = 0; i < n / 1000; i++)
+		small.push_back(rand_r(&seed));
+	run(big, same, max);
+	run(big, small, max);
+	return (0);
+}
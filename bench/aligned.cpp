@@ -0,0 +1,147 @@
+/*
+Large ft::vector<float> buffers through std::allocator, aligned_allocator and
+huge_page_allocator: first touch (page faults), sequential scan, random
+gather (bound by TLB misses on small pages), with the dTLB load misses when
+the CPU counters are available and how much of the buffer huge pages back;
+then an axpy on a 64 bytes aligned buffer and on one 4 bytes off.
+Use: ./bench_aligned [ MiB [ gathers ] ]
+*/
+
+#include <iostream>
+#include <iomanip>
+#include <fstream>
+#include <sstream>
+#include <string>
+#include "../containers/vector.hpp"
+#include "../containers/aligned_allocator.hpp"
+#include <linux/perf_event.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#include <cstdlib>
+#include <cstring>
+#include <time.h>
+
+static double now_ns(void){
+	struct timespec ts;
+	clock_gettime(CLOCK_MONOTONIC, &ts);
+	return (ts.tv_sec * 1e9 + ts.tv_nsec);
+}
+
+/* A dTLB load miss counter for this thread, -1 when the CPU has none to give.*/
+static int tlb_counter(void){
+	struct perf_event_attr attr;
+
+	std::memset(&attr, 0, sizeof(attr));
+	attr.size = sizeof(attr);
+	attr.type = PERF_TYPE_HW_CACHE;
+	attr.config = PERF_COUNT_HW_CACHE_DTLB | (PERF_COUNT_HW_CACHE_OP_READ << 8)
+		| (PERF_COUNT_HW_CACHE_RESULT_MISS << 16);
+	attr.exclude_kernel = 1;
+	attr.exclude_hv = 1;
+	return (syscall(SYS_perf_event_open, &attr, 0, -1, -1, 0));
+}
+
+static long long tlb_read(int fd){
+	long long count = 0;
+
+	if (fd < 0 || read(fd, &count, sizeof(count)) != (ssize_t)sizeof(count))
+		return (-1);
+	return (count);
+}
+
+/* AnonHugePages, in KiB, of the mappings that overlap [p, p + bytes).*/
+static long huge_kib(const void *p, size_t bytes){
+	std::ifstream smaps("/proc/self/smaps");
+	std::string line;
+	size_t start = (size_t)p, end = start + bytes;
+	bool inside = false;
+	long kib = 0;
+
+	while (std::getline(smaps, line)){
+		size_t lo, hi;
+		char dash;
+		std::istringstream fields(line);
+		if (line.compare(0, 15, "AnonHugePages: ") == 0 && inside)
+			kib += atol(line.c_str() + 15);
+		else if (fields >> std::hex >> lo >> dash >> hi && dash == '-')
+			inside = lo < end && hi > start;
+	}
+	return (kib);
+}
+
+static float sink;
+
+template <class Alloc>
+static void run(const char *name, size_t n, size_t gathers){
+	int counter = tlb_counter();
+	unsigned int seed = 7;
+
+	double start = now_ns();
+	ft::vector<float, Alloc> v(n, 1.0f);
+	double touch = now_ns() - start;
+
+	float sum = 0;
+	start = now_ns();
+	for (size_t i = 0; i < n; i++)
+		sum += v[i];
+	double scan = now_ns() - start;
+
+	ft::vector<size_t> index(gathers);
+	for (size_t i = 0; i < gathers; i++)
+		index[i] = ((size_t)rand_r(&seed) << 16 ^ rand_r(&seed)) % n;
+	long long before = tlb_read(counter);
+	start = now_ns();
+	for (size_t i = 0; i < gathers; i++)
+		sum += v[index[i]];
+	double gather = now_ns() - start;
+	long long misses = tlb_read(counter) - before;
+	sink += sum;
+
+	std::cout << std::left << std::setw(18) << name << std::right << std::fixed << std::setprecision(1)
+		<< std::setw(10) << touch / 1e6 << std::setw(10) << n * sizeof(float) / scan
+		<< std::setw(11) << gather / gathers << std::setw(12);
+	if (counter < 0 || before < 0)
+		std::cout << "n/a";
+	else
+		std::cout << (double)misses / gathers;
+	std::cout << std::setw(9) << (int)(100.0 * huge_kib(&v[0], n * sizeof(float)) * 1024 / (n * sizeof(float)))
+		<< "%" << std::endl;
+	if (counter >= 0)
+		close(counter);
+}
+
+static void axpy(float *__restrict__ y, const float *__restrict__ x, float a, size_t n){
+	for (size_t i = 0; i < n; i++)
+		y[i] = a * x[i] + y[i];
+}
+
+/* axpy over buffers that stay in the L1 cache, from offset floats past a cache line.*/
+static double run_axpy(size_t offset){
+	const size_t n = 2048;
+	ft::vector<float, ft::aligned_allocator<float> > x(n + 16, 1.0f), y(n + 16, 2.0f);
+	const int rounds = 20000;
+
+	double start = now_ns();
+	for (int r = 0; r < rounds; r++)
+		axpy(&y[offset], &x[offset], 0.5f, n);
+	sink += y[offset];
+	return ((now_ns() - start) / rounds / n);
+}
+
+int main(int argc, char **argv){
+	size_t mib = argc > 1 ? strtoul(argv[1], NULL, 10) : 256;
+	size_t gathers = argc > 2 ? strtoul(argv[2], NULL, 10) : 4000000;
+	size_t n = (mib << 20) / sizeof(float);
+
+	std::cout << mib << " MiB of float, " << gathers << " random reads" << std::endl;
+	std::cout << "allocator          touch ms  scan GB/s  gather ns  TLB miss/rd  huge pages" << std::endl;
+	run<std::allocator<float> >("std::allocator", n, gathers);
+	run<ft::aligned_allocator<float> >("aligned 64", n, gathers);
+	run<ft::aligned_allocator<float, 4096> >("aligned 4096", n, gathers);
+	run<ft::huge_page_allocator<float> >("huge pages", n, gathers);
+	run<ft::huge_page_allocator<float, true> >("hugetlb or THP", n, gathers);
+	std::cout << std::endl << "axpy, ns per element" << std::endl;
+	std::cout << "64 bytes aligned   " << std::setw(8) << std::setprecision(3) << run_axpy(0) << std::endl;
+	std::cout << "4 bytes off        " << std::setw(8) << std::setprecision(3) << run_axpy(1) << std::endl;
+	return (sink == 42 ? 1 : 0);
+}
@@ -0,0 +1,85 @@
+/*
+Compares the balancing policies of ft::Rbtree: height, rotations and lookup
+latency for uniform and skewed (90% of the lookups on 1% of the keys) access.
+Use: ./bench_balance [ number of keys ]
+*/
+
+#include <iostream>
+#include <iomanip>
+#include <memory>
+#include <vector>
+#include "../rbtree/Rbtree.hpp"
+#include <cstdlib>
+#include <time.h>
+
+static double now_ns(void){
+	struct timespec ts;
+	clock_gettime(CLOCK_MONOTONIC, &ts);
+	return (ts.tv_sec * 1e9 + ts.tv_nsec);
+}
+
+template <class Policy>
+static void bench_policy(const char *name, const std::vector<int> &keys,
+	const std::vector<int> &uniform, const std::vector<int> &skewed){
+	typedef ft::Rbtree<int, std::less<int>, std::allocator<int>,
+		std::allocator<ft::Node<int> >, Policy> tree_type;
+	tree_type tree;
+	double start;
+	long found = 0;
+
+	start = now_ns();
+	for (size_t i = 0; i < keys.size(); i++)
+		tree.insert_value(keys[i]);
+	double insert_ns = (now_ns() - start) / keys.size();
+	size_t height = tree.height();
+	size_t insert_rotations = tree.rotations();
+
+	start = now_ns();
+	for (size_t i = 0; i < uniform.size(); i++)
+		found += tree.lookup_value(uniform[i]) != NULL;
+	double uniform_ns = (now_ns() - start) / uniform.size();
+
+	start = now_ns();
+	for (size_t i = 0; i < skewed.size(); i++)
+		found += tree.lookup_value(skewed[i]) != NULL;
+	double skewed_ns = (now_ns() - start) / skewed.size();
+
+	size_t before = tree.rotations();
+	start = now_ns();
+	for (size_t i = 0; i < keys.size(); i += 2)
+		tree.delete_value(keys[i]);
+	double erase_ns = (now_ns() - start) / ((keys.size() + 1) / 2);
+
+	std::cout << std::left << std::setw(8) << name << std::right << std::fixed << std::setprecision(1)
+		<< std::setw(8) << height
+		<< std::setw(12) << (double)insert_rotations / keys.size()
+		<< std::setw(12) << (double)(tree.rotations() - before) / ((keys.size() + 1) / 2)
+		<< std::setw(11) << insert_ns
+		<< std::setw(11) << uniform_ns
+		<< std::setw(11) << skewed_ns
+		<< std::setw(11) << erase_ns
+		<< "   (" << found << ")" << std::endl;
+}
+
+int main(int argc, char **argv){
+	size_t n = argc > 1 ? strtoul(argv[1], NULL, 10) : 200000;
+	std::vector<int> keys(n);
+	std::vector<int> uniform(n);
+	std::vector<int> skewed(n);
+
+	srand(42);
+	for (size_t i = 0; i < n; i++)
+		keys[i] = rand();
+	for (size_t i = 0; i < n; i++)
+		uniform[i] = keys[rand() % n];
+	for (size_t i = 0; i < n; i++)
+		skewed[i] = (rand() % 10) ? keys[rand() % (n / 100 + 1)] : keys[rand() % n];
+
+	std::cout << "balance policies, " << n << " random keys" << std::endl;
+	std::cout << "policy    height  rot/insert   rot/erase  insert ns  lookup ns  skewed ns   erase ns" << std::endl;
+	bench_policy<ft::rb_balance>("rb", keys, uniform, skewed);
+	bench_policy<ft::avl_balance>("avl", keys, uniform, skewed);
+	bench_policy<ft::wavl_balance>("wavl", keys, uniform, skewed);
+	bench_policy<ft::splay_balance>("splay", keys, uniform, skewed);
+	return (0);
+}
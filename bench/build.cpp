@@ -0,0 +1,44 @@
+/*
+Time to build an ft::map from an unsorted ft::vector of pairs: the range
+constructor (one insert per element) against the parallel one (parallel sort,
+then bottom up build of the tree) with 1 to max threads.
+Use: ./bench_build [ elements [ max threads ] ]
+*/
+
+#include <iostream>
+#include <iomanip>
+#include "../containers/map.hpp"
+#include "../containers/vector.hpp"
+#include <cstdlib>
+#include <time.h>
+
+static double now_ns(void){
+	struct timespec ts;
+	clock_gettime(CLOCK_MONOTONIC, &ts);
+	return (ts.tv_sec * 1e9 + ts.tv_nsec);
+}
+
+int main(int argc, char **argv){
+	long n = argc > 1 ? atol(argv[1]) : 2000000;
+	size_t max = argc > 2 ? atoi(argv[2]) : 8;
+	ft::vector<ft::pair<int, int> > input;
+	unsigned int seed = 1;
+
+	for (long i = 0; i < n; i++)
+		input.push_back(ft::make_pair(rand_r(&seed), (int)i));
+	std::cout << "map build, " << n << " unsorted elements, ms" << std::endl;
+
+	double start = now_ns();
+	{
+		ft::map<int, int> map(input.begin(), input.end());
+		std::cout << "insert loop     " << std::fixed << std::setprecision(1)
+			<< std::setw(10) << (now_ns() - start) / 1e6 << "  (" << map.size() << " keys)" << std::endl;
+	}
+	for (size_t threads = 1; threads <= max; threads *= 2){
+		start = now_ns();
+		ft::map<int, int> map(input.begin(), input.end(), ft::parallel(threads));
+		std::cout << "parallel, " << std::setw(2) << threads << " th" << std::setw(10)
+			<< (now_ns() - start) / 1e6 << "  (" << map.size() << " keys)" << std::endl;
+	}
+	return (0);
+}
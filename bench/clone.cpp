@@ -0,0 +1,64 @@
+/*
+Time to copy and to destroy a large ft::map: the copy by insertion of every
+element (what the copy constructor used to do) against the node for node clone
+with 1 to max threads, then clear() against clear(ft::parallel) and the time
+clear(ft::background()) keeps the caller.
+Use: ./bench_clone [ elements [ max threads ] ]
+*/
+
+#include <iostream>
+#include <iomanip>
+#include "../containers/map.hpp"
+#include <cstdlib>
+#include <time.h>
+
+static double now_ns(void){
+	struct timespec ts;
+	clock_gettime(CLOCK_MONOTONIC, &ts);
+	return (ts.tv_sec * 1e9 + ts.tv_nsec);
+}
+
+static void report(const char *name, size_t threads, double start){
+	std::cout << name;
+	if (threads)
+		std::cout << ", " << std::setw(2) << threads << " th";
+	else
+		std::cout << "      ";
+	std::cout << std::fixed << std::setprecision(1) << std::setw(10)
+		<< (now_ns() - start) / 1e6 << std::endl;
+}
+
+int main(int argc, char **argv){
+	long n = argc > 1 ? atol(argv[1]) : 2000000;
+	size_t max = argc > 2 ? atoi(argv[2]) : 8;
+	ft::map<int, int> map;
+	unsigned int seed = 1;
+
+	for (long i = 0; i < n; i++)
+		map.insert(ft::make_pair(rand_r(&seed), (int)i));
+	std::cout << "map of " << map.size() << " elements, ms" << std::endl;
+
+	double start = now_ns();
+	{
+		ft::map<int, int> copy(map.begin(), map.end());
+		report("insert copy ", 0, start);
+		start = now_ns();
+	}
+	report("clear       ", 0, start);
+	for (size_t threads = 1; threads <= max; threads *= 2){
+		start = now_ns();
+		ft::map<int, int> copy(map, ft::parallel(threads));
+		report("clone       ", threads, start);
+		start = now_ns();
+		copy.clear(ft::parallel(threads));
+		report("clear       ", threads, start);
+	}
+	ft::map<int, int> copy(map);
+	start = now_ns();
+	copy.clear(ft::background());
+	report("background  ", 0, start);
+	start = now_ns();
+	ft::background::wait();
+	report("  then wait ", 0, start);
+	return (0);
+}
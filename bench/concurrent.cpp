@@ -0,0 +1,112 @@
+/*
+Throughput of ft::concurrent_map against an ft::map behind one mutex, for a
+read-mostly mix (find, plus one set every write_every operations), with 1 to
+max threads.
+Use: ./bench_concurrent [ max threads [ write_every ] ]
+*/
+
+#include <iostream>
+#include <iomanip>
+#include "../containers/concurrent_map.hpp"
+#include "../containers/map.hpp"
+#include <cstdlib>
+#include <pthread.h>
+#include <time.h>
+
+static const int g_keys = 100000;
+static const int g_ops = 400000;
+static int g_write_every = 20;
+
+static double now_ns(void){
+	struct timespec ts;
+	clock_gettime(CLOCK_MONOTONIC, &ts);
+	return (ts.tv_sec * 1e9 + ts.tv_nsec);
+}
+
+struct locked_map
+{
+	ft::map<int, int>	map;
+	pthread_mutex_t		mutex;
+
+	locked_map() { pthread_mutex_init(&mutex, NULL); }
+	~locked_map() { pthread_mutex_destroy(&mutex); }
+
+	bool find(int k, int &out){
+		pthread_mutex_lock(&mutex);
+		ft::map<int, int>::iterator it = map.find(k);
+		bool found = it != map.end();
+		if (found)
+			out = it->second;
+		pthread_mutex_unlock(&mutex);
+		return (found);
+	}
+	void set(int k, int v){
+		pthread_mutex_lock(&mutex);
+		map[k] = v;
+		pthread_mutex_unlock(&mutex);
+	}
+};
+
+template <class Map>
+struct job
+{
+	Map				*map;
+	unsigned int	seed;
+	long			found;
+};
+
+template <class Map>
+static void *run(void *arg){
+	job<Map> *j = static_cast<job<Map> *>(arg);
+	int value;
+
+	for (int i = 0; i < g_ops; i++){
+		int k = rand_r(&j->seed) % g_keys;
+		if (i % g_write_every == 0)
+			j->map->set(k, i);
+		else
+			j->found += j->map->find(k, value);
+	}
+	return (NULL);
+}
+
+/* Million operations per second with n threads.*/
+template <class Map>
+static double bench(Map &map, int n){
+	pthread_t threads[64];
+	job<Map> jobs[64];
+
+	double start = now_ns();
+	for (int i = 0; i < n; i++){
+		jobs[i].map = &map;
+		jobs[i].seed = i + 1;
+		jobs[i].found = 0;
+		pthread_create(&threads[i], NULL, &run<Map>, &jobs[i]);
+	}
+	for (int i = 0; i < n; i++)
+		pthread_join(threads[i], NULL);
+	return ((double)n * g_ops / (now_ns() - start) * 1e3);
+}
+
+int main(int argc, char **argv){
+	int max = argc > 1 ? atoi(argv[1]) : 8;
+	if (argc > 2)
+		g_write_every = atoi(argv[2]);
+	if (max > 64)
+		max = 64;
+	ft::concurrent_map<int, int> concurrent;
+	locked_map locked;
+
+	for (int k = 0; k < g_keys; k += 2){
+		concurrent.set(k, k);
+		locked.set(k, k);
+	}
+	std::cout << "concurrent map, " << g_keys / 2 << " keys, 1 write every " << g_write_every
+		<< " operations, Mops/s" << std::endl;
+	std::cout << "threads  mutex+map  concurrent_map" << std::endl;
+	for (int n = 1; n <= max; n *= 2)
+		std::cout << std::setw(7) << n << std::fixed << std::setprecision(2)
+			<< std::setw(11) << bench(locked, n)
+			<< std::setw(16) << bench(concurrent, n) << std::endl;
+	return (0);
+}
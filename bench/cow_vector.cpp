@@ -0,0 +1,68 @@
+/*
+A vector of double passed by value through a pipeline of stages, most of
+which only read it (a sum) and the last of which changes it (scales it):
+ft::vector, copied whole into every stage, against ft::cow_vector, shared
+by the reading stages and copied once by the writing one.
+Use: ./bench_cow_vector [ elements [ stages ] ]
+*/
+
+#include <iostream>
+#include <iomanip>
+#include "../containers/vector.hpp"
+#include "../containers/cow_vector.hpp"
+#include <cstdlib>
+#include <time.h>
+
+static double sink;
+
+static double now_ns(void){
+	struct timespec ts;
+	clock_gettime(CLOCK_MONOTONIC, &ts);
+	return (ts.tv_sec * 1e9 + ts.tv_nsec);
+}
+
+/* Takes its input by value, as a stage handing data to the next one.*/
+template <class Vector>
+static double read_stage(Vector input){
+	const Vector &read = input;
+	double sum = 0;
+	for (size_t i = 0; i < read.size(); i += 16)
+		sum += read[i];
+	return (sum);
+}
+
+template <class Vector>
+static double write_stage(Vector input){
+	for (size_t i = 0; i < input.size(); i += 16)
+		input[i] *= 2;
+	return (input[input.size() / 2]);
+}
+
+template <class Vector>
+static double run(const Vector &data, size_t stages, int passes){
+	double start = now_ns();
+	for (int p = 0; p < passes; p++){
+		for (size_t s = 1; s < stages; s++)
+			sink += read_stage(data);
+		sink += write_stage(data);
+	}
+	return ((now_ns() - start) / passes);
+}
+
+int main(int argc, char **argv){
+	size_t n = argc > 1 ? strtoul(argv[1], NULL, 10) : 4000000;
+	size_t stages = argc > 2 ? strtoul(argv[2], NULL, 10) : 8;
+	int passes = 20;
+
+	ft::vector<double> data(n);
+	for (size_t i = 0; i < n; i++)
+		data[i] = i * 0.5;
+	ft::cow_vector<double> shared(data);
+
+	std::cout << n << " doubles through " << stages << " stages (" << stages - 1 << " read only)" << std::endl;
+	std::cout << "container              ms per pass" << std::endl;
+	std::cout << std::fixed << std::setprecision(2);
+	std::cout << "ft::vector          " << std::setw(14) << run(data, stages, passes) / 1e6 << std::endl;
+	std::cout << "ft::cow_vector      " << std::setw(14) << run(shared, stages, passes) / 1e6 << std::endl;
+	return (sink == 42);
+}
@@ -0,0 +1,106 @@
+/*
+Overhead of ft::epoch per operation: an epoch::guard around a shared pointer
+load, and a guard plus retire() of a heap node, against the same work with no
+reclamation (a plain load, an immediate delete), with 1 to max threads.
+Use: ./bench_epoch [ max threads ]
+*/
+
+#include <iostream>
+#include <iomanip>
+#include "../containers/epoch.hpp"
+#include <cstdlib>
+#include <pthread.h>
+#include <time.h>
+
+static const int g_ops = 2000000;
+static int *g_shared = NULL;
+static int *g_sink = NULL;
+
+static double now_ns(void){
+	struct timespec ts;
+	clock_gettime(CLOCK_MONOTONIC, &ts);
+	return (ts.tv_sec * 1e9 + ts.tv_nsec);
+}
+
+static void free_int(void *ptr){
+	delete static_cast<int *>(ptr);
+}
+
+struct job
+{
+	int		mode;
+	long	sum;
+	size_t	peak;
+};
+
+static void *run(void *arg){
+	job *j = static_cast<job *>(arg);
+
+	for (int i = 0; i < g_ops; i++){
+		switch (j->mode){
+			case 0:
+				j->sum += *__atomic_load_n(&g_shared, __ATOMIC_ACQUIRE);
+				break;
+			case 1:{
+				ft::epoch::guard guard;
+				j->sum += *__atomic_load_n(&g_shared, __ATOMIC_ACQUIRE);
+				break;
+			}
+			case 2:{
+				int *node = new int(i);
+				__atomic_store_n(&g_sink, node, __ATOMIC_RELAXED);
+				delete node;
+				break;
+			}
+			default:{
+				ft::epoch::guard guard;
+				ft::epoch::retire(new int(i), &free_int);
+				if (i % 4096 == 0){
+					size_t pending = ft::epoch::statistics().pending;
+					j->peak = pending > j->peak ? pending : j->peak;
+				}
+			}
+		}
+	}
+	ft::epoch::flush();
+	return (NULL);
+}
+
+/* Nanoseconds per operation, peak garbage in *peak.*/
+static double bench(int mode, int n, size_t *peak){
+	pthread_t threads[64];
+	job jobs[64];
+
+	double start = now_ns();
+	for (int i = 0; i < n; i++){
+		jobs[i].mode = mode;
+		jobs[i].sum = 0;
+		jobs[i].peak = 0;
+		pthread_create(&threads[i], NULL, &run, &jobs[i]);
+	}
+	*peak = 0;
+	for (int i = 0; i < n; i++){
+		pthread_join(threads[i], NULL);
+		*peak = jobs[i].peak > *peak ? jobs[i].peak : *peak;
+	}
+	return ((now_ns() - start) / ((double)n * g_ops));
+}
+
+int main(int argc, char **argv){
+	int max = argc > 1 ? atoi(argv[1]) : 8;
+	size_t peak;
+
+	if (max > 64)
+		max = 64;
+	g_shared = new int(42);
+	std::cout << "epoch overhead, ns per operation" << std::endl;
+	std::cout << "threads      load  guard+load    delete  guard+retire  peak pending" << std::endl;
+	for (int n = 1; n <= max; n *= 2){
+		std::cout << std::setw(7) << n << std::fixed << std::setprecision(1);
+		for (int mode = 0; mode < 4; mode++)
+			std::cout << std::setw(mode == 3 ? 14 : mode == 0 ? 10 : 12) << bench(mode, n, &peak);
+		std::cout << std::setw(14) << peak << std::endl;
+	}
+	delete g_shared;
+	return (0);
+}
@@ -0,0 +1,65 @@
+/*
+Lookup throughput of ft::frozen_map (Eytzinger array) against the ft::map it
+was frozen from, for random hits and misses.
+Use: ./bench_frozen [ number of keys ]
+*/
+
+#include <iostream>
+#include <iomanip>
+#include <vector>
+#include "../containers/frozen_map.hpp"
+#include <cstdlib>
+#include <time.h>
+
+static double now_ns(void){
+	struct timespec ts;
+	clock_gettime(CLOCK_MONOTONIC, &ts);
+	return (ts.tv_sec * 1e9 + ts.tv_nsec);
+}
+
+template <class Map>
+static double bench_find(const Map &map, const std::vector<int> &queries, long &found){
+	double start = now_ns();
+	for (size_t i = 0; i < queries.size(); i++)
+		found += map.find(queries[i]) != map.end();
+	return ((now_ns() - start) / queries.size());
+}
+
+template <class Map>
+static double bench_lower_bound(const Map &map, const std::vector<int> &queries, long &found){
+	double start = now_ns();
+	for (size_t i = 0; i < queries.size(); i++)
+		found += map.lower_bound(queries[i]) != map.end();
+	return ((now_ns() - start) / queries.size());
+}
+
+int main(int argc, char **argv){
+	size_t n = argc > 1 ? strtoul(argv[1], NULL, 10) : 1000000;
+	ft::map<int, int> map;
+	std::vector<int> queries(2000000);
+	long found = 0;
+
+	srand(42);
+	for (size_t i = 0; i < n; i++)
+		map[rand()] = (int)i;
+	for (size_t i = 0; i < queries.size(); i++)
+		queries[i] = rand();
+	double start = now_ns();
+	ft::frozen_map<int, int> frozen = map.freeze();
+	double freeze_ms = (now_ns() - start) / 1e6;
+
+	std::cout << "frozen map, " << map.size() << " keys, " << queries.size()
+		<< " random queries (freeze: " << std::fixed << std::setprecision(1) << freeze_ms << " ms)" << std::endl;
+	std::cout << "container      find ns  lower_bound ns" << std::endl;
+	double map_find = bench_find(map, queries, found);
+	double map_lower = bench_lower_bound(map, queries, found);
+	double frozen_find = bench_find(frozen, queries, found);
+	double frozen_lower = bench_lower_bound(frozen, queries, found);
+	std::cout << std::left << std::setw(12) << "ft::map" << std::right
+		<< std::setw(10) << map_find << std::setw(16) << map_lower << std::endl;
+	std::cout << std::left << std::setw(12) << "frozen_map" << std::right
+		<< std::setw(10) << frozen_find << std::setw(16) << frozen_lower << std::endl;
+	std::cout << "speedup     " << std::setw(10) << map_find / frozen_find
+		<< std::setw(16) << map_lower / frozen_lower << "   (" << found << ")" << std::endl;
+	return (0);
+}
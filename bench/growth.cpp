@@ -0,0 +1,60 @@
+/*
+Growth policies of ft::vector: vectors of random final sizes filled by
+push_back, for each policy the fill time, the storage left unused (slack)
+and what shrink_to_fit() gives back.
+Use: ./bench_growth [ vectors [ max size ] ]
+*/
+
+#include <iostream>
+#include <iomanip>
+#include "../containers/vector.hpp"
+#include <cstdlib>
+#include <time.h>
+
+static double now_ns(void){
+	struct timespec ts;
+	clock_gettime(CLOCK_MONOTONIC, &ts);
+	return (ts.tv_sec * 1e9 + ts.tv_nsec);
+}
+
+template <class Policy>
+static void run(const char *name, const ft::vector<size_t> &sizes){
+	typedef ft::vector<int, std::allocator<int>, Policy> vector_type;
+	ft::vector<vector_type> vectors(sizes.size());
+	size_t elements = 0, slack = 0;
+
+	double start = now_ns();
+	for (size_t v = 0; v < sizes.size(); v++)
+		for (size_t i = 0; i < sizes[v]; i++)
+			vectors[v].push_back((int)i);
+	double fill = now_ns() - start;
+	for (size_t v = 0; v < sizes.size(); v++){
+		elements += vectors[v].size();
+		slack += vectors[v].slack();
+	}
+	start = now_ns();
+	for (size_t v = 0; v < sizes.size(); v++)
+		vectors[v].shrink_to_fit();
+	double shrink = now_ns() - start;
+	std::cout << std::left << std::setw(20) << name << std::right << std::fixed << std::setprecision(1)
+		<< std::setw(10) << fill / 1e6 << std::setw(10) << 100.0 * slack / (elements + slack)
+		<< std::setw(12) << slack * sizeof(int) / (1 << 20) << std::setw(11) << shrink / 1e6 << std::endl;
+}
+
+int main(int argc, char **argv){
+	size_t count = argc > 1 ? strtoul(argv[1], NULL, 10) : 200;
+	size_t max = argc > 2 ? strtoul(argv[2], NULL, 10) : 1000000;
+	ft::vector<size_t> sizes;
+	unsigned int seed = 3;
+
+	for (size_t v = 0; v < count; v++)
+		sizes.push_back(rand_r(&seed) % max + 1);
+	std::cout << count << " vectors of int, 1 to " << max << " elements" << std::endl;
+	std::cout << "policy                 fill ms   slack %   slack MiB  shrink ms" << std::endl;
+	run<ft::growth_double>("double", sizes);
+	run<ft::growth_golden>("golden", sizes);
+	run<ft::growth_chunk<65536> >("chunk 64Ki", sizes);
+	run<ft::growth_pages<> >("pages, double", sizes);
+	run<ft::growth_pages<ft::growth_golden> >("pages, golden", sizes);
+	return (0);
+}
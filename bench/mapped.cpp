@@ -0,0 +1,66 @@
+/*
+Startup cost of a large read-only table: rebuilding an ft::map by insertion,
+against opening the file written by ft::mapped_map, then the time of random
+lookups in each (the first mapped lookups also fault the pages in).
+Use: ./bench_mapped [ elements [ file ] ]
+*/
+
+#include <iostream>
+#include <iomanip>
+#include "../containers/map.hpp"
+#include "../containers/mapped_map.hpp"
+#include <cstdlib>
+#include <unistd.h>
+#include <time.h>
+
+static double now_ns(void){
+	struct timespec ts;
+	clock_gettime(CLOCK_MONOTONIC, &ts);
+	return (ts.tv_sec * 1e9 + ts.tv_nsec);
+}
+
+static void report(const char *name, double start, long check){
+	std::cout << name << std::fixed << std::setprecision(3) << std::setw(12)
+		<< (now_ns() - start) / 1e6 << "  (" << check << ")" << std::endl;
+}
+
+int main(int argc, char **argv){
+	long n = argc > 1 ? atol(argv[1]) : 2000000;
+	const char *path = argc > 2 ? argv[2] : "bench_mapped.map";
+	unsigned int seed = 1;
+	ft::vector<int> keys;
+
+	for (long i = 0; i < n; i++)
+		keys.push_back(rand_r(&seed));
+	{
+		ft::map<int, long> source;
+		for (long i = 0; i < n; i++)
+			source.insert(ft::make_pair(keys[i], i));
+		ft::mapped_map<int, long>::write(path, source);
+	}
+	std::cout << n << " elements, ms" << std::endl;
+
+	double start = now_ns();
+	ft::map<int, long> map;
+	for (long i = 0; i < n; i++)
+		map.insert(ft::make_pair(keys[i], i));
+	report("map: rebuild        ", start, map.size());
+
+	start = now_ns();
+	ft::mapped_map<int, long> mapped(path);
+	report("mapped_map: open    ", start, mapped.size());
+
+	long sum = 0;
+	start = now_ns();
+	for (long i = 0; i < n; i++)
+		sum += mapped.find(keys[(i * 7919) % n])->second;
+	report("mapped_map: lookups ", start, sum);
+
+	sum = 0;
+	start = now_ns();
+	for (long i = 0; i < n; i++)
+		sum += map.find(keys[(i * 7919) % n])->second;
+	report("map: lookups        ", start, sum);
+	unlink(path);
+	return (0);
+}
@@ -0,0 +1,117 @@
+/*
+An append-only log of 32 byte records, saved at checkpoints: an ft::vector
+written whole to its file at each one (write + fdatasync), against an
+ft::mapped_vector synced in place (msync writes only the modified pages);
+then the time to get the log back from the file, read into a vector or
+mapped again.
+Use: ./bench_mapped_vector [ records [ checkpoints ] ]
+*/
+
+#include <iostream>
+#include <iomanip>
+#include <sstream>
+#include "../containers/vector.hpp"
+#include "../containers/mapped_vector.hpp"
+#include <cstdlib>
+#include <time.h>
+
+struct record
+{
+	long	id;
+	long	time;
+	double	value;
+	char	tag[8];
+};
+
+static double now_ns(void){
+	struct timespec ts;
+	clock_gettime(CLOCK_MONOTONIC, &ts);
+	return (ts.tv_sec * 1e9 + ts.tv_nsec);
+}
+
+static record make_record(size_t i){
+	record r = {(long)i, (long)i * 3, i * 0.25, "log"};
+	return (r);
+}
+
+/* The whole vector written to path, then flushed to disk.*/
+static void save(const ft::vector<record> &log, const std::string &path){
+	int fd = open(path.c_str(), O_WRONLY | O_CREAT | O_TRUNC, 0644);
+	const char *bytes = reinterpret_cast<const char *>(&log[0]);
+	size_t left = log.size() * sizeof(record);
+
+	while (left > 0){
+		ssize_t written = write(fd, bytes, left);
+		if (written <= 0)
+			exit(1);
+		bytes += written;
+		left -= written;
+	}
+	fdatasync(fd);
+	close(fd);
+}
+
+static void load(ft::vector<record> &log, const std::string &path){
+	struct stat st;
+	int fd = open(path.c_str(), O_RDONLY);
+
+	fstat(fd, &st);
+	log.resize(st.st_size / sizeof(record));
+	if (read(fd, &log[0], st.st_size) != st.st_size)
+		exit(1);
+	close(fd);
+}
+
+int main(int argc, char **argv){
+	size_t n = argc > 1 ? strtoul(argv[1], NULL, 10) : 4000000;
+	size_t checkpoints = argc > 2 ? strtoul(argv[2], NULL, 10) : 8;
+	std::ostringstream base;
+	base << "/tmp/ft_bench_log_" << getpid();
+	std::string vector_path = base.str() + ".vector";
+	std::string mapped_path = base.str() + ".mapped";
+	long check = 0;
+
+	double start = now_ns();
+	{
+		ft::vector<record> log;
+		for (size_t i = 0; i < n; i++){
+			log.push_back(make_record(i));
+			if ((i + 1) % (n / checkpoints) == 0)
+				save(log, vector_path);
+		}
+	}
+	double vector_append = now_ns() - start;
+	start = now_ns();
+	{
+		ft::mapped_vector<record> log(mapped_path.c_str());
+		for (size_t i = 0; i < n; i++){
+			log.push_back(make_record(i));
+			if ((i + 1) % (n / checkpoints) == 0)
+				log.sync();
+		}
+	}
+	double mapped_append = now_ns() - start;
+
+	start = now_ns();
+	{
+		ft::vector<record> log;
+		load(log, vector_path);
+		check += log.back().id;
+	}
+	double vector_open = now_ns() - start;
+	start = now_ns();
+	{
+		ft::mapped_vector<record> log(mapped_path.c_str());
+		check += log.back().id;
+	}
+	double mapped_open = now_ns() - start;
+	unlink(vector_path.c_str());
+	unlink(mapped_path.c_str());
+
+	std::cout << n << " records of " << sizeof(record) << " bytes, " << checkpoints << " checkpoints" << std::endl;
+	std::cout << "container              append+save ms   reopen ms" << std::endl;
+	std::cout << std::fixed << std::setprecision(2);
+	std::cout << "ft::vector + write     " << std::setw(14) << vector_append / 1e6 << std::setw(12) << vector_open / 1e6 << std::endl;
+	std::cout << "ft::mapped_vector      " << std::setw(14) << mapped_append / 1e6 << std::setw(12) << mapped_open / 1e6 << std::endl;
+	return (check == 42 ? 1 : 0);
+}
@@ -0,0 +1,101 @@
+/*
+ft::paged_map on a file several times larger than its buffer pool: ordered
+load, random lookups and inserts, and full scans with and without read
+ahead. The file is dropped from the system cache before the lookups and the
+scans, so pool misses go to the disk.
+Use: ./bench_paged [ elements [ pool MiB [ file ] ] ]
+*/
+
+#include <iostream>
+#include <iomanip>
+#include "../containers/paged_map.hpp"
+#include <cstdlib>
+#include <fcntl.h>
+#include <unistd.h>
+#include <time.h>
+
+typedef ft::paged_map<long, long> map_type;
+
+static double now_ns(void){
+	struct timespec ts;
+	clock_gettime(CLOCK_MONOTONIC, &ts);
+	return (ts.tv_sec * 1e9 + ts.tv_nsec);
+}
+
+static void drop_cache(const char *path){
+	int fd = open(path, O_RDONLY);
+	if (fd >= 0){
+		posix_fadvise(fd, 0, 0, POSIX_FADV_DONTNEED);
+		close(fd);
+	}
+}
+
+static void report(const char *name, double start, long ops, const map_type &map, size_t misses){
+	std::cout << std::left << std::setw(26) << name << std::right << std::fixed
+		<< std::setprecision(1) << std::setw(10) << (now_ns() - start) / 1e6
+		<< std::setw(10) << (now_ns() - start) / ops
+		<< std::setw(12) << map.pool().misses() - misses << std::endl;
+}
+
+static void scan(const char *name, const char *path, size_t pool, size_t read_ahead){
+	drop_cache(path);
+	map_type map(path, pool, read_ahead);
+	double start = now_ns();
+	long sum = 0;
+	for (map_type::iterator it = map.begin(); it != map.end(); ++it)
+		sum += it->second;
+	report(name, start, map.size(), map, 0);
+	if (sum == 42)
+		std::cout << std::endl;
+}
+
+int main(int argc, char **argv){
+	long n = argc > 1 ? atol(argv[1]) : 4000000;
+	size_t pool = (argc > 2 ? atol(argv[2]) : 16) << 20;
+	const char *path = argc > 3 ? argv[3] : "bench_paged.db";
+	unsigned int seed = 1;
+
+	unlink(path);
+	std::cout << "paged_map<long, long>, " << n << " elements, pool of "
+		<< (pool >> 20) << " MiB" << std::endl;
+	std::cout << "                                  ms  ns / op  pool misses" << std::endl;
+	{
+		map_type map(path, pool);
+		double start = now_ns();
+		for (long i = 0; i < n; i++)
+			map.insert(ft::make_pair(2 * i, i));
+		map.sync();
+		report("ordered load", start, n, map, 0);
+		std::cout << "file: " << map.pool().head().pages * ft::paged_pool::page_size / (1 << 20)
+			<< " MiB, height " << map.pool().head().height + 1 << std::endl;
+	}
+	drop_cache(path);
+	{
+		map_type map(path, pool);
+		long ops = n / 10;
+		size_t misses = map.pool().misses();
+		double start = now_ns();
+		long found = 0;
+		for (long i = 0; i < ops; i++)
+			found += map.count(rand_r(&seed) % (2 * n));
+		report("random find, cold", start, ops, map, misses);
+		misses = map.pool().misses();
+		start = now_ns();
+		for (long i = 0; i < ops; i++)
+			found += map.count(rand_r(&seed) % (2 * n));
+		report("random find, warm", start, ops, map, misses);
+		misses = map.pool().misses();
+		start = now_ns();
+		for (long i = 0; i < ops; i++)
+			map.insert(ft::make_pair(2 * (rand_r(&seed) % n) + 1, i));
+		map.sync();
+		report("random insert", start, ops, map, misses);
+		if (found == 42)
+			std::cout << std::endl;
+	}
+	scan("scan, no read ahead", path, pool, 0);
+	scan("scan, read ahead 8", path, pool, 8);
+	scan("scan, read ahead 32", path, pool, 32);
+	unlink(path);
+	return (0);
+}
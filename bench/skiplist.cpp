@@ -0,0 +1,125 @@
+/*
+Throughput of ft::concurrent_skiplist_map against ft::concurrent_map and an
+ft::map behind one mutex, for a write heavy mix (one insert and one erase every
+write_every operations, find otherwise), with 1 to max threads.
+Use: ./bench_skiplist [ max threads [ write_every ] ]
+*/
+
+#include <iostream>
+#include <iomanip>
+#include "../containers/concurrent_skiplist_map.hpp"
+#include "../containers/concurrent_map.hpp"
+#include "../containers/map.hpp"
+#include <cstdlib>
+#include <pthread.h>
+#include <time.h>
+
+static const int g_keys = 100000;
+static const int g_ops = 400000;
+static int g_write_every = 2;
+
+static double now_ns(void){
+	struct timespec ts;
+	clock_gettime(CLOCK_MONOTONIC, &ts);
+	return (ts.tv_sec * 1e9 + ts.tv_nsec);
+}
+
+struct locked_map
+{
+	ft::map<int, int>	map;
+	pthread_mutex_t		mutex;
+
+	locked_map() { pthread_mutex_init(&mutex, NULL); }
+	~locked_map() { pthread_mutex_destroy(&mutex); }
+
+	bool find(int k, int &out){
+		pthread_mutex_lock(&mutex);
+		ft::map<int, int>::iterator it = map.find(k);
+		bool found = it != map.end();
+		if (found)
+			out = it->second;
+		pthread_mutex_unlock(&mutex);
+		return (found);
+	}
+	bool insert(const ft::pair<const int, int> &val){
+		pthread_mutex_lock(&mutex);
+		bool inserted = map.insert(val).second;
+		pthread_mutex_unlock(&mutex);
+		return (inserted);
+	}
+	size_t erase(int k){
+		pthread_mutex_lock(&mutex);
+		size_t erased = map.erase(k);
+		pthread_mutex_unlock(&mutex);
+		return (erased);
+	}
+};
+
+template <class Map>
+struct job
+{
+	Map				*map;
+	unsigned int	seed;
+	long			found;
+};
+
+template <class Map>
+static void *run(void *arg){
+	job<Map> *j = static_cast<job<Map> *>(arg);
+	int value;
+
+	for (int i = 0; i < g_ops; i++){
+		int k = rand_r(&j->seed) % g_keys;
+		if (i % g_write_every == 0){
+			j->map->insert(ft::make_pair(k, i));
+			j->map->erase(rand_r(&j->seed) % g_keys);
+		}
+		else
+			j->found += j->map->find(k, value);
+	}
+	return (NULL);
+}
+
+/* Million operations per second with n threads.*/
+template <class Map>
+static double bench(Map &map, int n){
+	pthread_t threads[64];
+	job<Map> jobs[64];
+
+	double start = now_ns();
+	for (int i = 0; i < n; i++){
+		jobs[i].map = &map;
+		jobs[i].seed = i + 1;
+		jobs[i].found = 0;
+		pthread_create(&threads[i], NULL, &run<Map>, &jobs[i]);
+	}
+	for (int i = 0; i < n; i++)
+		pthread_join(threads[i], NULL);
+	return ((double)n * g_ops / (now_ns() - start) * 1e3);
+}
+
+int main(int argc, char **argv){
+	int max = argc > 1 ? atoi(argv[1]) : 8;
+	if (argc > 2)
+		g_write_every = atoi(argv[2]);
+	if (max > 64)
+		max = 64;
+	ft::concurrent_skiplist_map<int, int> skiplist;
+	ft::concurrent_map<int, int> concurrent;
+	locked_map locked;
+
+	for (int k = 0; k < g_keys; k += 2){
+		skiplist.insert(ft::make_pair(k, k));
+		concurrent.insert(ft::make_pair(k, k));
+		locked.insert(ft::make_pair(k, k));
+	}
+	std::cout << "concurrent skiplist, " << g_keys / 2 << " keys, 1 insert + 1 erase every "
+		<< g_write_every << " operations, Mops/s" << std::endl;
+	std::cout << "threads  mutex+map  concurrent_map  skiplist_map" << std::endl;
+	for (int n = 1; n <= max; n *= 2)
+		std::cout << std::setw(7) << n << std::fixed << std::setprecision(2)
+			<< std::setw(11) << bench(locked, n)
+			<< std::setw(16) << bench(concurrent, n)
+			<< std::setw(14) << bench(skiplist, n) << std::endl;
+	return (0);
+}
@@ -0,0 +1,64 @@
+/*
+Short lived vectors of 1 to 8 elements, as built per request: ft::vector
+against ft::small_vector<int, 8>, filled by push_back then dropped, and a
+stack of the same depth.
+Use: ./bench_small_vector [ rounds ]
+*/
+
+#include <iostream>
+#include <iomanip>
+#include "../containers/small_vector.hpp"
+#include "../containers/stack.hpp"
+#include <cstdlib>
+#include <time.h>
+
+static double now_ns(void){
+	struct timespec ts;
+	clock_gettime(CLOCK_MONOTONIC, &ts);
+	return (ts.tv_sec * 1e9 + ts.tv_nsec);
+}
+
+template <class Vector>
+static double fill(const ft::vector<int> &sizes, long &sum){
+	double start = now_ns();
+	for (size_t r = 0; r < sizes.size(); r++){
+		Vector v;
+		for (int i = 0; i < sizes[r]; i++)
+			v.push_back(i);
+		sum += v.back();
+	}
+	return ((now_ns() - start) / sizes.size());
+}
+
+template <class Stack>
+static double stack(const ft::vector<int> &sizes, long &sum){
+	double start = now_ns();
+	for (size_t r = 0; r < sizes.size(); r++){
+		Stack s;
+		for (int i = 0; i < sizes[r]; i++)
+			s.push(i);
+		while (s.size() > 1)
+			s.pop();
+		sum += s.top();
+	}
+	return ((now_ns() - start) / sizes.size());
+}
+
+int main(int argc, char **argv){
+	size_t rounds = argc > 1 ? strtoul(argv[1], NULL, 10) : 2000000;
+	ft::vector<int> sizes;
+	unsigned int seed = 5;
+	long sum = 0;
+
+	for (size_t r = 0; r < rounds; r++)
+		sizes.push_back(rand_r(&seed) % 8 + 1);
+	std::cout << rounds << " containers of 1 to 8 int" << std::endl;
+	std::cout << "                           ns / container" << std::endl;
+	std::cout << std::fixed << std::setprecision(1);
+	std::cout << "vector push_back           " << std::setw(10) << fill<ft::vector<int> >(sizes, sum) << std::endl;
+	std::cout << "small_vector push_back     " << std::setw(10) << fill<ft::small_vector<int, 8> >(sizes, sum) << std::endl;
+	std::cout << "stack over vector          " << std::setw(10) << stack<ft::stack<int> >(sizes, sum) << std::endl;
+	std::cout << "stack over small_vector    " << std::setw(10)
+		<< stack<ft::stack<int, ft::small_vector<int, 8> > >(sizes, sum) << std::endl;
+	return (sum == 42 ? 1 : 0);
+}
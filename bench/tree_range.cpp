@@ -0,0 +1,70 @@
+/*
+Time to sum the mapped values of a large ft::map: a serial iterator loop, a
+copy into an ft::vector summed afterwards, and parallel_reduce over tree
+ranges with 1 to max threads.
+Use: ./bench_tree_range [ elements [ max threads ] ]
+*/
+
+#include <iostream>
+#include <iomanip>
+#include "../containers/map.hpp"
+#include "../containers/tree_range.hpp"
+#include "../containers/vector.hpp"
+#include <cstdlib>
+#include <time.h>
+
+static double now_ns(void){
+	struct timespec ts;
+	clock_gettime(CLOCK_MONOTONIC, &ts);
+	return (ts.tv_sec * 1e9 + ts.tv_nsec);
+}
+
+static long add_second(long sum, const ft::pair<const int, int> &value){
+	return (sum + value.second);
+}
+
+static long add(long a, long b){
+	return (a + b);
+}
+
+static void report(const char *name, double start, long sum){
+	std::cout << name << std::fixed << std::setprecision(1) << std::setw(10)
+		<< (now_ns() - start) / 1e6 << "  (sum " << sum << ")" << std::endl;
+}
+
+int main(int argc, char **argv){
+	long n = argc > 1 ? atol(argv[1]) : 2000000;
+	size_t max = argc > 2 ? atoi(argv[2]) : 8;
+	ft::map<int, int> map;
+	unsigned int seed = 1;
+
+	for (long i = 0; i < n; i++)
+		map.insert(ft::make_pair(rand_r(&seed), (int)(i % 1000)));
+	std::cout << "sum over a map of " << map.size() << " elements, ms" << std::endl;
+
+	double start = now_ns();
+	long sum = 0;
+	for (ft::map<int, int>::iterator it = map.begin(); it != map.end(); ++it)
+		sum += it->second;
+	report("iterator loop   ", start, sum);
+
+	start = now_ns();
+	{
+		ft::vector<int> values;
+		for (ft::map<int, int>::iterator it = map.begin(); it != map.end(); ++it)
+			values.push_back(it->second);
+		sum = 0;
+		for (size_t i = 0; i < values.size(); i++)
+			sum += values[i];
+	}
+	report("copy, then sum  ", start, sum);
+
+	for (size_t threads = 1; threads <= max; threads *= 2){
+		start = now_ns();
+		sum = ft::parallel_reduce(map.begin(), map.end(), 0L, add_second, add,
+			ft::parallel(threads));
+		std::cout << "reduce, " << std::setw(2) << threads << " th  ";
+		report("", start, sum);
+	}
+	return (0);
+}
@@ -0,0 +1,77 @@
+/*
+A receive buffer filled in 64 KiB chunks (memcpy standing in for read()):
+grown with resize(), which zeroes each chunk before it is overwritten,
+against append_uninitialized(), which leaves it to the copy; then a large
+byte buffer sized once, by resize() against resize_uninitialized(), with
+its pages touched by the first write.
+Use: ./bench_uninitialized [ MiB ]
+*/
+
+#include <iostream>
+#include <iomanip>
+#include "../containers/vector.hpp"
+#include <cstdlib>
+#include <cstring>
+#include <time.h>
+
+static const size_t chunk = 64 << 10;
+static char source[64 << 10];
+static long sink;
+
+static double now_ns(void){
+	struct timespec ts;
+	clock_gettime(CLOCK_MONOTONIC, &ts);
+	return (ts.tv_sec * 1e9 + ts.tv_nsec);
+}
+
+static double receive_resize(size_t bytes){
+	double start = now_ns();
+	ft::vector<char> buffer;
+	while (buffer.size() < bytes){
+		size_t old_size = buffer.size();
+		buffer.resize(old_size + chunk);
+		memcpy(&buffer[old_size], source, chunk);
+	}
+	sink += buffer[bytes / 2];
+	return (now_ns() - start);
+}
+
+static double receive_uninitialized(size_t bytes){
+	double start = now_ns();
+	ft::vector<char> buffer;
+	while (buffer.size() < bytes)
+		memcpy(buffer.append_uninitialized(chunk), source, chunk);
+	sink += buffer[bytes / 2];
+	return (now_ns() - start);
+}
+
+/* One sized buffer, then filled: the fill is the first touch of its pages.*/
+static double sized(size_t bytes, bool uninitialized){
+	double start = now_ns();
+	ft::vector<char> buffer;
+	buffer.reserve(bytes);
+	if (uninitialized)
+		buffer.resize_uninitialized(bytes);
+	else
+		buffer.resize(bytes);
+	for (size_t i = 0; i < bytes; i += chunk)
+		memcpy(&buffer[i], source, chunk);
+	sink += buffer[bytes / 2];
+	return (now_ns() - start);
+}
+
+int main(int argc, char **argv){
+	size_t mib = argc > 1 ? strtoul(argv[1], NULL, 10) : 256;
+	size_t bytes = mib << 20;
+
+	for (size_t i = 0; i < chunk; i++)
+		source[i] = (char)i;
+	std::cout << mib << " MiB received in " << chunk / 1024 << " KiB chunks" << std::endl;
+	std::cout << "buffer growth                  ms" << std::endl;
+	std::cout << std::fixed << std::setprecision(1);
+	std::cout << "resize + copy           " << std::setw(10) << receive_resize(bytes) / 1e6 << std::endl;
+	std::cout << "append_uninitialized    " << std::setw(10) << receive_uninitialized(bytes) / 1e6 << std::endl;
+	std::cout << "sized once, resize      " << std::setw(10) << sized(bytes, false) / 1e6 << std::endl;
+	std::cout << "resize_uninitialized    " << std::setw(10) << sized(bytes, true) / 1e6 << std::endl;
+	return (sink == 42);
+}
@@ -0,0 +1,134 @@
+/*
+Bulk paths of ft::vector against std::vector, for ints, a 32 byte POD
+struct and vectors of vectors: fill construction, copy, assign, push_back
+growth, and reserve of an already full vector (a pure relocation); then
+inserts and erases in the middle, and loads from an ft::map.
+Use: ./bench_vector [ elements [ rounds ] ]
+*/
+
+#include <iostream>
+#include <iomanip>
+#include <vector>
+#include "../containers/vector.hpp"
+#include "../containers/map.hpp"
+#include <cstdlib>
+#include <time.h>
+
+struct particle
+{
+	float	x, y, z, mass;
+	float	vx, vy, vz, charge;
+};
+
+static double now_ns(void){
+	struct timespec ts;
+	clock_gettime(CLOCK_MONOTONIC, &ts);
+	return (ts.tv_sec * 1e9 + ts.tv_nsec);
+}
+
+static long sink;
+
+template <class Vector>
+static void run(const char *name, size_t n, int rounds, const typename Vector::value_type &val){
+	double fill = 0, copy = 0, assign = 0, grow = 0, relocate = 0;
+
+	for (int r = 0; r <= rounds; r++){
+		if (r == 1)	// the first round warms the allocator up
+			fill = copy = assign = grow = relocate = 0;
+		double start = now_ns();
+		Vector a(n, val);
+		fill += now_ns() - start;
+		start = now_ns();
+		Vector b(a);
+		copy += now_ns() - start;
+		start = now_ns();
+		b.assign(n / 2, val);
+		assign += now_ns() - start;
+		start = now_ns();
+		Vector c;
+		for (size_t i = 0; i < n; i++)
+			c.push_back(val);
+		grow += now_ns() - start;
+		start = now_ns();
+		c.reserve(c.capacity() + 1);
+		relocate += now_ns() - start;
+		sink += a.size() + b.size() + c.size();
+	}
+	std::cout << std::left << std::setw(24) << name << std::right << std::fixed << std::setprecision(1)
+		<< std::setw(10) << fill / rounds / 1e3 << std::setw(10) << copy / rounds / 1e3
+		<< std::setw(10) << assign / rounds / 1e3 << std::setw(11) << grow / rounds / 1e3
+		<< std::setw(11) << relocate / rounds / 1e3 << std::endl;
+}
+
+template <class Vector>
+static void run_edit(const char *name, size_t n, int rounds, const typename Vector::value_type &val){
+	Vector v(n, val);
+	Vector range(16, val);
+	double one = 0, fill = 0, insert_range = 0, erase_range = 0;
+
+	for (int r = 0; r < rounds; r++){
+		double start = now_ns();
+		v.insert(v.begin() + v.size() / 2, val);
+		one += now_ns() - start;
+		start = now_ns();
+		v.insert(v.begin() + v.size() / 2, (size_t)16, val);
+		fill += now_ns() - start;
+		start = now_ns();
+		v.insert(v.begin() + v.size() / 2, range.begin(), range.end());
+		insert_range += now_ns() - start;
+		start = now_ns();
+		v.erase(v.begin() + v.size() / 2, v.begin() + v.size() / 2 + 33);
+		erase_range += now_ns() - start;
+	}
+	sink += v.size();
+	std::cout << std::left << std::setw(24) << name << std::right << std::fixed << std::setprecision(1)
+		<< std::setw(10) << one / rounds / 1e3 << std::setw(10) << fill / rounds / 1e3
+		<< std::setw(10) << insert_range / rounds / 1e3 << std::setw(11) << erase_range / rounds / 1e3 << std::endl;
+}
+
+/* A map loaded straight from its iterators, and through a temporary copy.*/
+static void run_load(size_t n, int rounds){
+	typedef ft::map<int, int>::value_type entry;
+	ft::map<int, int> map;
+	double direct = 0, copied = 0;
+
+	for (size_t i = 0; i < n; i++)
+		map.insert(ft::make_pair((int)i, (int)i));
+	for (int r = 0; r < rounds; r++){
+		double start = now_ns();
+		ft::vector<entry> v(map.begin(), map.end());
+		direct += now_ns() - start;
+		start = now_ns();
+		std::vector<entry> tmp(map.begin(), map.end());
+		ft::vector<entry> w(&tmp[0], &tmp[0] + tmp.size());
+		copied += now_ns() - start;
+		sink += v.size() + w.size();
+	}
+	std::cout << std::left << std::setw(24) << "ft::vector<pair>" << std::right << std::fixed << std::setprecision(1)
+		<< std::setw(10) << direct / rounds / 1e3 << std::setw(10) << copied / rounds / 1e3 << std::endl;
+}
+
+int main(int argc, char **argv){
+	size_t n = argc > 1 ? strtoul(argv[1], NULL, 10) : 4000000;
+	int rounds = argc > 2 ? atoi(argv[2]) : 5;
+	particle p = {1, 2, 3, 4, 5, 6, 7, 8};
+
+	std::cout << n << " elements, us per operation" << std::endl;
+	std::cout << "container                     fill      copy    assign  push_back    reserve" << std::endl;
+	run<ft::vector<int> >("ft::vector<int>", n, rounds, 7);
+	run<std::vector<int> >("std::vector<int>", n, rounds, 7);
+	run<ft::vector<particle> >("ft::vector<particle>", n, rounds, p);
+	run<std::vector<particle> >("std::vector<particle>", n, rounds, p);
+	run<ft::vector<ft::vector<int> > >("ft, vectors of 16 int", n / 16, rounds, ft::vector<int>(16, 1));
+	run<std::vector<std::vector<int> > >("std, vectors of 16 int", n / 16, rounds, std::vector<int>(16, 1));
+	std::cout << std::endl << "in the middle, us per operation" << std::endl;
+	std::cout << "container                   insert  insert 16  range 16  erase 33" << std::endl;
+	run_edit<ft::vector<int> >("ft::vector<int>", n, rounds, 7);
+	run_edit<std::vector<int> >("std::vector<int>", n, rounds, 7);
+	run_edit<ft::vector<particle> >("ft::vector<particle>", n, rounds, p);
+	run_edit<std::vector<particle> >("std::vector<particle>", n, rounds, p);
+	std::cout << std::endl << "from an ft::map of " << n / 4 << " int, us per load" << std::endl;
+	std::cout << "container                   direct  via copy" << std::endl;
+	run_load(n / 4, rounds);
+	return (sink == 42);
+}
@@ -0,0 +1,69 @@
+/*
+Growing a large vector of int by push_back: ft::vector, which copies every
+element to a new buffer at each reallocation, against ft::vm_vector, which
+commits more of its reservation in place. For each, the total time, the
+worst block of 4096 push_back (the reallocation spikes) and the peak
+resident memory, each run in its own process.
+Use: ./bench_vm_vector [ MiB ]
+*/
+
+#include <iostream>
+#include <iomanip>
+#include "../containers/vector.hpp"
+#include "../containers/vm_vector.hpp"
+#include <sys/resource.h>
+#include <sys/wait.h>
+#include <cstdlib>
+#include <time.h>
+
+static double now_ns(void){
+	struct timespec ts;
+	clock_gettime(CLOCK_MONOTONIC, &ts);
+	return (ts.tv_sec * 1e9 + ts.tv_nsec);
+}
+
+template <class Vector>
+static void grow(size_t n){
+	Vector v;
+	double worst = 0;
+
+	double start = now_ns();
+	for (size_t i = 0; i < n; ){
+		double block = now_ns();
+		for (size_t end = i + 4096 < n ? i + 4096 : n; i < end; i++)
+			v.push_back((int)i);
+		double spent = now_ns() - block;
+		worst = spent > worst ? spent : worst;
+	}
+	double total = now_ns() - start;
+	std::cout << std::right << std::fixed << std::setprecision(1)
+		<< std::setw(10) << total / 1e6 << std::setw(13) << worst / 1e6 << std::flush;
+	if (v[n / 2] != (int)(n / 2))
+		exit(1);
+}
+
+/* Runs grow<Vector> in a child, to read its own peak resident memory.*/
+template <class Vector>
+static void run(const char *name, size_t n){
+	std::cout << std::left << std::setw(16) << name << std::flush;
+	pid_t pid = fork();
+	if (pid == 0){
+		grow<Vector>(n);
+		exit(0);
+	}
+	int status;
+	struct rusage usage;
+	wait4(pid, &status, 0, &usage);
+	std::cout << std::right << std::setw(10) << usage.ru_maxrss / 1024 << std::endl;
+}
+
+int main(int argc, char **argv){
+	size_t mib = argc > 1 ? strtoul(argv[1], NULL, 10) : 1024;
+	size_t n = (mib << 20) / sizeof(int);
+
+	std::cout << "push_back of " << mib << " MiB of int" << std::endl;
+	std::cout << "container         total ms  worst 4Ki ms  peak MiB" << std::endl;
+	run<ft::vector<int> >("ft::vector", n);
+	run<ft::vm_vector<int> >("ft::vm_vector", n);
+	return (0);
+}
@@ -0,0 +1,191 @@
+#ifndef ALIGNED_ALLOCATOR_HPP
+#define ALIGNED_ALLOCATOR_HPP
+
+#include <sys/mman.h>
+#include <cstddef>
+#include <cstdlib>
+#include <new>
+#include "utils.hpp"
+
+/*
+Allocators for ft::vector buffers read by numeric kernels, where
+std::allocator only guarantees 16 bytes alignment and 4 KiB pages.
+
+	aligned_allocator<T, A>		every block starts on an A bytes boundary
+								(64: a cache line, no SIMD load splits one;
+								4096: a page)
+	huge_page_allocator<T>		blocks of 2 MiB or more are mapped on their
+								own, 2 MiB aligned, and marked MADV_HUGEPAGE
+								so that transparent huge pages back them: one
+								TLB entry covers 2 MiB instead of 4 KiB.
+								Smaller blocks are 64 bytes aligned.
+	huge_page_allocator<T, true>	asks for explicit huge pages (MAP_HUGETLB)
+								first, which only works when the system has
+								reserved some (vm.nr_hugepages), and falls
+								back to the transparent ones otherwise.
+
+	ft::vector<float, ft::huge_page_allocator<float> > samples;
+
+Transparent huge pages depend on the system setting
+(/sys/kernel/mm/transparent_hugepage/enabled must be "madvise" or
+"always"), and the kernel may still back part of a block with small pages
+when it cannot find free 2 MiB ranges. The allocators are stateless: any two
+instances are equal, and a vector using one is relocated with memcpy.
+*/
+
+namespace ft
+{
+	/**
+	 * An allocator whose blocks start on an Align bytes boundary.
+	 * @param T Type of the elements.
+	 * @param Align Alignment in bytes, a power of two multiple of sizeof(void *).
+	 * @throw std::bad_alloc when the memory cannot be allocated.
+	*/
+	template <class T, size_t Align = 64>
+	class aligned_allocator
+	{
+	public:
+		typedef T value_type;
+		typedef T *pointer;
+		typedef const T *const_pointer;
+		typedef T &reference;
+		typedef const T &const_reference;
+		typedef size_t size_type;
+		typedef ptrdiff_t difference_type;
+
+		static const size_t alignment = Align;
+
+		template <class U>
+		struct rebind { typedef aligned_allocator<U, Align> other; };
+
+		aligned_allocator(void) {}
+		aligned_allocator(const aligned_allocator &) {}
+		template <class U>
+		aligned_allocator(const aligned_allocator<U, Align> &) {}
+
+		pointer address(reference x) const { return (&x); }
+		const_pointer address(const_reference x) const { return (&x); }
+		size_type max_size(void) const { return ((size_t)-1 / sizeof(T)); }
+
+		pointer allocate(size_type n, const void * = 0)
+		{
+			void *p = NULL;
+			size_t bytes = n ? n * sizeof(T) : 1;
+
+			if (n > max_size() || posix_memalign(&p, Align, bytes) != 0)
+				throw std::bad_alloc();
+			return (static_cast<pointer>(p));
+		}
+
+		void deallocate(pointer p, size_type)
+		{
+			free(p);
+		}
+
+		void construct(pointer p, const T &val) { new (static_cast<void *>(p)) T(val); }
+		void destroy(pointer p) { p->~T(); }
+	};
+
+	template <class T, class U, size_t Align>
+	bool operator==(const aligned_allocator<T, Align> &, const aligned_allocator<U, Align> &) { return (true); }
+	template <class T, class U, size_t Align>
+	bool operator!=(const aligned_allocator<T, Align> &, const aligned_allocator<U, Align> &) { return (false); }
+
+	template <class T, size_t Align>
+	struct is_trivially_relocatable<aligned_allocator<T, Align> > : public true_type {};
+
+	/**
+	 * An allocator backing the blocks of huge_page_size bytes or more with
+	 * huge pages (see the top of this file).
+	 * @param T Type of the elements.
+	 * @param Explicit Tries MAP_HUGETLB before transparent huge pages.
+	 * @throw std::bad_alloc when the memory cannot be allocated.
+	*/
+	template <class T, bool Explicit = false>
+	class huge_page_allocator
+	{
+	public:
+		typedef T value_type;
+		typedef T *pointer;
+		typedef const T *const_pointer;
+		typedef T &reference;
+		typedef const T &const_reference;
+		typedef size_t size_type;
+		typedef ptrdiff_t difference_type;
+
+		static const size_t huge_page_size = 2 << 20;
+
+		template <class U>
+		struct rebind { typedef huge_page_allocator<U, Explicit> other; };
+
+		huge_page_allocator(void) {}
+		huge_page_allocator(const huge_page_allocator &) {}
+		template <class U>
+		huge_page_allocator(const huge_page_allocator<U, Explicit> &) {}
+
+		pointer address(reference x) const { return (&x); }
+		const_pointer address(const_reference x) const { return (&x); }
+		size_type max_size(void) const { return (((size_t)-1 - huge_page_size) / sizeof(T)); }
+
+		pointer allocate(size_type n, const void * = 0)
+		{
+			if (n > max_size())
+				throw std::bad_alloc();
+			if (n * sizeof(T) < huge_page_size)
+				return (aligned_allocator<T>().allocate(n));
+			return (static_cast<pointer>(map(round(n * sizeof(T)))));
+		}
+
+		void deallocate(pointer p, size_type n)
+		{
+			if (n * sizeof(T) < huge_page_size)
+				free(p);
+			else
+				munmap(p, round(n * sizeof(T)));
+		}
+
+		void construct(pointer p, const T &val) { new (static_cast<void *>(p)) T(val); }
+		void destroy(pointer p) { p->~T(); }
+
+	private:
+		static size_t round(size_t bytes)
+		{
+			return ((bytes + huge_page_size - 1) / huge_page_size * huge_page_size);
+		}
+
+		/**
+		 * bytes (whole huge pages) of anonymous memory, 2 MiB aligned: mapped
+		 * one huge page larger, then trimmed to the aligned part.
+		*/
+		static void *map(size_t bytes)
+		{
+			if (Explicit)
+			{
+				void *p = mmap(NULL, bytes, PROT_READ | PROT_WRITE,
+					MAP_PRIVATE | MAP_ANONYMOUS | MAP_HUGETLB, -1, 0);
+				if (p != MAP_FAILED)
+					return (p);
+			}
+			char *raw = static_cast<char *>(mmap(NULL, bytes + huge_page_size, PROT_READ | PROT_WRITE,
+				MAP_PRIVATE | MAP_ANONYMOUS, -1, 0));
+			if (raw == MAP_FAILED)
+				throw std::bad_alloc();
+			size_t head = (huge_page_size - (size_t)raw % huge_page_size) % huge_page_size;
+			if (head)
+				munmap(raw, head);
+			munmap(raw + head + bytes, huge_page_size - head);
+			madvise(raw + head, bytes, MADV_HUGEPAGE);
+			return (raw + head);
+		}
+	};
+
+	template <class T, class U, bool Explicit>
+	bool operator==(const huge_page_allocator<T, Explicit> &, const huge_page_allocator<U, Explicit> &) { return (true); }
+	template <class T, class U, bool Explicit>
+	bool operator!=(const huge_page_allocator<T, Explicit> &, const huge_page_allocator<U, Explicit> &) { return (false); }
+
+	template <class T, bool Explicit>
+	struct is_trivially_relocatable<huge_page_allocator<T, Explicit> > : public true_type {};
+}
+
+#endif
@@ -0,0 +1,249 @@
+#ifndef CONCURRENT_MAP_HPP
+#define CONCURRENT_MAP_HPP
+
+#include "persistent_map.hpp"
+#include "thread_slot.hpp"
+#include "vector.hpp"
+#include <pthread.h>
+
+namespace ft
+{
+	/**
+	 * An ordered map shared by concurrent readers and writers.
+	 *
+	 * The map is a sequence of immutable versions (ft::persistent_map). Writers
+	 * take a mutex, derive the next version (O(1) copy, then O(log n) new
+	 * nodes) and publish it with one atomic store. Readers never lock nor write
+	 * anything shared but their own hazard slot: they pin the published version
+	 * and read it, so read throughput grows with the cores whatever the writers
+	 * do.
+	 *
+	 * Reclamation: a replaced version is retired, and freed (with the nodes no
+	 * other version shares) once no hazard slot holds it. At most one version
+	 * per reading thread can be pinned, so the garbage stays bounded.
+	 *
+	 * Lookups copy the mapped value out; for ordered iteration, bounds and the
+	 * rest of the map interface, snapshot() returns the current version in O(1).
+	 * @param Key Type of keys mapped to elements.
+	 * @param Val Type of elements mapped to keys.
+	 * @param Compare Comparison object used to sort the keys.
+	 * @param Alloc Object used to manage the storage.
+	*/
+	template <class Key, class Val, class Compare = std::less<Key>,
+		  class Alloc = std::allocator<ft::pair<const Key, Val> > >
+	class concurrent_map
+	{
+		public:
+		/***************************Member Types*****************************/
+		typedef Key key_type;
+		typedef Val mapped_type;
+		typedef ft::pair<const Key, Val> value_type;
+		typedef Compare key_compare;
+		typedef Alloc allocator_type;
+		typedef size_t size_type;
+		typedef ft::persistent_map<Key, Val, Compare, Alloc>			snapshot_type;
+
+			private:
+		typedef typename Alloc::template rebind<snapshot_type>::other	version_allocator_type;
+
+		/* One hazard per thread slot, each on its own cache line.*/
+		struct hazard
+		{
+			snapshot_type	*version;
+			char			pad[64 - sizeof(snapshot_type *)];
+		};
+
+		/* Pins the published version for the lifetime of a read.*/
+		class reader
+		{
+			public:
+				reader(const concurrent_map &map) : _slot(&map._hazards[thread_slot::id()])
+				{
+					snapshot_type *version;
+
+					do
+					{
+						version = __atomic_load_n(&map._current, __ATOMIC_SEQ_CST);
+						__atomic_store_n(&_slot->version, version, __ATOMIC_SEQ_CST);
+					} while (version != __atomic_load_n(&map._current, __ATOMIC_SEQ_CST));
+					this->version = version;
+				}
+
+				~reader(void)
+				{
+					__atomic_store_n(&_slot->version, (snapshot_type *)NULL, __ATOMIC_RELEASE);
+				}
+
+				const snapshot_type	*version;
+
+			private:
+				hazard	*_slot;
+				reader(const reader &);
+				reader &operator=(const reader &);
+		};
+
+		/* Holds the writer mutex for a scope.*/
+		class writer
+		{
+			public:
+				writer(pthread_mutex_t &mutex) : _mutex(mutex) { pthread_mutex_lock(&_mutex); }
+				~writer(void) { pthread_mutex_unlock(&_mutex); }
+
+			private:
+				pthread_mutex_t	&_mutex;
+				writer(const writer &);
+				writer &operator=(const writer &);
+		};
+
+		key_compare							_comp;
+		version_allocator_type				_version_alloc;
+		snapshot_type						*_current;
+		mutable hazard						_hazards[thread_slot::max_threads];
+		pthread_mutex_t						_writer;
+		ft::vector<snapshot_type *>			_retired; // guarded by _writer
+
+		// not copyable: take a snapshot()
+		concurrent_map(const concurrent_map &);
+		concurrent_map &operator=(const concurrent_map &);
+
+		public:
+		/*************************** Coplien form *****************************/
+		explicit concurrent_map(const key_compare &comp = key_compare(),
+				const allocator_type &alloc = allocator_type())
+			: _comp(comp), _version_alloc(alloc), _current(NULL), _hazards()
+		{
+			pthread_mutex_init(&_writer, NULL);
+			_current = make_version(snapshot_type(comp, alloc));
+		}
+
+		/** Must not run concurrently with any other member.*/
+		~concurrent_map(void){
+			for (size_type i = 0; i < _retired.size(); i++)
+				destroy_version(_retired[i]);
+			destroy_version(_current);
+			pthread_mutex_destroy(&_writer);
+		}
+
+		/*************************** Reads *****************************/
+		/**
+		 * Copies the value mapped to k to out. Lock free.
+		 * @return Whether k was found (out is unchanged otherwise).
+		*/
+		bool find(const key_type &k, mapped_type &out) const{
+			reader read(*this);
+			typename snapshot_type::iterator it = read.version->find(k);
+
+			if (it == read.version->end())
+				return (false);
+			out = it->second;
+			return (true);
+		}
+
+		size_type count(const key_type &k) const{
+			reader read(*this);
+			return (read.version->count(k));
+		}
+
+		size_type size() const{
+			reader read(*this);
+			return (read.version->size());
+		}
+
+		bool empty() const{
+			return (this->size() == 0);
+		}
+
+		/**
+		 * The current contents as an immutable ft::persistent_map, with the
+		 * whole map interface (iteration, lower_bound...). O(1), and later
+		 * writes never affect it.
+		*/
+		snapshot_type snapshot() const{
+			reader read(*this);
+			return (*read.version);
+		}
+
+		key_compare key_comp() const{
+			return (_comp);
+		}
+
+		allocator_type get_allocator(void) const{
+			return (allocator_type(_version_alloc));
+		}
+
+		/*************************** Writes *****************************/
+		/** Inserts val if its key is absent. @return Whether it was inserted.*/
+		bool insert(const value_type &val){
+			writer lock(_writer);
+			snapshot_type *next = make_version(*_current);
+			bool inserted = next->insert(val).second;
+			commit(next, inserted);
+			return (inserted);
+		}
+
+		/** Maps k to val, inserting k or replacing its value.*/
+		void set(const key_type &k, const mapped_type &val){
+			writer lock(_writer);
+			snapshot_type *next = make_version(*_current);
+			next->set(k, val);
+			commit(next, true);
+		}
+
+		/** @return 1 if k was removed, 0 if it was absent.*/
+		size_type erase(const key_type &k){
+			writer lock(_writer);
+			snapshot_type *next = make_version(*_current);
+			size_type erased = next->erase(k);
+			commit(next, erased != 0);
+			return (erased);
+		}
+
+		void clear(){
+			writer lock(_writer);
+			snapshot_type *next = make_version(snapshot_type(_comp, allocator_type(_version_alloc)));
+			commit(next, true);
+		}
+
+		private:
+		snapshot_type *make_version(const snapshot_type &from){
+			snapshot_type *version = _version_alloc.allocate(1);
+			_version_alloc.construct(version, from);
+			return (version);
+		}
+
+		void destroy_version(snapshot_type *version){
+			_version_alloc.destroy(version);
+			_version_alloc.deallocate(version, 1);
+		}
+
+		/* Publishes next if changed (drops it otherwise) and reclaims. Writer held.*/
+		void commit(snapshot_type *next, bool changed){
+			if (!changed){
+				destroy_version(next);
+				return;
+			}
+			_retired.push_back(_current);
+			__atomic_store_n(&_current, next, __ATOMIC_SEQ_CST);
+			reclaim();
+		}
+
+		/* Frees the retired versions no reader has pinned.*/
+		void reclaim(){
+			int slots = thread_slot::high_water();
+			size_type kept = 0;
+
+			for (size_type i = 0; i < _retired.size(); i++){
+				bool pinned = false;
+				for (int s = 0; s < slots && !pinned; s++)
+					pinned = __atomic_load_n(&_hazards[s].version, __ATOMIC_SEQ_CST) == _retired[i];
+				if (pinned)
+					_retired[kept++] = _retired[i];
+				else
+					destroy_version(_retired[i]);
+			}
+			_retired.resize(kept);
+		}
+	};
+}
+
+#endif
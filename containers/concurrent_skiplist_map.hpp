@@ -0,0 +1,143 @@
+#ifndef CONCURRENT_SKIPLIST_MAP_HPP
+#define CONCURRENT_SKIPLIST_MAP_HPP
+
+#include "../rbtree/SkipList.hpp"
+#include "skiplist_iterator.hpp"
+#include "pair.hpp"
+
+namespace ft
+{
+	/**
+	 * Lock-free ordered map for write heavy concurrent workloads (see
+	 * SkipList.hpp): find, insert and erase from any number of threads, none
+	 * of them ever blocking the others, erased elements reclaimed by ft::epoch.
+	 *
+	 * The members taking or returning no iterator guard themselves. Iterators
+	 * (begin, find, lower_bound...) are only valid inside an ft::epoch::guard
+	 * held by the caller; iterating gives the elements in key order, including
+	 * the concurrent changes made ahead of the iterator. Elements are read only.
+	 * @param Key Type of keys mapped to elements.
+	 * @param Val Type of elements mapped to keys.
+	 * @param Compare Comparison object used to sort the keys.
+	*/
+	template <class Key, class Val, class Compare = std::less<Key> >
+	class concurrent_skiplist_map
+	{
+		public:
+		/***************************Member Types*****************************/
+		typedef Key key_type;
+		typedef Val mapped_type;
+		typedef ft::pair<const Key, Val> value_type;
+		typedef Compare key_compare;
+		typedef size_t size_type;
+
+		class value_compare
+		{
+			friend class concurrent_skiplist_map<Key, Val, Compare>;
+			protected:
+				Compare comp;
+				value_compare(Compare c) : comp(c) {}
+			public:
+				bool operator()(const value_type &x, const value_type &y) const {
+					return comp(x.first, y.first);
+				}
+		};
+		typedef ft::SkipList<value_type, value_compare>					list_type;
+		typedef ft::skiplist_iterator<const value_type, list_type>		iterator;
+		typedef iterator												const_iterator;
+
+			private:
+		key_compare		_comp;
+		list_type		_list;
+
+		concurrent_skiplist_map(const concurrent_skiplist_map &);
+		concurrent_skiplist_map &operator=(const concurrent_skiplist_map &);
+
+		public:
+		/*************************** Coplien form *****************************/
+		explicit concurrent_skiplist_map(const key_compare &comp = key_compare())
+			: _comp(comp), _list(value_compare(comp)) {}
+
+		/** Must not run concurrently with any other member.*/
+		~concurrent_skiplist_map(void) {}
+
+		/*************************** Iterators *****************************/
+		iterator begin() const{
+			return (iterator(_list.first()));
+		}
+
+		iterator end() const{
+			return (iterator());
+		}
+
+		/*************************** Capacity *****************************/
+		/** Exact when no writer runs, approximate otherwise.*/
+		size_type size() const{
+			return (_list.size());
+		}
+
+		bool empty() const{
+			return (this->size() == 0);
+		}
+
+		/*************************** Modifiers *****************************/
+		/** Inserts val if its key is absent. @return Whether it was inserted.*/
+		bool insert(const value_type &val){
+			epoch::guard guard;
+			return (_list.insert_value(val));
+		}
+
+		/** @return 1 if this call removed k, 0 otherwise.*/
+		size_type erase(const key_type &k){
+			epoch::guard guard;
+			return (_list.delete_value(value_type(k, mapped_type())));
+		}
+
+		/*************************** Observers *****************************/
+		key_compare key_comp() const{
+			return (_comp);
+		}
+
+		value_compare value_comp() const{
+			return (value_compare(_comp));
+		}
+
+		/*************************** Operations *****************************/
+		/**
+		 * Copies the value mapped to k to out.
+		 * @return Whether k was found (out is unchanged otherwise).
+		*/
+		bool find(const key_type &k, mapped_type &out) const{
+			epoch::guard guard;
+			typename list_type::node_type *node = _list.lookup_value(value_type(k, mapped_type()));
+
+			if (!node)
+				return (false);
+			out = node->value.second;
+			return (true);
+		}
+
+		size_type count(const key_type &k) const{
+			epoch::guard guard;
+			return (_list.lookup_value(value_type(k, mapped_type())) != NULL);
+		}
+
+		iterator find(const key_type &k) const{
+			return (iterator(_list.lookup_value(value_type(k, mapped_type()))));
+		}
+
+		iterator lower_bound(const key_type &k) const{
+			return (iterator(_list.lower_bound(value_type(k, mapped_type()))));
+		}
+
+		iterator upper_bound(const key_type &k) const{
+			return (iterator(_list.upper_bound(value_type(k, mapped_type()))));
+		}
+
+		ft::pair<iterator, iterator> equal_range(const key_type &k) const{
+			return (ft::make_pair(lower_bound(k), upper_bound(k)));
+		}
+	};
+}
+
+#endif
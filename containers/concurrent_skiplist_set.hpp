@@ -0,0 +1,111 @@
+#ifndef CONCURRENT_SKIPLIST_SET_HPP
+#define CONCURRENT_SKIPLIST_SET_HPP
+
+#include "../rbtree/SkipList.hpp"
+#include "skiplist_iterator.hpp"
+#include "pair.hpp"
+
+namespace ft
+{
+	/**
+	 * Lock-free ordered set, the set counterpart of
+	 * ft::concurrent_skiplist_map, with the same rules: iterators only inside
+	 * an ft::epoch::guard held by the caller.
+	 * @param T Type of the elements.
+	 * @param Compare Comparison object used to sort the elements.
+	*/
+	template <typename T, typename Compare = std::less<T> >
+	class concurrent_skiplist_set
+	{
+	public:
+		/***************************Member Types*****************************/
+		typedef T key_type;
+		typedef T value_type;
+		typedef Compare key_compare;
+		typedef Compare value_compare;
+		typedef size_t size_type;
+		typedef ft::SkipList<value_type, value_compare>					list_type;
+		typedef ft::skiplist_iterator<const value_type, list_type>		iterator;
+		typedef iterator												const_iterator;
+
+	private:
+		key_compare		_comp;
+		list_type		_list;
+
+		concurrent_skiplist_set(const concurrent_skiplist_set &);
+		concurrent_skiplist_set &operator=(const concurrent_skiplist_set &);
+
+	public:
+		/*************************** Coplien form *****************************/
+		explicit concurrent_skiplist_set(const Compare &comp = Compare())
+			: _comp(comp), _list(comp) {}
+
+		/** Must not run concurrently with any other member.*/
+		~concurrent_skiplist_set(void) {}
+
+		/*************************** Iterators *****************************/
+		iterator begin() const{
+			return (iterator(_list.first()));
+		}
+
+		iterator end() const{
+			return (iterator());
+		}
+
+		/*************************** Capacity *****************************/
+		/** Exact when no writer runs, approximate otherwise.*/
+		size_type size(void) const{
+			return (_list.size());
+		}
+
+		bool empty(void) const{
+			return (this->size() == 0);
+		}
+
+		/*************************** Modifiers *****************************/
+		/** @return Whether val was inserted.*/
+		bool insert(const value_type &val){
+			epoch::guard guard;
+			return (_list.insert_value(val));
+		}
+
+		/** @return 1 if this call removed val, 0 otherwise.*/
+		size_type erase(const value_type &val){
+			epoch::guard guard;
+			return (_list.delete_value(val));
+		}
+
+		/*************************** Observers *****************************/
+		key_compare key_comp(void) const{
+			return (_comp);
+		}
+
+		value_compare value_comp(void) const{
+			return (_comp);
+		}
+
+		/*************************** Operations *****************************/
+		size_type count(const value_type &val) const{
+			epoch::guard guard;
+			return (_list.lookup_value(val) != NULL);
+		}
+
+		iterator find(const value_type &val) const{
+			return (iterator(_list.lookup_value(val)));
+		}
+
+		iterator lower_bound(const value_type &val) const{
+			return (iterator(_list.lower_bound(val)));
+		}
+
+		iterator upper_bound(const value_type &val) const{
+			return (iterator(_list.upper_bound(val)));
+		}
+
+		ft::pair<iterator, iterator> equal_range(const value_type &val) const{
+			return (ft::make_pair(lower_bound(val), upper_bound(val)));
+		}
+	};
+}
+
+#endif
@@ -0,0 +1,419 @@
+#ifndef COW_VECTOR_HPP
+#define COW_VECTOR_HPP
+
+#include "vector.hpp"
+#include <new>
+
+/*
+A vector whose copies share one buffer until one of them is modified.
+
+Copying a cow_vector (constructor, assignment, passing by value) takes a
+reference to the buffer: O(1), whatever the size. The first modification
+through a copy that still shares its buffer copies the elements once
+(detaches); later ones work on its own buffer as in ft::vector.
+
+	shared buffer	an ft::vector and an atomic count of the cow_vectors
+					holding it, freed by the last one
+	reads			the const members, cbegin(), view(): never copy
+	modifications	the non-const members, edit(), detach(): copy the
+					buffer first if it is shared
+
+Which member detaches is decided by constness, as for a reference counted
+string: the non-const begin(), operator[], at(), front() and back() of a
+shared cow_vector detach, even when only used to read. Read through a
+const reference, cbegin()/cend() or view() to keep sharing, and call
+detach() (or edit(), for a run of changes with one check) to choose where
+the copy happens, out of a timed loop for instance.
+
+The count is atomic, so cow_vectors sharing a buffer may be read, copied,
+modified and destroyed from different threads; a single cow_vector is not
+thread safe, as any container. Pointers and iterators obtained from a
+shared buffer point into the shared copy and are not updated by a detach;
+a reference kept from a non-const member while the cow_vector is copied
+writes into both copies.
+*/
+
+namespace ft
+{
+	/**
+	 * @param T Type of the elements.
+	 * @param Alloc Object used to manage the storage.
+	 * @param Growth Growth policy of the buffer (growth.hpp).
+	*/
+	template <class T, class Alloc = std::allocator<T>, class Growth = ft::growth_double>
+	class cow_vector
+	{
+		public:
+		/***************************Member Types*****************************/
+		typedef ft::vector<T, Alloc, Growth> vector_type;
+		typedef T value_type;
+		typedef Alloc allocator_type;
+		typedef Growth growth_policy;
+		typedef typename Alloc::pointer pointer;
+		typedef typename Alloc::const_pointer const_pointer;
+		typedef typename Alloc::reference reference;
+		typedef typename Alloc::const_reference const_reference;
+		typedef typename vector_type::iterator iterator;
+		typedef typename vector_type::const_iterator const_iterator;
+		typedef typename vector_type::reverse_iterator reverse_iterator;
+		typedef typename vector_type::const_reverse_iterator const_reverse_iterator;
+		typedef std::ptrdiff_t difference_type;
+		typedef std::size_t size_type;
+
+			private:
+		struct shared_buffer
+		{
+			long		refs;
+			vector_type	items;
+
+			explicit shared_buffer(const vector_type &from) : refs(1), items(from) {}
+		};
+		typedef typename Alloc::template rebind<shared_buffer>::other	buffer_allocator_type;
+
+		buffer_allocator_type	_buffer_alloc;
+		shared_buffer			*_buffer;
+
+		public:
+		/*************************** Coplien form *****************************/
+		explicit cow_vector(const allocator_type &alloc = allocator_type())
+			: _buffer_alloc(alloc), _buffer(make_buffer(vector_type(alloc))) {}
+
+		explicit cow_vector(size_type n, const value_type &val = value_type(),
+				const allocator_type &alloc = allocator_type())
+			: _buffer_alloc(alloc), _buffer(make_buffer(vector_type(alloc)))
+		{
+			edit().assign(n, val);
+		}
+
+		template <class InputIterator>
+		cow_vector(InputIterator first, InputIterator last, const allocator_type &alloc = allocator_type(),
+				typename ft::enable_if<!ft::is_integral<InputIterator>::value, InputIterator>::type* = NULL)
+			: _buffer_alloc(alloc), _buffer(make_buffer(vector_type(alloc)))
+		{
+			edit().assign(first, last);
+		}
+
+		/** Copies the elements of x once, into a buffer of its own.*/
+		explicit cow_vector(const vector_type &x)
+			: _buffer_alloc(x.get_allocator()), _buffer(make_buffer(x)) {}
+
+		/** Shares the buffer of x. O(1).*/
+		cow_vector(const cow_vector &x) : _buffer_alloc(x._buffer_alloc), _buffer(x.acquire()) {}
+
+		~cow_vector()
+		{
+			release();
+		}
+
+		/** Shares the buffer of x, dropping the current one. O(1).*/
+		cow_vector &operator=(const cow_vector &x)
+		{
+			shared_buffer *buffer = x.acquire();
+
+			release();
+			_buffer = buffer;
+			_buffer_alloc = x._buffer_alloc;
+			return (*this);
+		}
+
+		/*************************** Sharing *****************************/
+		/** @return The number of cow_vectors holding this buffer (this one included).*/
+		long use_count(void) const
+		{
+			return (__atomic_load_n(&_buffer->refs, __ATOMIC_ACQUIRE));
+		}
+
+		bool is_shared(void) const
+		{
+			return (use_count() != 1);
+		}
+
+		/** Gives this cow_vector a buffer of its own now, if it shares one.*/
+		void detach(void)
+		{
+			if (is_shared())
+				unshare(_buffer->items.capacity(), size());
+		}
+
+		/** The elements, for any read of the ft::vector interface. Never copies.*/
+		const vector_type &view(void) const
+		{
+			return (_buffer->items);
+		}
+
+		/**
+		 * Detaches, then gives the buffer to modify directly. The reference
+		 * is valid until this cow_vector is copied, assigned or destroyed.
+		*/
+		vector_type &edit(void)
+		{
+			detach();
+			return (_buffer->items);
+		}
+
+		/*************************** Iterators *****************************/
+		iterator begin(void)					{ return (edit().begin()); }
+		const_iterator begin(void) const		{ return (view().begin()); }
+		iterator end(void)						{ return (edit().end()); }
+		const_iterator end(void) const			{ return (view().end()); }
+		const_iterator cbegin(void) const		{ return (view().begin()); }
+		const_iterator cend(void) const			{ return (view().end()); }
+		reverse_iterator rbegin(void)			{ return (edit().rbegin()); }
+		const_reverse_iterator rbegin(void) const	{ return (view().rbegin()); }
+		reverse_iterator rend(void)				{ return (edit().rend()); }
+		const_reverse_iterator rend(void) const	{ return (view().rend()); }
+
+		/*************************** Capacity *****************************/
+		size_type size(void) const				{ return (view().size()); }
+		size_type max_size(void) const			{ return (view().max_size()); }
+		size_type capacity(void) const			{ return (view().capacity()); }
+		bool empty(void) const					{ return (view().empty()); }
+
+		/** Detaches with room for n elements at once, instead of copying then growing.*/
+		void reserve(size_type n)
+		{
+			if (is_shared())
+				unshare(n, size());
+			else
+				_buffer->items.reserve(n);
+		}
+
+		void resize(size_type n, value_type val = value_type())
+		{
+			if (is_shared())
+				unshare(n, n < size() ? n : size());	// only what is kept
+			_buffer->items.resize(n, val);
+		}
+
+		void shrink_to_fit(void)
+		{
+			if (is_shared())
+				unshare(size(), size());	// the copy is already exact
+			else
+				_buffer->items.shrink_to_fit();
+		}
+
+		/*************************** Element access *****************************/
+		reference operator[](size_type n)			{ return (edit()[n]); }
+		const_reference operator[](size_type n) const	{ return (view()[n]); }
+		reference at(size_type n)					{ return (edit().at(n)); }
+		const_reference at(size_type n) const		{ return (view().at(n)); }
+		reference front(void)						{ return (edit().front()); }
+		const_reference front(void) const			{ return (view().front()); }
+		reference back(void)						{ return (edit().back()); }
+		const_reference back(void) const			{ return (view().back()); }
+
+		/*************************** Modifiers *****************************/
+		/** Replaces the contents: a shared buffer is dropped, never copied.*/
+		template <class InputIterator>
+		void assign(InputIterator first, InputIterator last,
+				typename ft::enable_if<!ft::is_integral<InputIterator>::value, InputIterator>::type* = NULL)
+		{
+			if (is_shared())
+				replace(make_buffer(vector_type(get_allocator())));
+			_buffer->items.assign(first, last);
+		}
+
+		void assign(size_type n, const value_type &val)
+		{
+			value_type copy(val);	// val may be in the buffer being dropped
+
+			if (is_shared())
+				replace(make_buffer(vector_type(get_allocator())));
+			_buffer->items.assign(n, copy);
+		}
+
+		void push_back(const value_type &val)
+		{
+			if (!is_shared())
+				_buffer->items.push_back(val);
+			else
+			{
+				value_type copy(val);	// val may be in the buffer being dropped
+
+				unshare(size() + 1 > capacity() ? size() + 1 : capacity(), size());
+				_buffer->items.push_back(copy);
+			}
+		}
+
+		void pop_back(void)
+		{
+			edit().pop_back();
+		}
+
+		/*
+		 * Positions may come from a shared buffer (cbegin(), or begin() on a
+		 * const cow_vector): they are taken as indexes before detaching, and
+		 * val is copied first, as it may be in that buffer.
+		*/
+		iterator insert(iterator position, const value_type &val)
+		{
+			size_type index = position - cbegin();
+			value_type copy(val);
+
+			return (edit().insert(_buffer->items.begin() + index, copy));
+		}
+
+		void insert(iterator position, size_type n, const value_type &val)
+		{
+			size_type index = position - cbegin();
+			value_type copy(val);
+
+			edit().insert(_buffer->items.begin() + index, n, copy);
+		}
+
+		template <class InputIterator>
+		void insert(iterator position, InputIterator first, InputIterator last,
+				typename ft::enable_if<!ft::is_integral<InputIterator>::value, InputIterator>::type* = NULL)
+		{
+			size_type index = position - cbegin();
+
+			edit().insert(_buffer->items.begin() + index, first, last);
+		}
+
+		iterator erase(iterator position)
+		{
+			size_type index = position - cbegin();
+
+			return (edit().erase(_buffer->items.begin() + index));
+		}
+
+		iterator erase(iterator first, iterator last)
+		{
+			size_type index = first - cbegin();
+			size_type n = last - first;
+
+			edit();
+			return (_buffer->items.erase(_buffer->items.begin() + index, _buffer->items.begin() + index + n));
+		}
+
+		/** Exchanges the buffers. O(1), nothing detaches.*/
+		void swap(cow_vector &x)
+		{
+			shared_buffer *buffer = x._buffer;
+			buffer_allocator_type alloc = x._buffer_alloc;
+
+			x._buffer = _buffer;
+			x._buffer_alloc = _buffer_alloc;
+			_buffer = buffer;
+			_buffer_alloc = alloc;
+		}
+
+		/** A shared buffer is dropped, never copied.*/
+		void clear(void)
+		{
+			if (is_shared())
+				replace(make_buffer(vector_type(get_allocator())));
+			else
+				_buffer->items.clear();
+		}
+
+		allocator_type get_allocator(void) const
+		{
+			return (view().get_allocator());
+		}
+
+		private:
+		shared_buffer *make_buffer(const vector_type &from)
+		{
+			shared_buffer *buffer = _buffer_alloc.allocate(1);
+
+			try{
+				new (buffer) shared_buffer(from);
+			}
+			catch (...){
+				_buffer_alloc.deallocate(buffer, 1);
+				throw;
+			}
+			return (buffer);
+		}
+
+		shared_buffer *acquire(void) const
+		{
+			__atomic_add_fetch(&_buffer->refs, 1, __ATOMIC_RELAXED);
+			return (_buffer);
+		}
+
+		/* The last holder frees; acq_rel orders its reads after every other release.*/
+		void release(void)
+		{
+			if (__atomic_sub_fetch(&_buffer->refs, 1, __ATOMIC_ACQ_REL) == 0)
+			{
+				_buffer_alloc.destroy(_buffer);
+				_buffer_alloc.deallocate(_buffer, 1);
+			}
+		}
+
+		void replace(shared_buffer *buffer)
+		{
+			release();
+			_buffer = buffer;
+		}
+
+		/* A copy of the first count elements with room for capacity, one allocation.*/
+		void unshare(size_type capacity, size_type count)
+		{
+			shared_buffer *copy = make_buffer(vector_type(get_allocator()));
+
+			try{
+				copy->items.reserve(capacity > count ? capacity : count);
+				copy->items.assign(_buffer->items.begin(), _buffer->items.begin() + count);
+			}
+			catch (...){
+				_buffer_alloc.destroy(copy);
+				_buffer_alloc.deallocate(copy, 1);
+				throw;
+			}
+			replace(copy);
+		}
+	};
+
+	/** A cow_vector is a pointer to its buffer.*/
+	template <class T, class Alloc, class Growth>
+	struct is_trivially_relocatable<ft::cow_vector<T, Alloc, Growth> > : public true_type {};
+
+	/*************************** Relational operators *****************************/
+	template <class T, class Alloc, class Growth>
+	bool operator==(const cow_vector<T, Alloc, Growth> &lhs, const cow_vector<T, Alloc, Growth> &rhs)
+	{
+		return (&lhs.view() == &rhs.view() || lhs.view() == rhs.view());
+	}
+
+	template <class T, class Alloc, class Growth>
+	bool operator!=(const cow_vector<T, Alloc, Growth> &lhs, const cow_vector<T, Alloc, Growth> &rhs)
+	{
+		return (!(lhs == rhs));
+	}
+
+	template <class T, class Alloc, class Growth>
+	bool operator<(const cow_vector<T, Alloc, Growth> &lhs, const cow_vector<T, Alloc, Growth> &rhs)
+	{
+		return (lhs.view() < rhs.view());
+	}
+
+	template <class T, class Alloc, class Growth>
+	bool operator<=(const cow_vector<T, Alloc, Growth> &lhs, const cow_vector<T, Alloc, Growth> &rhs)
+	{
+		return (!(rhs < lhs));
+	}
+
+	template <class T, class Alloc, class Growth>
+	bool operator>(const cow_vector<T, Alloc, Growth> &lhs, const cow_vector<T, Alloc, Growth> &rhs)
+	{
+		return (rhs < lhs);
+	}
+
+	template <class T, class Alloc, class Growth>
+	bool operator>=(const cow_vector<T, Alloc, Growth> &lhs, const cow_vector<T, Alloc, Growth> &rhs)
+	{
+		return (!(lhs < rhs));
+	}
+
+	template <class T, class Alloc, class Growth>
+	void swap(cow_vector<T, Alloc, Growth> &x, cow_vector<T, Alloc, Growth> &y)
+	{
+		x.swap(y);
+	}
+}
+
+#endif
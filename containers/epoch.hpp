@@ -0,0 +1,251 @@
+#ifndef EPOCH_HPP
+#define EPOCH_HPP
+
+#include "thread_slot.hpp"
+#include "vector.hpp"
+#include <sched.h>
+
+namespace ft
+{
+	/**
+	 * Epoch based reclamation, for lock-free containers (tree, list or hash
+	 * based alike) whose readers may still hold a node another thread has just
+	 * unlinked.
+	 *
+	 * A thread wraps every access to shared nodes in an epoch::guard, which
+	 * announces the global epoch it started in. Unlinked nodes are retire()d
+	 * with the function freeing them, into a bag of the current epoch. The
+	 * global epoch only moves from e to e + 1 once every thread inside a guard
+	 * has announced e, so when it reaches e + 2 no guard can still see a node
+	 * retired in e, and the whole bag is freed at once.
+	 *
+	 * Memory: each thread tries to advance the epoch and frees its safe bags
+	 * every advance_every retires, and every advance_every guards while it
+	 * holds garbage, so a thread that stops retiring still gets its nodes
+	 * freed. Past max_pending nodes it tries at every retire, and yields the
+	 * core if that was not enough, as the thread holding the epoch back may be
+	 * preempted inside its guard. Garbage is then bounded by about max_pending
+	 * per thread, unless a thread stays inside one guard: nothing retired after
+	 * it entered can be freed until it leaves.
+	 * The bags of an exited thread go to the next thread given its slot.
+	 *
+	 * Cost: a guard is two stores to the thread's own cache line, one of them
+	 * sequentially consistent; retire() is a push_back, plus a scan of the
+	 * threads every advance_every calls (see bench/epoch.cpp).
+	*/
+	class epoch
+	{
+	public:
+		typedef void (*deleter_type)(void *);
+
+		static const size_t advance_every = 64;
+		static const size_t max_pending = 4096;
+
+		/** Counters over all the threads, for tests and tuning.*/
+		struct stats
+		{
+			unsigned long	epoch;		// global epoch
+			size_t			retired;	// retire() calls
+			size_t			freed;		// deleters run
+			size_t			pending;	// retired - freed
+		};
+
+		/** Keeps the calling thread inside the current epoch. Nests.*/
+		class guard
+		{
+			public:
+				guard(void) { epoch::enter(); }
+				~guard(void) { epoch::exit(); }
+
+			private:
+				guard(const guard &);
+				guard &operator=(const guard &);
+		};
+
+		static void enter(void)
+		{
+			record &r = local();
+
+			if (r.nesting++ == 0)
+			{
+				unsigned long e = __atomic_load_n(&global(), __ATOMIC_SEQ_CST);
+				__atomic_store_n(&r.announced, e | active, __ATOMIC_SEQ_CST);
+			}
+		}
+
+		static void exit(void)
+		{
+			record &r = local();
+
+			if (--r.nesting == 0)
+			{
+				__atomic_store_n(&r.announced, 0UL, __ATOMIC_RELEASE);
+				if (r.retired != r.freed && ++r.exits % advance_every == 0)
+					collect(r);
+			}
+		}
+
+		/**
+		 * Hands ptr over: deleter(ptr) runs once no guard can reach it anymore.
+		 * Call it after ptr is unreachable from the shared structure.
+		*/
+		static void retire(void *ptr, deleter_type deleter)
+		{
+			record &r = local();
+			unsigned long e = __atomic_load_n(&global(), __ATOMIC_SEQ_CST);
+			bag &b = r.bags[(e / step) % 3];
+
+			if (b.epoch != e)
+			{
+				// the bag holds what was retired three epochs ago or more: safe
+				free_bag(r, b);
+				b.epoch = e;
+			}
+			b.items.push_back(retired(ptr, deleter));
+			count(r.retired, 1);
+			size_t pending = r.retired - r.freed;
+			if (pending % advance_every == 0 || pending > max_pending)
+				collect(r);
+			if (r.retired - r.freed > max_pending)
+				sched_yield(); // a guard holder may be waiting for a core
+		}
+
+		/**
+		 * Frees what the calling thread retired, as far as the other threads'
+		 * guards allow. For a thread about to exit or to go idle for long.
+		 * Must be called outside any guard.
+		*/
+		static void flush(void)
+		{
+			record &r = local();
+
+			for (int i = 0; i < 3 && r.retired != r.freed; i++)
+				collect(r);
+		}
+
+		/** The global epoch.*/
+		static unsigned long current(void)
+		{
+			return (__atomic_load_n(&global(), __ATOMIC_SEQ_CST) / step);
+		}
+
+		/** Sums the counters of every thread slot. Approximate while threads run.*/
+		static stats statistics(void)
+		{
+			stats s;
+			int slots = thread_slot::high_water();
+
+			s.epoch = current();
+			s.retired = 0;
+			s.freed = 0;
+			for (int i = 0; i < slots; i++)
+			{
+				s.retired += __atomic_load_n(&records()[i].retired, __ATOMIC_RELAXED);
+				s.freed += __atomic_load_n(&records()[i].freed, __ATOMIC_RELAXED);
+			}
+			s.pending = s.retired - s.freed;
+			return (s);
+		}
+
+	private:
+		static const unsigned long active = 1;	// low bit of an announcement
+		static const unsigned long step = 2;	// epochs count in steps of 2
+
+		struct retired
+		{
+			void			*ptr;
+			deleter_type	deleter;
+
+			retired(void *p = NULL, deleter_type d = NULL) : ptr(p), deleter(d) {}
+		};
+
+		struct bag
+		{
+			unsigned long			epoch;
+			ft::vector<retired>		items; // keeps its capacity once freed
+
+			bag(void) : epoch(0) {}
+		};
+
+		/* Per thread slot, on its own cache lines. Only its owner writes it.*/
+		struct record
+		{
+			unsigned long	announced; // epoch | active inside a guard, 0 outside
+			int				nesting;
+			size_t			exits;
+			size_t			retired;
+			size_t			freed;
+			bag				bags[3];
+			char			pad[64];
+
+			record(void) : announced(0), nesting(0), exits(0), retired(0), freed(0) {}
+
+			// at exit, no guard is left
+			~record(void)
+			{
+				for (int i = 0; i < 3; i++)
+					free_bag(*this, bags[i]);
+			}
+		};
+
+		static unsigned long &global(void)
+		{
+			static unsigned long e = step;
+			return (e);
+		}
+
+		static record *records(void)
+		{
+			static record r[thread_slot::max_threads];
+			return (r);
+		}
+
+		static record &local(void)
+		{
+			return (records()[thread_slot::id()]);
+		}
+
+		/* Owner only, but statistics() reads it from other threads.*/
+		static void count(size_t &counter, size_t n)
+		{
+			__atomic_store_n(&counter, counter + n, __ATOMIC_RELAXED);
+		}
+
+		static void free_bag(record &r, bag &b)
+		{
+			size_t n = b.items.size();
+
+			for (size_t i = 0; i < n; i++)
+				b.items[i].deleter(b.items[i].ptr);
+			b.items.clear();
+			count(r.freed, n);
+		}
+
+		/* Advances the epoch if it can, then frees the bags two epochs old.*/
+		static void collect(record &r)
+		{
+			try_advance();
+			unsigned long e = __atomic_load_n(&global(), __ATOMIC_SEQ_CST);
+			for (int i = 0; i < 3; i++)
+				if (!r.bags[i].items.empty() && r.bags[i].epoch + 2 * step <= e)
+					free_bag(r, r.bags[i]);
+		}
+
+		/* Moves the global epoch on if every active thread has caught up.*/
+		static void try_advance(void)
+		{
+			unsigned long e = __atomic_load_n(&global(), __ATOMIC_SEQ_CST);
+			int slots = thread_slot::high_water();
+
+			for (int i = 0; i < slots; i++)
+			{
+				unsigned long a = __atomic_load_n(&records()[i].announced, __ATOMIC_SEQ_CST);
+				if ((a & active) && (a & ~active) != e)
+					return;
+			}
+			__sync_bool_compare_and_swap(&global(), e, e + step);
+		}
+	};
+}
+
+#endif
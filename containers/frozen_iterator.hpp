@@ -0,0 +1,173 @@
+#ifndef FROZEN_ITERATOR_HPP
+#define FROZEN_ITERATOR_HPP
+
+#include <cstddef>
+#include <iterator>
+
+namespace ft{
+	/*
+	Eytzinger (BFS) layout: the sorted elements of a complete binary search tree
+	stored level by level in a 1-indexed array, the children of slot k being
+	2k and 2k + 1. Index 0 is the past-the-end position.
+	*/
+
+	/** In-order successor of slot k among n slots, 0 past the last one.*/
+	inline size_t eytzinger_next(size_t k, size_t n){
+		if (k == 0)
+			return (0);
+		if (2 * k + 1 <= n){
+			k = 2 * k + 1;
+			while (2 * k <= n)
+				k = 2 * k;
+			return (k);
+		}
+		// climb while k is a right child, then once more
+		return (k >> __builtin_ffsl(~(long)k));
+	}
+
+	/** In-order predecessor of slot k among n slots; from 0, the last slot.*/
+	inline size_t eytzinger_prev(size_t k, size_t n){
+		if (k == 0){
+			k = n ? 1 : 0;
+			while (k && 2 * k + 1 <= n)
+				k = 2 * k + 1;
+			return (k);
+		}
+		if (2 * k <= n){
+			k = 2 * k;
+			while (2 * k + 1 <= n)
+				k = 2 * k + 1;
+			return (k);
+		}
+		// climb while k is a left child, then once more
+		return (k >> __builtin_ffsl((long)k));
+	}
+
+	/** Slot of the first element in order among n slots (0 if n is 0).*/
+	inline size_t eytzinger_first(size_t n){
+		size_t k = n ? 1 : 0;
+		while (k && 2 * k <= n)
+			k = 2 * k;
+		return (k);
+	}
+
+	/*
+	Searches of the keys k[1..n] in Eytzinger order: the descent goes down
+	i -> 2i + (k[i] < x) without a data dependent branch, prefetching the cache
+	line of the slots four levels below. It ends past a leaf; the slots where it
+	went right are the trailing ones of i, and the answer is the last slot where
+	it went left: drop the trailing ones and one more bit. 0 when it never went
+	left.
+	*/
+
+	/** Slot of the first key not less than x, 0 if none.*/
+	template <class Key, class Compare>
+	size_t eytzinger_lower_bound(const Key *keys, size_t n, const Key &x, const Compare &comp){
+		static const size_t block = 64 / sizeof(Key) ? 64 / sizeof(Key) : 1;
+		size_t i = 1;
+
+		while (i <= n){
+			__builtin_prefetch(keys + i * block);
+			i = 2 * i + comp(keys[i], x);
+		}
+		return (i >> __builtin_ffsl(~(long)i));
+	}
+
+	/** Slot of the first key greater than x, 0 if none.*/
+	template <class Key, class Compare>
+	size_t eytzinger_upper_bound(const Key *keys, size_t n, const Key &x, const Compare &comp){
+		static const size_t block = 64 / sizeof(Key) ? 64 / sizeof(Key) : 1;
+		size_t i = 1;
+
+		while (i <= n){
+			__builtin_prefetch(keys + i * block);
+			i = 2 * i + !comp(x, keys[i]);
+		}
+		return (i >> __builtin_ffsl(~(long)i));
+	}
+
+	/** Slot of the key equivalent to x, 0 if none.*/
+	template <class Key, class Compare>
+	size_t eytzinger_find(const Key *keys, size_t n, const Key &x, const Compare &comp){
+		size_t slot = eytzinger_lower_bound(keys, n, x, comp);
+
+		if (slot && comp(x, keys[slot]))
+			return (0);
+		return (slot);
+	}
+
+	/**
+	 * Bidirectional iterator over an Eytzinger array, in key order.
+	 * @param T Type of the elements (const for the frozen containers).
+	*/
+	template<class T>
+	class frozen_iterator{
+		public:
+			typedef std::bidirectional_iterator_tag iterator_category;
+			typedef T value_type;
+			typedef T* pointer;
+			typedef T& reference;
+			typedef std::ptrdiff_t difference_type;
+
+			frozen_iterator() : _base(NULL), _index(0), _size(0) {}
+
+			/** @param base The 1-indexed array, @param index The slot, @param size The number of slots.*/
+			frozen_iterator(pointer base, size_t index, size_t size)
+				: _base(base), _index(index), _size(size) {}
+
+			frozen_iterator(frozen_iterator const &src)
+				: _base(src._base), _index(src._index), _size(src._size) {}
+
+			~frozen_iterator(void){}
+
+			frozen_iterator &operator=(frozen_iterator const &other){
+				this->_base = other._base;
+				this->_index = other._index;
+				this->_size = other._size;
+				return (*this);
+			}
+			//equality/inequality operators
+			bool operator==(frozen_iterator const &other) const{
+				return (this->_index == other._index && this->_base == other._base);
+			}
+			bool operator!=(frozen_iterator const &other) const{
+				return (!(*this == other));
+			}
+			//dereference
+			reference operator*() const{
+				return (this->_base[this->_index]);
+			}
+
+			pointer operator->() const{
+				return (&(operator*()));
+			}
+			//increment and decrement
+			frozen_iterator &operator++(){
+				this->_index = eytzinger_next(this->_index, this->_size);
+				return (*this);
+			}
+			frozen_iterator &operator--(){
+				this->_index = eytzinger_prev(this->_index, this->_size);
+				return (*this);
+			}
+			frozen_iterator operator++(int){
+				frozen_iterator copy(*this);
+				++(*this);
+				return (copy);
+			}
+			frozen_iterator operator--(int){
+				frozen_iterator copy(*this);
+				--(*this);
+				return (copy);
+			}
+			/** The slot in the Eytzinger array, 0 for end().*/
+			size_t get_index(void) const{
+				return (this->_index);
+			}
+	private:
+		pointer	_base;
+		size_t	_index;
+		size_t	_size;
+	};
+}
+#endif
@@ -0,0 +1,252 @@
+#ifndef FROZEN_MAP_HPP
+#define FROZEN_MAP_HPP
+
+#include "map.hpp"
+#include "frozen_iterator.hpp"
+#include "vector.hpp"
+#include <stdexcept>
+
+namespace ft
+{
+	/**
+	 * Immutable snapshot of a map, for tables built once and read many times.
+	 *
+	 * The elements are stored in one contiguous array in Eytzinger (BFS) order,
+	 * and the keys once more in a parallel array so that searches only touch
+	 * keys. A search goes down k -> 2k + (key[k] < x) without a data dependent
+	 * branch, prefetching the cache line of the slots four levels below: the
+	 * top levels of the tree stay in cache and the loads of the lower levels
+	 * overlap, which is where the pointer tree loses most of its time once the
+	 * data outgrows the cache.
+	 * @param Key Type of keys mapped to elements.
+	 * @param Val Type of elements mapped to keys.
+	 * @param Compare Comparison object used to sort the keys.
+	 * @param Alloc Object used to manage the storage.
+	*/
+	template <class Key, class Val, class Compare = std::less<Key>,
+		  class Alloc = std::allocator<ft::pair<const Key, Val> > >
+	class frozen_map
+	{
+		public:
+		/***************************Member Types*****************************/
+		typedef Key key_type;
+		typedef Val mapped_type;
+		typedef ft::pair<const Key, Val> value_type;
+		typedef Compare key_compare;
+		typedef Alloc allocator_type;
+		typedef ft::frozen_iterator<const value_type>					iterator;
+		typedef iterator												const_iterator;
+		typedef ft::reverse_iterator<iterator>							reverse_iterator;
+		typedef ft::reverse_iterator<const_iterator>					const_reverse_iterator;
+		typedef ptrdiff_t												difference_type;
+		typedef size_t													size_type;
+		typedef typename allocator_type::const_reference reference;
+		typedef typename allocator_type::const_reference const_reference;
+		typedef typename allocator_type::const_pointer pointer;
+		typedef typename allocator_type::const_pointer const_pointer;
+
+			private:
+		typedef typename Alloc::template rebind<Key>::other				key_allocator_type;
+
+		key_compare			_comp;
+		allocator_type		_alloc;
+		key_allocator_type	_key_alloc;
+		size_type			_size;
+		value_type			*_values; // 1-indexed, slot 0 unused
+		Key					*_keys; // 1-indexed, slot 0 unused
+
+		public:
+		/*************************** Coplien form *****************************/
+		explicit frozen_map(const key_compare &comp = key_compare(),
+				const allocator_type &alloc = allocator_type())
+			: _comp(comp), _alloc(alloc), _key_alloc(alloc), _size(0),
+			_values(NULL), _keys(NULL) {}
+
+		/**
+		 * Freezes the contents of a map. O(n).
+		 * @param map Any ft::map with the same key, mapped type and comparison.
+		*/
+		template <class A, class B, class M>
+		explicit frozen_map(const ft::map<Key, Val, Compare, A, B, M> &map,
+				const allocator_type &alloc = allocator_type())
+			: _comp(map.key_comp()), _alloc(alloc), _key_alloc(alloc), _size(0),
+			_values(NULL), _keys(NULL)
+		{
+			build(map.begin(), map.size());
+		}
+
+		/**
+		 * Freezes the range [first, last), which must already be sorted by key
+		 * with unique keys (the iteration of a map, a sorted vector...). O(n).
+		 * A forward range is counted then copied; an input range, which can
+		 * only be walked once, is collected into an ft::vector first.
+		*/
+		template <class InputIterator>
+		frozen_map(InputIterator first, InputIterator last,
+			const key_compare &comp = key_compare(),
+			const allocator_type &alloc = allocator_type(),
+			typename enable_if<!ft::is_integral<InputIterator>::value, InputIterator>::type * = 0)
+			: _comp(comp), _alloc(alloc), _key_alloc(alloc), _size(0),
+			_values(NULL), _keys(NULL)
+		{
+			build_range(first, last, typename ft::iterator_traits<InputIterator>::iterator_category());
+		}
+
+		frozen_map(const frozen_map &x)
+			: _comp(x._comp), _alloc(x._alloc), _key_alloc(x._key_alloc), _size(0),
+			_values(NULL), _keys(NULL)
+		{
+			build(x.begin(), x.size());
+		}
+
+		~frozen_map(void){
+			destroy();
+		}
+
+		frozen_map &operator=(const frozen_map &x){
+			if (this != &x){
+				destroy();
+				_comp = x._comp;
+				build(x.begin(), x.size());
+			}
+			return (*this);
+		}
+
+		/*************************** Iterators *****************************/
+		iterator begin() const{
+			return (iterator(_values, eytzinger_first(_size), _size));
+		}
+
+		iterator end() const{
+			return (iterator(_values, 0, _size));
+		}
+
+		reverse_iterator rbegin() const{
+			return (reverse_iterator(--this->end()));
+		}
+
+		reverse_iterator rend() const{
+			return (reverse_iterator(--this->begin()));
+		}
+
+		/*************************** Capacity *****************************/
+		bool empty() const{
+			return (_size == 0);
+		}
+
+		size_type size() const{
+			return (_size);
+		}
+
+		size_type max_size() const{
+			return (_alloc.max_size());
+		}
+
+		/*************************** Element access *****************************/
+		const mapped_type &at(const key_type &k) const{
+			size_type slot = find_slot(k);
+			if (!slot)
+				throw(std::out_of_range("frozen_map::at"));
+			return (_values[slot].second);
+		}
+
+		/*************************** Observers *****************************/
+		key_compare key_comp() const{
+			return (_comp);
+		}
+
+		allocator_type get_allocator(void) const{
+			return (_alloc);
+		}
+
+		/*************************** Operations *****************************/
+		iterator find(const key_type &k) const{
+			return (iterator(_values, find_slot(k), _size));
+		}
+
+		size_type count(const key_type &k) const{
+			return (find_slot(k) != 0);
+		}
+
+		iterator lower_bound(const key_type &k) const{
+			return (iterator(_values, lower_slot(k), _size));
+		}
+
+		iterator upper_bound(const key_type &k) const{
+			return (iterator(_values, upper_slot(k), _size));
+		}
+
+		ft::pair<iterator, iterator> equal_range(const key_type &k) const{
+			return (ft::make_pair(lower_bound(k), upper_bound(k)));
+		}
+
+		private:
+		size_type lower_slot(const key_type &k) const{
+			return (eytzinger_lower_bound(_keys, _size, k, _comp));
+		}
+
+		size_type upper_slot(const key_type &k) const{
+			return (eytzinger_upper_bound(_keys, _size, k, _comp));
+		}
+
+		size_type find_slot(const key_type &k) const{
+			return (eytzinger_find(_keys, _size, k, _comp));
+		}
+
+		template <class ForwardIterator>
+		void build_range(ForwardIterator first, ForwardIterator last, std::forward_iterator_tag){
+			build(first, ft::distance(first, last));
+		}
+
+		template <class InputIterator>
+		void build_range(InputIterator first, InputIterator last, std::input_iterator_tag){
+			ft::vector<value_type, allocator_type> items(first, last, _alloc);
+
+			build(items.begin(), items.size());
+		}
+
+		/* Copies n sorted elements to the slots, in order.*/
+		template <class InputIterator>
+		void build(InputIterator first, size_type n){
+			_size = n;
+			if (!n)
+				return;
+			_values = _alloc.allocate(n + 1);
+			_keys = _key_alloc.allocate(n + 1);
+			for (size_type k = eytzinger_first(n); k; k = eytzinger_next(k, n), ++first){
+				_alloc.construct(_values + k, *first);
+				_key_alloc.construct(_keys + k, _values[k].first);
+			}
+		}
+
+		void destroy(){
+			if (!_size)
+				return;
+			for (size_type k = 1; k <= _size; k++){
+				_alloc.destroy(_values + k);
+				_key_alloc.destroy(_keys + k);
+			}
+			_alloc.deallocate(_values, _size + 1);
+			_key_alloc.deallocate(_keys, _size + 1);
+			_values = NULL;
+			_keys = NULL;
+			_size = 0;
+		}
+	};
+
+	template <class Key, class Val, class Compare, class Alloc>
+	bool operator==(const ft::frozen_map<Key, Val, Compare, Alloc> &lhs,
+			const ft::frozen_map<Key, Val, Compare, Alloc> &rhs){
+		if (lhs.size() != rhs.size())
+			return (false);
+		return (ft::equal(lhs.begin(), lhs.end(), rhs.begin()));
+	}
+
+	template <class Key, class Val, class Compare, class Alloc>
+	bool operator!=(const ft::frozen_map<Key, Val, Compare, Alloc> &lhs,
+			const ft::frozen_map<Key, Val, Compare, Alloc> &rhs){
+		return (!(lhs == rhs));
+	}
+}
+
+#endif
@@ -0,0 +1,92 @@
+#ifndef GROWTH_HPP
+#define GROWTH_HPP
+
+#include <cstddef>
+
+/*
+Growth policies for ft::vector.
+
+When an insertion needs more room than the capacity, the vector asks its
+policy for the new capacity. A policy is a stateless struct with one static
+hook:
+
+	grow(capacity, needed, element_size)
+					capacity to allocate for at least needed elements,
+					when capacity (< needed) is full; element_size is
+					sizeof(value_type)
+
+The factor trades the memory left unused against the copies: growing by f
+leaves up to 1 - 1 / f of the storage unused right after a reallocation
+(half at 2x, a third at 1.5x) and copies each element about 1 / (f - 1)
+times overall (once at 2x, twice at 1.5x). A fixed chunk wastes at most
+one chunk but copies O(n / chunk) times per element, so it only suits
+vectors whose final size is about known.
+
+	growth_double		2x, the default
+	growth_golden		1.5x, less slack for memory bound workers
+	growth_chunk<N>		N more elements at a time
+	growth_pages<P>		P, rounded up to whole 4 KiB pages, so that large
+						buffers use the pages the allocator maps anyway
+
+reserve() and shrink_to_fit() allocate exactly what they are asked for,
+whatever the policy. vector::slack() gives the unused capacity to tune it.
+*/
+
+namespace ft
+{
+	/** Twice the capacity (default policy).*/
+	struct growth_double
+	{
+		static size_t grow(size_t capacity, size_t needed, size_t)
+		{
+			return (needed > capacity * 2 ? needed : capacity * 2);
+		}
+	};
+
+	/** One and a half times the capacity.*/
+	struct growth_golden
+	{
+		static size_t grow(size_t capacity, size_t needed, size_t)
+		{
+			size_t next = capacity + capacity / 2;
+
+			return (needed > next ? needed : next);
+		}
+	};
+
+	/**
+	 * Chunk more elements, rounded to a multiple of Chunk.
+	 * @param Chunk Elements added at a time.
+	*/
+	template <size_t Chunk>
+	struct growth_chunk
+	{
+		static size_t grow(size_t capacity, size_t needed, size_t)
+		{
+			size_t next = capacity + Chunk > needed ? capacity + Chunk : needed;
+
+			return ((next + Chunk - 1) / Chunk * Chunk);
+		}
+	};
+
+	/**
+	 * The capacity of Policy, rounded up to whole pages once it spans one.
+	 * @param Policy Growth policy rounded.
+	 * @param Page Page size in bytes.
+	*/
+	template <class Policy = growth_double, size_t Page = 4096>
+	struct growth_pages
+	{
+		static size_t grow(size_t capacity, size_t needed, size_t element_size)
+		{
+			size_t next = Policy::grow(capacity, needed, element_size);
+			size_t bytes = next * element_size;
+
+			if (bytes < Page)
+				return (next);
+			return ((bytes + Page - 1) / Page * Page / element_size);
+		}
+	};
+}
+
+#endif
@@ -0,0 +1,397 @@
+#ifndef INTERVAL_MAP_HPP
+#define INTERVAL_MAP_HPP
+
+#include "../rbtree/Rbtree.hpp"
+#include "algorithm.hpp"
+#include "pair.hpp"
+#include "rb_iterator.hpp"
+#include "reverse_iterator.hpp"
+#include "utils.hpp"
+#include <cstddef>
+
+namespace ft
+{
+	/**
+	 * Orders intervals [first, second) by lower endpoint, then by upper endpoint.
+	*/
+	template <class T, class Compare = std::less<T> >
+	struct interval_less
+	{
+		Compare comp;
+
+		interval_less(const Compare &c = Compare()) : comp(c) {}
+		bool operator()(const ft::pair<T, T> &x, const ft::pair<T, T> &y) const{
+			if (comp(x.first, y.first))
+				return (true);
+			if (comp(y.first, x.first))
+				return (false);
+			return (comp(x.second, y.second));
+		}
+	};
+
+/*
+/   * ------------------------------------------------------------- *
+	* --------------------- FT::INTERVAL_MAP ---------------------- *
+	*
+	* A map whose keys are half open intervals [first, second), ordered by
+	* lower endpoint (then upper endpoint). Same interface as ft::map, plus:
+	*
+	* - Interval operations:
+	* overlaps:			Test whether any key overlaps [lo, hi)		O(log n)
+	* find_overlap:		Get iterator to one key overlapping [lo, hi)	O(log n)
+	* overlapping:		Get iterators to all keys overlapping [lo, hi)	O(log n + k log(n / k))
+	*
+	* Every tree node keeps the greatest upper endpoint of its subtree
+	* (ft::interval_augment), maintained through inserts, erases and rotations.
+	* ------------------------------------------------------------- *
+    */
+
+   /**
+	* @param T Type of the interval endpoints.
+	* @param Val Type of elements mapped to intervals.
+	* @param Compare Comparison object on endpoints.
+	* @param Alloc Object used to manage the storage
+	* @param Balance Balancing policy of the underlying tree (see Balance.hpp)
+   */
+	template <class T, class Val, class Compare = std::less<T>,
+		  class Alloc = std::allocator<ft::pair<const ft::pair<T, T>, Val> >,
+		  class Balance = ft::rb_balance>
+	class interval_map
+	{
+		public:
+		/***************************Member Types*****************************/
+		typedef T endpoint_type;
+		typedef ft::pair<T, T> key_type; // [first, second)
+		typedef Val mapped_type;
+		typedef ft::pair<const key_type, Val> value_type;
+		typedef ft::interval_less<T, Compare> key_compare;
+		typedef Alloc allocator_type;
+		class value_compare
+		{
+			friend class interval_map<T, Val, Compare, Alloc, Balance>;
+			protected:
+				key_compare comp;
+				value_compare(key_compare c) : comp(c) {}
+			public:
+				bool operator()(const value_type &x, const value_type &y) const {
+					return comp(x.first, y.first);
+				}
+		};
+		typedef ft::rb_iterator<value_type>								iterator;
+		typedef ft::rb_iterator<value_type>								const_iterator;
+		typedef ft::reverse_iterator<iterator>							reverse_iterator;
+		typedef ft::reverse_iterator<const_iterator>					const_reverse_iterator;
+		typedef ptrdiff_t												difference_type;
+		typedef size_t													size_type;
+
+		typedef ft::Node<value_type>									node_type;
+			private:
+		typedef typename Alloc::template rebind<node_type>::other		node_allocator_type;
+
+		public:
+		typedef ft::interval_augment<T, ft::select_first, Compare>		augment_type;
+		typedef ft::Rbtree<value_type, value_compare, allocator_type, node_allocator_type,
+			Balance, augment_type>										tree_type;
+		typedef typename allocator_type::reference reference;
+		typedef typename allocator_type::const_reference const_reference;
+		typedef typename allocator_type::pointer pointer;
+		typedef typename allocator_type::const_pointer const_pointer;
+			private:
+		key_compare			_comp;
+		allocator_type		_alloc;
+		size_type			_size;
+		tree_type			_tree;
+
+		/** Collects the overlap query results as iterators.*/
+		template <class OutputIterator>
+		struct collector
+		{
+			OutputIterator out;
+			collector(OutputIterator o) : out(o) {}
+			void operator()(node_type *node) { *out = iterator(node); ++out; }
+		};
+
+		public:
+		/*************************** Coplien form *****************************/
+		explicit interval_map(const Compare &comp = Compare(),
+				const allocator_type &alloc = allocator_type())
+			: _comp(comp), _alloc(alloc), _size(0),
+			_tree(value_compare(_comp), _alloc, node_allocator_type()) {}
+
+		template <class InputIterator>
+		interval_map(InputIterator first, InputIterator last,
+			const Compare &comp = Compare(),
+			const allocator_type &alloc = allocator_type())
+			: _comp(comp), _alloc(alloc), _size(0),
+			_tree(value_compare(_comp), _alloc, node_allocator_type())
+		{
+			insert(first, last);
+		}
+
+		interval_map(const interval_map &x)
+			: _comp(x._comp), _alloc(x._alloc), _size(x._size), _tree(x._tree) {}
+
+		~interval_map(void) {}
+
+		interval_map &operator=(const interval_map &x){
+			if (this != &x){
+				this->_tree = x._tree;
+				this->_size = x._size;
+			}
+			return (*this);
+		}
+
+		/*************************** Iterators *****************************/
+		iterator begin(){
+			return (iterator(this->_tree.minValueNode(this->_tree.get_root())));
+		}
+
+		const_iterator begin() const{
+			return (const_iterator(this->_tree.minValueNode(this->_tree.get_root())));
+		}
+
+		iterator end(){
+			node_type *node = this->_tree.maxValueNode(this->_tree.get_root());
+			if (!node)
+				return (NULL);
+			return (iterator(node->right));
+		}
+
+		const_iterator end() const{
+			node_type *node = this->_tree.maxValueNode(this->_tree.get_root());
+			if (!node)
+				return (NULL);
+			return (const_iterator(node->right));
+		}
+
+		reverse_iterator rbegin(){
+			iterator it = this->end();
+			it--;
+			return (reverse_iterator(it));
+		}
+
+		const_reverse_iterator rbegin() const{
+			const_iterator it = this->end();
+			it--;
+			return (const_reverse_iterator(it));
+		}
+
+		reverse_iterator rend(){
+			iterator it = this->begin();
+			it--;
+			return (reverse_iterator(it));
+		}
+
+		const_reverse_iterator rend() const{
+			const_iterator it = this->begin();
+			it--;
+			return (const_reverse_iterator(it));
+		}
+
+		/*************************** Capacity *****************************/
+		bool empty() const{
+			return (this->_size == 0);
+		}
+
+		size_type size() const{
+			return (this->_size);
+		}
+
+		size_type max_size() const{
+			return (this->_tree.max_size());
+		}
+
+		/*************************** Element access *****************************/
+		/**
+		 * @return A reference to the value mapped to the interval k, inserted
+		 * with a default constructed value when k is not a key yet.
+		*/
+		mapped_type &operator[](const key_type &k){
+			return (this->insert(ft::make_pair(k, mapped_type())).first->second);
+		}
+
+		mapped_type &at(const key_type &k){
+			node_type *node = this->_tree.lookup_value(ft::make_pair(k, mapped_type()));
+			if (!node)
+				throw(std::out_of_range("interval_map::at"));
+			return (node->data->second);
+		}
+
+		const mapped_type &at(const key_type &k) const{
+			node_type *node = this->_tree.lookup_value(ft::make_pair(k, mapped_type()));
+			if (!node)
+				throw(std::out_of_range("interval_map::at"));
+			return (node->data->second);
+		}
+
+		/*************************** Modifiers *****************************/
+		/**
+		 * Inserts val if no element has the same interval as key.
+		 * @return An iterator to the element with that key, and whether it was inserted.
+		*/
+		ft::pair<iterator, bool> insert(const value_type &val){
+			node_type *look = this->_tree.lookup_value(val);
+			if (look)
+				return (ft::make_pair(iterator(look), false));
+			node_type *node = this->_tree.insert_value(val);
+			this->_size += 1;
+			return (ft::make_pair(iterator(node), true));
+		}
+
+		/** Inserts the interval [lo, hi) mapped to val.*/
+		ft::pair<iterator, bool> insert(const endpoint_type &lo, const endpoint_type &hi,
+			const mapped_type &val){
+			return (this->insert(value_type(key_type(lo, hi), val)));
+		}
+
+		template <class InputIterator>
+		void insert(InputIterator first, InputIterator last){
+			while (first != last)
+			{
+				this->insert(*first);
+				++first;
+			}
+		}
+
+		void erase(iterator position){
+			if (this->_tree.delete_value(*position))
+				this->_size -= 1;
+		}
+
+		size_type erase(const key_type &k){
+			if (this->_tree.delete_value(ft::make_pair(k, mapped_type())))
+			{
+				this->_size -= 1;
+				return (1);
+			}
+			return (0);
+		}
+
+		void erase(iterator first, iterator last){
+			iterator it;
+			while (first != last){
+				it = first;
+				++first;
+				this->erase(it->first);
+			}
+		}
+
+		void swap(interval_map &x){
+			std::swap(this->_comp, x._comp);
+			std::swap(this->_alloc, x._alloc);
+			std::swap(this->_size, x._size);
+			this->_tree.swap(x._tree);
+		}
+
+		void clear(){
+			this->_tree.clear();
+			this->_size = 0;
+		}
+
+		/*************************** Observers *****************************/
+		key_compare key_comp() const{
+			return (this->_comp);
+		}
+
+		value_compare value_comp() const{
+			return (value_compare(this->_comp));
+		}
+
+		/*************************** Operations *****************************/
+		iterator find(const key_type &k){
+			node_type *node = this->_tree.lookup_value(ft::make_pair(k, mapped_type()));
+			if (!node)
+				return (this->end());
+			return (iterator(node));
+		}
+
+		const_iterator find(const key_type &k) const{
+			node_type *node = this->_tree.lookup_value(ft::make_pair(k, mapped_type()));
+			if (!node)
+				return (this->end());
+			return (const_iterator(node));
+		}
+
+		size_type count(const key_type &k) const{
+			return (this->find(k) != this->end());
+		}
+
+		/** First key not ordered before k (by lower, then upper endpoint).*/
+		iterator lower_bound(const key_type &k) const{
+			node_type *node = this->_tree.lower_bound(this->_tree.get_root(), ft::make_pair(k, mapped_type()));
+			if (!node)
+				return (this->end());
+			return (iterator(node));
+		}
+
+		/** First key ordered after k (by lower, then upper endpoint).*/
+		iterator upper_bound(const key_type &k) const{
+			node_type *node = this->_tree.upper_bound(this->_tree.get_root(), ft::make_pair(k, mapped_type()));
+			if (!node)
+				return (this->end());
+			return (iterator(node));
+		}
+
+		ft::pair<iterator, iterator> equal_range(const key_type &k) const{
+			return (ft::make_pair(this->lower_bound(k), this->upper_bound(k)));
+		}
+
+		/*************************** Interval operations *****************************/
+		/**
+		 * Tests whether some key overlaps [lo, hi). O(log n).
+		*/
+		bool overlaps(const endpoint_type &lo, const endpoint_type &hi) const{
+			return (augment_type::any_overlap(this->_tree, lo, hi) != NULL);
+		}
+
+		/**
+		 * @return An iterator to one element whose key overlaps [lo, hi),
+		 * or end() when there is none. O(log n).
+		*/
+		iterator find_overlap(const endpoint_type &lo, const endpoint_type &hi) const{
+			node_type *node = augment_type::any_overlap(this->_tree, lo, hi);
+			if (!node)
+				return (this->end());
+			return (iterator(node));
+		}
+
+		/**
+		 * Writes to out an iterator to every element whose key overlaps [lo, hi),
+		 * in key order. O(log n + k log(n / k)) for k results.
+		 * @return The output iterator past the last written result.
+		*/
+		template <class OutputIterator>
+		OutputIterator overlapping(const endpoint_type &lo, const endpoint_type &hi,
+			OutputIterator out) const{
+			collector<OutputIterator> collect(out);
+			augment_type::each_overlap(this->_tree.get_root(), lo, hi, collect);
+			return (collect.out);
+		}
+
+		allocator_type get_allocator(void) const{
+			return (this->_alloc);
+		}
+	};
+
+	template <class T, class Val, class Compare, class Alloc, class Balance>
+	bool operator==(const ft::interval_map<T, Val, Compare, Alloc, Balance> &lhs,
+			const ft::interval_map<T, Val, Compare, Alloc, Balance> &rhs){
+		if (lhs.size() != rhs.size())
+			return (false);
+		return (ft::equal(lhs.begin(), lhs.end(), rhs.begin()));
+	}
+
+	template <class T, class Val, class Compare, class Alloc, class Balance>
+	bool operator!=(const ft::interval_map<T, Val, Compare, Alloc, Balance> &lhs,
+			const ft::interval_map<T, Val, Compare, Alloc, Balance> &rhs){
+		return (!(lhs == rhs));
+	}
+
+	template <class T, class Val, class Compare, class Alloc, class Balance>
+	void swap(ft::interval_map<T, Val, Compare, Alloc, Balance> &x,
+			ft::interval_map<T, Val, Compare, Alloc, Balance> &y){
+		x.swap(y);
+	}
+}
+
+#endif
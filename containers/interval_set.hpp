@@ -0,0 +1,265 @@
+#ifndef INTERVAL_SET_HPP
+#define INTERVAL_SET_HPP
+
+#include "interval_map.hpp"
+
+namespace ft
+{
+	/**
+	 * A set of half open intervals [first, second), ordered by lower endpoint
+	 * (then upper endpoint), with the overlap queries of ft::interval_map:
+	 * overlaps and find_overlap in O(log n), overlapping in O(log n + k log(n / k)).
+	 * @param T Type of the interval endpoints.
+	 * @param Compare Comparison object on endpoints.
+	 * @param Allocator Object used to manage the storage.
+	 * @param Balance Balancing policy of the underlying tree (see Balance.hpp).
+	*/
+	template <typename T,
+				typename Compare = std::less<T>,
+				typename Allocator = std::allocator<ft::pair<T, T> >,
+				typename Balance = ft::rb_balance>
+	class interval_set
+	{
+	public:
+		/***************************Member Types*****************************/
+		typedef T endpoint_type;
+		typedef ft::pair<T, T> key_type; // [first, second)
+		typedef ft::pair<T, T> value_type;
+		typedef ft::interval_less<T, Compare> key_compare;
+		typedef ft::interval_less<T, Compare> value_compare;
+		typedef Allocator allocator_type;
+		typedef typename Allocator::size_type size_type;
+		typedef std::ptrdiff_t difference_type;
+		typedef value_type& reference;
+		typedef const value_type& const_reference;
+		typedef typename allocator_type::pointer 		pointer;
+		typedef typename allocator_type::const_pointer 	const_pointer;
+		typedef ft::rb_iterator<value_type>								iterator;
+		typedef ft::rb_iterator<value_type>								const_iterator;
+		typedef ft::reverse_iterator<iterator>							reverse_iterator;
+		typedef ft::reverse_iterator<const_iterator>					const_reverse_iterator;
+
+		typedef ft::Node<value_type>					node_type;
+		private:
+			typedef typename Allocator::template rebind<node_type>::other		node_allocator_type;
+		public:
+		typedef ft::interval_augment<T, ft::select_self, Compare>		augment_type;
+		typedef ft::Rbtree<value_type, value_compare, allocator_type, node_allocator_type,
+			Balance, augment_type>										tree_type;
+
+	protected:
+		tree_type 							_tree;
+		size_type 							_size;
+		key_compare							_comp;
+
+		template <class OutputIterator>
+		struct collector
+		{
+			OutputIterator out;
+			collector(OutputIterator o) : out(o) {}
+			void operator()(node_type *node) { *out = iterator(node); ++out; }
+		};
+
+	public:
+		/*************************** Coplien form *****************************/
+		explicit interval_set(const Compare &comp = Compare(),
+				const Allocator& alloc = Allocator())
+			: _tree(value_compare(comp), alloc), _size(0), _comp(comp) {}
+
+		template<class InputIterator>
+		interval_set(InputIterator first, InputIterator last,
+			const Compare& comp = Compare(),
+			const Allocator& alloc = Allocator())
+			: _tree(value_compare(comp), alloc), _size(0), _comp(comp){
+				insert(first, last);
+			}
+
+		interval_set(const interval_set& other)
+			: _tree(other._tree), _size(other._size), _comp(other._comp) {}
+
+		~interval_set(void) {}
+
+		interval_set& operator=(const interval_set& x){
+			if (this != &x){
+				_tree = x._tree;
+				_size = x._size;
+			}
+			return (*this);
+		}
+
+		allocator_type get_allocator() const{
+			return (_tree.get_allocator());
+		}
+
+		/*************************** Iterators *****************************/
+		iterator begin() const{
+			return (iterator(this->_tree.minValueNode(this->_tree.get_root())));
+		}
+
+		iterator end() const{
+			node_type *node = this->_tree.maxValueNode(this->_tree.get_root());
+			if (!node)
+				return (NULL);
+			return (iterator(node->right));
+		}
+
+		reverse_iterator rbegin() const{
+			return (reverse_iterator(--this->end()));
+		}
+
+		reverse_iterator rend() const{
+			return (reverse_iterator(--this->begin()));
+		}
+
+		/*************************** Capacity *****************************/
+		bool empty(void) const{
+			return (this->_size == 0);
+		}
+
+		size_type size(void) const{
+			return (_size);
+		}
+
+		size_type max_size(void) const{
+			return (_tree.max_size());
+		}
+
+		/*************************** Modifiers *****************************/
+		/**
+		 * Inserts val if it is not already in the set.
+		 * @return An iterator to the element equal to val, and whether it was inserted.
+		*/
+		ft::pair<iterator,bool> insert(const value_type &val){
+			node_type *look = _tree.lookup_value(val);
+			if (look)
+				return ft::make_pair(iterator(look), false);
+			_size++;
+			return ft::make_pair(iterator(_tree.insert_value(val)), true);
+		}
+
+		/** Inserts the interval [lo, hi).*/
+		ft::pair<iterator,bool> insert(const endpoint_type &lo, const endpoint_type &hi){
+			return (insert(value_type(lo, hi)));
+		}
+
+		template<class InputIterator>
+		void insert(InputIterator first, InputIterator last,
+			typename enable_if<!ft::is_integral<InputIterator>::value, InputIterator>::type * = 0){
+			while (first != last)
+				insert(*first++);
+		}
+
+		void erase(iterator position){
+			erase(*position);
+		}
+
+		size_type erase(const value_type& val){
+			if (this->_tree.delete_value(val)){
+				this->_size -= 1;
+				return (1);
+			}
+			return (0);
+		}
+
+		void erase(iterator first, iterator last){
+			iterator it;
+			while (first != last){
+				it = first;
+				++first;
+				erase(*it);
+			}
+		}
+
+		void swap(interval_set& x){
+			_tree.swap(x._tree);
+			std::swap(_size, x._size);
+			std::swap(_comp, x._comp);
+		}
+
+		void clear(void){
+			_tree.clear();
+			this->_size = 0;
+		}
+
+		/*************************** Observers *****************************/
+		key_compare key_comp(void) const{
+			return (_comp);
+		}
+
+		value_compare value_comp(void) const{
+			return (_comp);
+		}
+
+		/*************************** Operations *****************************/
+		iterator find(const value_type& val) const{
+			node_type *n = _tree.lookup_value(val);
+			if (!n)
+				return (end());
+			return iterator(n);
+		}
+
+		size_type count(const value_type& val) const{
+			return (find(val) != end());
+		}
+
+		iterator lower_bound(const value_type& val) const{
+			node_type *node = this->_tree.lower_bound(_tree.get_root(), val);
+			if (!node)
+				return (this->end());
+			return (iterator(node));
+		}
+
+		iterator upper_bound(const value_type& val) const{
+			node_type *node = this->_tree.upper_bound(_tree.get_root(), val);
+			if (!node)
+				return (this->end());
+			return (iterator(node));
+		}
+
+		ft::pair<iterator, iterator> equal_range(const value_type &val) const{
+			return (ft::make_pair(lower_bound(val), upper_bound(val)));
+		}
+
+		/*************************** Interval operations *****************************/
+		/** Tests whether some interval of the set overlaps [lo, hi). O(log n).*/
+		bool overlaps(const endpoint_type &lo, const endpoint_type &hi) const{
+			return (augment_type::any_overlap(this->_tree, lo, hi) != NULL);
+		}
+
+		/** @return One interval overlapping [lo, hi), or end(). O(log n).*/
+		iterator find_overlap(const endpoint_type &lo, const endpoint_type &hi) const{
+			node_type *node = augment_type::any_overlap(this->_tree, lo, hi);
+			if (!node)
+				return (end());
+			return (iterator(node));
+		}
+
+		/**
+		 * Writes to out an iterator to every interval overlapping [lo, hi), in order.
+		 * @return The output iterator past the last written result.
+		*/
+		template <class OutputIterator>
+		OutputIterator overlapping(const endpoint_type &lo, const endpoint_type &hi,
+			OutputIterator out) const{
+			collector<OutputIterator> collect(out);
+			augment_type::each_overlap(this->_tree.get_root(), lo, hi, collect);
+			return (collect.out);
+		}
+	};
+
+	template <typename T, typename Compare, typename Allocator, typename Balance>
+	bool operator==(const ft::interval_set<T, Compare, Allocator, Balance> &lhs,
+			const ft::interval_set<T, Compare, Allocator, Balance> &rhs){
+		if (lhs.size() != rhs.size())
+			return (false);
+		return (ft::equal(lhs.begin(), lhs.end(), rhs.begin()));
+	}
+
+	template <typename T, typename Compare, typename Allocator, typename Balance>
+	bool operator!=(const ft::interval_set<T, Compare, Allocator, Balance> &lhs,
+			const ft::interval_set<T, Compare, Allocator, Balance> &rhs){
+		return (!(lhs == rhs));
+	}
+}
+
+#endif
@@ -13,6 +13,9 @@
 #ifndef ITERATOR_TRAITS_HPP
 #define ITERATOR_TRAITS_HPP
 
+#include <cstddef>
+#include <iterator>
+
 namespace ft{
 
 /**
@@ -36,6 +39,58 @@ template<typename Iterator>
 		typedef typename Iterator::reference reference;
 		typedef typename Iterator::iterator_category iterator_category;
 	};
+
+/** Pointers are random-access iterators.*/
+template<typename T>
+	class iterator_traits<T*>
+	{
+	public:
+		typedef std::ptrdiff_t difference_type;
+		typedef T value_type;
+		typedef T* pointer;
+		typedef T& reference;
+		typedef std::random_access_iterator_tag iterator_category;
+	};
+
+template<typename T>
+	class iterator_traits<const T*>
+	{
+	public:
+		typedef std::ptrdiff_t difference_type;
+		typedef T value_type;
+		typedef const T* pointer;
+		typedef const T& reference;
+		typedef std::random_access_iterator_tag iterator_category;
+	};
+
+/**
+ * @return the number of increments from first to last: counted one by one,
+ * or a subtraction for random-access iterators.
+*/
+template<typename InputIterator>
+	typename iterator_traits<InputIterator>::difference_type
+	distance(InputIterator first, InputIterator last, std::input_iterator_tag)
+	{
+		typename iterator_traits<InputIterator>::difference_type n = 0;
+
+		for (; first != last; ++first)
+			n++;
+		return (n);
+	}
+
+template<typename RandomAccessIterator>
+	typename iterator_traits<RandomAccessIterator>::difference_type
+	distance(RandomAccessIterator first, RandomAccessIterator last, std::random_access_iterator_tag)
+	{
+		return (last - first);
+	}
+
+template<typename InputIterator>
+	typename iterator_traits<InputIterator>::difference_type
+	distance(InputIterator first, InputIterator last)
+	{
+		return (ft::distance(first, last, typename iterator_traits<InputIterator>::iterator_category()));
+	}
 }
 
 #endif
\ No newline at end of file
@@ -19,10 +19,14 @@
 #include "rb_iterator.hpp"
 #include "reverse_iterator.hpp"
 #include "utils.hpp"
+#include "vector.hpp"
 #include <cstddef>
 
 namespace ft
 {
+	template <class Key, class Val, class Compare, class Alloc>
+	class frozen_map;
+
 /*
 /   * ------------------------------------------------------------- *
 	* ------------------------- FT::MAP --------------------------- *
@@ -50,7 +54,7 @@ namespace ft
 	* insert:			Insert elements
 	* erase:			Erase elements
 	* swap:				Swap content
-	* clear:			Clear content
+	* clear:			Clear content (also in parallel or in the background)
 	*
 	* - Observers:
 	* key_comp:			Return key comparison object
@@ -62,6 +66,17 @@ namespace ft
 	* lower_bound:		Return iterator to lower bound
 	* upper_bound:		Return iterator to upper bound
 	* equal_range		Get range of equal elements
+	*
+	* - Aggregates (only with a Monoid):
+	* aggregate			Combine the mapped values of a key range in O(log n)
+	*
+	* - Set algebra:
+	* union_with		Move in the elements of another map with new keys
+	* intersect_with	Keep only the keys another map holds too
+	* difference_with	Keep only the keys another map does not hold
+	*
+	* - Snapshots:
+	* freeze			Immutable copy laid out for fast lookups (frozen_map.hpp)
 	* ------------------------------------------------------------- *
 	* Maps are associative containers that store elements formed by a combination
 	* of a key value and a mapped value, following a specific order.
@@ -72,9 +87,16 @@ namespace ft
 	* @param Val Type of elements mapped to keys.
 	* @param Compare Comparison object used to sort the binary tree.
 	* @param Alloc Object used to manahe the storage
+	* @param Balance Balancing policy of the underlying tree (see Balance.hpp),
+	* 		red-black by default.
+	* @param Monoid Optional monoid over the mapped values (ft::sum_monoid, ft::min_monoid,
+	* 		ft::max_monoid or user defined, see Augment.hpp). When given, every tree node
+	* 		keeps the combination of its subtree and aggregate() answers in O(log n).
    */
 	template <class Key, class Val, class Compare = std::less<Key>,
-		  class Alloc = std::allocator<ft::pair<const Key, Val> > >
+		  class Alloc = std::allocator<ft::pair<const Key, Val> >,
+		  class Balance = ft::rb_balance,
+		  class Monoid = ft::no_augment>
 	class map
 	{
 		public:
@@ -92,7 +114,7 @@ namespace ft
 		*/
 		class value_compare
 		{
-			friend class map<Key, Val, Compare>;
+			friend class map<Key, Val, Compare, Alloc, Balance, Monoid>;
 			protected:
 				Compare comp;
 				value_compare(Compare c) : comp(c) {}
@@ -115,7 +137,10 @@ namespace ft
 		single typedef, other, which is an instance of allocator*/
 
 		public:
-		typedef ft::Rbtree<value_type, value_compare, allocator_type, node_allocator_type>	tree_type;
+		typedef ft::monoid_augment<Monoid, ft::select_second>			augment_type;
+		typedef typename augment_type::value_type						aggregate_type;
+		typedef ft::Rbtree<value_type, value_compare, allocator_type, node_allocator_type,
+			Balance, augment_type>										tree_type;
 		typedef typename allocator_type::reference reference;
 		typedef typename allocator_type::const_reference const_reference;
 		typedef typename allocator_type::pointer pointer;
@@ -158,6 +183,29 @@ namespace ft
 			insert(first, last);
 		}
 
+		/**
+		 * parallel range constructor - Same contents as the range constructor (the
+		 * first of equivalent keys wins), built by par.threads threads: the range is
+		 * sorted in parallel, then the tree is built bottom up in O(n), its subtrees
+		 * concurrently (see parallel.hpp). The allocator must be usable from several
+		 * threads at once, as std::allocator is.
+		 * @param first	A forward iterator to the first element in range
+		 * @param last	An iterator representing end of the range (will be excluded and not copied).
+		 * @param par The number of threads, as in ft::parallel(8).
+		 * @param comp The template param used for sorting the map.
+		 * @param alloc The template param used for the allocation.
+		*/
+		template <class ForwardIterator>
+		map(ForwardIterator first, ForwardIterator last, const ft::parallel &par,
+			const key_compare &comp = key_compare(),
+			const allocator_type &alloc = allocator_type())
+			: _comp(comp), _alloc(alloc), _node_alloc(node_allocator_type()),
+			_size(0), _tree(value_compare(_comp), _alloc, _node_alloc)
+		{
+			if (first != last)
+				build(first, last, &*first, par.threads);
+		}
+
 		/**
 		 * copy constructor - Constructs a container with a copy of each of the elements in x.
 		 * @param x The map that will be copied.
@@ -166,6 +214,21 @@ namespace ft
 			: _comp(x._comp), _alloc(x._alloc), _node_alloc(x._node_alloc),
 			_size(x._size), _tree(x._tree) {}
 
+		/**
+		 * parallel copy constructor - Same copy, the subtrees of x copied by up
+		 * to par.threads threads when x is large (see Rbtree::clone). The
+		 * allocator must be usable from several threads at once.
+		 * @param x The map that will be copied.
+		 * @param par The number of threads, as in ft::parallel(8).
+		*/
+		map(const map &x, const ft::parallel &par)
+			: _comp(x._comp), _alloc(x._alloc), _node_alloc(x._node_alloc),
+			_size(0), _tree(value_compare(_comp), _alloc, _node_alloc)
+		{
+			this->_tree.clone(x._tree, par.threads, x._size);
+			this->_size = x._size;
+		}
+
 		/**
 		 * Map destructor - Destroys the container object.
 		*/
@@ -462,6 +525,26 @@ namespace ft
 			this->_tree.clear();
 			this->_size = 0;
 		}
+
+		/**
+		 * Clear content, the elements destroyed by up to par.threads threads
+		 * when the map is large. The allocator must be usable from several
+		 * threads at once.
+		*/
+		void clear(const ft::parallel &par){
+			this->_tree.clear(par.threads, this->_size);
+			this->_size = 0;
+		}
+
+		/**
+		 * Clear content at once: the elements are destroyed later, on a
+		 * background thread (ft::background::wait() waits for it). The
+		 * allocator must be usable from another thread.
+		*/
+		void clear(const ft::background &){
+			this->_tree.clear_in_background();
+			this->_size = 0;
+		}
 		
 		/*************************** Modifiers *****************************/
 		/**
@@ -617,6 +700,93 @@ namespace ft
 			return (ft::make_pair(lowerBound, upperBound));
 		}
 		
+		/*************************** Aggregates *****************************/
+		/**
+		 * Combines, in key order, the mapped values of the elements whose key k
+		 * satisfies lo <= k < hi. Only available when the map has a Monoid.
+		 * Values inserted or erased are accounted for automatically, values
+		 * modified in place need update_aggregate().
+		 * Complexity: O(log n), whatever the size of the range.
+		 * @param lo	First key of the range (included).
+		 * @param hi	End of the range (excluded).
+		 * @return		The combination, or the monoid identity for an empty range.
+		*/
+		aggregate_type aggregate(const key_type &lo, const key_type &hi) const{
+			return (augment_type::range(this->_tree, ft::make_pair(lo, mapped_type()),
+				ft::make_pair(hi, mapped_type())));
+		}
+
+		/**
+		 * Combines, in key order, the mapped values of every element. O(1).
+		*/
+		aggregate_type aggregate() const{
+			return (augment_type::all(this->_tree));
+		}
+
+		/**
+		 * The tree cannot see mapped values changed in place (through operator[],
+		 * at() or an iterator): call this after such a change to bring the
+		 * aggregates of the element and of its ancestors up to date. O(log n).
+		 * @param position	Iterator to the element whose mapped value changed.
+		*/
+		void update_aggregate(iterator position){
+			this->_tree.update_path(position.get_node_pointer());
+		}
+
+		/*************************** Set algebra *****************************/
+		/**
+		 * Moves into the map the elements of other whose key it does not hold;
+		 * on equal keys the element of the map stays. other ends empty.
+		 * The trees are split around each other's keys and joined back, so
+		 * the work is O(m log(n / m + 1)) for sizes m <= n, on the calling
+		 * thread; the overload taking ft::parallel combines large inputs with
+		 * up to par.threads threads (see Rbtree::combine).
+		 * If an allocation fails, both maps end empty.
+		 * @param other A map whose allocator compares equal to this one's.
+		 * @param par The number of threads, as in ft::parallel(8).
+		*/
+		void union_with(map &other){
+			combine(tree_type::algebra_union, other, 1);
+		}
+
+		void union_with(map &other, const ft::parallel &par){
+			combine(tree_type::algebra_union, other, par.threads);
+		}
+
+		/**
+		 * Erases the elements whose key other does not hold, and empties other.
+		 * Same cost as union_with, plus the elements destroyed.
+		*/
+		void intersect_with(map &other){
+			combine(tree_type::algebra_intersection, other, 1);
+		}
+
+		void intersect_with(map &other, const ft::parallel &par){
+			combine(tree_type::algebra_intersection, other, par.threads);
+		}
+
+		/**
+		 * Erases the elements whose key other holds, and empties other.
+		 * Same cost as union_with, plus the elements destroyed.
+		*/
+		void difference_with(map &other){
+			combine(tree_type::algebra_difference, other, 1);
+		}
+
+		void difference_with(map &other, const ft::parallel &par){
+			combine(tree_type::algebra_difference, other, par.threads);
+		}
+
+		/*************************** Snapshots *****************************/
+		/**
+		 * Immutable copy of the map in Eytzinger layout, for tables built once
+		 * and then only read. Needs frozen_map.hpp. O(n).
+		 * @return An ft::frozen_map holding the current elements.
+		*/
+		ft::frozen_map<Key, Val, Compare, Alloc> freeze() const{
+			return (ft::frozen_map<Key, Val, Compare, Alloc>(*this, this->_alloc));
+		}
+
 		/**
 		 * Get allocator
 		 * @return a copy of the allocator object associated with the map.
@@ -629,6 +799,51 @@ namespace ft
 		void print_tree(){
 			this->_tree.printBT();
 		}
+
+			private:
+		void combine(typename tree_type::set_operation op, map &other, size_t threads){
+			size_type size = this->_size;
+			size_type other_size = other._size;
+
+			if (&other == this){
+				if (op == tree_type::algebra_difference)
+					this->clear();
+				return;
+			}
+			this->_size = 0;
+			other._size = 0;
+			if (size + other_size < ft::parallel_grain)
+				threads = 1;
+			size_type common = this->_tree.combine(op, other._tree, threads);
+			if (op == tree_type::algebra_union)
+				this->_size = size + other_size - common;
+			else if (op == tree_type::algebra_intersection)
+				this->_size = common;
+			else
+				this->_size = size - common;
+		}
+
+		/* Orders the range elements by key, whatever their pair type.*/
+		struct key_order
+		{
+			key_compare comp;
+			key_order(const key_compare &c) : comp(c) {}
+			template <class P>
+			bool operator()(const P &x, const P &y) const {
+				return comp(x.first, y.first);
+			}
+		};
+
+		/* Parallel range constructor, Source being the type of the range elements.*/
+		template <class ForwardIterator, class Source>
+		void build(ForwardIterator first, ForwardIterator last, const Source *, size_t threads){
+			ft::vector<const Source *> sorted;
+
+			for (; first != last; ++first)
+				sorted.push_back(&*first);
+			this->_size = ft::sort_unique(&sorted[0], sorted.size(), key_order(this->_comp), threads);
+			this->_tree.build(&sorted[0], this->_size, threads);
+		}
 	};
 
 	/**
@@ -646,9 +861,9 @@ namespace ft
 	 * If the elements are equal, ft::equal returns true and the operator== function returns true. 
 	 * If the elements are not equal, ft::equal returns false and the operator== function returns false.
 	*/
-	template <class Key, class Val, class Compare, class Alloc>
-	bool operator==(const ft::map<Key, Val, Compare, Alloc> &lhs,
-			const ft::map<Key, Val, Compare, Alloc> &rhs){
+	template <class Key, class Val, class Compare, class Alloc, class Balance, class Monoid>
+	bool operator==(const ft::map<Key, Val, Compare, Alloc, Balance, Monoid> &lhs,
+			const ft::map<Key, Val, Compare, Alloc, Balance, Monoid> &rhs){
 		if (lhs.size() != rhs.size())
 			return (false);
 		if (lhs.empty() && rhs.empty())
@@ -664,9 +879,9 @@ namespace ft
 	 * Otherwise, it uses the ft::equal function to compare the elements of lhs and rhs. 
 	 * If all elements are equal, then it returns false, otherwise it returns true.
 	*/
-	template <class Key, class Val, class Compare, class Alloc>
-	bool operator!=(const ft::map<Key, Val, Compare, Alloc> &lhs,
-			const ft::map<Key, Val, Compare, Alloc> &rhs){
+	template <class Key, class Val, class Compare, class Alloc, class Balance, class Monoid>
+	bool operator!=(const ft::map<Key, Val, Compare, Alloc, Balance, Monoid> &lhs,
+			const ft::map<Key, Val, Compare, Alloc, Balance, Monoid> &rhs){
 		return (!(lhs == rhs));
 	}
 
@@ -679,9 +894,9 @@ namespace ft
 	 * If any pair of elements is not equal, the comparison stops and the result is based on the comparison of the current elements. 
 	 * The operator returns false if rhs is empty or if the two maps have the same elements.
 	*/
-	template <class Key, class Val, class Compare, class Alloc>
-	bool operator<(const ft::map<Key, Val, Compare, Alloc> &lhs,
-			const ft::map<Key, Val, Compare, Alloc> &rhs){
+	template <class Key, class Val, class Compare, class Alloc, class Balance, class Monoid>
+	bool operator<(const ft::map<Key, Val, Compare, Alloc, Balance, Monoid> &lhs,
+			const ft::map<Key, Val, Compare, Alloc, Balance, Monoid> &rhs){
 		if (rhs.empty())
 			return (false);
 		if (lhs.empty())
@@ -703,9 +918,9 @@ namespace ft
 	 * or one of the maps has been completely iterated through. If lhs is less than rhs, 
 	 * then !(rhs < lhs) returns false, so the operator returns true to indicate that lhs is less than or equal to rhs.
 	*/
-	template <class Key, class Val, class Compare, class Alloc>
-	bool operator<=(const ft::map<Key, Val, Compare, Alloc> &lhs,
-			const ft::map<Key, Val, Compare, Alloc> &rhs){
+	template <class Key, class Val, class Compare, class Alloc, class Balance, class Monoid>
+	bool operator<=(const ft::map<Key, Val, Compare, Alloc, Balance, Monoid> &lhs,
+			const ft::map<Key, Val, Compare, Alloc, Balance, Monoid> &rhs){
 		return (!(rhs < lhs));
 	}
 
@@ -720,9 +935,9 @@ namespace ft
 	 * which is calculated by the previously defined operator "<" for maps. If rhs is less than lhs, 
 	 * then lhs is greater than rhs, and the function returns true. Otherwise, it returns false.
 	*/
-	template <class Key, class Val, class Compare, class Alloc>
-	bool operator>(const ft::map<Key, Val, Compare, Alloc> &lhs,
-			const ft::map<Key, Val, Compare, Alloc> &rhs){
+	template <class Key, class Val, class Compare, class Alloc, class Balance, class Monoid>
+	bool operator>(const ft::map<Key, Val, Compare, Alloc, Balance, Monoid> &lhs,
+			const ft::map<Key, Val, Compare, Alloc, Balance, Monoid> &rhs){
 		return (rhs < lhs);
 	}
 	
@@ -733,9 +948,9 @@ namespace ft
 	 * The operator returns the result of !(lhs < rhs), where < is the less than operator defined earlier. 
 	 * In other words, if lhs is not less than rhs, then lhs >= rhs.
 	*/
-	template <class Key, class Val, class Compare, class Alloc>
-	bool operator>=(const ft::map<Key, Val, Compare, Alloc> &lhs,
-			const ft::map<Key, Val, Compare, Alloc> &rhs){
+	template <class Key, class Val, class Compare, class Alloc, class Balance, class Monoid>
+	bool operator>=(const ft::map<Key, Val, Compare, Alloc, Balance, Monoid> &lhs,
+			const ft::map<Key, Val, Compare, Alloc, Balance, Monoid> &rhs){
 		return (!(lhs < rhs));
 	}
 }
@@ -0,0 +1,260 @@
+#ifndef MAPPED_FILE_HPP
+#define MAPPED_FILE_HPP
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#include <algorithm>
+#include <cerrno>
+#include <cstdio>
+#include <cstring>
+#include <cstddef>
+#include <stdexcept>
+#include <string>
+
+/*
+On-disk format of ft::mapped_map and ft::mapped_set: the frozen_map layout
+(keys, then elements, each sorted in Eytzinger order, see frozen_iterator.hpp)
+written to a file that is then searched where it lies, mmap()ed read-only.
+
+	offset 0		header (64 bytes)
+	keys			n + 1 keys, slot 0 unused
+	values			n + 1 elements, slot 0 unused (maps only; a set's
+					elements are its keys)
+
+Both arrays start on a 64 bytes boundary. Keys and mapped values are stored as
+their bytes: they must be trivially copyable and hold no pointer (integers,
+floating point numbers, fixed size arrays and structs of those), and a file
+is only read back by a program with the same types, compiler and byte order.
+The header records the sizes and the byte order, and opening a file that does
+not match, or is shorter than its element count needs, throws
+std::runtime_error.
+*/
+
+namespace ft
+{
+	struct mapped_header
+	{
+		char	magic[8];
+		size_t	layout;		// byte order and word size of the writer
+		size_t	key_size;
+		size_t	value_size;	// 0 for a set
+		size_t	size;		// elements
+		size_t	keys;		// offset of the keys
+		size_t	values;		// offset of the values
+		size_t	bytes;		// file size
+	};
+
+	/* The pieces shared by the writer and the reader.*/
+	struct mapped_format
+	{
+		static const size_t alignment = 64;
+
+		static const char *magic(void)
+		{
+			return ("ftmap01");
+		}
+
+		static size_t layout(void)
+		{
+			return ((size_t)0x01020304 * 0x100 + sizeof(size_t));
+		}
+
+		static size_t align(size_t offset)
+		{
+			return ((offset + alignment - 1) / alignment * alignment);
+		}
+
+		static void fail(const std::string &what, const char *path)
+		{
+			std::string message = "mapped file " + std::string(path) + ": " + what;
+
+			if (errno)
+				message += std::string(" (") + strerror(errno) + ")";
+			throw std::runtime_error(message);
+		}
+
+		/* write() was given elements out of key order, or a key twice.*/
+		static void unordered(const char *path)
+		{
+			throw std::invalid_argument("mapped file " + std::string(path)
+				+ ": elements not sorted with unique keys");
+		}
+
+		/* Header of a file of n elements.*/
+		static mapped_header describe(size_t key_size, size_t value_size, size_t n)
+		{
+			mapped_header head;
+
+			std::memset(&head, 0, sizeof(head));
+			std::memcpy(head.magic, magic(), 8);
+			head.layout = layout();
+			head.key_size = key_size;
+			head.value_size = value_size;
+			head.size = n;
+			head.keys = align(sizeof(mapped_header));
+			head.values = align(head.keys + (n + 1) * key_size);
+			head.bytes = value_size ? head.values + (n + 1) * value_size : head.values;
+			return (head);
+		}
+	};
+
+	/**
+	 * Creates a mapped file: path.tmp is sized, mapped and filled through
+	 * keys() and values(), then commit() renames it over path, so readers
+	 * of path see the old file or the new one, never a partial one. Without
+	 * commit(), the destructor removes path.tmp.
+	*/
+	class mapped_writer
+	{
+	public:
+		mapped_writer(const char *path, size_t key_size, size_t value_size, size_t n)
+			: _path(path), _tmp(std::string(path) + ".tmp"), _base(NULL)
+		{
+			_head = mapped_format::describe(key_size, value_size, n);
+			errno = 0;
+			int fd = ::open(_tmp.c_str(), O_RDWR | O_CREAT | O_TRUNC, 0644);
+			if (fd < 0)
+				mapped_format::fail("cannot create", _tmp.c_str());
+			if (ftruncate(fd, _head.bytes) != 0)
+			{
+				::close(fd);
+				unlink(_tmp.c_str());
+				mapped_format::fail("cannot size", _tmp.c_str());
+			}
+			void *base = mmap(NULL, _head.bytes, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+			::close(fd);
+			if (base == MAP_FAILED)
+			{
+				unlink(_tmp.c_str());
+				mapped_format::fail("cannot map", _tmp.c_str());
+			}
+			_base = static_cast<char *>(base);
+		}
+
+		~mapped_writer(void)
+		{
+			if (_base)
+			{
+				munmap(_base, _head.bytes);
+				unlink(_tmp.c_str());
+			}
+		}
+
+		char *keys(void) { return (_base + _head.keys); }
+		char *values(void) { return (_base + _head.values); }
+
+		/** Writes the header last, flushes, and replaces path.*/
+		void commit(void)
+		{
+			std::memcpy(_base, &_head, sizeof(_head));
+			errno = 0;
+			bool synced = msync(_base, _head.bytes, MS_SYNC) == 0;
+			munmap(_base, _head.bytes);
+			_base = NULL;
+			if (!synced || rename(_tmp.c_str(), _path.c_str()) != 0)
+			{
+				unlink(_tmp.c_str());
+				mapped_format::fail("cannot write", _path.c_str());
+			}
+		}
+
+	private:
+		std::string		_path;
+		std::string		_tmp;
+		mapped_header	_head;
+		char			*_base;
+
+		mapped_writer(const mapped_writer &);
+		mapped_writer &operator=(const mapped_writer &);
+	};
+
+	/**
+	 * A mapped file opened read-only. The pages are shared with every other
+	 * process mapping the same file, and only read from disk when touched.
+	*/
+	class mapped_reader
+	{
+	public:
+		mapped_reader(void) : _base(NULL), _bytes(0) {}
+
+		~mapped_reader(void)
+		{
+			close();
+		}
+
+		/** Maps path and checks its header against the expected sizes.*/
+		void open(const char *path, size_t key_size, size_t value_size)
+		{
+			struct stat st;
+
+			close();
+			errno = 0;
+			int fd = ::open(path, O_RDONLY);
+			if (fd < 0)
+				mapped_format::fail("cannot open", path);
+			if (fstat(fd, &st) != 0 || (size_t)st.st_size < sizeof(mapped_header))
+			{
+				::close(fd);
+				mapped_format::fail("not a mapped file", path);
+			}
+			void *base = mmap(NULL, st.st_size, PROT_READ, MAP_SHARED, fd, 0);
+			::close(fd);
+			if (base == MAP_FAILED)
+				mapped_format::fail("cannot map", path);
+			_base = static_cast<const char *>(base);
+			_bytes = st.st_size;
+			// bound the count before describe() multiplies it by the sizes
+			if (head().size > (_bytes - sizeof(mapped_header)) / (key_size + value_size))
+			{
+				close();
+				mapped_format::fail("wrong format, types or size", path);
+			}
+			mapped_header expected = mapped_format::describe(key_size, value_size, head().size);
+			errno = 0;
+			if (std::memcmp(&head(), &expected, sizeof(expected)) != 0 || _bytes < expected.bytes)
+			{
+				close();
+				mapped_format::fail("wrong format, types or size", path);
+			}
+		}
+
+		void close(void)
+		{
+			if (_base)
+				munmap(const_cast<char *>(_base), _bytes);
+			_base = NULL;
+			_bytes = 0;
+		}
+
+		const mapped_header &head(void) const
+		{
+			return (*reinterpret_cast<const mapped_header *>(_base));
+		}
+
+		/** Number of elements, 0 when nothing is mapped.*/
+		size_t size(void) const
+		{
+			return (_base ? head().size : 0);
+		}
+
+		const char *keys(void) const { return (_base + head().keys); }
+		const char *values(void) const { return (_base + head().values); }
+
+		void swap(mapped_reader &other)
+		{
+			std::swap(_base, other._base);
+			std::swap(_bytes, other._bytes);
+		}
+
+	private:
+		const char	*_base;
+		size_t		_bytes;
+
+		mapped_reader(const mapped_reader &);
+		mapped_reader &operator=(const mapped_reader &);
+	};
+}
+
+#endif
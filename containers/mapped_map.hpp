@@ -0,0 +1,175 @@
+#ifndef MAPPED_MAP_HPP
+#define MAPPED_MAP_HPP
+
+#include "mapped_file.hpp"
+#include "frozen_iterator.hpp"
+#include "reverse_iterator.hpp"
+#include "pair.hpp"
+#include <functional>
+#include <new>
+
+namespace ft
+{
+	/**
+	 * Read-only map searched in place in a file written by write(), for large
+	 * tables loaded at startup: opening it maps the file (O(1), no parsing and
+	 * no insert), and the pages are read on first touch and shared through the
+	 * page cache by every process opening the same file.
+	 *
+	 * The file holds the frozen_map layout (see mapped_file.hpp for the format
+	 * and frozen_map.hpp for the search), so lookups run the same branch free
+	 * Eytzinger descent, on the keys only.
+	 * @param Key Type of keys, trivially copyable and without pointers.
+	 * @param Val Type of mapped values, same requirement.
+	 * @param Compare Comparison object used to sort the keys; the file must
+	 * 		have been written in that order.
+	*/
+	template <class Key, class Val, class Compare = std::less<Key> >
+	class mapped_map
+	{
+		public:
+		/***************************Member Types*****************************/
+		typedef Key key_type;
+		typedef Val mapped_type;
+		typedef ft::pair<const Key, Val> value_type;
+		typedef Compare key_compare;
+		typedef ft::frozen_iterator<const value_type>					iterator;
+		typedef iterator												const_iterator;
+		typedef ft::reverse_iterator<iterator>							reverse_iterator;
+		typedef ft::reverse_iterator<const_iterator>					const_reverse_iterator;
+		typedef ptrdiff_t												difference_type;
+		typedef size_t													size_type;
+		typedef const value_type &										reference;
+		typedef const value_type &										const_reference;
+		/** Keys and values are read from the file as bytes: other types do not compile.*/
+		typedef char bytes_check[sizeof(ft::static_check<ft::is_trivially_copyable<Key>::value && ft::is_trivially_copyable<Val>::value>)];
+
+		/*************************** Writing *****************************/
+		/**
+		 * Writes the elements of map to path, replacing the file at once
+		 * (readers that already mapped the old file keep it). O(n).
+		 * @param map An ft::map, ft::frozen_map, or any container iterating
+		 * 		pairs in key order with unique keys, and knowing its size().
+		 * @throw std::runtime_error when the file cannot be written;
+		 * 		std::invalid_argument when the keys are not sorted and unique.
+		*/
+		template <class Map>
+		static void write(const char *path, const Map &map){
+			write(path, map.begin(), map.size());
+		}
+
+		/** write() of the n elements from first, sorted by key with unique keys.*/
+		template <class InputIterator>
+		static void write(const char *path, InputIterator first, size_type n){
+			mapped_writer out(path, sizeof(Key), sizeof(value_type), n);
+			Key *keys = reinterpret_cast<Key *>(out.keys());
+			value_type *values = reinterpret_cast<value_type *>(out.values());
+			key_compare comp;
+			size_type prev = 0;
+
+			for (size_type k = eytzinger_first(n); k; k = eytzinger_next(k, n), ++first){
+				if (prev && !comp(keys[prev], first->first))
+					mapped_format::unordered(path);
+				new (keys + k) Key(first->first);
+				new (values + k) value_type(first->first, first->second);
+				prev = k;
+			}
+			out.commit();
+		}
+
+		/*************************** Coplien form *****************************/
+		/**
+		 * Maps the file at path.
+		 * @throw std::runtime_error when it cannot be opened, or was not written
+		 * 		by mapped_map::write() with the same key and value sizes.
+		*/
+		explicit mapped_map(const char *path, const key_compare &comp = key_compare())
+			: _comp(comp){
+			_file.open(path, sizeof(Key), sizeof(value_type));
+		}
+
+		~mapped_map(void) {}
+
+		void swap(mapped_map &x){
+			std::swap(_comp, x._comp);
+			_file.swap(x._file);
+		}
+
+		/*************************** Iterators *****************************/
+		iterator begin() const{
+			return (iterator(values(), eytzinger_first(size()), size()));
+		}
+
+		iterator end() const{
+			return (iterator(values(), 0, size()));
+		}
+
+		reverse_iterator rbegin() const{
+			return (reverse_iterator(--this->end()));
+		}
+
+		reverse_iterator rend() const{
+			return (reverse_iterator(--this->begin()));
+		}
+
+		/*************************** Capacity *****************************/
+		bool empty() const{
+			return (size() == 0);
+		}
+
+		size_type size() const{
+			return (_file.size());
+		}
+
+		/*************************** Element access *****************************/
+		const mapped_type &at(const key_type &k) const{
+			size_type slot = eytzinger_find(keys(), size(), k, _comp);
+			if (!slot)
+				throw(std::out_of_range("mapped_map::at"));
+			return (values()[slot].second);
+		}
+
+		/*************************** Observers *****************************/
+		key_compare key_comp() const{
+			return (_comp);
+		}
+
+		/*************************** Operations *****************************/
+		iterator find(const key_type &k) const{
+			return (iterator(values(), eytzinger_find(keys(), size(), k, _comp), size()));
+		}
+
+		size_type count(const key_type &k) const{
+			return (eytzinger_find(keys(), size(), k, _comp) != 0);
+		}
+
+		iterator lower_bound(const key_type &k) const{
+			return (iterator(values(), eytzinger_lower_bound(keys(), size(), k, _comp), size()));
+		}
+
+		iterator upper_bound(const key_type &k) const{
+			return (iterator(values(), eytzinger_upper_bound(keys(), size(), k, _comp), size()));
+		}
+
+		ft::pair<iterator, iterator> equal_range(const key_type &k) const{
+			return (ft::make_pair(lower_bound(k), upper_bound(k)));
+		}
+
+		private:
+		key_compare		_comp;
+		mapped_reader	_file;
+
+		mapped_map(const mapped_map &);
+		mapped_map &operator=(const mapped_map &);
+
+		const Key *keys() const{
+			return (reinterpret_cast<const Key *>(_file.keys()));
+		}
+
+		const value_type *values() const{
+			return (reinterpret_cast<const value_type *>(_file.values()));
+		}
+	};
+}
+
+#endif
@@ -0,0 +1,158 @@
+#ifndef MAPPED_SET_HPP
+#define MAPPED_SET_HPP
+
+#include "mapped_file.hpp"
+#include "frozen_iterator.hpp"
+#include "reverse_iterator.hpp"
+#include "pair.hpp"
+#include <functional>
+#include <new>
+
+namespace ft
+{
+	/**
+	 * Read-only set searched in place in a file written by write(). Same
+	 * format and costs as ft::mapped_map, the file holding the keys only.
+	 * @param Key Type of the elements, trivially copyable and without pointers.
+	 * @param Compare Comparison object used to sort the elements; the file
+	 * 		must have been written in that order.
+	*/
+	template <class Key, class Compare = std::less<Key> >
+	class mapped_set
+	{
+		public:
+		/***************************Member Types*****************************/
+		typedef Key key_type;
+		typedef Key value_type;
+		typedef Compare key_compare;
+		typedef Compare value_compare;
+		typedef ft::frozen_iterator<const value_type>					iterator;
+		typedef iterator												const_iterator;
+		typedef ft::reverse_iterator<iterator>							reverse_iterator;
+		typedef ft::reverse_iterator<const_iterator>					const_reverse_iterator;
+		typedef ptrdiff_t												difference_type;
+		typedef size_t													size_type;
+		typedef const value_type &										reference;
+		typedef const value_type &										const_reference;
+		/** As mapped_map::bytes_check, for the keys.*/
+		typedef char bytes_check[sizeof(ft::static_check<ft::is_trivially_copyable<Key>::value>)];
+
+		/*************************** Writing *****************************/
+		/**
+		 * Writes the elements of set to path, replacing the file at once
+		 * (readers that already mapped the old file keep it). O(n).
+		 * @param set An ft::set, or any container iterating unique elements in
+		 * 		order and knowing its size().
+		 * @throw std::runtime_error when the file cannot be written;
+		 * 		std::invalid_argument when the elements are not sorted and unique.
+		*/
+		template <class Set>
+		static void write(const char *path, const Set &set){
+			write(path, set.begin(), set.size());
+		}
+
+		/** write() of the n elements from first, sorted and unique.*/
+		template <class InputIterator>
+		static void write(const char *path, InputIterator first, size_type n){
+			mapped_writer out(path, sizeof(Key), 0, n);
+			Key *keys = reinterpret_cast<Key *>(out.keys());
+			key_compare comp;
+			size_type prev = 0;
+
+			for (size_type k = eytzinger_first(n); k; k = eytzinger_next(k, n), ++first){
+				if (prev && !comp(keys[prev], *first))
+					mapped_format::unordered(path);
+				new (keys + k) Key(*first);
+				prev = k;
+			}
+			out.commit();
+		}
+
+		/*************************** Coplien form *****************************/
+		/**
+		 * Maps the file at path.
+		 * @throw std::runtime_error when it cannot be opened, or was not written
+		 * 		by mapped_set::write() with the same key size.
+		*/
+		explicit mapped_set(const char *path, const key_compare &comp = key_compare())
+			: _comp(comp){
+			_file.open(path, sizeof(Key), 0);
+		}
+
+		~mapped_set(void) {}
+
+		void swap(mapped_set &x){
+			std::swap(_comp, x._comp);
+			_file.swap(x._file);
+		}
+
+		/*************************** Iterators *****************************/
+		iterator begin() const{
+			return (iterator(keys(), eytzinger_first(size()), size()));
+		}
+
+		iterator end() const{
+			return (iterator(keys(), 0, size()));
+		}
+
+		reverse_iterator rbegin() const{
+			return (reverse_iterator(--this->end()));
+		}
+
+		reverse_iterator rend() const{
+			return (reverse_iterator(--this->begin()));
+		}
+
+		/*************************** Capacity *****************************/
+		bool empty() const{
+			return (size() == 0);
+		}
+
+		size_type size() const{
+			return (_file.size());
+		}
+
+		/*************************** Observers *****************************/
+		key_compare key_comp() const{
+			return (_comp);
+		}
+
+		value_compare value_comp() const{
+			return (_comp);
+		}
+
+		/*************************** Operations *****************************/
+		iterator find(const value_type &k) const{
+			return (iterator(keys(), eytzinger_find(keys(), size(), k, _comp), size()));
+		}
+
+		size_type count(const value_type &k) const{
+			return (eytzinger_find(keys(), size(), k, _comp) != 0);
+		}
+
+		iterator lower_bound(const value_type &k) const{
+			return (iterator(keys(), eytzinger_lower_bound(keys(), size(), k, _comp), size()));
+		}
+
+		iterator upper_bound(const value_type &k) const{
+			return (iterator(keys(), eytzinger_upper_bound(keys(), size(), k, _comp), size()));
+		}
+
+		ft::pair<iterator, iterator> equal_range(const value_type &k) const{
+			return (ft::make_pair(lower_bound(k), upper_bound(k)));
+		}
+
+		private:
+		key_compare		_comp;
+		mapped_reader	_file;
+
+		mapped_set(const mapped_set &);
+		mapped_set &operator=(const mapped_set &);
+
+		const Key *keys() const{
+			return (reinterpret_cast<const Key *>(_file.keys()));
+		}
+	};
+}
+
+#endif
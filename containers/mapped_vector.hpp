@@ -0,0 +1,455 @@
+#ifndef MAPPED_VECTOR_HPP
+#define MAPPED_VECTOR_HPP
+
+#include "mapped_file.hpp"
+#include "vector.hpp"
+
+/*
+A vector whose elements live in a file, mmap()ed read/write and shared:
+
+	offset 0		header (mapped_vector_header), 64 bytes
+	64				capacity() elements, the first size() of them in use
+
+The size is kept in the header, so the file is the vector: reopening it maps
+it again, without reading or copying anything, and writing an element is a
+store to the page cache, with no write() or full copy to save it. Growing
+extends the file (ftruncate) and remaps it (mremap, which may move it), so
+it invalidates every iterator, as a reallocation of ft::vector does.
+
+Elements are stored as their bytes: T must be trivially copyable and hold no
+pointer, and a file is only reopened by a program with the same type,
+compiler and byte order (the header records the element size and the byte
+order, and a file that does not match throws std::runtime_error).
+
+The kernel writes the modified pages back on its own schedule: flush()
+starts writing them now and sync() waits until they are on disk. A process
+crash loses nothing, the pages being the file's; a system crash may lose
+what was written since the last sync(), or keep a size counting elements
+whose pages were not written yet.
+*/
+
+namespace ft
+{
+	struct mapped_vector_header
+	{
+		char	magic[8];
+		size_t	layout;			// byte order and word size of the writer
+		size_t	element_size;
+		size_t	size;			// elements in use
+	};
+
+	/**
+	 * @param T Type of the elements, trivially copyable and without pointers.
+	 * @param Growth Growth policy of the file (growth.hpp); whole pages by default.
+	*/
+	template <class T, class Growth = ft::growth_pages<> >
+	class mapped_vector
+	{
+		public:
+		/***************************Member Types*****************************/
+		typedef T value_type;
+		typedef Growth growth_policy;
+		typedef T *pointer;
+		typedef const T *const_pointer;
+		typedef T &reference;
+		typedef const T &const_reference;
+		typedef ft::random_access_iterator<value_type> iterator;
+		typedef ft::random_access_iterator<value_type> const_iterator;
+		typedef ft::reverse_iterator<iterator> reverse_iterator;
+		typedef ft::reverse_iterator<const_iterator> const_reverse_iterator;
+		typedef std::ptrdiff_t difference_type;
+		typedef std::size_t size_type;
+		/** The elements are the file's bytes: only a trivially copyable T compiles.*/
+		typedef char bytes_check[sizeof(ft::static_check<ft::is_trivially_copyable<T>::value>)];
+
+		/**
+		 * Opens the vector stored at path, or creates an empty one there.
+		 * @throw std::runtime_error when the file cannot be opened or mapped,
+		 * 		or holds another type.
+		*/
+		explicit mapped_vector(const char *path)
+			: _path(path), _fd(-1), _base(NULL), _bytes(0)
+		{
+			struct stat st;
+
+			errno = 0;
+			_fd = ::open(path, O_RDWR | O_CREAT, 0644);
+			if (_fd < 0)
+				mapped_format::fail("cannot open", path);
+			if (fstat(_fd, &st) != 0)
+				fail_open("cannot open");
+			if (st.st_size == 0)
+			{
+				if (ftruncate(_fd, data_offset()) != 0)
+					fail_open("cannot size");
+				st.st_size = data_offset();
+			}
+			void *base = mmap(NULL, st.st_size, PROT_READ | PROT_WRITE, MAP_SHARED, _fd, 0);
+			if (base == MAP_FAILED)
+				fail_open("cannot map");
+			_base = static_cast<char *>(base);
+			_bytes = st.st_size;
+			if (_bytes == data_offset() && head().magic[0] == 0)
+				init_head();
+			if (!valid())
+			{
+				munmap(_base, _bytes);
+				errno = 0;
+				fail_open("wrong format, type or size");
+			}
+		}
+
+		/** Unmaps the file; the kernel still writes the modified pages back.*/
+		~mapped_vector(void)
+		{
+			munmap(_base, _bytes);
+			::close(_fd);
+		}
+
+		/*************************** Iterators *****************************/
+		/* const_iterator is iterator, as in ft::vector.*/
+		iterator begin() { return (iterator(data())); }
+		const_iterator begin() const { return (const_iterator(const_cast<value_type *>(data()))); }
+		iterator end() { return (iterator(data() + size())); }
+		const_iterator end() const { return (begin() + size()); }
+		reverse_iterator rbegin() { return (reverse_iterator(end() - 1)); }
+		const_reverse_iterator rbegin() const { return (const_reverse_iterator(end() - 1)); }
+		reverse_iterator rend() { return (reverse_iterator(data() - 1)); }
+		const_reverse_iterator rend() const { return (const_reverse_iterator(begin() - 1)); }
+
+		/*************************** Capacity *****************************/
+		size_type size(void) const { return (head().size); }
+		size_type max_size(void) const { return (((size_t)-1 - data_offset()) / sizeof(T)); }
+		/** @return the elements the file holds room for.*/
+		size_type capacity(void) const { return ((_bytes - data_offset()) / sizeof(T)); }
+		size_type slack(void) const { return (capacity() - size()); }
+		bool empty(void) const { return (size() == 0); }
+
+		void resize(size_type n, value_type val = value_type())
+		{
+			if (n > size())
+			{
+				if (n > capacity())
+					remap(grow_to(n));
+				ft::uninitialized_fill_n(_alloc, data() + size(), n - size(), val);
+			}
+			head().size = n;
+		}
+
+		/**
+		 * As vector::resize_uninitialized(): trivial types only. The new
+		 * elements hold what the file held there (zeros when it grew).
+		*/
+		void resize_uninitialized(size_type n)
+		{
+			ft::static_check<ft::is_trivial<value_type>::value>::holds();
+			if (n > capacity())
+				remap(grow_to(n));
+			head().size = n;
+		}
+
+		/** @return the first of n uninitialized elements added at the end.*/
+		pointer append_uninitialized(size_type n)
+		{
+			size_type old_size = size();
+
+			resize_uninitialized(old_size + n);
+			return (data() + old_size);
+		}
+
+		/** Extends the file to n elements.*/
+		void reserve(size_type n)
+		{
+			if (n > capacity())
+				remap(n);
+		}
+
+		/** Truncates the file to the elements in use.*/
+		void shrink_to_fit(void)
+		{
+			if (capacity() > size())
+				remap(size());
+		}
+
+		/*************************** Element access *****************************/
+		reference operator[](size_type n) { return (data()[n]); }
+		const_reference operator[](size_type n) const { return (data()[n]); }
+
+		reference at(size_type n)
+		{
+			if (n >= size())
+				throw(std::out_of_range("ft::mapped_vector::Out-of-Range"));
+			return (data()[n]);
+		}
+
+		const_reference at(size_type n) const
+		{
+			if (n >= size())
+				throw(std::out_of_range("ft::mapped_vector::Out-of-Range"));
+			return (data()[n]);
+		}
+
+		reference front(void) { return (data()[0]); }
+		const_reference front(void) const { return (data()[0]); }
+		reference back(void) { return (data()[size() - 1]); }
+		const_reference back(void) const { return (data()[size() - 1]); }
+
+		/*************************** Modifiers *****************************/
+		void assign(size_type n, const value_type &val)
+		{
+			value_type copy(val); // val may be one of the elements overwritten
+
+			clear();
+			resize(n, copy);
+		}
+
+		template <class InputIterator>
+		void assign(InputIterator first, InputIterator last,
+			typename ft::enable_if<!ft::is_integral<InputIterator>::value, int>::type = 0)
+		{
+			clear();
+			insert(end(), first, last);
+		}
+
+		void push_back(const value_type &val)
+		{
+			if (size() == capacity())
+			{
+				value_type copy(val); // val may be an element, and the file move
+				remap(grow_to(size() + 1));
+				data()[size()] = copy;
+			}
+			else
+				data()[size()] = val;
+			head().size++;
+		}
+
+		void pop_back(void)
+		{
+			if (size())
+				head().size--;
+		}
+
+		iterator insert(iterator position, const value_type &val)
+		{
+			size_type index = position - begin();
+
+			insert(position, 1, val);
+			return (iterator(data() + index));
+		}
+
+		void insert(iterator position, size_type n, const value_type &val)
+		{
+			size_type index = position - begin();
+			value_type copy(val); // val may be an element, and the file move
+
+			if (n == 0)
+				return;
+			make_room(n);
+			ft::insert_in_place_n(_alloc, data(), size(), index, n, copy);
+			head().size += n;
+		}
+
+		/** As vector::insert(): forward ranges are measured first, input ranges rotated in.*/
+		template <class InputIterator>
+		void insert(iterator position, InputIterator first, InputIterator last,
+			typename ft::enable_if<!ft::is_integral<InputIterator>::value, int>::type = 0)
+		{
+			insert_range(position - begin(), first, last,
+				typename ft::iterator_traits<InputIterator>::iterator_category());
+		}
+
+		iterator erase(iterator position)
+		{
+			return (erase(position, position + 1));
+		}
+
+		iterator erase(iterator first, iterator last)
+		{
+			size_type index = first - begin();
+			size_type n = last - first;
+
+			ft::shift_down(_alloc, data(), size(), index, n);
+			head().size -= n;
+			return (first);
+		}
+
+		/** Exchanges the files.*/
+		void swap(mapped_vector &x)
+		{
+			_path.swap(x._path);
+			std::swap(_fd, x._fd);
+			std::swap(_base, x._base);
+			std::swap(_bytes, x._bytes);
+		}
+
+		/** Keeps the file size (see shrink_to_fit()).*/
+		void clear(void)
+		{
+			head().size = 0;
+		}
+
+		/*************************** File *****************************/
+		const std::string &path(void) const { return (_path); }
+
+		/** Starts writing the modified pages back, without waiting.*/
+		void flush(void)
+		{
+			errno = 0;
+			if (msync(_base, _bytes, MS_ASYNC) != 0)
+				mapped_format::fail("cannot flush", _path.c_str());
+		}
+
+		/** Writes the modified pages back and waits until they are on disk.*/
+		void sync(void)
+		{
+			errno = 0;
+			if (msync(_base, _bytes, MS_SYNC) != 0)
+				mapped_format::fail("cannot sync", _path.c_str());
+		}
+
+			private:
+		std::string					_path;
+		int							_fd;
+		char						*_base;
+		size_t						_bytes;	// file size
+		std::allocator<value_type>	_alloc;	// bulk helpers only
+
+		mapped_vector(const mapped_vector &);
+		mapped_vector &operator=(const mapped_vector &);
+
+		static const char *magic(void)
+		{
+			return ("ftvec01");
+		}
+
+		static size_t data_offset(void)
+		{
+			return (mapped_format::align(sizeof(mapped_vector_header)));
+		}
+
+		mapped_vector_header &head(void) { return (*reinterpret_cast<mapped_vector_header *>(_base)); }
+		const mapped_vector_header &head(void) const { return (*reinterpret_cast<const mapped_vector_header *>(_base)); }
+		value_type *data(void) { return (reinterpret_cast<value_type *>(_base + data_offset())); }
+		const value_type *data(void) const { return (reinterpret_cast<const value_type *>(_base + data_offset())); }
+
+		void init_head(void)
+		{
+			std::memset(_base, 0, data_offset());
+			std::memcpy(head().magic, magic(), 8);
+			head().layout = mapped_format::layout();
+			head().element_size = sizeof(T);
+		}
+
+		bool valid(void) const
+		{
+			return (_bytes >= data_offset() && std::memcmp(head().magic, magic(), 8) == 0 && head().layout == mapped_format::layout()
+				&& head().element_size == sizeof(T) && head().size <= capacity());
+		}
+
+		void fail_open(const char *what)
+		{
+			int error = errno;
+
+			::close(_fd);
+			errno = error;
+			mapped_format::fail(what, _path.c_str());
+		}
+
+		/** Capacity to hold needed elements, from the growth policy.*/
+		size_type grow_to(size_type needed) const
+		{
+			return (Growth::grow(capacity(), needed, sizeof(value_type)));
+		}
+
+		/** Resizes the file to n elements and maps it again.*/
+		void remap(size_type n)
+		{
+			size_t bytes = data_offset() + n * sizeof(T);
+
+			errno = 0;
+			if (bytes > _bytes && ftruncate(_fd, bytes) != 0)
+				mapped_format::fail("cannot extend", _path.c_str());
+			void *base = mremap(_base, _bytes, bytes, MREMAP_MAYMOVE);
+			if (base == MAP_FAILED)
+				mapped_format::fail("cannot map", _path.c_str());
+			_base = static_cast<char *>(base);
+			if (bytes < _bytes && ftruncate(_fd, bytes) != 0)
+			{
+				_bytes = bytes;
+				mapped_format::fail("cannot truncate", _path.c_str());
+			}
+			_bytes = bytes;
+		}
+
+		/** Grows the file, if needed, to hold n more elements.*/
+		void make_room(size_type n)
+		{
+			if (size() + n > capacity())
+				remap(grow_to(size() + n));
+		}
+
+		template <class ForwardIterator>
+		void insert_range(size_type index, ForwardIterator first, ForwardIterator last, std::forward_iterator_tag)
+		{
+			size_type n = ft::distance(first, last);
+
+			if (n == 0)
+				return;
+			make_room(n);
+			ft::insert_in_place(_alloc, data(), size(), index, first, n);
+			head().size += n;
+		}
+
+		template <class InputIterator>
+		void insert_range(size_type index, InputIterator first, InputIterator last, std::input_iterator_tag)
+		{
+			ft::insert_by_rotation(*this, index, first, last);
+		}
+	};
+
+	/*************************** Relational operators *****************************/
+	template <class T, class Growth>
+	bool operator==(const mapped_vector<T, Growth> &lhs, const mapped_vector<T, Growth> &rhs)
+	{
+		return (lhs.size() == rhs.size() && ft::equal(lhs.begin(), lhs.end(), rhs.begin()));
+	}
+
+	template <class T, class Growth>
+	bool operator!=(const mapped_vector<T, Growth> &lhs, const mapped_vector<T, Growth> &rhs)
+	{
+		return (!(lhs == rhs));
+	}
+
+	template <class T, class Growth>
+	bool operator<(const mapped_vector<T, Growth> &lhs, const mapped_vector<T, Growth> &rhs)
+	{
+		return (ft::lexicographical_compare(lhs.begin(), lhs.end(), rhs.begin(), rhs.end()));
+	}
+
+	template <class T, class Growth>
+	bool operator<=(const mapped_vector<T, Growth> &lhs, const mapped_vector<T, Growth> &rhs)
+	{
+		return (!(rhs < lhs));
+	}
+
+	template <class T, class Growth>
+	bool operator>(const mapped_vector<T, Growth> &lhs, const mapped_vector<T, Growth> &rhs)
+	{
+		return (rhs < lhs);
+	}
+
+	template <class T, class Growth>
+	bool operator>=(const mapped_vector<T, Growth> &lhs, const mapped_vector<T, Growth> &rhs)
+	{
+		return (!(lhs < rhs));
+	}
+
+	template <class T, class Growth>
+	void swap(mapped_vector<T, Growth> &x, mapped_vector<T, Growth> &y)
+	{
+		x.swap(y);
+	}
+}
+
+#endif
@@ -0,0 +1,75 @@
+#ifndef PAGED_ITERATOR_HPP
+#define PAGED_ITERATOR_HPP
+
+#include "pair.hpp"
+#include <iterator>
+
+namespace ft{
+	/**
+	 * Forward iterator of ft::paged_map. It names an element by its leaf page
+	 * and slot, and holds a copy of it: the page itself may be evicted from
+	 * the pool while the iterator lives. Any insert or erase invalidates it.
+	 * @param Map The paged_map iterated.
+	*/
+	template<class Map>
+	class paged_iterator{
+		public:
+			typedef std::forward_iterator_tag iterator_category;
+			typedef ft::pair<typename Map::key_type, typename Map::mapped_type> value_type;
+			typedef const value_type* pointer;
+			typedef const value_type& reference;
+			typedef std::ptrdiff_t difference_type;
+			typedef typename Map::page_id page_id;
+
+			/** The past-the-end iterator of map.*/
+			paged_iterator(const Map *map = NULL) : _map(map), _page(0), _slot(0) {}
+
+			/** The element at slot of the leaf page, which must hold it.*/
+			paged_iterator(const Map *map, page_id page, size_t slot)
+				: _map(map), _page(page), _slot(slot){
+				if (_page)
+					_map->load(_page, _slot, _value);
+			}
+
+			//equality/inequality operators
+			bool operator==(paged_iterator const &other) const{
+				return (this->_page == other._page && this->_slot == other._slot);
+			}
+			bool operator!=(paged_iterator const &other) const{
+				return (!(*this == other));
+			}
+			//dereference
+			reference operator*() const{
+				return (this->_value);
+			}
+
+			pointer operator->() const{
+				return (&this->_value);
+			}
+			//increment
+			paged_iterator &operator++(){
+				if (this->_page)
+					this->_map->step_forward(this->_page, this->_slot, this->_value);
+				return (*this);
+			}
+			paged_iterator operator++(int){
+				paged_iterator copy(*this);
+				++(*this);
+				return (copy);
+			}
+
+			page_id page(void) const{
+				return (this->_page);
+			}
+
+			size_t slot(void) const{
+				return (this->_slot);
+			}
+	private:
+		const Map	*_map;
+		page_id		_page;	// 0 for end()
+		size_t		_slot;
+		value_type	_value;
+	};
+}
+#endif
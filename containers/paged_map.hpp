@@ -0,0 +1,556 @@
+#ifndef PAGED_MAP_HPP
+#define PAGED_MAP_HPP
+
+#include "paged_pool.hpp"
+#include "paged_iterator.hpp"
+#include "pair.hpp"
+#include <functional>
+#include <stdexcept>
+
+namespace ft
+{
+	/**
+	 * Sorted map stored in a file, for key spaces larger than the memory:
+	 * a B+tree whose nodes are the pages of a ft::paged_pool, so only the
+	 * pages the pool has room for are in memory at a time.
+	 *
+	 * A leaf page holds up to leaf_capacity() elements, keys and values in
+	 * two arrays, chained to its neighbours for iteration; an internal page
+	 * holds up to inner_capacity() keys separating its children. With 4 KiB
+	 * pages and int keys that is a few hundred children per page, so a
+	 * search reads 3 or 4 pages for a billion elements, the top ones almost
+	 * always in the pool. Leaves are split in half when full (appending to the
+	 * last leaf starts a new one instead, so ordered loads fill their pages);
+	 * a page is freed when it empties, not merged when it runs low (most
+	 * disk B-trees do the same: merges cost writes and rarely pay off), and
+	 * freed pages are reused.
+	 *
+	 * Iteration copies the elements out (see paged_iterator.hpp) and reads
+	 * ahead: entering a leaf asks the system to start reading the leaf
+	 * read_ahead positions further, so sequential scans do not wait on each
+	 * page.
+	 *
+	 * Keys and values are stored as their bytes, with the restrictions of
+	 * ft::mapped_map (trivially copyable, no pointers, same types and
+	 * comparison to read a file back). Not thread safe.
+	 * @param Key Type of keys.
+	 * @param Val Type of mapped values.
+	 * @param Compare Comparison object used to sort the keys.
+	*/
+	template <class Key, class Val, class Compare = std::less<Key> >
+	class paged_map
+	{
+		public:
+		/***************************Member Types*****************************/
+		typedef Key key_type;
+		typedef Val mapped_type;
+		typedef ft::pair<const Key, Val> value_type;
+		typedef Compare key_compare;
+		typedef paged_pool::page_id page_id;
+		typedef ft::paged_iterator<paged_map>							iterator;
+		typedef iterator												const_iterator;
+		typedef ptrdiff_t												difference_type;
+		typedef size_t													size_type;
+		/** Keys and values are memcpy'd in and out of the pages (see mapped_map::bytes_check).*/
+		typedef char bytes_check[sizeof(ft::static_check<ft::is_trivially_copyable<Key>::value && ft::is_trivially_copyable<Val>::value>)];
+
+		static const size_type max_height = 64;
+
+		/*************************** Coplien form *****************************/
+		/**
+		 * Opens the map stored at path, or creates an empty one there.
+		 * @param memory Budget of the buffer pool, in bytes.
+		 * @param read_ahead Leaves read ahead by iteration, 0 for none.
+		 * @throw std::runtime_error when the file cannot be opened, or holds
+		 * 		other key or value types; std::length_error when a page
+		 * 		cannot hold three keys and values.
+		*/
+		explicit paged_map(const char *path, size_type memory = 64 << 20,
+				size_type read_ahead = 8, const key_compare &comp = key_compare())
+			: _comp(comp), _pool(fits(path), memory, sizeof(Key), sizeof(Val)),
+			_read_ahead(read_ahead),
+			_scratch(round((inner_capacity() + 1) * sizeof(Key)) + (inner_capacity() + 2) * sizeof(page_id)) {}
+
+		/** Flushes the modified pages to the file, errors ignored.*/
+		~paged_map(void) {}
+
+		/*************************** Iterators *****************************/
+		iterator begin() const{
+			return (iterator(this, head().first, 0));
+		}
+
+		iterator end() const{
+			return (iterator(this));
+		}
+
+		/*************************** Capacity *****************************/
+		bool empty() const{
+			return (size() == 0);
+		}
+
+		size_type size() const{
+			return (head().size);
+		}
+
+		/** Elements in a leaf page.*/
+		static size_type leaf_capacity(void){
+			return ((paged_pool::page_size - sizeof(node) - 16) / (sizeof(Key) + sizeof(Val)));
+		}
+
+		/** Keys in an internal page, which has one more child.*/
+		static size_type inner_capacity(void){
+			return ((paged_pool::page_size - sizeof(node) - sizeof(page_id) - 16)
+				/ (sizeof(Key) + sizeof(page_id)));
+		}
+
+		/*************************** Element access *****************************/
+		/** A copy of the value mapped to k: pages are not kept in memory.*/
+		mapped_type at(const key_type &k) const{
+			iterator it = find(k);
+			if (it == end())
+				throw(std::out_of_range("paged_map::at"));
+			return (it->second);
+		}
+
+		/*************************** Modifiers *****************************/
+		/** Inserts val unless its key is already there. O(log n) page accesses.*/
+		ft::pair<iterator, bool> insert(const value_type &val){
+			return (put(val.first, val.second, false));
+		}
+
+		template <class InputIterator>
+		void insert(InputIterator first, InputIterator last){
+			for (; first != last; ++first)
+				put(first->first, first->second, false);
+		}
+
+		/** Inserts k mapped to v, or assigns v to the value already mapped to k.*/
+		ft::pair<iterator, bool> insert_or_assign(const key_type &k, const mapped_type &v){
+			return (put(k, v, true));
+		}
+
+		/** Removes the element of key k, if any. O(log n) page accesses.*/
+		size_type erase(const key_type &k){
+			step path[max_height];
+
+			if (!head().root)
+				return (0);
+			paged_pool::handle leaf = descend(k, path);
+			node &n = node_of(leaf);
+			Key *keys = leaf_keys(leaf);
+			size_type i = lower(keys, n.count, k);
+			if (i == n.count || _comp(k, keys[i]))
+				return (0);
+			std::memmove(keys + i, keys + i + 1, (n.count - i - 1) * sizeof(Key));
+			std::memmove(leaf_values(leaf) + i, leaf_values(leaf) + i + 1, (n.count - i - 1) * sizeof(Val));
+			n.count--;
+			leaf.dirty();
+			head().size--;
+			if (n.count)
+				return (1);
+			page_id page = leaf.id();
+			page_id next = n.next;
+			page_id prev = n.prev;
+			leaf = paged_pool::handle();
+			if (next){
+				paged_pool::handle h = _pool.fetch(next);
+				node_of(h).prev = prev;
+				h.dirty();
+			}
+			if (prev){
+				paged_pool::handle h = _pool.fetch(prev);
+				node_of(h).next = next;
+				h.dirty();
+			}
+			else
+				head().first = next;
+			_pool.release(page);
+			remove_child(path);
+			return (1);
+		}
+
+		void erase(iterator position){
+			erase(position->first);
+		}
+
+		/** Removes every element and shrinks the file to its header.*/
+		void clear(){
+			_pool.truncate();
+			head().root = 0;
+			head().height = 0;
+			head().size = 0;
+			head().first = 0;
+		}
+
+		/** Writes the modified pages to the file (also done on destruction).*/
+		void flush(){
+			_pool.flush();
+		}
+
+		/** flush(), then waits for the file to reach the disk.*/
+		void sync(){
+			_pool.sync();
+		}
+
+		/*************************** Observers *****************************/
+		key_compare key_comp() const{
+			return (_comp);
+		}
+
+		/** The buffer pool, for its statistics.*/
+		const paged_pool &pool() const{
+			return (_pool);
+		}
+
+		/*************************** Operations *****************************/
+		iterator find(const key_type &k) const{
+			if (!head().root)
+				return (end());
+			paged_pool::handle leaf = descend(k, NULL);
+			const Key *keys = leaf_keys(leaf);
+			size_type i = lower(keys, node_of(leaf).count, k);
+			if (i == node_of(leaf).count || _comp(k, keys[i]))
+				return (end());
+			return (iterator(this, leaf.id(), i));
+		}
+
+		size_type count(const key_type &k) const{
+			return (find(k) != end());
+		}
+
+		iterator lower_bound(const key_type &k) const{
+			if (!head().root)
+				return (end());
+			paged_pool::handle leaf = descend(k, NULL);
+			return (first_from(leaf, lower(leaf_keys(leaf), node_of(leaf).count, k)));
+		}
+
+		iterator upper_bound(const key_type &k) const{
+			if (!head().root)
+				return (end());
+			paged_pool::handle leaf = descend(k, NULL);
+			return (first_from(leaf, upper(leaf_keys(leaf), node_of(leaf).count, k)));
+		}
+
+		ft::pair<iterator, iterator> equal_range(const key_type &k) const{
+			return (ft::make_pair(lower_bound(k), upper_bound(k)));
+		}
+
+		private:
+		friend class ft::paged_iterator<paged_map>;
+
+		/* Head of every page. Leaves keep their keys, then their values,
+		internal pages their children, then their keys.*/
+		struct node
+		{
+			size_t	leaf;
+			size_t	count;	// elements, or keys of an internal page
+			page_id	next;	// neighbour leaves
+			page_id	prev;
+		};
+
+		/* A page on the path of a search, and the child taken.*/
+		struct step
+		{
+			page_id		page;
+			size_type	index;
+		};
+
+		key_compare			_comp;
+		mutable paged_pool	_pool;
+		size_type			_read_ahead;
+		ft::vector<char>	_scratch;	// an overfull internal page while it splits
+
+		paged_map(const paged_map &);
+		paged_map &operator=(const paged_map &);
+
+		static const char *fits(const char *path){
+			if (leaf_capacity() < 3 || inner_capacity() < 3)
+				throw(std::length_error("paged_map: key and value too large for a page"));
+			return (path);
+		}
+
+		static size_type round(size_type offset){
+			return ((offset + 15) / 16 * 16);
+		}
+
+		paged_header &head() const{
+			return (_pool.head());
+		}
+
+		static node &node_of(const paged_pool::handle &h){
+			return (*reinterpret_cast<node *>(h.data()));
+		}
+
+		static Key *leaf_keys(const paged_pool::handle &h){
+			return (reinterpret_cast<Key *>(h.data() + sizeof(node)));
+		}
+
+		static Val *leaf_values(const paged_pool::handle &h){
+			return (reinterpret_cast<Val *>(h.data()
+				+ round(sizeof(node) + leaf_capacity() * sizeof(Key))));
+		}
+
+		static page_id *children(const paged_pool::handle &h){
+			return (reinterpret_cast<page_id *>(h.data() + sizeof(node)));
+		}
+
+		static Key *inner_keys(const paged_pool::handle &h){
+			return (reinterpret_cast<Key *>(h.data()
+				+ round(sizeof(node) + (inner_capacity() + 1) * sizeof(page_id))));
+		}
+
+		/* First of the n keys not less than k.*/
+		size_type lower(const Key *keys, size_type n, const Key &k) const{
+			size_type lo = 0;
+
+			while (lo < n){
+				size_type mid = lo + (n - lo) / 2;
+				if (_comp(keys[mid], k))
+					lo = mid + 1;
+				else
+					n = mid;
+			}
+			return (lo);
+		}
+
+		/* First of the n keys greater than k.*/
+		size_type upper(const Key *keys, size_type n, const Key &k) const{
+			size_type lo = 0;
+
+			while (lo < n){
+				size_type mid = lo + (n - lo) / 2;
+				if (_comp(k, keys[mid]))
+					n = mid;
+				else
+					lo = mid + 1;
+			}
+			return (lo);
+		}
+
+		/* The leaf that holds k, or would; path gets the internal pages.*/
+		paged_pool::handle descend(const Key &k, step *path) const{
+			page_id page = head().root;
+
+			for (size_type level = 0; level < head().height; level++){
+				paged_pool::handle h = _pool.fetch(page);
+				size_type i = upper(inner_keys(h), node_of(h).count, k);
+				if (path){
+					path[level].page = page;
+					path[level].index = i;
+				}
+				page = children(h)[i];
+			}
+			return (_pool.fetch(page));
+		}
+
+		/* The element at slot i of leaf, or the first of the next leaf.*/
+		iterator first_from(const paged_pool::handle &leaf, size_type i) const{
+			if (i < node_of(leaf).count)
+				return (iterator(this, leaf.id(), i));
+			return (iterator(this, node_of(leaf).next, 0));
+		}
+
+		void load(page_id page, size_type slot, typename iterator::value_type &value) const{
+			paged_pool::handle h = _pool.fetch(page);
+
+			value.first = leaf_keys(h)[slot];
+			value.second = leaf_values(h)[slot];
+		}
+
+		/* Moves an iterator to the next element.*/
+		void step_forward(page_id &page, size_type &slot, typename iterator::value_type &value) const{
+			paged_pool::handle h = _pool.fetch(page);
+
+			if (++slot < node_of(h).count){
+				value.first = leaf_keys(h)[slot];
+				value.second = leaf_values(h)[slot];
+				return;
+			}
+			page = node_of(h).next;
+			slot = 0;
+			h = paged_pool::handle();
+			if (!page)
+				return;
+			load(page, 0, value);
+			if (_read_ahead)
+				read_ahead(value.first);
+		}
+
+		/* Advises the leaf read_ahead places after the leaf of k, or all of
+		the first read_ahead leaves when it starts a parent.*/
+		void read_ahead(const Key &k) const{
+			if (!head().height)
+				return;
+			page_id page = head().root;
+			for (size_type level = 0; level + 1 < head().height; level++){
+				paged_pool::handle h = _pool.fetch(page);
+				page = children(h)[upper(inner_keys(h), node_of(h).count, k)];
+			}
+			paged_pool::handle parent = _pool.fetch(page);
+			size_type count = node_of(parent).count + 1;
+			size_type i = upper(inner_keys(parent), count - 1, k);
+			size_type from = i ? i + _read_ahead : i + 1;
+			for (size_type j = from; j <= i + _read_ahead && j < count; j++)
+				_pool.advise(children(parent)[j]);
+		}
+
+		ft::pair<iterator, bool> put(const Key &k, const Val &v, bool assign){
+			step path[max_height];
+
+			if (!head().root){
+				paged_pool::handle h = _pool.allocate();
+				node_of(h).leaf = 1;
+				head().root = h.id();
+				head().first = h.id();
+				head().height = 0;
+			}
+			paged_pool::handle leaf = descend(k, path);
+			size_type i = lower(leaf_keys(leaf), node_of(leaf).count, k);
+			if (i < node_of(leaf).count && !_comp(k, leaf_keys(leaf)[i])){
+				if (assign){
+					leaf_values(leaf)[i] = v;
+					leaf.dirty();
+				}
+				return (ft::make_pair(iterator(this, leaf.id(), i), false));
+			}
+			page_id split = 0;
+			if (node_of(leaf).count == leaf_capacity()){
+				// appending to the last leaf starts a new one and leaves it full
+				size_type keep = i == leaf_capacity() && !node_of(leaf).next ? i : leaf_capacity() / 2;
+				paged_pool::handle right = split_leaf(leaf, keep);
+				split = right.id();
+				if (i > keep || keep == leaf_capacity()){
+					i -= keep;
+					leaf = right;
+				}
+			}
+			node &n = node_of(leaf);
+			std::memmove(leaf_keys(leaf) + i + 1, leaf_keys(leaf) + i, (n.count - i) * sizeof(Key));
+			std::memmove(leaf_values(leaf) + i + 1, leaf_values(leaf) + i, (n.count - i) * sizeof(Val));
+			leaf_keys(leaf)[i] = k;
+			leaf_values(leaf)[i] = v;
+			n.count++;
+			leaf.dirty();
+			head().size++;
+			page_id page = leaf.id();
+			leaf = paged_pool::handle();
+			if (split){
+				paged_pool::handle right = _pool.fetch(split);
+				Key separator = leaf_keys(right)[0];
+				right = paged_pool::handle();
+				insert_child(path, separator, split);
+			}
+			return (ft::make_pair(iterator(this, page, i), true));
+		}
+
+		/* Moves the elements of the full leaf after the first keep to a new
+		leaf after it.*/
+		paged_pool::handle split_leaf(paged_pool::handle &leaf, size_type keep){
+			paged_pool::handle right = _pool.allocate();
+			node &l = node_of(leaf);
+			node &r = node_of(right);
+
+			r.leaf = 1;
+			r.count = l.count - keep;
+			std::memcpy(leaf_keys(right), leaf_keys(leaf) + keep, r.count * sizeof(Key));
+			std::memcpy(leaf_values(right), leaf_values(leaf) + keep, r.count * sizeof(Val));
+			l.count = keep;
+			r.next = l.next;
+			r.prev = leaf.id();
+			l.next = right.id();
+			if (r.next){
+				paged_pool::handle next = _pool.fetch(r.next);
+				node_of(next).prev = right.id();
+				next.dirty();
+			}
+			leaf.dirty();
+			return (right);
+		}
+
+		/* Adds child after the child taken by path at the lowest internal
+		level, separated by key, splitting the full pages up to the root.*/
+		void insert_child(const step *path, Key key, page_id child){
+			size_type capacity = inner_capacity();
+			Key *keys = reinterpret_cast<Key *>(&_scratch[0]);
+			page_id *kids = reinterpret_cast<page_id *>(&_scratch[0] + round((capacity + 1) * sizeof(Key)));
+
+			for (size_type level = head().height; level-- > 0; ){
+				paged_pool::handle h = _pool.fetch(path[level].page);
+				node &n = node_of(h);
+				size_type i = path[level].index;
+				h.dirty();
+				if (n.count < capacity){
+					std::memmove(inner_keys(h) + i + 1, inner_keys(h) + i, (n.count - i) * sizeof(Key));
+					std::memmove(children(h) + i + 2, children(h) + i + 1, (n.count - i) * sizeof(page_id));
+					inner_keys(h)[i] = key;
+					children(h)[i + 1] = child;
+					n.count++;
+					return;
+				}
+				// capacity + 1 keys: the middle one goes up, the rest is split
+				std::memcpy(keys, inner_keys(h), i * sizeof(Key));
+				keys[i] = key;
+				std::memcpy(keys + i + 1, inner_keys(h) + i, (n.count - i) * sizeof(Key));
+				std::memcpy(kids, children(h), (i + 1) * sizeof(page_id));
+				kids[i + 1] = child;
+				std::memcpy(kids + i + 2, children(h) + i + 1, (n.count - i) * sizeof(page_id));
+				size_type mid = (capacity + 1) / 2;
+				paged_pool::handle right = _pool.allocate();
+				node_of(right).count = capacity - mid;
+				std::memcpy(inner_keys(right), keys + mid + 1, (capacity - mid) * sizeof(Key));
+				std::memcpy(children(right), kids + mid + 1, (capacity - mid + 1) * sizeof(page_id));
+				n.count = mid;
+				std::memcpy(inner_keys(h), keys, mid * sizeof(Key));
+				std::memcpy(children(h), kids, (mid + 1) * sizeof(page_id));
+				key = keys[mid];
+				child = right.id();
+			}
+			paged_pool::handle root = _pool.allocate();
+			node_of(root).count = 1;
+			inner_keys(root)[0] = key;
+			children(root)[0] = head().root;
+			children(root)[1] = child;
+			head().root = root.id();
+			head().height++;
+		}
+
+		/* Removes the child taken by path at the lowest internal level, which
+		was freed, freeing the pages left without children, then the roots
+		left with one child.*/
+		void remove_child(const step *path){
+			for (size_type level = head().height; level-- > 0; ){
+				paged_pool::handle h = _pool.fetch(path[level].page);
+				node &n = node_of(h);
+				size_type c = path[level].index;
+				if (n.count == 0){
+					h = paged_pool::handle();
+					_pool.release(path[level].page);
+					continue;
+				}
+				size_type k = c ? c - 1 : 0;
+				std::memmove(inner_keys(h) + k, inner_keys(h) + k + 1, (n.count - 1 - k) * sizeof(Key));
+				std::memmove(children(h) + c, children(h) + c + 1, (n.count - c) * sizeof(page_id));
+				n.count--;
+				h.dirty();
+				while (head().height){
+					paged_pool::handle root = _pool.fetch(head().root);
+					if (node_of(root).count)
+						return;
+					page_id only = children(root)[0];
+					page_id page = root.id();
+					root = paged_pool::handle();
+					_pool.release(page);
+					head().root = only;
+					head().height--;
+				}
+				return;
+			}
+			head().root = 0;
+			head().height = 0;
+			head().first = 0;
+		}
+	};
+}
+
+#endif
@@ -0,0 +1,395 @@
+#ifndef PAGED_POOL_HPP
+#define PAGED_POOL_HPP
+
+#include "mapped_file.hpp"
+#include "vector.hpp"
+
+/*
+File of fixed size pages behind ft::paged_map, and the buffer pool that keeps
+a bounded number of them in memory.
+
+	page 0			header (paged_header), rest unused
+	pages 1...		tree pages, or free pages chained through their first
+					word (head of the chain in the header)
+
+The pool holds memory / page_size frames. A page is read into a frame by
+fetch() and stays there, at the same address, while a handle pins it; the
+least recently used unpinned frame is reused for the next miss, after its
+page is written back if it was modified. Nothing is written before flush()
+or eviction, so the file is only consistent after flush() (the destructor
+flushes); a crash in between can leave it corrupt.
+*/
+
+namespace ft
+{
+	struct paged_header
+	{
+		char	magic[8];
+		size_t	layout;		// byte order and word size of the writer
+		size_t	page_size;
+		size_t	key_size;
+		size_t	value_size;
+		size_t	pages;		// pages in the file, this one included
+		size_t	free;		// first free page, 0 if none
+		size_t	root;		// root page, 0 for an empty tree
+		size_t	height;		// levels of internal pages above the leaves
+		size_t	size;		// elements
+		size_t	first;		// leftmost leaf
+	};
+
+	class paged_pool
+	{
+	public:
+		typedef size_t page_id;
+
+		static const size_t page_size = 4096;
+		static const size_t min_frames = 16;
+
+		/** A pinned page: it is not evicted while a handle to it lives.*/
+		class handle
+		{
+		public:
+			handle(void) : _pool(NULL), _frame(0) {}
+
+			handle(const handle &src) : _pool(src._pool), _frame(src._frame)
+			{
+				if (_pool)
+					_pool->_frames[_frame].pins++;
+			}
+
+			~handle(void)
+			{
+				release();
+			}
+
+			handle &operator=(const handle &other)
+			{
+				if (other._pool)
+					other._pool->_frames[other._frame].pins++;
+				release();
+				_pool = other._pool;
+				_frame = other._frame;
+				return (*this);
+			}
+
+			page_id id(void) const { return (_pool->_frames[_frame].page); }
+			char *data(void) const { return (_pool->frame_data(_frame)); }
+
+			/** Marks the page modified: it is written back before its frame is reused.*/
+			void dirty(void) const { _pool->_frames[_frame].dirty = true; }
+
+		private:
+			friend class paged_pool;
+
+			paged_pool	*_pool;
+			size_t		_frame;
+
+			handle(paged_pool *pool, size_t frame) : _pool(pool), _frame(frame)
+			{
+				_pool->_frames[_frame].pins++;
+			}
+
+			void release(void)
+			{
+				if (_pool)
+					_pool->_frames[_frame].pins--;
+				_pool = NULL;
+			}
+		};
+
+		/**
+		 * Opens the file at path, creating it if needed, with a pool of about
+		 * memory bytes (at least min_frames pages).
+		 * @throw std::runtime_error when the file cannot be opened, or was
+		 * 		written with other key or value sizes.
+		*/
+		paged_pool(const char *path, size_t memory, size_t key_size, size_t value_size)
+			: _path(path), _fd(-1), _hits(0), _misses(0), _writes(0)
+		{
+			size_t frames = memory / page_size < min_frames ? (size_t)min_frames : memory / page_size;
+			size_t buckets = 1;
+
+			while (buckets < 2 * frames)
+				buckets *= 2;
+			_mask = buckets - 1;
+			_buckets.assign(buckets, 0);
+			_frames.resize(frames + 1);	// the last one heads the LRU list
+			_memory.resize(frames * page_size);
+			for (size_t f = 0; f <= frames; f++)
+			{
+				_frames[f].prev = f ? f - 1 : frames;
+				_frames[f].next = f < frames ? f + 1 : 0;
+			}
+			open(key_size, value_size);
+		}
+
+		~paged_pool(void)
+		{
+			try
+			{
+				flush();
+			}
+			catch (std::exception &)
+			{
+			}
+			::close(_fd);
+		}
+
+		paged_header &head(void) { return (_head); }
+		const paged_header &head(void) const { return (_head); }
+
+		/** Pins page, reading it from the file on a miss.*/
+		handle fetch(page_id page)
+		{
+			size_t f = lookup(page);
+
+			if (f != npos)
+			{
+				_hits++;
+				touch(f);
+				return (handle(this, f));
+			}
+			_misses++;
+			f = reuse();
+			errno = 0;
+			if (pread(_fd, frame_data(f), page_size, page * page_size) != (ssize_t)page_size)
+				mapped_format::fail("cannot read", _path.c_str());
+			attach(f, page);
+			return (handle(this, f));
+		}
+
+		/** A new zeroed page, taken from the free pages or added to the file.*/
+		handle allocate(void)
+		{
+			if (_head.free)
+			{
+				handle h = fetch(_head.free);
+				std::memcpy(&_head.free, h.data(), sizeof(page_id));
+				std::memset(h.data(), 0, page_size);
+				h.dirty();
+				return (h);
+			}
+			size_t f = reuse();
+			std::memset(frame_data(f), 0, page_size);
+			attach(f, _head.pages++);
+			_frames[f].dirty = true;
+			return (handle(this, f));
+		}
+
+		/** Gives page back to the free pages.*/
+		void release(page_id page)
+		{
+			handle h = fetch(page);
+
+			std::memset(h.data(), 0, page_size);
+			std::memcpy(h.data(), &_head.free, sizeof(page_id));
+			h.dirty();
+			_head.free = page;
+		}
+
+		/** Asks the system to start reading page, if it is not in the pool.*/
+		void advise(page_id page) const
+		{
+			if (lookup(page) == npos)
+				posix_fadvise(_fd, page * page_size, page_size, POSIX_FADV_WILLNEED);
+		}
+
+		/** Writes the modified pages and the header to the file.*/
+		void flush(void)
+		{
+			for (size_t f = 0; f + 1 < _frames.size(); f++)
+				write_back(f);
+			errno = 0;
+			if (pwrite(_fd, &_head, sizeof(_head), 0) != (ssize_t)sizeof(_head))
+				mapped_format::fail("cannot write", _path.c_str());
+		}
+
+		/** flush(), then waits for the data to reach the disk.*/
+		void sync(void)
+		{
+			flush();
+			errno = 0;
+			if (fdatasync(_fd) != 0)
+				mapped_format::fail("cannot sync", _path.c_str());
+		}
+
+		/** Empties the file: every page but the header is dropped.*/
+		void truncate(void)
+		{
+			for (size_t f = 0; f + 1 < _frames.size(); f++)
+			{
+				if (_frames[f].page)
+					detach(f);
+				_frames[f].dirty = false;
+			}
+			_head.pages = 1;
+			_head.free = 0;
+			errno = 0;
+			if (ftruncate(_fd, page_size) != 0)
+				mapped_format::fail("cannot truncate", _path.c_str());
+		}
+
+		size_t frames(void) const { return (_frames.size() - 1); }
+		/** Fetches served from memory, and read from the file.*/
+		size_t hits(void) const { return (_hits); }
+		size_t misses(void) const { return (_misses); }
+		/** Pages written back.*/
+		size_t writes(void) const { return (_writes); }
+
+	private:
+		static const size_t npos = (size_t)-1;
+
+		struct frame
+		{
+			page_id	page;	// 0 when empty
+			size_t	pins;
+			bool	dirty;
+			size_t	prev;	// LRU list, most recent first
+			size_t	next;
+			size_t	chain;	// next frame of the same bucket, plus one
+
+			frame(void) : page(0), pins(0), dirty(false), prev(0), next(0), chain(0) {}
+		};
+
+		std::string			_path;
+		int					_fd;
+		paged_header		_head;
+		ft::vector<frame>	_frames;
+		ft::vector<char>	_memory;
+		ft::vector<size_t>	_buckets;	// first frame of each bucket, plus one
+		size_t				_mask;
+		size_t				_hits;
+		size_t				_misses;
+		size_t				_writes;
+
+		paged_pool(const paged_pool &);
+		paged_pool &operator=(const paged_pool &);
+
+		static const char *magic(void)
+		{
+			return ("ftpage1");
+		}
+
+		void open(size_t key_size, size_t value_size)
+		{
+			struct stat st;
+			paged_header expected;
+
+			std::memset(&expected, 0, sizeof(expected));
+			std::memcpy(expected.magic, magic(), 8);
+			expected.layout = mapped_format::layout();
+			expected.page_size = page_size;
+			expected.key_size = key_size;
+			expected.value_size = value_size;
+			expected.pages = 1;
+			errno = 0;
+			_fd = ::open(_path.c_str(), O_RDWR | O_CREAT, 0644);
+			if (_fd < 0)
+				mapped_format::fail("cannot open", _path.c_str());
+			if (fstat(_fd, &st) != 0)
+				fail_open("cannot open");
+			if (st.st_size == 0)
+			{
+				_head = expected;
+				if (ftruncate(_fd, page_size) != 0)
+					fail_open("cannot size");
+				return;
+			}
+			if (pread(_fd, &_head, sizeof(_head), 0) != (ssize_t)sizeof(_head)
+				|| std::memcmp(&_head, &expected, offsetof(paged_header, pages)) != 0)
+			{
+				errno = 0;
+				fail_open("wrong format, types or page size");
+			}
+		}
+
+		void fail_open(const char *what)
+		{
+			int error = errno;
+
+			::close(_fd);
+			errno = error;
+			mapped_format::fail(what, _path.c_str());
+		}
+
+		char *frame_data(size_t f)
+		{
+			return (&_memory[0] + f * page_size);
+		}
+
+		size_t bucket(page_id page) const
+		{
+			return ((page * 2654435761u) & _mask);
+		}
+
+		size_t lookup(page_id page) const
+		{
+			for (size_t f = _buckets[bucket(page)]; f; f = _frames[f - 1].chain)
+				if (_frames[f - 1].page == page)
+					return (f - 1);
+			return (npos);
+		}
+
+		/** Moves f to the front of the LRU list.*/
+		void touch(size_t f)
+		{
+			size_t head = frames();
+
+			_frames[_frames[f].prev].next = _frames[f].next;
+			_frames[_frames[f].next].prev = _frames[f].prev;
+			_frames[f].prev = head;
+			_frames[f].next = _frames[head].next;
+			_frames[_frames[head].next].prev = f;
+			_frames[head].next = f;
+		}
+
+		/** The least recently used unpinned frame, emptied.*/
+		size_t reuse(void)
+		{
+			size_t head = frames();
+
+			for (size_t f = _frames[head].prev; f != head; f = _frames[f].prev)
+				if (!_frames[f].pins)
+				{
+					write_back(f);
+					if (_frames[f].page)
+						detach(f);
+					return (f);
+				}
+			throw std::runtime_error("paged_pool: every frame is pinned");
+		}
+
+		void write_back(size_t f)
+		{
+			if (!_frames[f].dirty)
+				return;
+			errno = 0;
+			if (pwrite(_fd, frame_data(f), page_size, _frames[f].page * page_size) != (ssize_t)page_size)
+				mapped_format::fail("cannot write", _path.c_str());
+			_frames[f].dirty = false;
+			_writes++;
+		}
+
+		void attach(size_t f, page_id page)
+		{
+			size_t b = bucket(page);
+
+			_frames[f].page = page;
+			_frames[f].chain = _buckets[b];
+			_buckets[b] = f + 1;
+			touch(f);
+		}
+
+		void detach(size_t f)
+		{
+			size_t *link = &_buckets[bucket(_frames[f].page)];
+
+			while (*link != f + 1)
+				link = &_frames[*link - 1].chain;
+			*link = _frames[f].chain;
+			_frames[f].page = 0;
+		}
+	};
+}
+
+#endif
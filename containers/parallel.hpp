@@ -0,0 +1,256 @@
+#ifndef PARALLEL_HPP
+#define PARALLEL_HPP
+
+#include <pthread.h>
+#include <unistd.h>
+#include <algorithm>
+#include <new>
+#include <cstddef>
+
+/*
+Fork-join helpers for the parallel members of the containers (bulk builds and
+the like): a thread count tag, a task run on its own thread, a stable parallel
+sort, and background jobs for work nobody waits on.
+
+Work is split recursively, each split handing half of its threads to a forked
+task and keeping the other half, so n threads cost log2(n) levels of forks and
+no pool. A task that throws on another thread cannot carry its exception over
+(C++98): its fork reports the failure and the caller throws std::bad_alloc,
+allocation being what tasks are expected to fail on.
+*/
+
+namespace ft
+{
+	/**
+	 * Thread count tag selecting the parallel overloads, as in
+	 * ft::map<K, V> m(v.begin(), v.end(), ft::parallel(8)).
+	 * @param threads Threads to use, 0 for one per online core.
+	*/
+	struct parallel
+	{
+		size_t	threads;
+
+		explicit parallel(size_t threads = 0) : threads(threads ? threads : hardware_threads()) {}
+
+		static size_t hardware_threads(void)
+		{
+			long n = sysconf(_SC_NPROCESSORS_ONLN);
+			return (n > 0 ? n : 1);
+		}
+	};
+
+	/**
+	 * Runs task() on a new thread, joined by join() or the destructor. Runs it
+	 * right away on the calling thread if no thread can be created.
+	 * @param Task A function object, kept by reference.
+	*/
+	template <class Task>
+	class fork_task
+	{
+	public:
+		fork_task(Task &task) : _task(task), _failed(false)
+		{
+			_started = pthread_create(&_thread, NULL, &run, this) == 0;
+			if (!_started)
+				run(this);
+		}
+
+		~fork_task(void)
+		{
+			join();
+		}
+
+		/** Waits for the task. @return false if it threw.*/
+		bool join(void)
+		{
+			if (_started)
+				pthread_join(_thread, NULL);
+			_started = false;
+			return (!_failed);
+		}
+
+	private:
+		Task		&_task;
+		pthread_t	_thread;
+		bool		_started;
+		bool		_failed;
+
+		fork_task(const fork_task &);
+		fork_task &operator=(const fork_task &);
+
+		static void *run(void *arg)
+		{
+			fork_task *self = static_cast<fork_task *>(arg);
+
+			try
+			{
+				self->_task();
+			}
+			catch (...)
+			{
+				self->_failed = true;
+			}
+			return (NULL);
+		}
+	};
+
+	/**
+	 * Tag handing work over to a background thread, as in
+	 * map.clear(ft::background()), which frees the nodes after returning.
+	 * wait() returns once every job handed over so far is done: call it
+	 * before exit when the memory must be back (leak checkers, tests).
+	*/
+	struct background
+	{
+		/** Runs (*job)(), then deletes job, on a detached thread if one can be created.*/
+		template <class Job>
+		static void run(Job *job)
+		{
+			pthread_attr_t	attr;
+			pthread_t		thread;
+			bool			started = false;
+
+			pending(1);
+			if (pthread_attr_init(&attr) == 0)
+			{
+				pthread_attr_setdetachstate(&attr, PTHREAD_CREATE_DETACHED);
+				started = pthread_create(&thread, &attr, &start<Job>, job) == 0;
+				pthread_attr_destroy(&attr);
+			}
+			if (!started)
+				start<Job>(job);
+		}
+
+		/** Waits until no job is left.*/
+		static void wait(void)
+		{
+			pthread_mutex_lock(&mutex());
+			while (count() != 0)
+				pthread_cond_wait(&done(), &mutex());
+			pthread_mutex_unlock(&mutex());
+		}
+
+	private:
+		template <class Job>
+		static void *start(void *arg)
+		{
+			Job *job = static_cast<Job *>(arg);
+
+			try
+			{
+				(*job)();
+			}
+			catch (...)
+			{
+			}
+			delete job;
+			pending(-1);
+			return (NULL);
+		}
+
+		static void pending(int n)
+		{
+			pthread_mutex_lock(&mutex());
+			count() += n;
+			if (count() == 0)
+				pthread_cond_broadcast(&done());
+			pthread_mutex_unlock(&mutex());
+		}
+
+		static pthread_mutex_t &mutex(void)
+		{
+			static pthread_mutex_t m = PTHREAD_MUTEX_INITIALIZER;
+			return (m);
+		}
+
+		static pthread_cond_t &done(void)
+		{
+			static pthread_cond_t c = PTHREAD_COND_INITIALIZER;
+			return (c);
+		}
+
+		static size_t &count(void)
+		{
+			static size_t n = 0;
+			return (n);
+		}
+	};
+
+	/* Below this many elements, a range is not worth a thread.*/
+	static const size_t parallel_grain = 4096;
+
+	template <class RandomIt, class Compare>
+	void parallel_sort(RandomIt first, RandomIt last, Compare comp, size_t threads);
+
+	template <class RandomIt, class Compare>
+	struct sort_task
+	{
+		RandomIt	first;
+		RandomIt	last;
+		Compare		comp;
+		size_t		threads;
+
+		sort_task(RandomIt first, RandomIt last, Compare comp, size_t threads)
+			: first(first), last(last), comp(comp), threads(threads) {}
+
+		void operator()(void)
+		{
+			parallel_sort(first, last, comp, threads);
+		}
+	};
+
+	/**
+	 * Stable sort of [first, last) by up to threads threads: both halves are
+	 * sorted concurrently, then merged.
+	*/
+	template <class RandomIt, class Compare>
+	void parallel_sort(RandomIt first, RandomIt last, Compare comp, size_t threads)
+	{
+		if (threads < 2 || (size_t)(last - first) < parallel_grain)
+		{
+			std::stable_sort(first, last, comp);
+			return;
+		}
+		RandomIt mid = first + (last - first) / 2;
+		sort_task<RandomIt, Compare> left(first, mid, comp, threads / 2);
+		fork_task<sort_task<RandomIt, Compare> > fork(left);
+
+		parallel_sort(mid, last, comp, threads - threads / 2);
+		if (!fork.join())
+			throw std::bad_alloc();
+		std::inplace_merge(first, mid, last, comp);
+	}
+
+	/* Compares what two pointers point to.*/
+	template <class T, class Compare>
+	struct indirect_compare
+	{
+		Compare	comp;
+
+		indirect_compare(Compare comp) : comp(comp) {}
+
+		bool operator()(const T *a, const T *b) const
+		{
+			return (comp(*a, *b));
+		}
+	};
+
+	/**
+	 * Sorts the pointers by what they point to, stable, then keeps only the
+	 * first of every run of equivalent ones, as successive inserts would.
+	 * @return The number of pointers kept, at the front.
+	*/
+	template <class T, class Compare>
+	size_t sort_unique(const T **values, size_t n, Compare comp, size_t threads)
+	{
+		size_t kept = 0;
+
+		parallel_sort(values, values + n, indirect_compare<T, Compare>(comp), threads);
+		for (size_t i = 0; i < n; i++)
+			if (kept == 0 || comp(*values[kept - 1], *values[i]))
+				values[kept++] = values[i];
+		return (kept);
+	}
+}
+
+#endif
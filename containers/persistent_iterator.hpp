@@ -0,0 +1,131 @@
+#ifndef PERSISTENT_ITERATOR_HPP
+#define PERSISTENT_ITERATOR_HPP
+
+#include "../rbtree/PersistentTree.hpp"
+#include <iterator>
+
+namespace ft{
+	/**
+	 * Bidirectional iterator of ft::persistent_map. Shared nodes have no
+	 * parent pointer, so the iterator keeps the path from the root to its
+	 * element. The path holds at most max_depth nodes, the height of an AVL
+	 * tree of about 2^44 elements. The elements are read only: they may be
+	 * shared with other versions.
+	 * @param T Type of the elements.
+	*/
+	template<class T>
+	class persistent_iterator{
+		public:
+			typedef std::bidirectional_iterator_tag iterator_category;
+			typedef T value_type;
+			typedef const T* pointer;
+			typedef const T& reference;
+			typedef std::ptrdiff_t difference_type;
+			typedef ft::PersistentNode<T> node_type;
+
+			static const int max_depth = 64;
+
+			/** The past-the-end iterator of the tree of root.*/
+			persistent_iterator(const node_type *root = NULL) : _root(root), _depth(0) {}
+
+			persistent_iterator(persistent_iterator const &src){
+				*this = src;
+			}
+
+			~persistent_iterator(void){}
+
+			persistent_iterator &operator=(persistent_iterator const &other){
+				this->_root = other._root;
+				this->_depth = other._depth;
+				for (int i = 0; i < this->_depth; i++)
+					this->_path[i] = other._path[i];
+				return (*this);
+			}
+			//equality/inequality operators
+			bool operator==(persistent_iterator const &other) const{
+				return (this->_root == other._root && this->node() == other.node());
+			}
+			bool operator!=(persistent_iterator const &other) const{
+				return (!(*this == other));
+			}
+			//dereference
+			reference operator*() const{
+				return (this->node()->value);
+			}
+
+			pointer operator->() const{
+				return (&(operator*()));
+			}
+			//increment and decrement
+			persistent_iterator &operator++(){
+				const node_type *child;
+
+				if (this->_depth == 0)
+					return (*this);
+				if (this->node()->right){
+					push(this->node()->right);
+					while (this->node()->left)
+						push(this->node()->left);
+					return (*this);
+				}
+				do
+					child = this->_path[--this->_depth];
+				while (this->_depth && this->node()->right == child);
+				return (*this);
+			}
+			persistent_iterator &operator--(){
+				const node_type *child;
+
+				if (this->_depth == 0){
+					// from end(), the last element
+					for (const node_type *node = this->_root; node; node = node->right)
+						push(node);
+					return (*this);
+				}
+				if (this->node()->left){
+					push(this->node()->left);
+					while (this->node()->right)
+						push(this->node()->right);
+					return (*this);
+				}
+				do
+					child = this->_path[--this->_depth];
+				while (this->_depth && this->node()->left == child);
+				return (*this);
+			}
+			persistent_iterator operator++(int){
+				persistent_iterator copy(*this);
+				++(*this);
+				return (copy);
+			}
+			persistent_iterator operator--(int){
+				persistent_iterator copy(*this);
+				--(*this);
+				return (copy);
+			}
+
+			/** Appends node to the path: it must be a child of the current node.*/
+			void push(const node_type *node){
+				this->_path[this->_depth++] = node;
+			}
+
+			/** Cuts the path back to its first depth nodes (0 is end()).*/
+			void truncate(int depth){
+				this->_depth = depth;
+			}
+
+			int depth(void) const{
+				return (this->_depth);
+			}
+
+			/** The current node, NULL for end().*/
+			const node_type *node(void) const{
+				return (this->_depth ? this->_path[this->_depth - 1] : NULL);
+			}
+	private:
+		const node_type	*_root;
+		const node_type	*_path[max_depth];
+		int				_depth;
+	};
+}
+#endif
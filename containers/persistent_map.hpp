@@ -0,0 +1,334 @@
+#ifndef PERSISTENT_MAP_HPP
+#define PERSISTENT_MAP_HPP
+
+#include "../rbtree/PersistentTree.hpp"
+#include "persistent_iterator.hpp"
+#include "algorithm.hpp"
+#include "pair.hpp"
+#include "reverse_iterator.hpp"
+#include "utils.hpp"
+#include <stdexcept>
+
+namespace ft
+{
+	/**
+	 * A map with O(1) snapshots. Every copy of a persistent_map is an
+	 * independent version that shares its nodes with the others (see
+	 * PersistentTree.hpp): copying is O(1), and an insert or an erase copies
+	 * only the O(log n) nodes of one path. Nothing a version holds is ever
+	 * modified, so a reader working on its own copy is never blocked nor
+	 * invalidated by writes to another copy, whichever thread they happen in.
+	 *
+	 * Elements are read only: set() replaces a mapped value. Iterators stay
+	 * valid as long as the version they come from is alive and unmodified.
+	 * @param Key Type of keys mapped to elements.
+	 * @param Val Type of elements mapped to keys.
+	 * @param Compare Comparison object used to sort the keys.
+	 * @param Alloc Object used to manage the storage.
+	*/
+	template <class Key, class Val, class Compare = std::less<Key>,
+		  class Alloc = std::allocator<ft::pair<const Key, Val> > >
+	class persistent_map
+	{
+		public:
+		/***************************Member Types*****************************/
+		typedef Key key_type;
+		typedef Val mapped_type;
+		typedef ft::pair<const Key, Val> value_type;
+		typedef Compare key_compare;
+		typedef Alloc allocator_type;
+
+		class value_compare
+		{
+			friend class persistent_map<Key, Val, Compare, Alloc>;
+			protected:
+				Compare comp;
+				value_compare(Compare c) : comp(c) {}
+			public:
+				bool operator()(const value_type &x, const value_type &y) const {
+					return comp(x.first, y.first);
+				}
+		};
+		typedef ft::persistent_iterator<value_type>						iterator;
+		typedef iterator												const_iterator;
+		typedef ft::reverse_iterator<iterator>							reverse_iterator;
+		typedef ft::reverse_iterator<const_iterator>					const_reverse_iterator;
+		typedef ptrdiff_t												difference_type;
+		typedef size_t													size_type;
+		typedef typename allocator_type::const_reference reference;
+		typedef typename allocator_type::const_reference const_reference;
+		typedef typename allocator_type::const_pointer pointer;
+		typedef typename allocator_type::const_pointer const_pointer;
+
+		typedef ft::PersistentNode<value_type>							node_type;
+			private:
+		typedef typename Alloc::template rebind<node_type>::other		node_allocator_type;
+			public:
+		typedef ft::PersistentTree<value_type, value_compare, node_allocator_type>	tree_type;
+
+			private:
+		key_compare			_comp;
+		allocator_type		_alloc;
+		size_type			_size;
+		tree_type			_tree;
+
+		public:
+		/*************************** Coplien form *****************************/
+		explicit persistent_map(const key_compare &comp = key_compare(),
+				const allocator_type &alloc = allocator_type())
+			: _comp(comp), _alloc(alloc), _size(0),
+			_tree(value_compare(comp), node_allocator_type(alloc)) {}
+
+		template <class InputIterator>
+		persistent_map(InputIterator first, InputIterator last,
+			const key_compare &comp = key_compare(),
+			const allocator_type &alloc = allocator_type())
+			: _comp(comp), _alloc(alloc), _size(0),
+			_tree(value_compare(comp), node_allocator_type(alloc))
+		{
+			insert(first, last);
+		}
+
+		/** Another version sharing every element with x. O(1).*/
+		persistent_map(const persistent_map &x)
+			: _comp(x._comp), _alloc(x._alloc), _size(x._size), _tree(x._tree) {}
+
+		~persistent_map(void) {}
+
+		persistent_map &operator=(const persistent_map &x){
+			_comp = x._comp;
+			_size = x._size;
+			_tree = x._tree;
+			return (*this);
+		}
+
+		/**
+		 * Point-in-time view of the map, unaffected by later updates. O(1).
+		 * Same as a copy.
+		*/
+		persistent_map snapshot() const{
+			return (*this);
+		}
+
+		/*************************** Iterators *****************************/
+		iterator begin() const{
+			iterator it(_tree.get_root());
+			for (const node_type *node = _tree.get_root(); node; node = node->left)
+				it.push(node);
+			return (it);
+		}
+
+		iterator end() const{
+			return (iterator(_tree.get_root()));
+		}
+
+		reverse_iterator rbegin() const{
+			return (reverse_iterator(--this->end()));
+		}
+
+		reverse_iterator rend() const{
+			return (reverse_iterator(--this->begin()));
+		}
+
+		/*************************** Capacity *****************************/
+		bool empty() const{
+			return (_size == 0);
+		}
+
+		size_type size() const{
+			return (_size);
+		}
+
+		size_type max_size() const{
+			return (_tree.max_size());
+		}
+
+		/*************************** Element access *****************************/
+		const mapped_type &at(const key_type &k) const{
+			node_type *node = _tree.lookup_value(value_type(k, mapped_type()));
+			if (!node)
+				throw(std::out_of_range("persistent_map::at"));
+			return (node->value.second);
+		}
+
+		/*************************** Modifiers *****************************/
+		/**
+		 * Inserts val if its key is not in the map yet, copying O(log n) nodes.
+		 * @return An iterator to the element with val's key, and whether it was inserted.
+		*/
+		ft::pair<iterator, bool> insert(const value_type &val){
+			bool inserted = _tree.insert_value(val);
+			if (inserted)
+				_size++;
+			return (ft::make_pair(find(val.first), inserted));
+		}
+
+		/** The hint is ignored: the insert copies a path from the root anyway.*/
+		iterator insert(iterator, const value_type &val){
+			return (insert(val).first);
+		}
+
+		template <class InputIterator>
+		void insert(InputIterator first, InputIterator last,
+			typename enable_if<!ft::is_integral<InputIterator>::value, InputIterator>::type * = 0){
+			while (first != last)
+				insert(*first++);
+		}
+
+		/**
+		 * Maps k to val, inserting k or replacing its mapped value (the
+		 * persistent counterpart of map[k] = val). O(log n) new nodes.
+		*/
+		void set(const key_type &k, const mapped_type &val){
+			if (!_tree.lookup_value(value_type(k, val)))
+				_size++;
+			_tree.insert_value(value_type(k, val), true);
+		}
+
+		void erase(iterator position){
+			erase(position->first);
+		}
+
+		size_type erase(const key_type &k){
+			if (!_tree.delete_value(value_type(k, mapped_type())))
+				return (0);
+			_size--;
+			return (1);
+		}
+
+		void erase(iterator first, iterator last){
+			// the snapshot keeps the nodes of the range alive while this version changes
+			persistent_map before(*this);
+			while (first != last)
+				erase((first++)->first);
+		}
+
+		void swap(persistent_map &x){
+			std::swap(_comp, x._comp);
+			std::swap(_alloc, x._alloc);
+			std::swap(_size, x._size);
+			_tree.swap(x._tree);
+		}
+
+		void clear(){
+			_tree.clear();
+			_size = 0;
+		}
+
+		/*************************** Observers *****************************/
+		key_compare key_comp() const{
+			return (_comp);
+		}
+
+		value_compare value_comp() const{
+			return (value_compare(_comp));
+		}
+
+		allocator_type get_allocator(void) const{
+			return (_alloc);
+		}
+
+		/** Height of the tree, at most 1.44 log2(n + 2).*/
+		int height() const{
+			return (tree_type::height(_tree.get_root()));
+		}
+
+		/*************************** Operations *****************************/
+		iterator find(const key_type &k) const{
+			iterator it = lower_bound(k);
+			if (it != end() && _comp(k, it->first))
+				return (end());
+			return (it);
+		}
+
+		size_type count(const key_type &k) const{
+			return (_tree.lookup_value(value_type(k, mapped_type())) != NULL);
+		}
+
+		/** The path down to the first key not less than k.*/
+		iterator lower_bound(const key_type &k) const{
+			iterator it(_tree.get_root());
+			int depth = 0;
+
+			for (const node_type *node = _tree.get_root(); node;){
+				it.push(node);
+				if (_comp(node->value.first, k))
+					node = node->right;
+				else{
+					depth = it.depth();
+					node = node->left;
+				}
+			}
+			it.truncate(depth);
+			return (it);
+		}
+
+		/** The path down to the first key greater than k.*/
+		iterator upper_bound(const key_type &k) const{
+			iterator it(_tree.get_root());
+			int depth = 0;
+
+			for (const node_type *node = _tree.get_root(); node;){
+				it.push(node);
+				if (!_comp(k, node->value.first))
+					node = node->right;
+				else{
+					depth = it.depth();
+					node = node->left;
+				}
+			}
+			it.truncate(depth);
+			return (it);
+		}
+
+		ft::pair<iterator, iterator> equal_range(const key_type &k) const{
+			return (ft::make_pair(lower_bound(k), upper_bound(k)));
+		}
+	};
+
+	template <class Key, class Val, class Compare, class Alloc>
+	bool operator==(const ft::persistent_map<Key, Val, Compare, Alloc> &lhs,
+			const ft::persistent_map<Key, Val, Compare, Alloc> &rhs){
+		if (lhs.size() != rhs.size())
+			return (false);
+		return (ft::equal(lhs.begin(), lhs.end(), rhs.begin()));
+	}
+
+	template <class Key, class Val, class Compare, class Alloc>
+	bool operator!=(const ft::persistent_map<Key, Val, Compare, Alloc> &lhs,
+			const ft::persistent_map<Key, Val, Compare, Alloc> &rhs){
+		return (!(lhs == rhs));
+	}
+
+	template <class Key, class Val, class Compare, class Alloc>
+	bool operator<(const ft::persistent_map<Key, Val, Compare, Alloc> &lhs,
+			const ft::persistent_map<Key, Val, Compare, Alloc> &rhs){
+		return (ft::lexicographical_compare(lhs.begin(), lhs.end(), rhs.begin(), rhs.end()));
+	}
+
+	template <class Key, class Val, class Compare, class Alloc>
+	bool operator<=(const ft::persistent_map<Key, Val, Compare, Alloc> &lhs,
+			const ft::persistent_map<Key, Val, Compare, Alloc> &rhs){
+		return (!(rhs < lhs));
+	}
+
+	template <class Key, class Val, class Compare, class Alloc>
+	bool operator>(const ft::persistent_map<Key, Val, Compare, Alloc> &lhs,
+			const ft::persistent_map<Key, Val, Compare, Alloc> &rhs){
+		return (rhs < lhs);
+	}
+
+	template <class Key, class Val, class Compare, class Alloc>
+	bool operator>=(const ft::persistent_map<Key, Val, Compare, Alloc> &lhs,
+			const ft::persistent_map<Key, Val, Compare, Alloc> &rhs){
+		return (!(lhs < rhs));
+	}
+
+	template <class Key, class Val, class Compare, class Alloc>
+	void swap(ft::persistent_map<Key, Val, Compare, Alloc> &x,
+			ft::persistent_map<Key, Val, Compare, Alloc> &y){
+		x.swap(y);
+	}
+}
+
+#endif
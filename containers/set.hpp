@@ -18,7 +18,8 @@ namespace ft
 	*/
 	template <typename Key, 
 				typename Compare = std::less<Key>, //ordering in ascending order
-				typename Allocator = std::allocator<Key> >
+				typename Allocator = std::allocator<Key>,
+				typename Balance = ft::rb_balance> //tree balancing policy, see Balance.hpp
 	class set 
 	{
 	public:
@@ -44,7 +45,7 @@ namespace ft
 		private:
 			typedef typename Allocator::template rebind<node_type>::other		node_allocator_type;
 		public:
-		typedef ft::Rbtree<value_type, value_compare, allocator_type, node_allocator_type>	tree_type;
+		typedef ft::Rbtree<value_type, value_compare, allocator_type, node_allocator_type, Balance>	tree_type;
 
 	protected:
 		tree_type 							_tree;
@@ -83,12 +84,44 @@ namespace ft
 				}
 			}
 
+		/**
+		 * parallel range constructor - Same contents as the range constructor, built by
+		 * par.threads threads: the range is sorted in parallel, then the tree is built
+		 * bottom up in O(n), its subtrees concurrently (see parallel.hpp). The allocator
+		 * must be usable from several threads at once, as std::allocator is.
+		 * @param first	A forward iterator to the first element in range
+		 * @param last	An iterator representing end of the range (will be excluded and not copied).
+		 * @param par The number of threads, as in ft::parallel(8).
+		 * @param comp The template param used for sorting the set.
+		 * @param alloc The template param used for the allocation.
+		*/
+		template<class ForwardIterator>
+		set(ForwardIterator first, ForwardIterator last, const ft::parallel &par,
+			const Compare& comp = Compare(),
+			const Allocator& alloc = Allocator()) : _tree(comp, alloc), _size(0){
+				if (first != last)
+					build(first, last, &*first, par.threads);
+			}
+
 		/**
 		 * copy constructor - Constructs a container with a copy of each of the elements in other.
 		 * @param other The set that will be copied.
 		*/
 		set(const set& other) : _tree(other._tree), _size(other._size) {}
 
+		/**
+		 * parallel copy constructor - Same copy, the subtrees of other copied by
+		 * up to par.threads threads when other is large (see Rbtree::clone). The
+		 * allocator must be usable from several threads at once.
+		 * @param other The set that will be copied.
+		 * @param par The number of threads, as in ft::parallel(8).
+		*/
+		set(const set& other, const ft::parallel &par)
+			: _tree(other._tree.value_comp(), other._tree.get_allocator()), _size(0){
+				_tree.clone(other._tree, par.threads, other._size);
+				_size = other._size;
+			}
+
 		/**
 		 * Set destructor - destroy the contained object.
 		*/
@@ -214,6 +247,26 @@ namespace ft
 			this->_size = 0;
 		}
 
+		/**
+		 * Clear content, the elements destroyed by up to par.threads threads
+		 * when the set is large. The allocator must be usable from several
+		 * threads at once.
+		*/
+		void clear(const ft::parallel &par){
+			_tree.clear(par.threads, _size);
+			this->_size = 0;
+		}
+
+		/**
+		 * Clear content at once: the elements are destroyed later, on a
+		 * background thread (ft::background::wait() waits for it). The
+		 * allocator must be usable from another thread.
+		*/
+		void clear(const ft::background &){
+			_tree.clear_in_background();
+			this->_size = 0;
+		}
+
 		/**
 		 * Test whether container is empty - 
 		 * @return True if the set' size is equal to 0.
@@ -433,36 +486,113 @@ namespace ft
 		value_compare value_comp(void) const{
 			return (value_compare(key_comp()));
 		}
+
+		/**
+		 * Set algebra - Moves into the set the elements of other it does not
+		 * hold; on equivalent elements the one of the set stays. other ends
+		 * empty. The trees are split around each other's elements and joined
+		 * back, so the work is O(m log(n / m + 1)) for sizes m <= n, on the
+		 * calling thread; the overload taking ft::parallel combines large
+		 * inputs with up to par.threads threads (see Rbtree::combine).
+		 * If an allocation fails, both sets end empty.
+		 * @param other A set whose allocator compares equal to this one's.
+		 * @param par The number of threads, as in ft::parallel(8).
+		*/
+		void union_with(set &other){
+			combine(tree_type::algebra_union, other, 1);
+		}
+
+		void union_with(set &other, const ft::parallel &par){
+			combine(tree_type::algebra_union, other, par.threads);
+		}
+
+		/**
+		 * Erases the elements other does not hold, and empties other.
+		 * Same cost as union_with, plus the elements destroyed.
+		*/
+		void intersect_with(set &other){
+			combine(tree_type::algebra_intersection, other, 1);
+		}
+
+		void intersect_with(set &other, const ft::parallel &par){
+			combine(tree_type::algebra_intersection, other, par.threads);
+		}
+
+		/**
+		 * Erases the elements other holds, and empties other.
+		 * Same cost as union_with, plus the elements destroyed.
+		*/
+		void difference_with(set &other){
+			combine(tree_type::algebra_difference, other, 1);
+		}
+
+		void difference_with(set &other, const ft::parallel &par){
+			combine(tree_type::algebra_difference, other, par.threads);
+		}
+
+	private:
+		void combine(typename tree_type::set_operation op, set &other, size_t threads){
+			size_type size = _size;
+			size_type other_size = other._size;
+
+			if (&other == this){
+				if (op == tree_type::algebra_difference)
+					clear();
+				return;
+			}
+			_size = 0;
+			other._size = 0;
+			if (size + other_size < ft::parallel_grain)
+				threads = 1;
+			size_type common = _tree.combine(op, other._tree, threads);
+			if (op == tree_type::algebra_union)
+				_size = size + other_size - common;
+			else if (op == tree_type::algebra_intersection)
+				_size = common;
+			else
+				_size = size - common;
+		}
+
+		/* Parallel range constructor, Source being the type of the range elements.*/
+		template <class ForwardIterator, class Source>
+		void build(ForwardIterator first, ForwardIterator last, const Source *, size_t threads){
+			ft::vector<const Source *> sorted;
+
+			for (; first != last; ++first)
+				sorted.push_back(&*first);
+			_size = ft::sort_unique(&sorted[0], sorted.size(), _tree.value_comp(), threads);
+			_tree.build(&sorted[0], _size, threads);
+		}
 	};
-		template <typename Key, typename Compare, typename Allocator>
-		bool operator==(const ft::set<Key, Compare, Allocator> & lhs, const ft::set<Key, Compare, Allocator>& rhs){
+		template <typename Key, typename Compare, typename Allocator, typename Balance>
+		bool operator==(const ft::set<Key, Compare, Allocator, Balance> & lhs, const ft::set<Key, Compare, Allocator, Balance>& rhs){
 			if (lhs.size() != rhs.size())
 				return (false);
 			return (ft::equal(lhs.begin(), lhs.end(), rhs.begin()));
 		}
 
-		template <typename Key, typename Compare, typename Allocator>
-		bool operator!=(const ft::set<Key, Compare, Allocator>& lhs, const ft::set<Key, Compare, Allocator>& rhs){
+		template <typename Key, typename Compare, typename Allocator, typename Balance>
+		bool operator!=(const ft::set<Key, Compare, Allocator, Balance>& lhs, const ft::set<Key, Compare, Allocator, Balance>& rhs){
 			return (!(lhs == rhs));
 		}
 
-		template <typename Key, typename Compare, typename Allocator>
-		bool operator<(const ft::set<Key, Compare, Allocator>& lhs, const ft::set<Key, Compare, Allocator>& rhs){
+		template <typename Key, typename Compare, typename Allocator, typename Balance>
+		bool operator<(const ft::set<Key, Compare, Allocator, Balance>& lhs, const ft::set<Key, Compare, Allocator, Balance>& rhs){
 			return (ft::lexicographical_compare(lhs.begin(), lhs.end(), rhs.begin(), rhs.end()));
 		}
 
-		template <typename Key, typename Compare, typename Allocator>
-		bool operator>=(const ft::set<Key, Compare, Allocator>& lhs, const ft::set<Key, Compare, Allocator>& rhs){
+		template <typename Key, typename Compare, typename Allocator, typename Balance>
+		bool operator>=(const ft::set<Key, Compare, Allocator, Balance>& lhs, const ft::set<Key, Compare, Allocator, Balance>& rhs){
 			return (!(lhs < rhs));
 		}
 
-		template <typename Key, typename Compare, typename Allocator>
-		bool operator>(const ft::set<Key, Compare, Allocator>& lhs, const ft::set<Key, Compare, Allocator>& rhs){
+		template <typename Key, typename Compare, typename Allocator, typename Balance>
+		bool operator>(const ft::set<Key, Compare, Allocator, Balance>& lhs, const ft::set<Key, Compare, Allocator, Balance>& rhs){
 			return (rhs < lhs);
 		}
 
-		template <typename Key, typename Compare, typename Allocator>
-		bool operator<=(const ft::set<Key, Compare, Allocator>& lhs, const ft::set<Key, Compare, Allocator>& rhs){
+		template <typename Key, typename Compare, typename Allocator, typename Balance>
+		bool operator<=(const ft::set<Key, Compare, Allocator, Balance>& lhs, const ft::set<Key, Compare, Allocator, Balance>& rhs){
 			return (!(rhs < lhs));
 		}
 }
@@ -0,0 +1,70 @@
+#ifndef SKIPLIST_ITERATOR_HPP
+#define SKIPLIST_ITERATOR_HPP
+
+#include <cstddef>
+#include <iterator>
+
+namespace ft{
+	/**
+	 * Forward iterator of the concurrent skip lists, walking level 0 and
+	 * stepping over the erased nodes. Only valid inside the ft::epoch::guard
+	 * it was obtained in; it sees the inserts and erases of other threads that
+	 * happen ahead of it.
+	 * @param T Type of the elements.
+	 * @param List The ft::SkipList providing next().
+	*/
+	template<class T, class List>
+	class skiplist_iterator{
+		public:
+			typedef std::forward_iterator_tag iterator_category;
+			typedef T value_type;
+			typedef T* pointer;
+			typedef T& reference;
+			typedef std::ptrdiff_t difference_type;
+			typedef typename List::node_type* node_pointer;
+
+			skiplist_iterator() : _node(NULL) {}
+
+			skiplist_iterator(node_pointer node) : _node(node) {}
+
+			skiplist_iterator(skiplist_iterator const &src) : _node(src._node) {}
+
+			~skiplist_iterator(void){}
+
+			skiplist_iterator &operator=(skiplist_iterator const &other){
+				this->_node = other._node;
+				return (*this);
+			}
+			//equality/inequality operators
+			bool operator==(skiplist_iterator const &other) const{
+				return (this->_node == other._node);
+			}
+			bool operator!=(skiplist_iterator const &other) const{
+				return (this->_node != other._node);
+			}
+			//dereference
+			reference operator*() const{
+				return (this->_node->value);
+			}
+
+			pointer operator->() const{
+				return (&(operator*()));
+			}
+			//increment
+			skiplist_iterator &operator++(){
+				this->_node = List::next(this->_node);
+				return (*this);
+			}
+			skiplist_iterator operator++(int){
+				skiplist_iterator copy(*this);
+				this->_node = List::next(this->_node);
+				return (copy);
+			}
+			node_pointer get_node_pointer(void) const{
+				return (this->_node);
+			}
+	private:
+		node_pointer _node;
+	};
+}
+#endif
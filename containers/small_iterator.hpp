@@ -0,0 +1,96 @@
+#ifndef SMALL_ITERATOR_HPP
+#define SMALL_ITERATOR_HPP
+
+#include <cstddef>
+#include <iterator>
+
+namespace ft{
+	/**
+	 * Iterator of ft::small_map and ft::small_set. While the container keeps its
+	 * elements inline it walks a plain pointer over the sorted array, once the
+	 * container has spilled it wraps the iterator of the tree. A NULL pointer
+	 * means tree mode (the inline array always has an address).
+	 * @param T Type of the elements.
+	 * @param TreeIterator Iterator of the spill container.
+	*/
+	template<class T, class TreeIterator>
+	class small_iterator{
+		public:
+			typedef std::bidirectional_iterator_tag iterator_category;
+			typedef T value_type;
+			typedef T* pointer;
+			typedef T& reference;
+			typedef std::ptrdiff_t difference_type;
+			typedef TreeIterator tree_iterator;
+
+			small_iterator() : _ptr(NULL), _it() {}
+
+			small_iterator(pointer ptr) : _ptr(ptr), _it() {}
+
+			small_iterator(tree_iterator it) : _ptr(NULL), _it(it) {}
+
+			small_iterator(small_iterator const &src) : _ptr(src._ptr), _it(src._it) {}
+
+			~small_iterator(void){}
+
+			small_iterator &operator=(small_iterator const &other){
+				this->_ptr = other._ptr;
+				this->_it = other._it;
+				return (*this);
+			}
+			//equality/inequality operators
+			bool operator==(small_iterator const &other) const{
+				return (this->_ptr == other._ptr && this->_it == other._it);
+			}
+			bool operator!=(small_iterator const &other) const{
+				return (!(*this == other));
+			}
+			//dereference
+			reference operator*() const{
+				if (this->_ptr)
+					return (*this->_ptr);
+				return (*this->_it);
+			}
+
+			pointer operator->() const{
+				return (&(operator*()));
+			}
+			//increment and decrement
+			small_iterator &operator++(){
+				if (this->_ptr)
+					++this->_ptr;
+				else
+					++this->_it;
+				return (*this);
+			}
+			small_iterator &operator--(){
+				if (this->_ptr)
+					--this->_ptr;
+				else
+					--this->_it;
+				return (*this);
+			}
+			small_iterator operator++(int){
+				small_iterator copy(*this);
+				++(*this);
+				return (copy);
+			}
+			small_iterator operator--(int){
+				small_iterator copy(*this);
+				--(*this);
+				return (copy);
+			}
+			/** The element pointer in inline mode, NULL in tree mode.*/
+			pointer get_pointer(void) const{
+				return (this->_ptr);
+			}
+			/** The wrapped iterator in tree mode.*/
+			tree_iterator get_tree_iterator(void) const{
+				return (this->_it);
+			}
+	private:
+		pointer			_ptr;
+		tree_iterator	_it;
+	};
+}
+#endif
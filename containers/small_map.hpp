@@ -0,0 +1,392 @@
+#ifndef SMALL_MAP_HPP
+#define SMALL_MAP_HPP
+
+#include "map.hpp"
+#include "small_iterator.hpp"
+#include <new>
+
+namespace ft
+{
+	/**
+	 * A map that keeps up to N elements inline, in a sorted array inside the
+	 * object, and only moves them to an ft::map when the (N + 1)th key arrives.
+	 *
+	 * Up to N elements nothing is allocated, lookups are a linear scan of
+	 * contiguous memory (which beats a tree walk for the handful of keys this
+	 * is meant for) and inserts / erases shift the tail of the array. Past N the
+	 * container behaves exactly like the ft::map it spilled into. It goes back to
+	 * inline storage once emptied (clear() or erasing the last element).
+	 *
+	 * Inline inserts and erases invalidate the iterators to the shifted
+	 * elements, and a spill invalidates every iterator.
+	 * @param Key Type of keys mapped to elements.
+	 * @param Val Type of elements mapped to keys.
+	 * @param N Number of elements kept inline (at least 1, keep it small).
+	 * @param Compare Comparison object used to sort the keys.
+	 * @param Alloc Object used to manage the storage once spilled.
+	*/
+	template <class Key, class Val, size_t N = 8, class Compare = std::less<Key>,
+		  class Alloc = std::allocator<ft::pair<const Key, Val> > >
+	class small_map
+	{
+		public:
+		/***************************Member Types*****************************/
+		typedef Key key_type;
+		typedef Val mapped_type;
+		typedef ft::pair<const Key, Val> value_type;
+		typedef Compare key_compare;
+		typedef Alloc allocator_type;
+		typedef ft::map<Key, Val, Compare, Alloc>						tree_type;
+		typedef typename tree_type::value_compare						value_compare;
+		typedef ft::small_iterator<value_type, typename tree_type::iterator>	iterator;
+		typedef iterator												const_iterator;
+		typedef ft::reverse_iterator<iterator>							reverse_iterator;
+		typedef ft::reverse_iterator<const_iterator>					const_reverse_iterator;
+		typedef ptrdiff_t												difference_type;
+		typedef size_t													size_type;
+		typedef typename allocator_type::reference reference;
+		typedef typename allocator_type::const_reference const_reference;
+		typedef typename allocator_type::pointer pointer;
+		typedef typename allocator_type::const_pointer const_pointer;
+
+		static const size_type inline_capacity = N;
+
+			private:
+		/* Raw storage for the inline elements, aligned for any scalar type.*/
+		union storage_type
+		{
+			char		bytes[N * sizeof(value_type)];
+			long double	align_ld;
+			long long	align_ll;
+			void		*align_ptr;
+		};
+
+		key_compare		_comp;
+		storage_type	_inline;
+		size_type		_count; // number of inline elements, 0 once spilled
+		bool			_spilled;
+		tree_type		_tree;
+
+		public:
+		/*************************** Coplien form *****************************/
+		explicit small_map(const key_compare &comp = key_compare(),
+				const allocator_type &alloc = allocator_type())
+			: _comp(comp), _count(0), _spilled(false), _tree(comp, alloc) {}
+
+		template <class InputIterator>
+		small_map(InputIterator first, InputIterator last,
+			const key_compare &comp = key_compare(),
+			const allocator_type &alloc = allocator_type())
+			: _comp(comp), _count(0), _spilled(false), _tree(comp, alloc)
+		{
+			insert(first, last);
+		}
+
+		small_map(const small_map &x)
+			: _comp(x._comp), _count(0), _spilled(x._spilled), _tree(x._tree)
+		{
+			for (; _count < x._count; _count++)
+				new (data() + _count) value_type(x.data()[_count]);
+		}
+
+		~small_map(void){
+			destroy_inline();
+		}
+
+		small_map &operator=(const small_map &x){
+			if (this != &x){
+				destroy_inline();
+				_comp = x._comp;
+				_tree = x._tree;
+				_spilled = x._spilled;
+				for (; _count < x._count; _count++)
+					new (data() + _count) value_type(x.data()[_count]);
+			}
+			return (*this);
+		}
+
+		/*************************** Iterators *****************************/
+		iterator begin() const{
+			if (_spilled)
+				return (iterator(_tree.begin()));
+			return (iterator(data()));
+		}
+
+		iterator end() const{
+			if (_spilled)
+				return (iterator(_tree.end()));
+			return (iterator(data() + _count));
+		}
+
+		reverse_iterator rbegin() const{
+			return (reverse_iterator(--this->end()));
+		}
+
+		reverse_iterator rend() const{
+			return (reverse_iterator(--this->begin()));
+		}
+
+		/*************************** Capacity *****************************/
+		bool empty() const{
+			return (this->size() == 0);
+		}
+
+		size_type size() const{
+			if (_spilled)
+				return (_tree.size());
+			return (_count);
+		}
+
+		size_type max_size() const{
+			return (_tree.max_size());
+		}
+
+		/** @return Whether the elements are still stored inline (nothing allocated).*/
+		bool is_inline() const{
+			return (!_spilled);
+		}
+
+		/*************************** Element access *****************************/
+		mapped_type &operator[](const key_type &k){
+			if (_spilled)
+				return (_tree[k]);
+			return (insert(value_type(k, mapped_type())).first->second);
+		}
+
+		mapped_type &at(const key_type &k) const{
+			iterator it = find(k);
+			if (it == end())
+				throw(std::out_of_range("small_map::at"));
+			return (it->second);
+		}
+
+		/*************************** Modifiers *****************************/
+		/**
+		 * Inserts val if its key is not in the container yet. Inline, the tail
+		 * of the array is shifted by one; inserting the (N + 1)th key moves
+		 * every element to the tree first.
+		 * @return An iterator to the element with val's key, and whether it was inserted.
+		*/
+		ft::pair<iterator, bool> insert(const value_type &val){
+			if (_spilled){
+				ft::pair<typename tree_type::iterator, bool> res = _tree.insert(val);
+				return (ft::make_pair(iterator(res.first), res.second));
+			}
+			size_type pos = lower_index(val.first);
+			if (pos < _count && !_comp(val.first, data()[pos].first))
+				return (ft::make_pair(iterator(data() + pos), false));
+			if (_count == N){
+				spill();
+				return (ft::make_pair(iterator(_tree.insert(val).first), true));
+			}
+			for (size_type i = _count; i > pos; i--){
+				new (data() + i) value_type(data()[i - 1]);
+				data()[i - 1].~value_type();
+			}
+			new (data() + pos) value_type(val);
+			_count++;
+			return (ft::make_pair(iterator(data() + pos), true));
+		}
+
+		/** The hint is only used once spilled.*/
+		iterator insert(iterator position, const value_type &val){
+			if (_spilled && position.get_pointer() == NULL)
+				return (iterator(_tree.insert(position.get_tree_iterator(), val)));
+			return (insert(val).first);
+		}
+
+		template <class InputIterator>
+		void insert(InputIterator first, InputIterator last){
+			while (first != last)
+				insert(*first++);
+		}
+
+		void erase(iterator position){
+			if (_spilled){
+				_tree.erase(position.get_tree_iterator());
+				if (_tree.empty())
+					_spilled = false;
+				return;
+			}
+			erase_index(position.get_pointer() - data());
+		}
+
+		size_type erase(const key_type &k){
+			iterator it = find(k);
+			if (it == end())
+				return (0);
+			erase(it);
+			return (1);
+		}
+
+		void erase(iterator first, iterator last){
+			if (!_spilled){
+				size_type pos = first.get_pointer() - data();
+				for (size_type n = last.get_pointer() - first.get_pointer(); n > 0; n--)
+					erase_index(pos);
+				return;
+			}
+			_tree.erase(first.get_tree_iterator(), last.get_tree_iterator());
+			if (_tree.empty())
+				_spilled = false;
+		}
+
+		/**
+		 * Exchanges the contents with x. The trees are swapped in O(1), the
+		 * inline elements are exchanged one by one (at most N copies).
+		*/
+		void swap(small_map &x){
+			size_type common = _count < x._count ? _count : x._count;
+			for (size_type i = 0; i < common; i++){
+				value_type tmp(data()[i]);
+				data()[i].~value_type();
+				new (data() + i) value_type(x.data()[i]);
+				x.data()[i].~value_type();
+				new (x.data() + i) value_type(tmp);
+			}
+			small_map &longer = _count > x._count ? *this : x;
+			small_map &shorter = _count > x._count ? x : *this;
+			for (size_type i = common; i < longer._count; i++){
+				new (shorter.data() + i) value_type(longer.data()[i]);
+				longer.data()[i].~value_type();
+			}
+			std::swap(_count, x._count);
+			std::swap(_spilled, x._spilled);
+			std::swap(_comp, x._comp);
+			_tree.swap(x._tree);
+		}
+
+		void clear(){
+			destroy_inline();
+			_tree.clear();
+			_spilled = false;
+		}
+
+		/*************************** Observers *****************************/
+		key_compare key_comp() const{
+			return (_comp);
+		}
+
+		value_compare value_comp() const{
+			return (_tree.value_comp());
+		}
+
+		allocator_type get_allocator(void) const{
+			return (_tree.get_allocator());
+		}
+
+		/*************************** Operations *****************************/
+		iterator find(const key_type &k) const{
+			if (_spilled)
+				return (iterator(_tree.find(k)));
+			size_type pos = lower_index(k);
+			if (pos < _count && !_comp(k, data()[pos].first))
+				return (iterator(data() + pos));
+			return (end());
+		}
+
+		size_type count(const key_type &k) const{
+			return (find(k) != end());
+		}
+
+		iterator lower_bound(const key_type &k) const{
+			if (_spilled)
+				return (iterator(_tree.lower_bound(k)));
+			return (iterator(data() + lower_index(k)));
+		}
+
+		iterator upper_bound(const key_type &k) const{
+			if (_spilled)
+				return (iterator(_tree.upper_bound(k)));
+			size_type pos = lower_index(k);
+			if (pos < _count && !_comp(k, data()[pos].first))
+				pos++;
+			return (iterator(data() + pos));
+		}
+
+		ft::pair<iterator, iterator> equal_range(const key_type &k) const{
+			return (ft::make_pair(lower_bound(k), upper_bound(k)));
+		}
+
+		private:
+		value_type *data() const{
+			return (reinterpret_cast<value_type *>(const_cast<char *>(_inline.bytes)));
+		}
+
+		/* Index of the first inline key not less than k, by linear scan.*/
+		size_type lower_index(const key_type &k) const{
+			size_type pos = 0;
+			while (pos < _count && _comp(data()[pos].first, k))
+				pos++;
+			return (pos);
+		}
+
+		void erase_index(size_type pos){
+			for (size_type i = pos; i + 1 < _count; i++){
+				data()[i].~value_type();
+				new (data() + i) value_type(data()[i + 1]);
+			}
+			data()[--_count].~value_type();
+		}
+
+		void destroy_inline(){
+			while (_count > 0)
+				data()[--_count].~value_type();
+		}
+
+		/* Moves the inline elements, already sorted, to the tree.*/
+		void spill(){
+			typename tree_type::iterator hint = _tree.end();
+			for (size_type i = 0; i < _count; i++)
+				hint = _tree.insert(hint, data()[i]);
+			destroy_inline();
+			_spilled = true;
+		}
+	};
+
+	template <class Key, class Val, size_t N, class Compare, class Alloc>
+	bool operator==(const ft::small_map<Key, Val, N, Compare, Alloc> &lhs,
+			const ft::small_map<Key, Val, N, Compare, Alloc> &rhs){
+		if (lhs.size() != rhs.size())
+			return (false);
+		return (ft::equal(lhs.begin(), lhs.end(), rhs.begin()));
+	}
+
+	template <class Key, class Val, size_t N, class Compare, class Alloc>
+	bool operator!=(const ft::small_map<Key, Val, N, Compare, Alloc> &lhs,
+			const ft::small_map<Key, Val, N, Compare, Alloc> &rhs){
+		return (!(lhs == rhs));
+	}
+
+	template <class Key, class Val, size_t N, class Compare, class Alloc>
+	bool operator<(const ft::small_map<Key, Val, N, Compare, Alloc> &lhs,
+			const ft::small_map<Key, Val, N, Compare, Alloc> &rhs){
+		return (ft::lexicographical_compare(lhs.begin(), lhs.end(), rhs.begin(), rhs.end()));
+	}
+
+	template <class Key, class Val, size_t N, class Compare, class Alloc>
+	bool operator<=(const ft::small_map<Key, Val, N, Compare, Alloc> &lhs,
+			const ft::small_map<Key, Val, N, Compare, Alloc> &rhs){
+		return (!(rhs < lhs));
+	}
+
+	template <class Key, class Val, size_t N, class Compare, class Alloc>
+	bool operator>(const ft::small_map<Key, Val, N, Compare, Alloc> &lhs,
+			const ft::small_map<Key, Val, N, Compare, Alloc> &rhs){
+		return (rhs < lhs);
+	}
+
+	template <class Key, class Val, size_t N, class Compare, class Alloc>
+	bool operator>=(const ft::small_map<Key, Val, N, Compare, Alloc> &lhs,
+			const ft::small_map<Key, Val, N, Compare, Alloc> &rhs){
+		return (!(lhs < rhs));
+	}
+
+	template <class Key, class Val, size_t N, class Compare, class Alloc>
+	void swap(ft::small_map<Key, Val, N, Compare, Alloc> &x,
+			ft::small_map<Key, Val, N, Compare, Alloc> &y){
+		x.swap(y);
+	}
+}
+
+#endif
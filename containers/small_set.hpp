@@ -0,0 +1,369 @@
+#ifndef SMALL_SET_HPP
+#define SMALL_SET_HPP
+
+#include "set.hpp"
+#include "small_iterator.hpp"
+#include <new>
+
+namespace ft
+{
+	/**
+	 * A set that keeps up to N elements inline, in a sorted array inside the
+	 * object, and only moves them to an ft::set when the (N + 1)th element
+	 * arrives. Same storage rules as ft::small_map: no allocation and linear
+	 * scans up to N, the behaviour of the spilled ft::set past N, back to inline
+	 * storage once emptied.
+	 * @param T Type of the elements.
+	 * @param N Number of elements kept inline (at least 1, keep it small).
+	 * @param Compare Comparison object used to sort the elements.
+	 * @param Allocator Object used to manage the storage once spilled.
+	*/
+	template <typename T, size_t N = 8, typename Compare = std::less<T>,
+				typename Allocator = std::allocator<T> >
+	class small_set
+	{
+	public:
+		/***************************Member Types*****************************/
+		typedef T key_type;
+		typedef T value_type;
+		typedef Compare key_compare;
+		typedef Compare value_compare;
+		typedef Allocator allocator_type;
+		typedef typename Allocator::size_type size_type;
+		typedef std::ptrdiff_t difference_type;
+		typedef value_type& reference;
+		typedef const value_type& const_reference;
+		typedef typename allocator_type::pointer 		pointer;
+		typedef typename allocator_type::const_pointer 	const_pointer;
+		typedef ft::set<T, Compare, Allocator>							tree_type;
+		typedef ft::small_iterator<value_type, typename tree_type::iterator>	iterator;
+		typedef iterator												const_iterator;
+		typedef ft::reverse_iterator<iterator>							reverse_iterator;
+		typedef ft::reverse_iterator<const_iterator>					const_reverse_iterator;
+
+		static const size_type inline_capacity = N;
+
+	private:
+		/* Raw storage for the inline elements, aligned for any scalar type.*/
+		union storage_type
+		{
+			char		bytes[N * sizeof(value_type)];
+			long double	align_ld;
+			long long	align_ll;
+			void		*align_ptr;
+		};
+
+		key_compare		_comp;
+		storage_type	_inline;
+		size_type		_count; // number of inline elements, 0 once spilled
+		bool			_spilled;
+		tree_type		_tree;
+
+	public:
+		/*************************** Coplien form *****************************/
+		explicit small_set(const Compare &comp = Compare(),
+				const Allocator& alloc = Allocator())
+			: _comp(comp), _count(0), _spilled(false), _tree(comp, alloc) {}
+
+		template<class InputIterator>
+		small_set(InputIterator first, InputIterator last,
+			const Compare& comp = Compare(),
+			const Allocator& alloc = Allocator())
+			: _comp(comp), _count(0), _spilled(false), _tree(comp, alloc){
+				insert(first, last);
+			}
+
+		small_set(const small_set& x)
+			: _comp(x._comp), _count(0), _spilled(x._spilled), _tree(x._tree)
+		{
+			for (; _count < x._count; _count++)
+				new (data() + _count) value_type(x.data()[_count]);
+		}
+
+		~small_set(void){
+			destroy_inline();
+		}
+
+		small_set& operator=(const small_set& x){
+			if (this != &x){
+				destroy_inline();
+				_comp = x._comp;
+				_tree = x._tree;
+				_spilled = x._spilled;
+				for (; _count < x._count; _count++)
+					new (data() + _count) value_type(x.data()[_count]);
+			}
+			return (*this);
+		}
+
+		allocator_type get_allocator() const{
+			return (_tree.get_allocator());
+		}
+
+		/*************************** Iterators *****************************/
+		iterator begin() const{
+			if (_spilled)
+				return (iterator(_tree.begin()));
+			return (iterator(data()));
+		}
+
+		iterator end() const{
+			if (_spilled)
+				return (iterator(_tree.end()));
+			return (iterator(data() + _count));
+		}
+
+		reverse_iterator rbegin() const{
+			return (reverse_iterator(--this->end()));
+		}
+
+		reverse_iterator rend() const{
+			return (reverse_iterator(--this->begin()));
+		}
+
+		/*************************** Capacity *****************************/
+		bool empty(void) const{
+			return (this->size() == 0);
+		}
+
+		size_type size(void) const{
+			if (_spilled)
+				return (_tree.size());
+			return (_count);
+		}
+
+		size_type max_size(void) const{
+			return (_tree.max_size());
+		}
+
+		/** @return Whether the elements are still stored inline (nothing allocated).*/
+		bool is_inline(void) const{
+			return (!_spilled);
+		}
+
+		/*************************** Modifiers *****************************/
+		/**
+		 * Inserts val if it is not in the set yet, shifting the tail of the
+		 * inline array, or spilling to the tree when N elements are inline.
+		 * @return An iterator to the element equal to val, and whether it was inserted.
+		*/
+		ft::pair<iterator,bool> insert(const value_type &val){
+			if (_spilled){
+				ft::pair<typename tree_type::iterator, bool> res = _tree.insert(val);
+				return (ft::make_pair(iterator(res.first), res.second));
+			}
+			size_type pos = lower_index(val);
+			if (pos < _count && !_comp(val, data()[pos]))
+				return (ft::make_pair(iterator(data() + pos), false));
+			if (_count == N){
+				spill();
+				return (ft::make_pair(iterator(_tree.insert(val).first), true));
+			}
+			for (size_type i = _count; i > pos; i--){
+				new (data() + i) value_type(data()[i - 1]);
+				data()[i - 1].~value_type();
+			}
+			new (data() + pos) value_type(val);
+			_count++;
+			return (ft::make_pair(iterator(data() + pos), true));
+		}
+
+		/** The hint is only used once spilled.*/
+		iterator insert(iterator position, const value_type& val){
+			if (_spilled && position.get_pointer() == NULL)
+				return (iterator(_tree.insert(position.get_tree_iterator(), val)));
+			return (insert(val).first);
+		}
+
+		template<class InputIterator>
+		void insert(InputIterator first, InputIterator last,
+			typename enable_if<!ft::is_integral<InputIterator>::value, InputIterator>::type * = 0){
+			while (first != last)
+				insert(*first++);
+		}
+
+		void erase(iterator position){
+			if (_spilled){
+				_tree.erase(position.get_tree_iterator());
+				if (_tree.empty())
+					_spilled = false;
+				return;
+			}
+			erase_index(position.get_pointer() - data());
+		}
+
+		size_type erase(const value_type& val){
+			iterator it = find(val);
+			if (it == end())
+				return (0);
+			erase(it);
+			return (1);
+		}
+
+		void erase(iterator first, iterator last){
+			if (!_spilled){
+				size_type pos = first.get_pointer() - data();
+				for (size_type n = last.get_pointer() - first.get_pointer(); n > 0; n--)
+					erase_index(pos);
+				return;
+			}
+			_tree.erase(first.get_tree_iterator(), last.get_tree_iterator());
+			if (_tree.empty())
+				_spilled = false;
+		}
+
+		/**
+		 * Exchanges the contents with x. The trees are swapped in O(1), the
+		 * inline elements are exchanged one by one (at most N copies).
+		*/
+		void swap(small_set& x){
+			size_type common = _count < x._count ? _count : x._count;
+			for (size_type i = 0; i < common; i++){
+				value_type tmp(data()[i]);
+				data()[i].~value_type();
+				new (data() + i) value_type(x.data()[i]);
+				x.data()[i].~value_type();
+				new (x.data() + i) value_type(tmp);
+			}
+			small_set &longer = _count > x._count ? *this : x;
+			small_set &shorter = _count > x._count ? x : *this;
+			for (size_type i = common; i < longer._count; i++){
+				new (shorter.data() + i) value_type(longer.data()[i]);
+				longer.data()[i].~value_type();
+			}
+			std::swap(_count, x._count);
+			std::swap(_spilled, x._spilled);
+			std::swap(_comp, x._comp);
+			_tree.swap(x._tree);
+		}
+
+		void clear(void){
+			destroy_inline();
+			_tree.clear();
+			_spilled = false;
+		}
+
+		/*************************** Observers *****************************/
+		key_compare key_comp(void) const{
+			return (_comp);
+		}
+
+		value_compare value_comp(void) const{
+			return (_comp);
+		}
+
+		/*************************** Operations *****************************/
+		iterator find(const value_type& val) const{
+			if (_spilled)
+				return (iterator(_tree.find(val)));
+			size_type pos = lower_index(val);
+			if (pos < _count && !_comp(val, data()[pos]))
+				return (iterator(data() + pos));
+			return (end());
+		}
+
+		size_type count(const value_type& val) const{
+			return (find(val) != end());
+		}
+
+		iterator lower_bound(const value_type& val) const{
+			if (_spilled)
+				return (iterator(_tree.lower_bound(val)));
+			return (iterator(data() + lower_index(val)));
+		}
+
+		iterator upper_bound(const value_type& val) const{
+			if (_spilled)
+				return (iterator(_tree.upper_bound(val)));
+			size_type pos = lower_index(val);
+			if (pos < _count && !_comp(val, data()[pos]))
+				pos++;
+			return (iterator(data() + pos));
+		}
+
+		ft::pair<iterator, iterator> equal_range(const value_type &val) const{
+			return (ft::make_pair(lower_bound(val), upper_bound(val)));
+		}
+
+	private:
+		value_type *data() const{
+			return (reinterpret_cast<value_type *>(const_cast<char *>(_inline.bytes)));
+		}
+
+		/* Index of the first inline element not less than val, by linear scan.*/
+		size_type lower_index(const value_type &val) const{
+			size_type pos = 0;
+			while (pos < _count && _comp(data()[pos], val))
+				pos++;
+			return (pos);
+		}
+
+		void erase_index(size_type pos){
+			for (size_type i = pos; i + 1 < _count; i++){
+				data()[i].~value_type();
+				new (data() + i) value_type(data()[i + 1]);
+			}
+			data()[--_count].~value_type();
+		}
+
+		void destroy_inline(){
+			while (_count > 0)
+				data()[--_count].~value_type();
+		}
+
+		/* Moves the inline elements, already sorted, to the tree.*/
+		void spill(){
+			typename tree_type::iterator hint = _tree.end();
+			for (size_type i = 0; i < _count; i++)
+				hint = _tree.insert(hint, data()[i]);
+			destroy_inline();
+			_spilled = true;
+		}
+	};
+
+	template <typename T, size_t N, typename Compare, typename Allocator>
+	bool operator==(const ft::small_set<T, N, Compare, Allocator> &lhs,
+			const ft::small_set<T, N, Compare, Allocator> &rhs){
+		if (lhs.size() != rhs.size())
+			return (false);
+		return (ft::equal(lhs.begin(), lhs.end(), rhs.begin()));
+	}
+
+	template <typename T, size_t N, typename Compare, typename Allocator>
+	bool operator!=(const ft::small_set<T, N, Compare, Allocator> &lhs,
+			const ft::small_set<T, N, Compare, Allocator> &rhs){
+		return (!(lhs == rhs));
+	}
+
+	template <typename T, size_t N, typename Compare, typename Allocator>
+	bool operator<(const ft::small_set<T, N, Compare, Allocator> &lhs,
+			const ft::small_set<T, N, Compare, Allocator> &rhs){
+		return (ft::lexicographical_compare(lhs.begin(), lhs.end(), rhs.begin(), rhs.end()));
+	}
+
+	template <typename T, size_t N, typename Compare, typename Allocator>
+	bool operator<=(const ft::small_set<T, N, Compare, Allocator> &lhs,
+			const ft::small_set<T, N, Compare, Allocator> &rhs){
+		return (!(rhs < lhs));
+	}
+
+	template <typename T, size_t N, typename Compare, typename Allocator>
+	bool operator>(const ft::small_set<T, N, Compare, Allocator> &lhs,
+			const ft::small_set<T, N, Compare, Allocator> &rhs){
+		return (rhs < lhs);
+	}
+
+	template <typename T, size_t N, typename Compare, typename Allocator>
+	bool operator>=(const ft::small_set<T, N, Compare, Allocator> &lhs,
+			const ft::small_set<T, N, Compare, Allocator> &rhs){
+		return (!(lhs < rhs));
+	}
+
+	template <typename T, size_t N, typename Compare, typename Allocator>
+	void swap(ft::small_set<T, N, Compare, Allocator> &x,
+			ft::small_set<T, N, Compare, Allocator> &y){
+		x.swap(y);
+	}
+}
+
+#endif
@@ -0,0 +1,482 @@
+#ifndef SMALL_VECTOR_HPP
+#define SMALL_VECTOR_HPP
+
+#include "vector.hpp"
+#include <algorithm>
+
+namespace ft
+{
+	/**
+	 * A vector that keeps up to N elements inline, in a buffer inside the
+	 * object, and only allocates when the (N + 1)th element arrives.
+	 *
+	 * It has the interface, iterators and complexities of ft::vector, and
+	 * grows the same way once spilled (by the Growth policy, from N). The
+	 * heap storage is kept by clear() and given back by shrink_to_fit(),
+	 * which moves the elements inline again when they fit. Swapping two
+	 * vectors moves the inline elements one by one (at most N each way),
+	 * and since the object points into itself while inline, it is never
+	 * relocated with memcpy.
+	 *
+	 * Anything that moves the elements between the inline buffer and the
+	 * heap invalidates every iterator, as a reallocation of ft::vector does.
+	 * @param T Type of the elements.
+	 * @param N Number of elements kept inline (at least 1, keep it small).
+	 * @param Alloc Object used to manage the storage once spilled.
+	 * @param Growth Growth policy once spilled (growth.hpp).
+	*/
+	template <class T, size_t N = 8, class Alloc = std::allocator<T>,
+		  class Growth = ft::growth_double>
+	class small_vector
+	{
+		public:
+		/***************************Member Types*****************************/
+		typedef T value_type;
+		typedef Alloc allocator_type;
+		typedef Growth growth_policy;
+		typedef typename Alloc::pointer pointer;
+		typedef typename Alloc::const_pointer const_pointer;
+		typedef typename Alloc::reference reference;
+		typedef typename Alloc::const_reference const_reference;
+		typedef ft::random_access_iterator<value_type> iterator;
+		typedef ft::random_access_iterator<value_type> const_iterator;
+		typedef ft::reverse_iterator<iterator> reverse_iterator;
+		typedef ft::reverse_iterator<const_iterator> const_reverse_iterator;
+		typedef std::ptrdiff_t difference_type;
+		typedef std::size_t size_type;
+
+		static const size_type inline_capacity = N;
+
+			private:
+		/* Raw storage for the inline elements, aligned for any scalar type.*/
+		union storage_type
+		{
+			char		bytes[N * sizeof(value_type)];
+			long double	align_ld;
+			long long	align_ll;
+			void		*align_ptr;
+		};
+
+		allocator_type	_alloc;
+		value_type		*_data;		// the inline buffer, or the heap once spilled
+		size_type		_size;
+		size_type		_capacity;	// N while inline
+		storage_type	_inline;
+
+		public:
+		/*************************** Coplien form *****************************/
+		explicit small_vector(const allocator_type &alloc = allocator_type())
+			: _alloc(alloc), _data(inline_data()), _size(0), _capacity(N) {}
+
+		explicit small_vector(size_type n, const value_type &val = value_type(),
+				const allocator_type &alloc = allocator_type())
+			: _alloc(alloc), _data(inline_data()), _size(0), _capacity(N)
+		{
+			reserve(n);
+			ft::uninitialized_fill_n(_alloc, _data, n, val);
+			_size = n;
+		}
+
+		template <class InputIterator>
+		small_vector(InputIterator first, InputIterator last,
+			const allocator_type &alloc = allocator_type(),
+			typename ft::enable_if<!ft::is_integral<InputIterator>::value, int>::type = 0)
+			: _alloc(alloc), _data(inline_data()), _size(0), _capacity(N)
+		{
+			assign_range(first, last, typename ft::iterator_traits<InputIterator>::iterator_category());
+		}
+
+		small_vector(const small_vector &x)
+			: _alloc(x._alloc), _data(inline_data()), _size(0), _capacity(N)
+		{
+			reserve(x._size);
+			ft::uninitialized_copy_n(_alloc, x._data, x._size, _data);
+			_size = x._size;
+		}
+
+		~small_vector(void)
+		{
+			ft::destroy_n(_alloc, _data, _size);
+			release();
+		}
+
+		/** Keeps the current storage (inline or not) when x fits in it.*/
+		small_vector &operator=(const small_vector &x)
+		{
+			if (this != &x)
+			{
+				clear();
+				reserve(x._size);
+				ft::uninitialized_copy_n(_alloc, x._data, x._size, _data);
+				_size = x._size;
+			}
+			return (*this);
+		}
+
+		/*************************** Iterators *****************************/
+		iterator begin() { return (iterator(_data)); }
+		const_iterator begin() const { return (const_iterator(_data)); }
+		iterator end() { return (iterator(_data + _size)); }
+		const_iterator end() const { return (const_iterator(_data + _size)); }
+		reverse_iterator rbegin() { return (reverse_iterator(end() - 1)); }
+		const_reverse_iterator rbegin() const { return (const_reverse_iterator(_data + _size - 1)); }
+		reverse_iterator rend() { return (reverse_iterator(_data - 1)); }
+		const_reverse_iterator rend() const { return (const_reverse_iterator(_data - 1)); }
+
+		/*************************** Capacity *****************************/
+		size_type size(void) const { return (_size); }
+		size_type max_size(void) const { return (_alloc.max_size()); }
+		size_type capacity(void) const { return (_capacity); }
+		bool empty(void) const { return (_size == 0); }
+
+		/** @return the capacity left unused (capacity() - size()).*/
+		size_type slack(void) const { return (_capacity - _size); }
+
+		/** @return Whether the elements are stored inline (nothing allocated).*/
+		bool is_inline(void) const { return (_data == inline_data()); }
+
+		void resize(size_type n, value_type val = value_type())
+		{
+			if (n > _size)
+			{
+				if (n > _capacity)
+					reserve(grow_to(n));
+				ft::uninitialized_fill_n(_alloc, _data + _size, n - _size, val);
+			}
+			else
+				ft::destroy_n(_alloc, _data + n, _size - n);
+			_size = n;
+		}
+
+		/** As vector::resize_uninitialized(): trivial types only.*/
+		void resize_uninitialized(size_type n)
+		{
+			ft::static_check<ft::is_trivial<value_type>::value>::holds();
+			if (n > _capacity)
+				reserve(grow_to(n));
+			_size = n;
+		}
+
+		/** @return the first of n uninitialized elements added at the end.*/
+		pointer append_uninitialized(size_type n)
+		{
+			size_type old_size = _size;
+
+			resize_uninitialized(_size + n);
+			return (_data + old_size);
+		}
+
+		/** Moves the elements to the heap if n exceeds the capacity.*/
+		void reserve(size_type n)
+		{
+			if (n <= _capacity)
+				return;
+			value_type *tmp = _alloc.allocate(n);
+			ft::uninitialized_relocate_n(_alloc, _data, _size, tmp);
+			release();
+			_data = tmp;
+			_capacity = n;
+		}
+
+		/**
+		 * Gives the unused heap storage back: the elements move inline when
+		 * they fit, to an exact allocation otherwise.
+		*/
+		void shrink_to_fit(void)
+		{
+			if (is_inline() || _capacity == _size)
+				return;
+			value_type *tmp = _size > N ? _alloc.allocate(_size) : inline_data();
+			ft::uninitialized_relocate_n(_alloc, _data, _size, tmp);
+			release();
+			_data = tmp;
+			_capacity = _size > N ? _size : N;
+		}
+
+		/*************************** Element access *****************************/
+		reference operator[](size_type n) { return (_data[n]); }
+		const_reference operator[](size_type n) const { return (_data[n]); }
+
+		reference at(size_type n)
+		{
+			if (n >= _size)
+				throw(std::out_of_range("ft::small_vector::Out-of-Range"));
+			return (_data[n]);
+		}
+
+		const_reference at(size_type n) const
+		{
+			if (n >= _size)
+				throw(std::out_of_range("ft::small_vector::Out-of-Range"));
+			return (_data[n]);
+		}
+
+		reference front(void) { return (_data[0]); }
+		const_reference front(void) const { return (_data[0]); }
+		reference back(void) { return (_data[_size - 1]); }
+		const_reference back(void) const { return (_data[_size - 1]); }
+
+		/*************************** Modifiers *****************************/
+		void assign(size_type n, const value_type &val)
+		{
+			value_type copy(val); // val may be one of the elements destroyed
+
+			clear();
+			reserve(n);
+			ft::uninitialized_fill_n(_alloc, _data, n, copy);
+			_size = n;
+		}
+
+		template <class InputIterator>
+		void assign(InputIterator first, InputIterator last,
+			typename ft::enable_if<!ft::is_integral<InputIterator>::value, int>::type = 0)
+		{
+			assign_range(first, last, typename ft::iterator_traits<InputIterator>::iterator_category());
+		}
+
+		void push_back(const value_type &val)
+		{
+			if (_size == _capacity)
+			{
+				value_type copy(val); // val may be one of the elements moved
+				reserve(grow_to(_size + 1));
+				_alloc.construct(_data + _size, copy);
+			}
+			else
+				_alloc.construct(_data + _size, val);
+			_size++;
+		}
+
+		void pop_back(void)
+		{
+			if (_size)
+			{
+				_alloc.destroy(_data + _size - 1);
+				_size--;
+			}
+		}
+
+		iterator insert(iterator position, const value_type &val)
+		{
+			size_type index = position - begin();
+
+			insert(position, 1, val);
+			return (iterator(_data + index));
+		}
+
+		/** The tail is shifted once in place, or moved once when it must grow.*/
+		void insert(iterator position, size_type n, const value_type &val)
+		{
+			size_type index = position - begin();
+
+			if (n == 0)
+				return;
+			if (_size + n > _capacity)
+			{
+				size_type capacity = grow_to(_size + n);
+				value_type *tmp = _alloc.allocate(capacity);
+				ft::uninitialized_fill_n(_alloc, tmp + index, n, val);
+				move_storage(tmp, capacity, index, n);
+				return;
+			}
+			ft::insert_in_place_n(_alloc, _data, _size, index, n, val);
+			_size += n;
+		}
+
+		/** As vector::insert(): forward ranges are measured first, input ranges rotated in.*/
+		template <class InputIterator>
+		void insert(iterator position, InputIterator first, InputIterator last,
+			typename ft::enable_if<!ft::is_integral<InputIterator>::value, int>::type = 0)
+		{
+			insert_range(position - begin(), first, last,
+				typename ft::iterator_traits<InputIterator>::iterator_category());
+		}
+
+		iterator erase(iterator position)
+		{
+			return (erase(position, position + 1));
+		}
+
+		iterator erase(iterator first, iterator last)
+		{
+			size_type index = first - begin();
+			size_type n = last - first;
+
+			if (n == 0)
+				return (first);
+			ft::shift_down(_alloc, _data, _size, index, n);
+			_size -= n;
+			return (first);
+		}
+
+		/**
+		 * Heap storage is exchanged by pointer, inline elements are moved one
+		 * by one (at most N each way).
+		*/
+		void swap(small_vector &x)
+		{
+			small_vector tmp(_alloc);
+
+			tmp.take(x);
+			x.take(*this);
+			take(tmp);
+		}
+
+		void clear(void)
+		{
+			ft::destroy_n(_alloc, _data, _size);
+			_size = 0;
+		}
+
+		allocator_type get_allocator() const
+		{
+			return (_alloc);
+		}
+
+			private:
+		value_type *inline_data(void)
+		{
+			return (reinterpret_cast<value_type *>(_inline.bytes));
+		}
+
+		const value_type *inline_data(void) const
+		{
+			return (reinterpret_cast<const value_type *>(_inline.bytes));
+		}
+
+		/** Frees the heap storage, if any; the elements must be gone.*/
+		void release(void)
+		{
+			if (!is_inline())
+				_alloc.deallocate(_data, _capacity);
+		}
+
+		/** Capacity to hold needed elements, from the growth policy.*/
+		size_type grow_to(size_type needed) const
+		{
+			return (Growth::grow(_capacity, needed, sizeof(value_type)));
+		}
+
+		/**
+		 * Takes the elements of from, which is left empty and inline. This
+		 * must be empty and inline.
+		*/
+		void take(small_vector &from)
+		{
+			if (from.is_inline())
+				ft::uninitialized_relocate_n(_alloc, from._data, from._size, _data);
+			else
+			{
+				_data = from._data;
+				_capacity = from._capacity;
+				from._data = from.inline_data();
+				from._capacity = N;
+			}
+			_size = from._size;
+			from._size = 0;
+		}
+
+		/** Forward ranges are measured first, for one exact allocation.*/
+		template <class ForwardIterator>
+		void assign_range(ForwardIterator first, ForwardIterator last, std::forward_iterator_tag)
+		{
+			size_type n = ft::distance(first, last);
+
+			clear();
+			reserve(n);
+			for (; first != last; ++first, ++_size)
+				_alloc.construct(_data + _size, *first);
+		}
+
+		template <class InputIterator>
+		void assign_range(InputIterator first, InputIterator last, std::input_iterator_tag)
+		{
+			clear();
+			for (; first != last; ++first)
+				push_back(*first);
+		}
+
+		template <class ForwardIterator>
+		void insert_range(size_type index, ForwardIterator first, ForwardIterator last, std::forward_iterator_tag)
+		{
+			size_type n = ft::distance(first, last);
+
+			if (n == 0)
+				return;
+			if (_size + n > _capacity)
+			{
+				size_type capacity = grow_to(_size + n);
+				value_type *tmp = _alloc.allocate(capacity);
+				ft::uninitialized_copy_range(_alloc, first, last, tmp + index);
+				move_storage(tmp, capacity, index, n);
+				return;
+			}
+			ft::insert_in_place(_alloc, _data, _size, index, first, n);
+			_size += n;
+		}
+
+		template <class InputIterator>
+		void insert_range(size_type index, InputIterator first, InputIterator last, std::input_iterator_tag)
+		{
+			ft::insert_by_rotation(*this, index, first, last);
+		}
+
+		/**
+		 * Moves the elements to tmp, of the given capacity, leaving the n slots
+		 * from index (already constructed by the caller) between them.
+		*/
+		void move_storage(value_type *tmp, size_type capacity, size_type index, size_type n)
+		{
+			ft::relocate_around(_alloc, _data, _size, index, n, tmp);
+			release();
+			_data = tmp;
+			_capacity = capacity;
+			_size += n;
+		}
+	};
+
+	/*************************** Relational operators *****************************/
+	template <class T, size_t N, class Alloc, class Growth>
+	bool operator==(const small_vector<T, N, Alloc, Growth> &lhs, const small_vector<T, N, Alloc, Growth> &rhs)
+	{
+		return (lhs.size() == rhs.size() && ft::equal(lhs.begin(), lhs.end(), rhs.begin()));
+	}
+
+	template <class T, size_t N, class Alloc, class Growth>
+	bool operator!=(const small_vector<T, N, Alloc, Growth> &lhs, const small_vector<T, N, Alloc, Growth> &rhs)
+	{
+		return (!(lhs == rhs));
+	}
+
+	template <class T, size_t N, class Alloc, class Growth>
+	bool operator<(const small_vector<T, N, Alloc, Growth> &lhs, const small_vector<T, N, Alloc, Growth> &rhs)
+	{
+		return (ft::lexicographical_compare(lhs.begin(), lhs.end(), rhs.begin(), rhs.end()));
+	}
+
+	template <class T, size_t N, class Alloc, class Growth>
+	bool operator<=(const small_vector<T, N, Alloc, Growth> &lhs, const small_vector<T, N, Alloc, Growth> &rhs)
+	{
+		return (!(rhs < lhs));
+	}
+
+	template <class T, size_t N, class Alloc, class Growth>
+	bool operator>(const small_vector<T, N, Alloc, Growth> &lhs, const small_vector<T, N, Alloc, Growth> &rhs)
+	{
+		return (rhs < lhs);
+	}
+
+	template <class T, size_t N, class Alloc, class Growth>
+	bool operator>=(const small_vector<T, N, Alloc, Growth> &lhs, const small_vector<T, N, Alloc, Growth> &rhs)
+	{
+		return (!(lhs < rhs));
+	}
+
+	template <class T, size_t N, class Alloc, class Growth>
+	void swap(small_vector<T, N, Alloc, Growth> &x, small_vector<T, N, Alloc, Growth> &y)
+	{
+		x.swap(y);
+	}
+}
+
+#endif
@@ -0,0 +1,90 @@
+#ifndef THREAD_SLOT_HPP
+#define THREAD_SLOT_HPP
+
+#include <pthread.h>
+#include <stdexcept>
+
+namespace ft
+{
+	/**
+	 * Small dense ids for the running threads, so the concurrent containers
+	 * can give each thread its own slot in a fixed array. A thread gets the
+	 * lowest free id on its first call to id() and gives it back when it exits.
+	*/
+	struct thread_slot
+	{
+		static const int max_threads = 128;
+
+		/** Id of the calling thread, in [0, max_threads).*/
+		static int id()
+		{
+			static __thread int slot = -1;
+
+			if (slot < 0)
+				slot = acquire();
+			return (slot);
+		}
+
+		/** One past the highest id handed out so far: the slots worth scanning.*/
+		static int high_water()
+		{
+			return (__atomic_load_n(&registry().high, __ATOMIC_ACQUIRE));
+		}
+
+	private:
+		static const int word_bits = 8 * sizeof(unsigned long);
+
+		struct state
+		{
+			unsigned long	used[max_threads / word_bits];
+			int				high;
+			pthread_key_t	key;
+		};
+
+		static state &registry()
+		{
+			static state s; // zero initialized before any thread can start
+			return (s);
+		}
+
+		static void create_key()
+		{
+			pthread_key_create(&registry().key, &release);
+		}
+
+		static int acquire()
+		{
+			static pthread_once_t once = PTHREAD_ONCE_INIT;
+			state &s = registry();
+
+			pthread_once(&once, &create_key);
+			for (int i = 0; i < max_threads; i++)
+			{
+				unsigned long *word = &s.used[i / word_bits];
+				unsigned long bit = 1UL << (i % word_bits);
+				unsigned long old = __atomic_load_n(word, __ATOMIC_RELAXED);
+
+				while (!(old & bit) && !__sync_bool_compare_and_swap(word, old, old | bit))
+					old = __atomic_load_n(word, __ATOMIC_RELAXED);
+				if (old & bit)
+					continue;
+				int high = __atomic_load_n(&s.high, __ATOMIC_RELAXED);
+				while (high < i + 1 && !__sync_bool_compare_and_swap(&s.high, high, i + 1))
+					high = __atomic_load_n(&s.high, __ATOMIC_RELAXED);
+				pthread_setspecific(s.key, reinterpret_cast<void *>(i + 1L));
+				return (i);
+			}
+			throw std::length_error("ft::thread_slot: too many threads");
+		}
+
+		/* pthread key destructor: the thread exits, its id is free again.*/
+		static void release(void *value)
+		{
+			long i = reinterpret_cast<long>(value) - 1;
+
+			__sync_fetch_and_and(&registry().used[i / word_bits], ~(1UL << (i % word_bits)));
+		}
+	};
+}
+
+#endif
@@ -0,0 +1,240 @@
+#ifndef TREE_RANGE_HPP
+#define TREE_RANGE_HPP
+
+#include "parallel.hpp"
+
+/*
+Splittable ranges over the ordered trees (ft::map, ft::set), and the parallel
+traversals built on them: parallel_for_each and parallel_reduce visit the
+elements in place, with no copy into a vector first.
+
+A range is cut at its shallowest node after the first element, found from the
+parent links in O(log n): cutting a whole tree splits it at the root, then at
+the roots of its subtrees, and so on. The trees keep no subtree sizes, so
+nothing bounds how uneven a cut is: the two subtrees of a red-black or AVL
+node may differ a lot in size (a balanced height only bounds their heights),
+and a splay tree may be a path. Ranges under ft::parallel_grain elements are
+not split: they run on the calling thread.
+*/
+
+namespace ft
+{
+	/**
+	 * Iteration range [first, last) of a tree, splittable in O(log n).
+	 * @param Iterator An iterator of ft::map or ft::set.
+	*/
+	template <class Iterator>
+	class tree_range
+	{
+	public:
+		typedef Iterator							iterator;
+		typedef typename Iterator::node_pointer		node_pointer;
+
+		tree_range(Iterator first, Iterator last) : _first(first), _last(last) {}
+
+		Iterator begin(void) const { return (_first); }
+		Iterator end(void) const { return (_last); }
+
+		bool empty(void) const
+		{
+			return (_first == _last);
+		}
+
+		/** True when split() can cut the range: it holds two elements or more.*/
+		bool is_divisible(void) const
+		{
+			if (empty())
+				return (false);
+			Iterator second = _first;
+			return (++second != _last);
+		}
+
+		/** True when the range holds n elements or more; walks at most n of them.*/
+		bool holds(size_t n) const
+		{
+			Iterator it = _first;
+
+			for (; n && it != _last; n--)
+				++it;
+			return (n == 0);
+		}
+
+		/**
+		 * Cuts the range in two at its shallowest node after the first
+		 * element: the range keeps what comes before it, the returned range
+		 * starts at it. The range must be divisible.
+		*/
+		tree_range split(void)
+		{
+			Iterator second = _first;
+			Iterator back = _last;
+
+			++second;
+			--back;
+			Iterator middle(ancestor(node(second), node(back)));
+			tree_range upper(middle, _last);
+			_last = middle;
+			return (upper);
+		}
+
+	private:
+		Iterator	_first;
+		Iterator	_last;
+
+		static node_pointer node(Iterator it)
+		{
+			return (it.get_node_pointer());
+		}
+
+		static int depth(node_pointer node)
+		{
+			int d = 0;
+
+			for (; node->parent; node = node->parent)
+				d++;
+			return (d);
+		}
+
+		/* Lowest common ancestor, between a and b in key order.*/
+		static node_pointer ancestor(node_pointer a, node_pointer b)
+		{
+			int da = depth(a);
+			int db = depth(b);
+
+			for (; da > db; da--)
+				a = a->parent;
+			for (; db > da; db--)
+				b = b->parent;
+			while (a != b)
+			{
+				a = a->parent;
+				b = b->parent;
+			}
+			return (a);
+		}
+	};
+
+	/* Whether range is worth a fork: threads to spare and ft::parallel_grain elements.*/
+	template <class Iterator>
+	bool worth_splitting(const tree_range<Iterator> &range, size_t threads)
+	{
+		return (threads > 1 && range.holds(ft::parallel_grain) && range.is_divisible());
+	}
+
+	template <class Iterator, class Function>
+	void parallel_for_each(tree_range<Iterator> range, Function f, size_t threads);
+
+	template <class Iterator, class Function>
+	struct for_each_task
+	{
+		tree_range<Iterator>	range;
+		Function				f;
+		size_t					threads;
+
+		for_each_task(const tree_range<Iterator> &range, Function f, size_t threads)
+			: range(range), f(f), threads(threads) {}
+
+		void operator()(void)
+		{
+			parallel_for_each(range, f, threads);
+		}
+	};
+
+	/**
+	 * Calls f on every element of range, the range split among up to threads
+	 * threads, each with its own copy of f; parts under ft::parallel_grain
+	 * elements are not split further. f must be safe to run on several
+	 * elements at once. If a copy of f throws on another thread, the
+	 * exception is lost and std::bad_alloc is thrown instead (see
+	 * parallel.hpp).
+	*/
+	template <class Iterator, class Function>
+	void parallel_for_each(tree_range<Iterator> range, Function f, size_t threads)
+	{
+		if (!worth_splitting(range, threads))
+		{
+			for (Iterator it = range.begin(); it != range.end(); ++it)
+				f(*it);
+			return;
+		}
+		tree_range<Iterator> upper = range.split();
+		for_each_task<Iterator, Function> lower(range, f, threads / 2);
+		ft::fork_task<for_each_task<Iterator, Function> > fork(lower);
+
+		parallel_for_each(upper, f, threads - threads / 2);
+		if (!fork.join())
+			throw std::bad_alloc();
+	}
+
+	/** parallel_for_each(first, last, f) on par.threads threads.*/
+	template <class Iterator, class Function>
+	void parallel_for_each(Iterator first, Iterator last, Function f, const ft::parallel &par)
+	{
+		parallel_for_each(tree_range<Iterator>(first, last), f, par.threads);
+	}
+
+	template <class Iterator, class T, class Reduce, class Combine>
+	T parallel_reduce(tree_range<Iterator> range, const T &identity, Reduce reduce,
+		Combine combine, size_t threads);
+
+	template <class Iterator, class T, class Reduce, class Combine>
+	struct reduce_task
+	{
+		tree_range<Iterator>	range;
+		const T					&identity;
+		Reduce					reduce;
+		Combine					combine;
+		size_t					threads;
+		T						result;
+
+		reduce_task(const tree_range<Iterator> &range, const T &identity, Reduce reduce,
+			Combine combine, size_t threads)
+			: range(range), identity(identity), reduce(reduce), combine(combine),
+			threads(threads), result(identity) {}
+
+		void operator()(void)
+		{
+			result = parallel_reduce(range, identity, reduce, combine, threads);
+		}
+	};
+
+	/**
+	 * Folds range in key order: every part of it is folded from identity
+	 * with value = reduce(value, element), on up to threads threads, then
+	 * the parts are merged left to right with combine(left, right). combine
+	 * must be associative with identity as its identity; it need not be
+	 * commutative. Exceptions as parallel_for_each.
+	*/
+	template <class Iterator, class T, class Reduce, class Combine>
+	T parallel_reduce(tree_range<Iterator> range, const T &identity, Reduce reduce,
+		Combine combine, size_t threads)
+	{
+		if (!worth_splitting(range, threads))
+		{
+			T value = identity;
+			for (Iterator it = range.begin(); it != range.end(); ++it)
+				value = reduce(value, *it);
+			return (value);
+		}
+		tree_range<Iterator> upper = range.split();
+		reduce_task<Iterator, T, Reduce, Combine> lower(range, identity, reduce, combine,
+			threads / 2);
+		ft::fork_task<reduce_task<Iterator, T, Reduce, Combine> > fork(lower);
+
+		T value = parallel_reduce(upper, identity, reduce, combine, threads - threads / 2);
+		if (!fork.join())
+			throw std::bad_alloc();
+		return (combine(lower.result, value));
+	}
+
+	/** parallel_reduce over [first, last) on par.threads threads.*/
+	template <class Iterator, class T, class Reduce, class Combine>
+	T parallel_reduce(Iterator first, Iterator last, const T &identity, Reduce reduce,
+		Combine combine, const ft::parallel &par)
+	{
+		return (parallel_reduce(tree_range<Iterator>(first, last), identity, reduce,
+			combine, par.threads));
+	}
+}
+
+#endif
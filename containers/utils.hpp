@@ -14,6 +14,10 @@
 # define UTILS_H
 
 #include <string>
+#include <memory>
+#include <cstring>
+#include <algorithm>
+#include "pair.hpp"
 
 namespace ft{
 	
@@ -122,6 +126,253 @@ namespace ft{
 	template <> struct is_integral<unsigned long long int> : public true_type {};
 	template <> struct is_integral<__int128_t> : public true_type {};
 	template <> struct is_integral<__uint128_t> : public true_type {};
+
+	/***************************Trivial types*****************************/
+	/**
+	 * is_trivially_copyable: objects of type T can be copied with memcpy
+	 * (no user defined copy, assignment or destructor). Read from the
+	 * compiler; specialize it for a type whose copy is a byte copy anyway.
+	*/
+	template <class T>
+	struct is_trivially_copyable : public integral_constant<bool, __is_trivially_copyable(T)> {};
+
+	/**
+	 * is_trivially_destructible: destroying an object of type T does
+	 * nothing, so a range of them is dropped without a loop.
+	*/
+	template <class T>
+	struct is_trivially_destructible : public integral_constant<bool, __has_trivial_destructor(T)> {};
+
+	/**
+	 * is_trivial: trivially copyable, and constructed by default without
+	 * running any code, so raw bytes are as good as a default constructed T.
+	*/
+	template <class T>
+	struct is_trivial : public integral_constant<bool, __is_trivial(T)> {};
+
+	/**
+	 * static_check<Cond>::holds() only compiles when Cond is true: a C++98
+	 * static_assert, to keep a member of a container template to the element
+	 * types it is safe for (the error names static_check<false>). At class
+	 * scope, a typedef of sizeof(static_check<Cond>) keeps the whole class.
+	*/
+	template <bool Cond> struct static_check;
+	template <> struct static_check<true> { static void holds(void) {} };
+
+	/**
+	 * is_trivially_relocatable: an object of type T may be moved to another
+	 * address by copying its bytes, the old bytes being dropped without
+	 * running the destructor. Every trivially copyable type is, and so are
+	 * most types that own memory but hold no pointer into themselves
+	 * (ft::vector for one). Specialize it to declare such a type:
+	 * containers then move it with memcpy when they grow.
+	*/
+	template <class T>
+	struct is_trivially_relocatable : public is_trivially_copyable<T> {};
+
+	template <class T>
+	struct is_trivially_relocatable<std::allocator<T> > : public true_type {};
+
+	template <class T1, class T2>
+	struct is_trivially_relocatable<ft::pair<T1, T2> >
+		: public integral_constant<bool, is_trivially_relocatable<T1>::value
+			&& is_trivially_relocatable<T2>::value> {};
+
+	/***************************Bulk construction*****************************/
+	/*
+	Constructors and destructors of n elements in raw storage, as containers
+	need them: one memcpy, memset or nothing for the types above, and the
+	allocator's construct and destroy for each element otherwise.
+	*/
+
+	/** Copies the n elements at src into the raw storage at dest.*/
+	template <class Alloc, class T>
+	void uninitialized_copy_n(Alloc &alloc, const T *src, size_t n, T *dest, false_type){
+		for (size_t i = 0; i < n; i++)
+			alloc.construct(dest + i, src[i]);
+	}
+
+	template <class Alloc, class T>
+	void uninitialized_copy_n(Alloc &, const T *src, size_t n, T *dest, true_type){
+		if (n)
+			std::memcpy(static_cast<void *>(dest), src, n * sizeof(T));
+	}
+
+	template <class Alloc, class T>
+	void uninitialized_copy_n(Alloc &alloc, const T *src, size_t n, T *dest){
+		uninitialized_copy_n(alloc, src, n, dest, typename is_trivially_copyable<T>::type());
+	}
+
+	/** Constructs n copies of val in the raw storage at dest.*/
+	template <class Alloc, class T>
+	void uninitialized_fill_n(Alloc &alloc, T *dest, size_t n, const T &val, false_type){
+		for (size_t i = 0; i < n; i++)
+			alloc.construct(dest + i, val);
+	}
+
+	template <class Alloc, class T>
+	void uninitialized_fill_n(Alloc &, T *dest, size_t n, const T &val, true_type){
+		const unsigned char *bytes = reinterpret_cast<const unsigned char *>(&val);
+		size_t same = 1;
+
+		while (same < sizeof(T) && bytes[same] == bytes[0])
+			same++;
+		if (same == sizeof(T))
+			std::memset(static_cast<void *>(dest), bytes[0], n * sizeof(T));
+		else
+			for (size_t i = 0; i < n; i++)
+				std::memcpy(static_cast<void *>(dest + i), &val, sizeof(T));
+	}
+
+	template <class Alloc, class T>
+	void uninitialized_fill_n(Alloc &alloc, T *dest, size_t n, const T &val){
+		uninitialized_fill_n(alloc, dest, n, val, typename is_trivially_copyable<T>::type());
+	}
+
+	/**
+	 * Moves the n elements at src to the raw storage at dest, which must not
+	 * overlap it; src is left raw.
+	*/
+	template <class Alloc, class T>
+	void uninitialized_relocate_n(Alloc &alloc, T *src, size_t n, T *dest, false_type){
+		for (size_t i = 0; i < n; i++){
+			alloc.construct(dest + i, src[i]);
+			alloc.destroy(src + i);
+		}
+	}
+
+	template <class Alloc, class T>
+	void uninitialized_relocate_n(Alloc &, T *src, size_t n, T *dest, true_type){
+		if (n)
+			std::memcpy(static_cast<void *>(dest), static_cast<void *>(src), n * sizeof(T));
+	}
+
+	template <class Alloc, class T>
+	void uninitialized_relocate_n(Alloc &alloc, T *src, size_t n, T *dest){
+		uninitialized_relocate_n(alloc, src, n, dest, typename is_trivially_relocatable<T>::type());
+	}
+
+	/** Destroys the n elements at first.*/
+	template <class Alloc, class T>
+	void destroy_n(Alloc &alloc, T *first, size_t n, false_type){
+		for (size_t i = 0; i < n; i++)
+			alloc.destroy(first + i);
+	}
+
+	template <class Alloc, class T>
+	void destroy_n(Alloc &, T *, size_t, true_type) {}
+
+	template <class Alloc, class T>
+	void destroy_n(Alloc &alloc, T *first, size_t n){
+		destroy_n(alloc, first, n, typename is_trivially_destructible<T>::type());
+	}
+
+	/*
+	Insertion and erasure inside contiguous storage, shared by the vectors:
+	data holds size elements and has room for n more, the caller owning the
+	storage and its size.
+	*/
+
+	/** Constructs the range [first, last) in the raw storage at dest.*/
+	template <class Alloc, class T, class ForwardIterator>
+	void uninitialized_copy_range(Alloc &alloc, ForwardIterator first, ForwardIterator last, T *dest){
+		for (; first != last; ++first, ++dest)
+			alloc.construct(dest, *first);
+	}
+
+	/**
+	 * Moves the size elements at data to the raw storage at dest, leaving
+	 * the n slots from index (constructed by the caller) between them.
+	*/
+	template <class Alloc, class T>
+	void relocate_around(Alloc &alloc, T *data, size_t size, size_t index, size_t n, T *dest){
+		uninitialized_relocate_n(alloc, data, index, dest);
+		uninitialized_relocate_n(alloc, data + index, size - index, dest + index + n);
+	}
+
+	/**
+	 * Moves [index, size) n places up, each element once. Relocatable types
+	 * are moved with one memmove and leave the n slots from index raw; the
+	 * others leave the slots below size holding stale elements, to be
+	 * assigned rather than constructed.
+	 * @return the end of the stale slots.
+	*/
+	template <class Alloc, class T>
+	size_t shift_up(Alloc &alloc, T *data, size_t size, size_t index, size_t n){
+		if (is_trivially_relocatable<T>::value){
+			std::memmove(static_cast<void *>(data + index + n), static_cast<void *>(data + index),
+				(size - index) * sizeof(T));
+			return (index);
+		}
+		for (size_t i = size; i-- > index; ){
+			if (i + n >= size)
+				alloc.construct(data + i + n, data[i]);
+			else
+				data[i + n] = data[i];
+		}
+		return (index + n < size ? index + n : size);
+	}
+
+	/** Fills slot i after shift_up(), which returned stale.*/
+	template <class Alloc, class T, class U>
+	void put_shifted(Alloc &alloc, T *data, size_t i, size_t stale, const U &val){
+		if (i < stale)
+			data[i] = val;
+		else
+			alloc.construct(data + i, val);
+	}
+
+	/** Inserts n copies of val at index; val may be one of the elements shifted.*/
+	template <class Alloc, class T>
+	void insert_in_place_n(Alloc &alloc, T *data, size_t size, size_t index, size_t n, const T &val){
+		T copy(val);
+		size_t stale = shift_up(alloc, data, size, index, n);
+
+		for (size_t i = index; i < index + n; i++)
+			put_shifted(alloc, data, i, stale, copy);
+	}
+
+	/** Inserts the n elements of [first, ...) at index.*/
+	template <class Alloc, class T, class ForwardIterator>
+	void insert_in_place(Alloc &alloc, T *data, size_t size, size_t index, ForwardIterator first, size_t n){
+		size_t stale = shift_up(alloc, data, size, index, n);
+
+		for (size_t i = index; i < index + n; ++first, ++i)
+			put_shifted(alloc, data, i, stale, *first);
+	}
+
+	/** Removes the n elements from index, moving the tail down once.*/
+	template <class Alloc, class T>
+	void shift_down(Alloc &alloc, T *data, size_t size, size_t index, size_t n, true_type){
+		destroy_n(alloc, data + index, n);
+		std::memmove(static_cast<void *>(data + index), static_cast<void *>(data + index + n),
+			(size - index - n) * sizeof(T));
+	}
+
+	template <class Alloc, class T>
+	void shift_down(Alloc &alloc, T *data, size_t size, size_t index, size_t n, false_type){
+		for (size_t i = index; i + n < size; i++)
+			data[i] = data[i + n];
+		destroy_n(alloc, data + size - n, n);
+	}
+
+	template <class Alloc, class T>
+	void shift_down(Alloc &alloc, T *data, size_t size, size_t index, size_t n){
+		shift_down(alloc, data, size, index, n, typename is_trivially_relocatable<T>::type());
+	}
+
+	/**
+	 * Inserts an input range, read once, at index of v: pushed back, then
+	 * rotated into place.
+	*/
+	template <class Vector, class InputIterator>
+	void insert_by_rotation(Vector &v, size_t index, InputIterator first, InputIterator last){
+		size_t old_size = v.size();
+
+		for (; first != last; ++first)
+			v.push_back(*first);
+		std::rotate(v.begin() + index, v.begin() + old_size, v.end());
+	}
 }
 
-#endif
\ No newline at end of file
+#endif
@@ -17,11 +17,14 @@
 #include "random_access_iterator.hpp"
 #include "reverse_iterator.hpp"
 #include "algorithm.hpp"
+#include "growth.hpp"
+#include "iterator_traits.hpp"
+#include <algorithm>
 
 
 namespace ft
 {
-	template <class T, class Alloc = std::allocator<T> > 
+	template <class T, class Alloc = std::allocator<T>, class Growth = ft::growth_double> 
 	class vector{
 		/*Vectors are the same as dynamic arrays with the ability to resize itself 
 	automatically when an element is inserted or deleted, with their storage being 
@@ -30,13 +33,15 @@ namespace ft
 	data is inserted at the end. Inserting at the end takes differential time, as 
 	sometimes the array may need to be extended. Removing the last element takes only 
 	constant time because no resizing happens. Inserting and erasing at the beginning 
-	or in the middle is linear in time.*/
+	or in the middle is linear in time.
+	How much the storage grows is set by the Growth policy (growth.hpp).*/
       public:
 	/*=================
 			MEMBER TYPES
 	=================*/
 	typedef T value_type;
 	typedef Alloc allocator_type;
+	typedef Growth growth_policy;
 	typedef typename Alloc::pointer pointer;
 	typedef typename Alloc::const_pointer const_pointer;
 	typedef typename Alloc::reference reference;
@@ -90,8 +95,7 @@ namespace ft
 	    : _alloc(alloc), _data(NULL), _size(0), _capacity(0)
 	{
 		this->reserve(n);
-		for (size_type i = 0; i < n; i++)
-			this->_alloc.construct(this->_data + i, val);
+		ft::uninitialized_fill_n(this->_alloc, this->_data, n, val);
 		this->_size = n;
 	}
 	/**
@@ -99,40 +103,33 @@ namespace ft
 	 * Constructs a container with as many elements as the range
 	 * [first,last), with each element constructed from its corresponding
 	 * element in that range, in the same order.
+	 * Forward ranges are measured first and allocated once, at their exact
+	 * size; input ranges (read once) grow like push_back.
 	*/
 	template <class InputIterator>
 	vector(InputIterator first, InputIterator last,
 	       const allocator_type &alloc = allocator_type(),
 	       typename ft::enable_if<!ft::is_integral<InputIterator>::value, InputIterator>::type = InputIterator())
+	    : _alloc(alloc), _data(NULL), _size(0), _capacity(0)
 	{
-		this->_alloc = alloc;
-		this->_size = last - first;
-		this->_capacity = _size;
-		this->_data = _alloc.allocate(_size);
-		for (size_type i = 0; i < _size; i++)
-		{
-			_alloc.construct(&this->_data[i], *first);
-			first++;
-		}
+		this->assign_range(first, last, typename ft::iterator_traits<InputIterator>::iterator_category());
 	}
 	/**
 	 * ==== copy constructor
 	 * Constructs a container with a copy of each of the elements in x, in the same order.
 	*/
 	vector(const vector &x)
-	    : _alloc(x._alloc), _size(x._size), _capacity(x._size)
+	    : _alloc(x._alloc), _data(NULL), _size(x._size), _capacity(x._size)
 	{
 		if (this->_capacity > 0)
 			this->_data = this->_alloc.allocate(this->_capacity);
-		for (size_type i = 0; i < this->_size; i++)
-			this->_alloc.construct(this->_data + i, x._data[i]);
+		ft::uninitialized_copy_n(this->_alloc, x._data, this->_size, this->_data);
 	}
 	
 	//Destructor
 	~vector(void)
 	{
-		for (size_type i = 0; i < this->_size; i++)
-			this->_alloc.destroy(this->_data + i);
+		ft::destroy_n(this->_alloc, this->_data, this->_size);
 		if (this->_capacity)
 		{
 			this->_alloc.deallocate(this->_data, this->_capacity);
@@ -149,8 +146,7 @@ namespace ft
 			_alloc = other._alloc;
 			if (_capacity)
 				_data = _alloc.allocate(_capacity);
-			for (size_type i = 0; i < _size; i++)
-				_alloc.construct(_data + i, other._data[i]);			
+			ft::uninitialized_copy_n(_alloc, other._data, _size, _data);
 		}
 		return *this;
 	}
@@ -262,23 +258,43 @@ namespace ft
 			if (n > this->_capacity)
 			//If n is also greater than the current container capacity, an automatic 
 			//reallocation of the allocated storage space takes place.
-			{
-				if (n > this->_capacity * 2)
-					this->reserve(n);
-				else
-					this->reserve(this->_capacity * 2);
-			}
-			for (size_type i = this->_size; i < n; i++)
-				this->_alloc.construct(this->_data + i, val);
+				this->reserve(this->grow_to(n));
+			ft::uninitialized_fill_n(this->_alloc, this->_data + this->_size, n - this->_size, val);
 		}
 		else
 		{// If n is smaller than the current container size, the content is reduced to 
 		//its first n elements, removing those beyond (and destroying them).
-			for (size_type i = n; i < this->_size; i++)
-				this->_alloc.destroy(this->_data + i);
+			ft::destroy_n(this->_alloc, this->_data + n, this->_size - n);
 		}
 		this->_size = n;
 	}
+
+	/**
+	 * Changes the size to n like resize(), but leaves the new elements
+	 * uninitialized, for the caller to write (a read() into the buffer):
+	 * growing costs no pass over the new memory. Only for trivial types
+	 * (ft::is_trivial), which have no constructor to skip.
+	*/
+	void resize_uninitialized(size_type n)
+	{
+		ft::static_check<ft::is_trivial<value_type>::value>::holds();
+		if (n > this->_capacity)
+			this->reserve(this->grow_to(n));
+		this->_size = n;
+	}
+
+	/**
+	 * Adds n uninitialized elements at the end, growing like push_back.
+	 * Only for trivial types.
+	 * @return a pointer to the first of them, for the caller to write.
+	*/
+	pointer append_uninitialized(size_type n)
+	{
+		size_type old_size = this->_size;
+
+		this->resize_uninitialized(this->_size + n);
+		return (this->_data + old_size);
+	}
 	
 	/**
 	 * @return the size of the storage space currently allocated 
@@ -286,11 +302,20 @@ namespace ft
 	 * Returns the maximum number of items that can be stored 
 	 * in the vector before it musta be resized.
 	*/
-	size_type capacity(void)
+	size_type capacity(void) const
 	{
 		return (this->_capacity);
 	}
 
+	/**
+	 * @return the capacity left unused (capacity() - size()), to tune the
+	 * growth policy or decide on a shrink_to_fit().
+	*/
+	size_type slack(void) const
+	{
+		return (this->_capacity - this->_size);
+	}
+
 	/**
 	 * @return whether the vector is empty (i.e. whether its size is 0).
 	*/
@@ -313,11 +338,8 @@ namespace ft
 		if (n > this->_capacity)
 		{
 			value_type *tmp = this->_alloc.allocate(n);
-			for (size_type i = 0; i < this->_size; i++)
-			{
-				this->_alloc.construct(tmp + i, this->_data[i]);
-				this->_alloc.destroy(this->_data + i);
-			}
+			// copied then destroyed one by one, or a memcpy for relocatable types
+			ft::uninitialized_relocate_n(this->_alloc, this->_data, this->_size, tmp);
 			if (this->_capacity > 0)
 				this->_alloc.deallocate(_data, _capacity);
 			this->_data = tmp;
@@ -325,6 +347,22 @@ namespace ft
 		}
 	}
 
+	/**
+	 * Reduces the capacity to the size, giving the unused storage back to
+	 * the allocator (all of it when the vector is empty). The elements are
+	 * moved once, so iterators are invalidated.
+	*/
+	void shrink_to_fit(void)
+	{
+		if (this->_capacity == this->_size)
+			return;
+		value_type *tmp = this->_size ? this->_alloc.allocate(this->_size) : NULL;
+		ft::uninitialized_relocate_n(this->_alloc, this->_data, this->_size, tmp);
+		this->_alloc.deallocate(this->_data, this->_capacity);
+		this->_data = tmp;
+		this->_capacity = this->_size;
+	}
+
 	/***************************Element Access*****************************/
 	/**
 	 * @return a reference to the element at position n in the vector container.
@@ -407,10 +445,12 @@ namespace ft
 	*/
 	void assign(size_type n, const value_type &val)
 	{
-		_size = 0;
+		value_type copy(val); // val may be one of the elements destroyed
+
+		clear();
 		reserve(n);
-		for (size_type i = 0; i < n; i++)
-			push_back(val);
+		ft::uninitialized_fill_n(_alloc, _data, n, copy);
+		_size = n;
 	}
 
 	/**
@@ -418,15 +458,13 @@ namespace ft
 	 * In the range version, the new contents are elements 
 	 * constructed from each of the elements 
 	 * in the range between first and last, in the same order.
+	 * A forward range reallocates at most once, to its exact size.
 	*/
 	template <class InputIterator>
 	void assign(InputIterator first, InputIterator last,
 	       typename ft::enable_if<!ft::is_integral<InputIterator>::value, int>::type = 0)
 	{
-		clear();
-		reserve(last - first);
-		while (first != last)
-			push_back(*first++);
+		assign_range(first, last, typename ft::iterator_traits<InputIterator>::iterator_category());
 	}
 
 	/**
@@ -438,12 +476,12 @@ namespace ft
 	{
 		if (_size + 1 > _capacity)
 		{
-			if (_capacity > 0)
-				reserve(_capacity * 2);
-			else
-				reserve(1);
+			value_type copy(val); // val may be one of the elements moved
+			reserve(grow_to(_size + 1));
+			_alloc.construct(_data + _size, copy);
 		}
-		_alloc.construct(_data + _size, val);
+		else
+			_alloc.construct(_data + _size, val);
 		_size++;
 	}
 
@@ -462,27 +500,23 @@ namespace ft
 	/** Insert single element
 	 * The vector is extended by inserting new elements before the element at the specified position, 
 	 * effectively increasing the container size by the number of elements inserted.
+	 * The tail is shifted once, in place, or moved once to the new storage when it must grow.
 	 * @param position the position to insert the element before
 	 * @param val element to be inserted
-	 * @return the number of elements inserted
+	 * @return an iterator to the inserted element
 	*/ 
 	iterator insert(iterator position, const value_type &val)
 	{
-		vector tmp;
 		size_type index = position - begin();
-		size_type tmp_end = end() - position;
-		tmp.assign(position, end());
-		_size = index;
-		push_back(val);
-		for (size_type i = 0; i < tmp_end; ++i)
-			push_back(tmp[i]);
+
+		insert(position, 1, val);
 		return iterator(_data + index);
 	}
 
 	/**
 	 * fill constructor
 	 * Extends vector by inserting new elements in the container. 
-	 * Reallocation happens if there is need of more space
+	 * Reallocation happens at most once, if there is need of more space
 	 * This function increases container size by n.
 	 * @param position - index in the vector where new element to be inserted
 	 * @param n  - number of elements to be inserted
@@ -490,36 +524,38 @@ namespace ft
 	*/
 	void insert(iterator position, size_type n, const value_type &val)
 	{
-		vector tmp(position, end());
 		size_type index = position - begin();
 
-		_size = index;
-		for (size_type i = 0; i < n; i++)
-			push_back(val);
-		for (size_type i = 0; i < tmp.size(); i++)
-			push_back(tmp[i]);
+		if (n == 0)
+			return;
+		if (_size + n > _capacity)
+		{
+			size_type capacity = grow_to(_size + n);
+			value_type *tmp = _alloc.allocate(capacity);
+			ft::uninitialized_fill_n(_alloc, tmp + index, n, val);
+			move_storage(tmp, capacity, index, n);
+			return;
+		}
+		ft::insert_in_place_n(_alloc, _data, _size, index, n, val);
+		_size += n;
 	}
 	
 	/**
 	 * range constructor
 	 * extends vector by inserting new elements in the container. 
-	 * Reallocation happens if there is need of more space
+	 * Reallocation happens at most once for forward ranges, which are measured
+	 * first; input ranges are pushed back then rotated into place.
 	 * This function increases container size.
 	 * @param position - index in the vector where new element to be inserted
 	 * @param first - input iterator to the initial position in the range
 	 * @param second - input iterator to the final position in the range
 	*/
 	template <class InputIterator>
-	void insert(iterator position, InputIterator first, InputIterator last)
+	void insert(iterator position, InputIterator first, InputIterator last,
+	       typename ft::enable_if<!ft::is_integral<InputIterator>::value, int>::type = 0)
 	{
-		vector tmp(position, end());
-		size_type index = position - begin();
-
-		_size = index;
-		while (first != last)
-			push_back(*first++);
-		for (size_type i = 0; i < tmp.size(); i++)
-			push_back(tmp[i]);
+		insert_range(position - begin(), first, last,
+			typename ft::iterator_traits<InputIterator>::iterator_category());
 	}
 
 	/**
@@ -529,16 +565,7 @@ namespace ft
 	*/
 	iterator erase(iterator position)
 	{
-		iterator it;
-		it = position;
-		it++;
-		while (it != end()){
-			_alloc.destroy(&(*(it - 1)));
-			*(it - 1) = *it;
-			it++;
-		}
-		_size--;
-		return position;
+		return (erase(position, position + 1));
 	}
 
 	/**
@@ -546,15 +573,19 @@ namespace ft
 	 * Iterators specifying a range within the vector to be removed: [first,last). i.e., 
 	 * the range includes all the elements between first and last, including the element 
 	 * pointed by first but not the one pointed by last.
+	 * The tail is shifted down once (one memmove for relocatable types).
 	 * @param first the first vector to be removed
 	 * @param last the last vector to be removed
 	 */
 	iterator erase(iterator first, iterator last)
 	{
+		size_type index = first - begin();
 		size_type n = last - first;
-		
-		while (n-- > 0) 
-			this->erase(first);
+
+		if (n == 0)
+			return (first);
+		ft::shift_down(_alloc, _data, _size, index, n);
+		_size -= n;
 		return (first);
 	}
 
@@ -582,8 +613,7 @@ namespace ft
 	*/
 	void clear(void)
 	{
-		for (size_type i = 0; i < _size; i++)
-			_alloc.destroy(_data + i);
+		ft::destroy_n(_alloc, _data, _size);
 		_size = 0;
 	}
 	
@@ -595,7 +625,82 @@ namespace ft
 		return (this->_alloc);
 	}
 
+
+	private:
+	/** Capacity to hold needed elements, from the growth policy.*/
+	size_type grow_to(size_type needed) const
+	{
+		return (Growth::grow(_capacity, needed, sizeof(value_type)));
+	}
+
+	/** Forward ranges are measured first, for one exact allocation.*/
+	template <class ForwardIterator>
+	void assign_range(ForwardIterator first, ForwardIterator last, std::forward_iterator_tag)
+	{
+		size_type n = ft::distance(first, last);
+
+		clear();
+		reserve(n);
+		for (; first != last; ++first, ++_size)
+			_alloc.construct(_data + _size, *first);
+	}
+
+	/** Input ranges are read once: the elements are pushed back as they come.*/
+	template <class InputIterator>
+	void assign_range(InputIterator first, InputIterator last, std::input_iterator_tag)
+	{
+		clear();
+		for (; first != last; ++first)
+			push_back(*first);
+	}
+
+	template <class ForwardIterator>
+	void insert_range(size_type index, ForwardIterator first, ForwardIterator last, std::forward_iterator_tag)
+	{
+		size_type n = ft::distance(first, last);
+
+		if (n == 0)
+			return;
+		if (_size + n > _capacity)
+		{
+			size_type capacity = grow_to(_size + n);
+			value_type *tmp = _alloc.allocate(capacity);
+			ft::uninitialized_copy_range(_alloc, first, last, tmp + index);
+			move_storage(tmp, capacity, index, n);
+			return;
+		}
+		ft::insert_in_place(_alloc, _data, _size, index, first, n);
+		_size += n;
+	}
+
+	/** Input ranges are pushed back, then rotated into place.*/
+	template <class InputIterator>
+	void insert_range(size_type index, InputIterator first, InputIterator last, std::input_iterator_tag)
+	{
+		ft::insert_by_rotation(*this, index, first, last);
+	}
+
+	/**
+	 * Moves the elements to tmp, of the given capacity, leaving the n slots
+	 * from index (already constructed by the caller) between them.
+	*/
+	void move_storage(value_type *tmp, size_type capacity, size_type index, size_type n)
+	{
+		ft::relocate_around(_alloc, _data, _size, index, n, tmp);
+		if (_capacity)
+			_alloc.deallocate(_data, _capacity);
+		_data = tmp;
+		_capacity = capacity;
+		_size += n;
+	}
 };
+	/**
+	 * A vector holds no pointer into itself: it is moved with memcpy when
+	 * its allocator can be.
+	*/
+	template <class T, class Alloc, class Growth>
+	struct is_trivially_relocatable<ft::vector<T, Alloc, Growth> > : public is_trivially_relocatable<Alloc> {};
+
 	/***************************Relational Operators*****************************/
 	//Performs the appropriate comparison operation between the vector containers lhs and rhs.
 
@@ -604,8 +709,8 @@ namespace ft
 	 * vector are considered equivalent if their sizes are equal, 
 	 * and if corresponding elements compare equal.
 	*/
-	template <class T, class Alloc>
-	bool operator==(const vector<T, Alloc> &lhs, const vector<T, Alloc> &rhs)
+	template <class T, class Alloc, class Growth>
+	bool operator==(const vector<T, Alloc, Growth> &lhs, const vector<T, Alloc, Growth> &rhs)
 	{
 		if (lhs.size() == rhs.size())
 			return (ft::equal(lhs.begin(), lhs.end(), rhs.begin()));
@@ -615,8 +720,8 @@ namespace ft
 	/**
 	 * Based on operator != --equivalent operation --- !(a==b)
 	*/
-	template <class T, class Alloc>
-	bool operator!=(const vector<T, Alloc> &lhs, const vector<T, Alloc> &rhs)
+	template <class T, class Alloc, class Growth>
+	bool operator!=(const vector<T, Alloc, Growth> &lhs, const vector<T, Alloc, Growth> &rhs)
 	{
 		return (!(lhs == rhs));
 	}
@@ -627,8 +732,8 @@ namespace ft
 	 * which compares the elements sequentially using operator< in a reciprocal manner 
 	 * (i.e., checking both a<b and b<a) and stopping at the first occurrence.
 	*/
-	template <class T, class Alloc>
-	bool operator<(const vector<T, Alloc> &lhs, const vector<T, Alloc> &rhs)
+	template <class T, class Alloc, class Growth>
+	bool operator<(const vector<T, Alloc, Growth> &lhs, const vector<T, Alloc, Growth> &rhs)
 	{
 		return (ft::lexicographical_compare(lhs.begin(), lhs.end(), rhs.begin(),
 							rhs.end()));
@@ -637,8 +742,8 @@ namespace ft
 	/**
 	 * Based on operator <= --equivalent operation --- !(b<a)
 	 */
-	template <class T, class Alloc>
-	bool operator<=(const vector<T, Alloc> &lhs, const vector<T, Alloc> &rhs)
+	template <class T, class Alloc, class Growth>
+	bool operator<=(const vector<T, Alloc, Growth> &lhs, const vector<T, Alloc, Growth> &rhs)
 	{
 		return (!(rhs < lhs));
 	}
@@ -646,8 +751,8 @@ namespace ft
 	/**
 	 * Based on operator > --equivalent operation --- b<a
 	 */
-	template <class T, class Alloc>
-	bool operator>(const vector<T, Alloc> &lhs, const vector<T, Alloc> &rhs)
+	template <class T, class Alloc, class Growth>
+	bool operator>(const vector<T, Alloc, Growth> &lhs, const vector<T, Alloc, Growth> &rhs)
 	{
 		return (rhs < lhs);
 	}
@@ -655,8 +760,8 @@ namespace ft
 	/**
 	 * Based on operator >= --equivalent operation ---!(a<b)
 	*/
-	template <class T, class Alloc>
-	bool operator>=(const vector<T, Alloc> &lhs, const vector<T, Alloc> &rhs)
+	template <class T, class Alloc, class Growth>
+	bool operator>=(const vector<T, Alloc, Growth> &lhs, const vector<T, Alloc, Growth> &rhs)
 	{
 		return (!(lhs < rhs));
 	}
@@ -665,8 +770,8 @@ namespace ft
 	 * The contents of container x are exchanged with those of y. Both container objects must be 
 	 * of the same type (same template parameters), although sizes may differ.
 	*/
-	template <class T, class Alloc>
-	void swap(vector<T, Alloc> &x, vector<T, Alloc> &y)
+	template <class T, class Alloc, class Growth>
+	void swap(vector<T, Alloc, Growth> &x, vector<T, Alloc, Growth> &y)
 	{
 		x.swap(y);
 	}
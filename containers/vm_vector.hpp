@@ -0,0 +1,440 @@
+#ifndef VM_VECTOR_HPP
+#define VM_VECTOR_HPP
+
+#include "vector.hpp"
+#include <sys/mman.h>
+#include <unistd.h>
+#include <new>
+#include <stdexcept>
+
+/*
+A vector that never moves its elements.
+
+The constructor reserves max_size() elements of address space (64 GiB by
+default) with one mmap(PROT_NONE): no memory, and no commit charge, only
+addresses. Growing makes the next part of that range readable and writable
+(mprotect), and the pages get memory when they are first written. So
+push_back, reserve, resize and insert never copy the elements or
+reallocate, there is no latency spike or doubled footprint while a large
+vector grows, and pointers, references and iterators to the elements stay
+valid as long as the elements themselves (an insert still shifts the tail).
+
+	reserved (PROT_NONE)	max_size() elements, whole pages
+	committed (read/write)	capacity() elements, a prefix of it, doubled
+							(at least 64 KiB) as the vector grows
+	touched					what the elements written so far span
+
+Growing past max_size() throws std::length_error, so the reservation must
+cover the largest size expected: addresses are cheap on 64 bit systems (a
+47 bit user space holds two thousand 64 GiB reservations). shrink_to_fit()
+gives the committed pages past the elements back to the system.
+*/
+
+namespace ft
+{
+	/**
+	 * @param T Type of the elements.
+	*/
+	template <class T>
+	class vm_vector
+	{
+		public:
+		/***************************Member Types*****************************/
+		typedef T value_type;
+		typedef std::allocator<T> allocator_type;	// only constructs and destroys
+		typedef T *pointer;
+		typedef const T *const_pointer;
+		typedef T &reference;
+		typedef const T &const_reference;
+		typedef ft::random_access_iterator<value_type> iterator;
+		typedef ft::random_access_iterator<value_type> const_iterator;
+		typedef ft::reverse_iterator<iterator> reverse_iterator;
+		typedef ft::reverse_iterator<const_iterator> const_reverse_iterator;
+		typedef std::ptrdiff_t difference_type;
+		typedef std::size_t size_type;
+
+		static const size_t default_reservation = (size_t)1 << 36;
+		static const size_t commit_granularity = 64 << 10;
+
+			private:
+		allocator_type	_alloc;
+		value_type		*_data;		// start of the reservation
+		size_type		_size;
+		size_type		_capacity;	// elements in the committed bytes
+		size_t			_committed;	// bytes
+		size_t			_reserved;	// bytes
+
+		public:
+		/*************************** Coplien form *****************************/
+		/** An empty vector, with max_elements of address space.*/
+		explicit vm_vector(size_type max_elements = default_reservation / sizeof(T))
+		{
+			reserve_range(max_elements);
+		}
+
+		explicit vm_vector(size_type n, const value_type &val,
+				size_type max_elements = default_reservation / sizeof(T))
+		{
+			reserve_range(max_elements);
+			reserve(n);
+			ft::uninitialized_fill_n(_alloc, _data, n, val);
+			_size = n;
+		}
+
+		template <class InputIterator>
+		vm_vector(InputIterator first, InputIterator last,
+			size_type max_elements = default_reservation / sizeof(T),
+			typename ft::enable_if<!ft::is_integral<InputIterator>::value, int>::type = 0)
+		{
+			reserve_range(max_elements);
+			assign(first, last);
+		}
+
+		/** The copy has the reservation of x.*/
+		vm_vector(const vm_vector &x)
+		{
+			reserve_range(x.max_size());
+			reserve(x._size);
+			ft::uninitialized_copy_n(_alloc, x._data, x._size, _data);
+			_size = x._size;
+		}
+
+		~vm_vector(void)
+		{
+			ft::destroy_n(_alloc, _data, _size);
+			munmap(_data, _reserved);
+		}
+
+		/** Keeps the reservation of this vector.
+		 * @throw std::length_error when x does not fit in it.
+		*/
+		vm_vector &operator=(const vm_vector &x)
+		{
+			if (this != &x)
+			{
+				clear();
+				reserve(x._size);
+				ft::uninitialized_copy_n(_alloc, x._data, x._size, _data);
+				_size = x._size;
+			}
+			return (*this);
+		}
+
+		/*************************** Iterators *****************************/
+		iterator begin() { return (iterator(_data)); }
+		const_iterator begin() const { return (const_iterator(_data)); }
+		iterator end() { return (iterator(_data + _size)); }
+		const_iterator end() const { return (const_iterator(_data + _size)); }
+		reverse_iterator rbegin() { return (reverse_iterator(end() - 1)); }
+		const_reverse_iterator rbegin() const { return (const_reverse_iterator(_data + _size - 1)); }
+		reverse_iterator rend() { return (reverse_iterator(_data - 1)); }
+		const_reverse_iterator rend() const { return (const_reverse_iterator(_data - 1)); }
+
+		/*************************** Capacity *****************************/
+		size_type size(void) const { return (_size); }
+		/** @return the elements the reservation holds.*/
+		size_type max_size(void) const { return (_reserved / sizeof(T)); }
+		size_type capacity(void) const { return (_capacity); }
+		size_type slack(void) const { return (_capacity - _size); }
+		bool empty(void) const { return (_size == 0); }
+
+		void resize(size_type n, value_type val = value_type())
+		{
+			if (n > _size)
+			{
+				commit(n, false);
+				ft::uninitialized_fill_n(_alloc, _data + _size, n - _size, val);
+			}
+			else
+				ft::destroy_n(_alloc, _data + n, _size - n);
+			_size = n;
+		}
+
+		/**
+		 * As vector::resize_uninitialized(): trivial types only. The new
+		 * pages only get memory when the caller writes them.
+		*/
+		void resize_uninitialized(size_type n)
+		{
+			ft::static_check<ft::is_trivial<value_type>::value>::holds();
+			commit(n, false);
+			_size = n;
+		}
+
+		/** @return the first of n uninitialized elements added at the end.*/
+		pointer append_uninitialized(size_type n)
+		{
+			size_type old_size = _size;
+
+			resize_uninitialized(_size + n);
+			return (_data + old_size);
+		}
+
+		/** Commits the pages of n elements; nothing moves.*/
+		void reserve(size_type n)
+		{
+			commit(n, true);
+		}
+
+		/** Gives the committed pages past the last element back.*/
+		void shrink_to_fit(void)
+		{
+			size_t keep = round(_size * sizeof(T), page_size());
+
+			if (keep >= _committed)
+				return;
+			if (mmap(reinterpret_cast<char *>(_data) + keep, _committed - keep, PROT_NONE,
+					MAP_PRIVATE | MAP_ANONYMOUS | MAP_NORESERVE | MAP_FIXED, -1, 0) == MAP_FAILED)
+				return;
+			_committed = keep;
+			_capacity = keep / sizeof(T);
+		}
+
+		/*************************** Element access *****************************/
+		reference operator[](size_type n) { return (_data[n]); }
+		const_reference operator[](size_type n) const { return (_data[n]); }
+
+		reference at(size_type n)
+		{
+			if (n >= _size)
+				throw(std::out_of_range("ft::vm_vector::Out-of-Range"));
+			return (_data[n]);
+		}
+
+		const_reference at(size_type n) const
+		{
+			if (n >= _size)
+				throw(std::out_of_range("ft::vm_vector::Out-of-Range"));
+			return (_data[n]);
+		}
+
+		reference front(void) { return (_data[0]); }
+		const_reference front(void) const { return (_data[0]); }
+		reference back(void) { return (_data[_size - 1]); }
+		const_reference back(void) const { return (_data[_size - 1]); }
+
+		/*************************** Modifiers *****************************/
+		void assign(size_type n, const value_type &val)
+		{
+			value_type copy(val); // val may be one of the elements destroyed
+
+			clear();
+			reserve(n);
+			ft::uninitialized_fill_n(_alloc, _data, n, copy);
+			_size = n;
+		}
+
+		template <class InputIterator>
+		void assign(InputIterator first, InputIterator last,
+			typename ft::enable_if<!ft::is_integral<InputIterator>::value, int>::type = 0)
+		{
+			clear();
+			insert(end(), first, last);
+		}
+
+		/** val may be an element: the storage it is in does not move.*/
+		void push_back(const value_type &val)
+		{
+			if (_size == _capacity)
+				commit(_size + 1, false);
+			_alloc.construct(_data + _size, val);
+			_size++;
+		}
+
+		void pop_back(void)
+		{
+			if (_size)
+			{
+				_alloc.destroy(_data + _size - 1);
+				_size--;
+			}
+		}
+
+		iterator insert(iterator position, const value_type &val)
+		{
+			size_type index = position - begin();
+
+			insert(position, 1, val);
+			return (iterator(_data + index));
+		}
+
+		/** The tail is shifted once, in place.*/
+		void insert(iterator position, size_type n, const value_type &val)
+		{
+			size_type index = position - begin();
+
+			if (n == 0)
+				return;
+			commit(_size + n, false);
+			ft::insert_in_place_n(_alloc, _data, _size, index, n, val);
+			_size += n;
+		}
+
+		/** As vector::insert(): forward ranges are measured first, input ranges rotated in.*/
+		template <class InputIterator>
+		void insert(iterator position, InputIterator first, InputIterator last,
+			typename ft::enable_if<!ft::is_integral<InputIterator>::value, int>::type = 0)
+		{
+			insert_range(position - begin(), first, last,
+				typename ft::iterator_traits<InputIterator>::iterator_category());
+		}
+
+		iterator erase(iterator position)
+		{
+			return (erase(position, position + 1));
+		}
+
+		iterator erase(iterator first, iterator last)
+		{
+			size_type index = first - begin();
+			size_type n = last - first;
+
+			if (n == 0)
+				return (first);
+			ft::shift_down(_alloc, _data, _size, index, n);
+			_size -= n;
+			return (first);
+		}
+
+		/** Exchanges the reservations: no element moves.*/
+		void swap(vm_vector &x)
+		{
+			std::swap(_data, x._data);
+			std::swap(_size, x._size);
+			std::swap(_capacity, x._capacity);
+			std::swap(_committed, x._committed);
+			std::swap(_reserved, x._reserved);
+		}
+
+		/** Keeps the committed pages (see shrink_to_fit()).*/
+		void clear(void)
+		{
+			ft::destroy_n(_alloc, _data, _size);
+			_size = 0;
+		}
+
+		allocator_type get_allocator() const
+		{
+			return (_alloc);
+		}
+
+			private:
+		static size_t page_size(void)
+		{
+			static const size_t page = sysconf(_SC_PAGESIZE);
+
+			return (page);
+		}
+
+		static size_t round(size_t bytes, size_t unit)
+		{
+			return ((bytes + unit - 1) / unit * unit);
+		}
+
+		/** Maps the PROT_NONE range of max_elements.*/
+		void reserve_range(size_type max_elements)
+		{
+			_data = NULL;
+			_size = 0;
+			_capacity = 0;
+			_committed = 0;
+			if (max_elements > ((size_t)-1 - page_size()) / sizeof(T))
+				throw std::length_error("ft::vm_vector: reservation too large");
+			_reserved = round((max_elements ? max_elements : 1) * sizeof(T), page_size());
+			void *base = mmap(NULL, _reserved, PROT_NONE, MAP_PRIVATE | MAP_ANONYMOUS | MAP_NORESERVE, -1, 0);
+			if (base == MAP_FAILED)
+				throw std::bad_alloc();
+			_data = static_cast<value_type *>(base);
+		}
+
+		/**
+		 * Makes room for needed elements: the committed prefix grows to
+		 * exactly that (exact) or at least doubles, within the reservation.
+		*/
+		void commit(size_type needed, bool exact)
+		{
+			if (needed <= _capacity)
+				return;
+			if (needed > max_size())
+				throw std::length_error("ft::vm_vector: reservation exceeded");
+			size_t bytes = needed * sizeof(T);
+			if (!exact)
+				bytes = bytes > 2 * _committed ? bytes : 2 * _committed;
+			bytes = round(bytes, exact ? page_size() : (size_t)commit_granularity);
+			if (bytes > _reserved)
+				bytes = _reserved;
+			if (mprotect(reinterpret_cast<char *>(_data) + _committed, bytes - _committed,
+					PROT_READ | PROT_WRITE) != 0)
+				throw std::bad_alloc();
+			_committed = bytes;
+			_capacity = bytes / sizeof(T);
+		}
+
+		template <class ForwardIterator>
+		void insert_range(size_type index, ForwardIterator first, ForwardIterator last, std::forward_iterator_tag)
+		{
+			size_type n = ft::distance(first, last);
+
+			if (n == 0)
+				return;
+			commit(_size + n, _size == 0);
+			ft::insert_in_place(_alloc, _data, _size, index, first, n);
+			_size += n;
+		}
+
+		template <class InputIterator>
+		void insert_range(size_type index, InputIterator first, InputIterator last, std::input_iterator_tag)
+		{
+			ft::insert_by_rotation(*this, index, first, last);
+		}
+	};
+
+	/** A vm_vector only holds the address of its mapping.*/
+	template <class T>
+	struct is_trivially_relocatable<ft::vm_vector<T> > : public true_type {};
+
+	/*************************** Relational operators *****************************/
+	template <class T>
+	bool operator==(const vm_vector<T> &lhs, const vm_vector<T> &rhs)
+	{
+		return (lhs.size() == rhs.size() && ft::equal(lhs.begin(), lhs.end(), rhs.begin()));
+	}
+
+	template <class T>
+	bool operator!=(const vm_vector<T> &lhs, const vm_vector<T> &rhs)
+	{
+		return (!(lhs == rhs));
+	}
+
+	template <class T>
+	bool operator<(const vm_vector<T> &lhs, const vm_vector<T> &rhs)
+	{
+		return (ft::lexicographical_compare(lhs.begin(), lhs.end(), rhs.begin(), rhs.end()));
+	}
+
+	template <class T>
+	bool operator<=(const vm_vector<T> &lhs, const vm_vector<T> &rhs)
+	{
+		return (!(rhs < lhs));
+	}
+
+	template <class T>
+	bool operator>(const vm_vector<T> &lhs, const vm_vector<T> &rhs)
+	{
+		return (rhs < lhs);
+	}
+
+	template <class T>
+	bool operator>=(const vm_vector<T> &lhs, const vm_vector<T> &rhs)
+	{
+		return (!(lhs < rhs));
+	}
+
+	template <class T>
+	void swap(vm_vector<T> &x, vm_vector<T> &y)
+	{
+		x.swap(y);
+	}
+}
+
+#endif
@@ -0,0 +1,306 @@
+#ifndef AUGMENT_HPP
+#define AUGMENT_HPP
+
+#include <limits>
+#include <functional>
+
+/*
+Augmentation policies for the ordered tree (ft::Rbtree).
+
+An augmentation keeps one extra value per node that summarizes its subtree
+(subtree sum, maximum endpoint, ...). The value lives in a node type derived
+from ft::Node, so iterators and balancing policies keep working on plain
+ft::Node pointers. Each augmentation is a struct exposing:
+
+	enabled						false only for no_augment, lets the tree skip
+								the path updates entirely
+	node<T>::type				the node type the tree allocates
+	update(node)				recomputes the summary of a real node from its
+								children (which are up to date, null leaves
+								included)
+
+The tree calls update on both nodes of every rotation and on every node of the
+path between a linked / unlinked node and the root, which is all it takes to
+keep the summaries exact through insert, erase and any balancing policy.
+*/
+
+namespace ft
+{
+	template <typename T>
+	struct Node;
+
+	/** A tree node carrying the summary of its subtree in aug.*/
+	template <typename T, typename A>
+	struct AugNode : public Node<T>
+	{
+		A	aug;
+
+		AugNode(T *value) : Node<T>(value), aug() {}
+	};
+
+	/** No augmentation: the tree allocates plain nodes and skips the updates.*/
+	struct no_augment
+	{
+		static const bool enabled = false;
+		typedef void value_type;
+
+		template <class T>
+		struct node
+		{
+			typedef ft::Node<T> type;
+		};
+
+		template <class N>
+		static void update(N *) {}
+	};
+
+	/***************************Monoids*****************************/
+	/**
+	 * A monoid is a value_type with an associative combine and its identity.
+	 * Values of the container are converted to value_type before combining.
+	*/
+	template <class V>
+	struct sum_monoid
+	{
+		typedef V value_type;
+		static value_type identity() { return (value_type()); }
+		static value_type combine(const value_type &a, const value_type &b) { return (a + b); }
+	};
+
+	template <class V>
+	struct min_monoid
+	{
+		typedef V value_type;
+		static value_type identity() { return (std::numeric_limits<V>::max()); }
+		static value_type combine(const value_type &a, const value_type &b) { return (b < a ? b : a); }
+	};
+
+	template <class V>
+	struct max_monoid
+	{
+		typedef V value_type;
+		// min() is the lowest integer (0 when unsigned), but the smallest positive floating point value
+		static value_type identity() { return (std::numeric_limits<V>::is_integer ?
+			std::numeric_limits<V>::min() : -std::numeric_limits<V>::max()); }
+		static value_type combine(const value_type &a, const value_type &b) { return (a < b ? b : a); }
+	};
+
+	/** Extracts the part of an element the monoid works on: the element itself...*/
+	struct select_self
+	{
+		template <class T>
+		static const T &get(const T &value) { return (value); }
+	};
+
+	/** ...or the mapped value of a map element.*/
+	struct select_second
+	{
+		template <class P>
+		static const typename P::second_type &get(const P &value) { return (value.second); }
+	};
+
+	/**
+	 * Keeps, for every node, the combination (in key order) of the extracted
+	 * values of its subtree, and answers range aggregates in O(log n).
+	*/
+	template <class Monoid, class Extract = select_self>
+	struct monoid_augment
+	{
+		static const bool enabled = true;
+		typedef Monoid monoid_type;
+		typedef typename Monoid::value_type value_type;
+
+		template <class T>
+		struct node
+		{
+			typedef ft::AugNode<T, value_type> type;
+		};
+
+		template <class T>
+		static value_type lift(const ft::Node<T> *node)
+		{
+			return (value_type(Extract::get(*node->data)));
+		}
+
+		/** The summary of a subtree, identity for a null leaf.*/
+		template <class T>
+		static value_type summary(const ft::Node<T> *node)
+		{
+			if (!node || node->data == NULL)
+				return (Monoid::identity());
+			return (static_cast<const ft::AugNode<T, value_type> *>(node)->aug);
+		}
+
+		template <class T>
+		static void update(ft::Node<T> *node)
+		{
+			static_cast<ft::AugNode<T, value_type> *>(node)->aug =
+				Monoid::combine(Monoid::combine(summary(node->left), lift(node)), summary(node->right));
+		}
+
+		/**
+		 * Combination of the elements x with lo <= x < hi, in order.
+		 * Walks down to the first node inside the range, then along its left
+		 * branch (for the lo bound) and its right branch (for the hi bound),
+		 * taking whole subtree summaries on the inner side of both branches.
+		*/
+		template <class Tree>
+		static value_type range(const Tree &tree, const typename Tree::value_type &lo,
+			const typename Tree::value_type &hi)
+		{
+			typename Tree::value_compare comp = tree.value_comp();
+			typename Tree::node_type *split = tree.get_root();
+			typename Tree::node_type *node;
+
+			while (split && !Tree::is_null_leaf(split))
+			{
+				if (comp(*split->data, lo))
+					split = split->right;
+				else if (!comp(*split->data, hi))
+					split = split->left;
+				else
+					break;
+			}
+			if (!split || Tree::is_null_leaf(split))
+				return (Monoid::identity());
+			value_type left = Monoid::identity();
+			for (node = split->left; !Tree::is_null_leaf(node);)
+			{
+				if (!comp(*node->data, lo))
+				{
+					left = Monoid::combine(Monoid::combine(lift(node), summary(node->right)), left);
+					node = node->left;
+				}
+				else
+					node = node->right;
+			}
+			value_type right = Monoid::identity();
+			for (node = split->right; !Tree::is_null_leaf(node);)
+			{
+				if (comp(*node->data, hi))
+				{
+					right = Monoid::combine(right, Monoid::combine(summary(node->left), lift(node)));
+					node = node->right;
+				}
+				else
+					node = node->left;
+			}
+			return (Monoid::combine(Monoid::combine(left, lift(split)), right));
+		}
+
+		/** Combination of every element of the tree.*/
+		template <class Tree>
+		static value_type all(const Tree &tree)
+		{
+			return (summary(tree.get_root()));
+		}
+	};
+
+	/** No monoid given to the container: no augmentation at all.*/
+	template <class Extract>
+	struct monoid_augment<no_augment, Extract> : public no_augment {};
+
+	/** Extracts the key of a map element.*/
+	struct select_first
+	{
+		template <class P>
+		static const typename P::first_type &get(const P &value) { return (value.first); }
+	};
+
+	/**
+	 * Interval tree augmentation. Elements hold (through Extract) a half open
+	 * interval [first, second) of endpoints ordered by Compare, and are sorted by
+	 * their lower endpoint. Every node keeps the greatest upper endpoint of its
+	 * subtree, which lets overlap queries skip every subtree that ends too early.
+	 * The summaries use a default constructed Compare.
+	*/
+	template <class Endpoint, class Extract, class Compare = std::less<Endpoint> >
+	struct interval_augment
+	{
+		static const bool enabled = true;
+		typedef Endpoint value_type;
+
+		template <class T>
+		struct node
+		{
+			typedef ft::AugNode<T, value_type> type;
+		};
+
+		template <class T>
+		static const value_type &max_end(const ft::Node<T> *node)
+		{
+			return (static_cast<const ft::AugNode<T, value_type> *>(node)->aug);
+		}
+
+		template <class T>
+		static void update(ft::Node<T> *node)
+		{
+			Compare comp;
+			const value_type *end = &Extract::get(*node->data).second;
+
+			if (node->left->data && comp(*end, max_end(node->left)))
+				end = &max_end(node->left);
+			if (node->right->data && comp(*end, max_end(node->right)))
+				end = &max_end(node->right);
+			static_cast<ft::AugNode<T, value_type> *>(node)->aug = *end;
+		}
+
+		/** [first, second) and [lo, hi) overlap when first < hi and lo < second.*/
+		template <class T>
+		static bool overlaps(const ft::Node<T> *node, const value_type &lo, const value_type &hi)
+		{
+			Compare comp;
+			return (comp(Extract::get(*node->data).first, hi) &&
+				comp(lo, Extract::get(*node->data).second));
+		}
+
+		/**
+		 * Finds one element overlapping [lo, hi), or NULL. O(log n):
+		 * go left whenever the left subtree ends after lo. If nothing there
+		 * overlaps, the interval ending after lo starts at or after hi, and so
+		 * does everything on the right.
+		*/
+		template <class Tree>
+		static typename Tree::node_type *any_overlap(const Tree &tree, const value_type &lo,
+			const value_type &hi)
+		{
+			Compare comp;
+			typename Tree::node_type *node = tree.get_root();
+
+			while (node && !Tree::is_null_leaf(node) && !overlaps(node, lo, hi))
+			{
+				if (!Tree::is_null_leaf(node->left) && comp(lo, max_end(node->left)))
+					node = node->left;
+				else
+					node = node->right;
+			}
+			if (!node || Tree::is_null_leaf(node))
+				return (NULL);
+			return (node);
+		}
+
+		/**
+		 * Calls f(node) on every element overlapping [lo, hi), in order.
+		 * Subtrees ending at or before lo and right subtrees starting at or
+		 * after hi are never entered, so only the paths leading to the k
+		 * results are walked: O(log n + k log(n / k)).
+		*/
+		template <class Node, class Function>
+		static void each_overlap(Node *node, const value_type &lo, const value_type &hi, Function &f)
+		{
+			Compare comp;
+
+			while (node && node->data && comp(lo, max_end(node)))
+			{
+				each_overlap(node->left, lo, hi, f);
+				if (!comp(Extract::get(*node->data).first, hi))
+					return;
+				if (comp(lo, Extract::get(*node->data).second))
+					f(node);
+				node = node->right;
+			}
+		}
+	};
+}
+
+#endif
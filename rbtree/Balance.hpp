@@ -0,0 +1,668 @@
+#ifndef BALANCE_HPP
+#define BALANCE_HPP
+
+#define BLACK 0
+#define RED 1
+
+/*
+Balancing policies for the ordered tree (ft::Rbtree).
+
+The tree owns the nodes, the null leaves, the BST descent, the structural
+unlink of erased nodes and the rotations. A policy only owns the fixup that
+runs afterwards, so swapping the policy keeps every node and iterator
+invariant intact. Each policy is a stateless struct exposing five static
+hooks, all templated on the tree type:
+
+	fix_insert(tree, node)			node was just linked as a leaf
+	fix_delete(tree, node, color)	node took the place of the unlinked node,
+									color is the balance field of the node
+									that was physically removed from its slot
+	after_access(tree, node)		node was found by a (non const) lookup
+	fix_build(tree, node, depth, full)
+									node was placed at depth by a bulk build,
+									its subtrees done; the built tree has its
+									first full levels complete and its null
+									leaves on the next two levels
+	join(tree, left, node, right)	links the detached subtrees left and right
+									(every key of left < node < every key of
+									right) under node or along one of their
+									spines, rebalances, and leaves the result
+									as the root of tree (see Rbtree set algebra)
+
+Each policy also defines bounded_height, false when a sequence of updates
+can leave the tree with a height linear in its size: code recursing along
+the height (the set algebra) rebuilds such trees first.
+
+The per node balance field is Node::color. Each policy gives it its own
+meaning, chosen so that null leaves (BLACK == 0) and fresh nodes (RED == 1)
+already hold the correct initial value:
+
+	rb_balance		color (BLACK / RED)
+	avl_balance		height of the subtree, null leaves have height 0
+	wavl_balance	rank, null leaves have rank 0
+	splay_balance	unused
+*/
+
+namespace ft
+{
+	/**
+	 * Red-black balancing (default policy).
+	 * The insertion and deletion fixups are the Cormen, Leiserson and Rivest
+	 * ones: recolor while the uncle / sibling is red, rotate otherwise.
+	 * Height is at most 2 * log2(n + 1), at most 2 rotations per insertion and
+	 * 3 per deletion.
+	*/
+	struct rb_balance
+	{
+		static const bool bounded_height = true;	// at most 2 * log2(n + 1)
+
+		template <class Node>
+		static int get_color(Node *node)
+		{
+			if (node == NULL)
+				return BLACK;
+			return (node->color);
+		}
+
+		template <class Node>
+		static void set_color(Node *node, int color)
+		{
+			if (node == NULL)
+				return;
+			node->color = color;
+		}
+
+		/**
+		 * Function to fix an RBT (Red-Black Tree) after inserting a node in order
+		 * to maintain its red-black properties.
+		 * 	Case 1: If the uncle node is red, then we change the color of the uncle node to black,
+		 * 		the color of the parent node to black, and the color of the grandparent node to red.
+		 * 		Then, we set the newly inserted node to be the grandparent node and repeat the same process.
+		 * 	Case 2: If the uncle node is black, and the newly inserted node is an inner child of its parent,
+		 * 		then we rotate the parent node to turn it into an outer child.
+		 * 	Case 3: If the uncle node is black, and the newly inserted node is an outer child of its parent,
+		 * 		then we rotate the grandparent node and change the color of the parent node
+		 * 		to black and the color of the grandparent node to red.
+		 * 	Finally, the function sets the color of the root node to black.
+		*/
+		template <class Tree>
+		static void fix_insert(Tree &tree, typename Tree::node_type *node)
+		{
+			typename Tree::node_type *uncle = NULL;
+			while (node != tree.get_root() && get_color(node->parent) == RED)
+			{
+				if (node->parent == node->parent->parent->right)
+				{
+					uncle = node->parent->parent->left;
+					if (get_color(uncle) == RED)
+					{
+						set_color(uncle, BLACK);
+						set_color(node->parent, BLACK);
+						set_color(node->parent->parent, RED);
+						node = node->parent->parent;
+					}
+					else
+					{
+						if (node == node->parent->left)
+						{
+							node = node->parent;
+							tree.rotate_right(node);
+						}
+						set_color(node->parent, BLACK);
+						set_color(node->parent->parent, RED);
+						tree.rotate_left(node->parent->parent);
+					}
+				}
+				else
+				{
+					uncle = node->parent->parent->right;
+					if (get_color(uncle) == RED)
+					{
+						set_color(uncle, BLACK);
+						set_color(node->parent, BLACK);
+						set_color(node->parent->parent, RED);
+						node = node->parent->parent;
+					}
+					else
+					{
+						if (node == node->parent->right)
+						{
+							node = node->parent;
+							tree.rotate_left(node);
+						}
+						set_color(node->parent, BLACK);
+						set_color(node->parent->parent, RED);
+						tree.rotate_right(node->parent->parent);
+					}
+				}
+			}
+			set_color(tree.get_root(), BLACK);
+		}
+
+		/**
+		 * Used to restore the red-black tree properties after a node is deleted.
+		 * Only needed when the removed node was black: node carries an extra black
+		 * that is pushed up (sibling black with black children) or absorbed by
+		 * rotations (sibling red, or sibling black with a red child).
+		*/
+		template <class Tree>
+		static void fix_delete(Tree &tree, typename Tree::node_type *node, int removed_color)
+		{
+			typename Tree::node_type *sibling;
+
+			if (removed_color != BLACK)
+				return;
+			while (node != tree.get_root() && get_color(node) == BLACK)
+			{
+				if (node == node->parent->left)
+				{
+					sibling = node->parent->right;
+					if (get_color(sibling) == RED)
+					{
+						set_color(sibling, BLACK);
+						set_color(node->parent, RED);
+						tree.rotate_left(node->parent);
+						sibling = node->parent->right;
+					}
+					if (get_color(sibling->left) == BLACK &&
+					    get_color(sibling->right) == BLACK)
+					{
+						set_color(sibling, RED);
+						node = node->parent;
+					}
+					else
+					{
+						if (get_color(sibling->right) == BLACK)
+						{
+							set_color(sibling->left, BLACK);
+							set_color(sibling, RED);
+							tree.rotate_right(sibling);
+							sibling = node->parent->right;
+						}
+						set_color(sibling, get_color(node->parent));
+						set_color(node->parent, BLACK);
+						set_color(sibling->right, BLACK);
+						tree.rotate_left(node->parent);
+						break;
+					}
+				}
+				else
+				{
+					sibling = node->parent->left;
+					if (get_color(sibling) == RED)
+					{
+						set_color(sibling, BLACK);
+						set_color(node->parent, RED);
+						tree.rotate_right(node->parent);
+						sibling = node->parent->left;
+					}
+					if (get_color(sibling->right) == BLACK &&
+					    get_color(sibling->left) == BLACK)
+					{
+						set_color(sibling, RED);
+						node = node->parent;
+					}
+					else
+					{
+						if (get_color(sibling->left) == BLACK)
+						{
+							set_color(sibling->right, BLACK);
+							set_color(sibling, RED);
+							tree.rotate_left(sibling);
+							sibling = node->parent->left;
+						}
+						set_color(sibling, get_color(node->parent));
+						set_color(node->parent, BLACK);
+						set_color(sibling->left, BLACK);
+						tree.rotate_right(node->parent);
+						break;
+					}
+				}
+			}
+			set_color(node, BLACK);
+		}
+
+		template <class Tree>
+		static void after_access(Tree &, typename Tree::node_type *) {}
+
+		/** Levels under full hold the last, incomplete level: red there keeps
+		every black height equal.*/
+		template <class Tree>
+		static void fix_build(Tree &, typename Tree::node_type *node, int depth, int full)
+		{
+			node->color = depth < full ? BLACK : RED;
+		}
+
+		template <class Tree>
+		static int black_height(typename Tree::node_type *node)
+		{
+			int height = 0;
+
+			for (; !Tree::is_null_leaf(node); node = node->left)
+				height += (node->color == BLACK);
+			return (height);
+		}
+
+		/**
+		 * Walks down the spine of the higher subtree to the first black node of
+		 * the black height of the other, hangs node there as a red node and
+		 * fixes it as an insertion. O(log n).
+		*/
+		template <class Tree>
+		static void join(Tree &tree, typename Tree::node_type *left,
+			typename Tree::node_type *node, typename Tree::node_type *right)
+		{
+			set_color(left, BLACK);
+			set_color(right, BLACK);
+			int left_height = black_height<Tree>(left);
+			int right_height = black_height<Tree>(right);
+			bool from_left = left_height >= right_height;
+			typename Tree::node_type *spine = from_left ? left : right;
+			int height = from_left ? left_height : right_height;
+			int target = from_left ? right_height : left_height;
+
+			tree.set_root(spine);
+			while (height > target || spine->color == RED)
+			{
+				height -= (spine->color == BLACK);
+				spine = from_left ? spine->right : spine->left;
+			}
+			tree.splice_join(spine, node, from_left ? right : left, from_left);
+			node->color = RED;
+			tree.update_path(node);
+			fix_insert(tree, node);
+		}
+	};
+
+	/**
+	 * AVL balancing.
+	 * Keeps the heights of the two subtrees of every node within one of each
+	 * other, which bounds the height to about 1.44 * log2(n): lookups visit fewer
+	 * nodes than with red-black, at the price of more rotations on updates.
+	*/
+	struct avl_balance
+	{
+		static const bool bounded_height = true;	// at most about 1.44 * log2(n)
+
+		template <class Node>
+		static int height(Node *node)
+		{
+			if (node == NULL)
+				return (0);
+			return (node->color);
+		}
+
+		template <class Node>
+		static void update(Node *node)
+		{
+			int left = height(node->left);
+			int right = height(node->right);
+			node->color = (left > right ? left : right) + 1;
+		}
+
+		/**
+		 * Walks from node up to the root, recomputing heights and rotating every
+		 * node whose balance factor left [-1, 1]. Stops early once a balanced node
+		 * keeps its previous height, since nothing above it can change.
+		*/
+		template <class Tree>
+		static void rebalance(Tree &tree, typename Tree::node_type *node)
+		{
+			typename Tree::node_type *child;
+
+			while (node)
+			{
+				int old_height = node->color;
+				int balance = height(node->left) - height(node->right);
+				if (balance > 1)
+				{
+					child = node->left;
+					if (height(child->left) < height(child->right))
+					{
+						tree.rotate_left(child);
+						update(child);
+					}
+					tree.rotate_right(node);
+					update(node);
+					node = node->parent;
+					update(node);
+				}
+				else if (balance < -1)
+				{
+					child = node->right;
+					if (height(child->right) < height(child->left))
+					{
+						tree.rotate_right(child);
+						update(child);
+					}
+					tree.rotate_left(node);
+					update(node);
+					node = node->parent;
+					update(node);
+				}
+				else
+				{
+					update(node);
+					if (node->color == old_height)
+						return;
+				}
+				node = node->parent;
+			}
+		}
+
+		template <class Tree>
+		static void fix_insert(Tree &tree, typename Tree::node_type *node)
+		{
+			rebalance(tree, node->parent);
+		}
+
+		template <class Tree>
+		static void fix_delete(Tree &tree, typename Tree::node_type *node, int)
+		{
+			rebalance(tree, node->parent);
+		}
+
+		template <class Tree>
+		static void after_access(Tree &, typename Tree::node_type *) {}
+
+		template <class Tree>
+		static void fix_build(Tree &, typename Tree::node_type *node, int, int)
+		{
+			update(node);
+		}
+
+		/**
+		 * Walks down the spine of the higher subtree to the first node at most
+		 * one higher than the other, hangs node there and rebalances upwards.
+		*/
+		template <class Tree>
+		static void join(Tree &tree, typename Tree::node_type *left,
+			typename Tree::node_type *node, typename Tree::node_type *right)
+		{
+			bool from_left = height(left) >= height(right);
+			typename Tree::node_type *spine = from_left ? left : right;
+			int target = (from_left ? height(right) : height(left)) + 1;
+
+			tree.set_root(spine);
+			while (height(spine) > target)
+				spine = from_left ? spine->right : spine->left;
+			tree.splice_join(spine, node, from_left ? right : left, from_left);
+			update(node);
+			tree.update_path(node);
+			rebalance(tree, node->parent);
+		}
+	};
+
+	/**
+	 * Weak AVL balancing (Haeupler, Sen and Tarjan, "Rank-balanced trees").
+	 * Every node has a rank, rank differences to the children are 1 or 2 and
+	 * leaves have rank differences 1, 1. Built by insertions only it is an AVL
+	 * tree; deletions never need more than 2 rotations, like red-black, and the
+	 * height stays below 2 * log2(n).
+	*/
+	struct wavl_balance
+	{
+		static const bool bounded_height = true;	// at most 2 * log2(n)
+
+		template <class Node>
+		static int rank(Node *node)
+		{
+			if (node == NULL)
+				return (0);
+			return (node->color);
+		}
+
+		template <class Tree>
+		static bool is_leaf(typename Tree::node_type *node)
+		{
+			return (Tree::is_null_leaf(node->left) && Tree::is_null_leaf(node->right));
+		}
+
+		/**
+		 * A fresh node has the rank of its parent when the parent was a leaf
+		 * (rank difference 0). Promote the parent while its other child is a
+		 * 1-child, otherwise one single or double rotation ends the fixup.
+		*/
+		template <class Tree>
+		static void fix_insert(Tree &tree, typename Tree::node_type *node)
+		{
+			typename Tree::node_type *parent = node->parent;
+			typename Tree::node_type *sibling;
+			typename Tree::node_type *inner;
+
+			while (parent && rank(parent) == rank(node))
+			{
+				sibling = (node == parent->left) ? parent->right : parent->left;
+				if (rank(parent) - rank(sibling) == 1)
+				{
+					parent->color++;
+					node = parent;
+					parent = node->parent;
+					continue;
+				}
+				if (node == parent->left)
+				{
+					inner = node->right;
+					if (rank(node) - rank(inner) == 2)
+						tree.rotate_right(parent);
+					else
+					{
+						tree.rotate_left(node);
+						tree.rotate_right(parent);
+						inner->color++;
+						node->color--;
+					}
+				}
+				else
+				{
+					inner = node->left;
+					if (rank(node) - rank(inner) == 2)
+						tree.rotate_left(parent);
+					else
+					{
+						tree.rotate_right(node);
+						tree.rotate_left(parent);
+						inner->color++;
+						node->color--;
+					}
+				}
+				parent->color--;
+				return;
+			}
+		}
+
+		/**
+		 * After the unlink, the parent of node may be a 2,2 leaf (demote it) and
+		 * node may be a 3-child. Demote while the sibling is a 2-child, or a 2,2
+		 * node; otherwise a single or double rotation ends the fixup.
+		*/
+		template <class Tree>
+		static void fix_delete(Tree &tree, typename Tree::node_type *node, int)
+		{
+			typename Tree::node_type *parent = node->parent;
+			typename Tree::node_type *sibling;
+			typename Tree::node_type *outer;
+			typename Tree::node_type *inner;
+			bool left;
+
+			if (parent && is_leaf<Tree>(parent) && rank(parent) == 2)
+			{
+				parent->color--;
+				node = parent;
+				parent = node->parent;
+			}
+			while (parent && rank(parent) - rank(node) == 3)
+			{
+				left = (node == parent->left);
+				sibling = left ? parent->right : parent->left;
+				if (rank(parent) - rank(sibling) == 2)
+				{
+					parent->color--;
+					node = parent;
+					parent = node->parent;
+					continue;
+				}
+				if (rank(sibling) - rank(sibling->left) == 2 &&
+				    rank(sibling) - rank(sibling->right) == 2)
+				{
+					sibling->color--;
+					parent->color--;
+					node = parent;
+					parent = node->parent;
+					continue;
+				}
+				outer = left ? sibling->right : sibling->left;
+				inner = left ? sibling->left : sibling->right;
+				if (rank(sibling) - rank(outer) == 1)
+				{
+					if (left)
+						tree.rotate_left(parent);
+					else
+						tree.rotate_right(parent);
+					sibling->color++;
+					parent->color--;
+					if (is_leaf<Tree>(parent))
+						parent->color--;
+				}
+				else
+				{
+					if (left)
+					{
+						tree.rotate_right(sibling);
+						tree.rotate_left(parent);
+					}
+					else
+					{
+						tree.rotate_left(sibling);
+						tree.rotate_right(parent);
+					}
+					inner->color += 2;
+					sibling->color--;
+					parent->color -= 2;
+				}
+				return;
+			}
+		}
+
+		template <class Tree>
+		static void after_access(Tree &, typename Tree::node_type *) {}
+
+		/** Ranks equal to the heights: the subtrees differ by one at most.*/
+		template <class Tree>
+		static void fix_build(Tree &, typename Tree::node_type *node, int, int)
+		{
+			int left = rank(node->left);
+			int right = rank(node->right);
+			node->color = (left > right ? left : right) + 1;
+		}
+
+		/**
+		 * Walks down the spine of the higher subtree to the first node at most
+		 * one rank above the other, hangs node there one rank above both, and
+		 * fixes it as an insertion when it is a 0-child.
+		*/
+		template <class Tree>
+		static void join(Tree &tree, typename Tree::node_type *left,
+			typename Tree::node_type *node, typename Tree::node_type *right)
+		{
+			bool from_left = rank(left) >= rank(right);
+			typename Tree::node_type *spine = from_left ? left : right;
+			int target = (from_left ? rank(right) : rank(left)) + 1;
+
+			tree.set_root(spine);
+			while (rank(spine) > target)
+				spine = from_left ? spine->right : spine->left;
+			tree.splice_join(spine, node, from_left ? right : left, from_left);
+			node->color = (rank(node->left) > rank(node->right) ?
+				rank(node->left) : rank(node->right)) + 1;
+			tree.update_path(node);
+			fix_insert(tree, node);
+		}
+	};
+
+	/**
+	 * Splay balancing (Sleator and Tarjan).
+	 * No balance information at all: every inserted node and every node found
+	 * through a non const lookup is rotated up to the root, and the parent of an
+	 * erased node is splayed as well. Operations are O(log n) amortized and
+	 * recently or frequently used keys stay close to the root, which suits
+	 * skewed access patterns. Worst case height is O(n).
+	*/
+	struct splay_balance
+	{
+		static const bool bounded_height = false;	// a path after sorted inserts
+
+		template <class Tree>
+		static void splay(Tree &tree, typename Tree::node_type *node)
+		{
+			typename Tree::node_type *parent;
+			typename Tree::node_type *grand;
+
+			while (node->parent)
+			{
+				parent = node->parent;
+				grand = parent->parent;
+				if (!grand)
+				{
+					if (node == parent->left)
+						tree.rotate_right(parent);
+					else
+						tree.rotate_left(parent);
+				}
+				else if (node == parent->left && parent == grand->left)
+				{
+					tree.rotate_right(grand);
+					tree.rotate_right(parent);
+				}
+				else if (node == parent->right && parent == grand->right)
+				{
+					tree.rotate_left(grand);
+					tree.rotate_left(parent);
+				}
+				else if (node == parent->right)
+				{
+					tree.rotate_left(parent);
+					tree.rotate_right(grand);
+				}
+				else
+				{
+					tree.rotate_right(parent);
+					tree.rotate_left(grand);
+				}
+			}
+		}
+
+		template <class Tree>
+		static void fix_insert(Tree &tree, typename Tree::node_type *node)
+		{
+			splay(tree, node);
+		}
+
+		template <class Tree>
+		static void fix_delete(Tree &tree, typename Tree::node_type *node, int)
+		{
+			if (node->parent)
+				splay(tree, node->parent);
+		}
+
+		template <class Tree>
+		static void after_access(Tree &tree, typename Tree::node_type *node)
+		{
+			splay(tree, node);
+		}
+
+		template <class Tree>
+		static void fix_build(Tree &, typename Tree::node_type *, int, int) {}
+
+		template <class Tree>
+		static void join(Tree &tree, typename Tree::node_type *left,
+			typename Tree::node_type *node, typename Tree::node_type *right)
+		{
+			tree.set_root(left);
+			tree.splice_join(left, node, right, true);
+			tree.update_path(node);
+		}
+	};
+}
+
+#endif
@@ -0,0 +1,323 @@
+#ifndef PERSISTENT_TREE_HPP
+#define PERSISTENT_TREE_HPP
+
+#include <cstddef>
+#include <new>
+#include <memory>
+#include <functional>
+
+/*
+Persistent (path copying) search tree, for ft::persistent_map.
+
+Nodes are never modified once linked: an insert or an erase copies the nodes
+of the path from the root to the change, O(log n) of them, and the new path
+shares every other subtree with the previous version. A node counts the
+parents and roots pointing to it; releasing a version only frees the nodes
+no other version uses. Copying a tree is then O(1): retain the root.
+
+Shared nodes cannot have a parent pointer, so this is not ft::Rbtree: nodes
+only link down, and the tree is kept balanced with the AVL rules of
+ft::avl_balance (the height lives in the node), which are simple to apply
+while rebuilding a path bottom up.
+
+The reference counts are atomic, so versions sharing nodes can be released
+from different threads. A single version is not itself thread safe.
+*/
+
+namespace ft
+{
+	template <typename T>
+	struct PersistentNode
+	{
+		const T					value;
+		PersistentNode			*left;
+		PersistentNode			*right;
+		int						height;
+		size_t					refs;
+
+		PersistentNode(const T &val, PersistentNode *l, PersistentNode *r)
+			: value(val), left(l), right(r), height(1), refs(0) {}
+	};
+
+	template <typename T, class Compare = std::less<T>,
+		class Node_Alloc = std::allocator<PersistentNode<T> > >
+	class PersistentTree
+	{
+	public:
+		typedef T							value_type;
+		typedef Compare						value_compare;
+		typedef PersistentNode<T>			node_type;
+		typedef Node_Alloc					node_allocator_type;
+
+	private:
+		node_type			*_root;
+		value_compare		_comp;
+		node_allocator_type	_node_alloc;
+
+	public:
+		PersistentTree(value_compare comp = value_compare(),
+			node_allocator_type node_alloc = node_allocator_type())
+			: _root(NULL), _comp(comp), _node_alloc(node_alloc) {}
+
+		/** Shares every node of src. O(1).*/
+		PersistentTree(const PersistentTree &src)
+			: _root(src._root), _comp(src._comp), _node_alloc(src._node_alloc)
+		{
+			retain(_root);
+		}
+
+		~PersistentTree(void)
+		{
+			release(_root);
+		}
+
+		PersistentTree &operator=(const PersistentTree &src)
+		{
+			retain(src._root);
+			release(this->_root);
+			this->_root = src._root;
+			this->_comp = src._comp;
+			return (*this);
+		}
+
+		node_type *get_root(void) const
+		{
+			return (this->_root);
+		}
+
+		value_compare value_comp(void) const
+		{
+			return (this->_comp);
+		}
+
+		size_t max_size(void) const
+		{
+			return (this->_node_alloc.max_size());
+		}
+
+		static int height(const node_type *node)
+		{
+			return (node ? node->height : 0);
+		}
+
+		// #############################################################################
+		// #                                 LOOKUP                                    #
+		// #############################################################################
+
+		node_type *lookup_value(const value_type &value) const
+		{
+			node_type *node = this->_root;
+
+			while (node)
+			{
+				if (_comp(value, node->value))
+					node = node->left;
+				else if (_comp(node->value, value))
+					node = node->right;
+				else
+					return (node);
+			}
+			return (NULL);
+		}
+
+		// #############################################################################
+		// #                                 UPDATES                                   #
+		// #############################################################################
+
+		/**
+		 * Links value in a new version of the tree, or replaces the element with
+		 * an equivalent key when replace is set.
+		 * @return true if the tree changed.
+		*/
+		bool insert_value(const value_type &value, bool replace = false)
+		{
+			return (set_root(insert(this->_root, value, replace)));
+		}
+
+		/** @return true if an element equivalent to value was removed.*/
+		bool delete_value(const value_type &value)
+		{
+			bool found = false;
+			node_type *root = erase(this->_root, value, found);
+
+			if (found)
+				set_root(root);
+			return (found);
+		}
+
+		void clear(void)
+		{
+			release(this->_root);
+			this->_root = NULL;
+		}
+
+		void swap(PersistentTree &other)
+		{
+			std::swap(this->_root, other._root);
+			std::swap(this->_comp, other._comp);
+			std::swap(this->_node_alloc, other._node_alloc);
+		}
+
+	private:
+		// #############################################################################
+		// #                             REFERENCE COUNTS                              #
+		// #############################################################################
+
+		static void retain(node_type *node)
+		{
+			if (node)
+				__sync_add_and_fetch(&node->refs, 1);
+		}
+
+		void release(node_type *node)
+		{
+			if (node && __sync_sub_and_fetch(&node->refs, 1) == 0)
+				destroy(node);
+		}
+
+		/* Frees a node built during an update that ended up unused.*/
+		void drop(node_type *node)
+		{
+			if (node && node->refs == 0)
+				destroy(node);
+		}
+
+		void destroy(node_type *node)
+		{
+			node_type *left = node->left;
+			node_type *right = node->right;
+
+			this->_node_alloc.destroy(node);
+			this->_node_alloc.deallocate(node, 1);
+			release(left);
+			release(right);
+		}
+
+		bool set_root(node_type *root)
+		{
+			if (root == this->_root)
+				return (false);
+			retain(root);
+			release(this->_root);
+			this->_root = root;
+			return (true);
+		}
+
+		// #############################################################################
+		// #                              PATH COPYING                                 #
+		// #############################################################################
+
+		/* A new node over two subtrees it shares.*/
+		node_type *make(const value_type &value, node_type *left, node_type *right)
+		{
+			node_type *node = this->_node_alloc.allocate(1);
+
+			new (node) node_type(value, left, right);
+			retain(left);
+			retain(right);
+			node->height = (height(left) > height(right) ? height(left) : height(right)) + 1;
+			return (node);
+		}
+
+		/*
+		make(), plus the single or double rotation when the subtrees heights
+		differ by 2. The node taken apart by the rotation is dropped if the
+		update had just built it.
+		*/
+		node_type *balance(const value_type &value, node_type *left, node_type *right)
+		{
+			node_type *node;
+
+			if (height(left) > height(right) + 1)
+			{
+				if (height(left->left) >= height(left->right))
+					node = make(left->value, left->left, make(value, left->right, right));
+				else
+					node = make(left->right->value,
+						make(left->value, left->left, left->right->left),
+						make(value, left->right->right, right));
+				drop(left);
+				return (node);
+			}
+			if (height(right) > height(left) + 1)
+			{
+				if (height(right->right) >= height(right->left))
+					node = make(right->value, make(value, left, right->left), right->right);
+				else
+					node = make(right->left->value,
+						make(value, left, right->left->left),
+						make(right->value, right->left->right, right->right));
+				drop(right);
+				return (node);
+			}
+			return (make(value, left, right));
+		}
+
+		/* The new subtree, or node itself when nothing changed.*/
+		node_type *insert(node_type *node, const value_type &value, bool replace)
+		{
+			node_type *child;
+
+			if (!node)
+				return (make(value, NULL, NULL));
+			if (_comp(value, node->value))
+			{
+				child = insert(node->left, value, replace);
+				if (child == node->left)
+					return (node);
+				return (balance(node->value, child, node->right));
+			}
+			if (_comp(node->value, value))
+			{
+				child = insert(node->right, value, replace);
+				if (child == node->right)
+					return (node);
+				return (balance(node->value, node->left, child));
+			}
+			if (!replace)
+				return (node);
+			return (make(value, node->left, node->right));
+		}
+
+		/* The subtree without its minimum, copied.*/
+		node_type *erase_min(node_type *node)
+		{
+			if (!node->left)
+				return (node->right);
+			return (balance(node->value, erase_min(node->left), node->right));
+		}
+
+		node_type *erase(node_type *node, const value_type &value, bool &found)
+		{
+			node_type *child;
+
+			if (!node)
+				return (NULL);
+			if (_comp(value, node->value))
+			{
+				child = erase(node->left, value, found);
+				if (!found)
+					return (node);
+				return (balance(node->value, child, node->right));
+			}
+			if (_comp(node->value, value))
+			{
+				child = erase(node->right, value, found);
+				if (!found)
+					return (node);
+				return (balance(node->value, node->left, child));
+			}
+			found = true;
+			if (!node->left)
+				return (node->right);
+			if (!node->right)
+				return (node->left);
+			node_type *min = node->right;
+			while (min->left)
+				min = min->left;
+			return (balance(min->value, node->left, erase_min(node->right)));
+		}
+	};
+}
+
+#endif
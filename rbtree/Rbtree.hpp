@@ -1,8 +1,9 @@
 #ifndef RBTREE_HPP
 #define RBTREE_HPP
 
-#define BLACK 0
-#define RED 1
+#include "Balance.hpp"
+#include "Augment.hpp"
+#include "../containers/parallel.hpp"
 
 #define CRED "\033[91m"
 #define CEND "\033[0m"
@@ -84,25 +85,46 @@ namespace ft
 * 2. If we have RED uncle - color flip
 * 3. After rotation working nodes should look like: parent - black, childrens - red
 * 4. After color flip working nodes should look like: parent - red, childrens - black
+*
+* 		Balancing policy
+* The rules above are the ones of the default policy, ft::rb_balance. The tree itself
+* only does the BST part (descent, linking, unlinking, rotations); the fixups that run
+* after an insertion, a deletion or a lookup come from the Balance template parameter
+* (see Balance.hpp for rb_balance, avl_balance, wavl_balance and splay_balance).
+*
+* 		Augmentation
+* The Augment template parameter (see Augment.hpp) can attach a summary of its subtree
+* to every node. The tree then allocates the node type given by the augmentation
+* (derived from Node, Node_Alloc is rebound to it) and keeps the summaries up to date
+* on rotations and along the path of every insertion and deletion.
 */
 template <class T, 
 		  class Compare, 
 		  class Alloc = std::allocator<T>,
-		  class Node_Alloc = std::allocator<Node<T> > >
+		  class Node_Alloc = std::allocator<Node<T> >,
+		  class Balance = ft::rb_balance,
+		  class Augment = ft::no_augment>
 class Rbtree
 {
       public:
+	typedef T							value_type;
 	typedef Compare						value_compare;
 	typedef Alloc						allocator_type;
 	typedef typename Node_Alloc::size_type size_type;
 	typedef Node<T>						node_type;
 	typedef Node_Alloc 					node_allocator_type;
+	typedef Balance						balance_type;
+	typedef Augment						augment_type;
+	typedef typename Augment::template node<T>::type	stored_node_type;
 
       private:
+	typedef typename Node_Alloc::template rebind<stored_node_type>::other	stored_allocator_type;
+
 	node_type 			*_root;
 	allocator_type 		_alloc;
 	value_compare 		_comp;
-	node_allocator_type	_node_alloc;
+	stored_allocator_type	_node_alloc;
+	size_type			_rotations;
 
 	public:
 	// ###########################################################################
@@ -118,7 +140,8 @@ class Rbtree
 	*/
 	Rbtree(value_compare comp = value_compare(), allocator_type alloc = allocator_type(),
 	       node_allocator_type node_alloc = node_allocator_type())
-	    : _root(NULL), _alloc(alloc), _comp(comp), _node_alloc(node_alloc)
+	    : _root(NULL), _alloc(alloc), _comp(comp), _node_alloc(node_alloc),
+	      _rotations(0)
 	{}
 
 	/**
@@ -138,12 +161,12 @@ class Rbtree
 	 * The constructor takes as input a constant reference to another red-black tree src. 
 	 * It initializes the root of the new tree to NULL, and sets the allocator, comparator, 
 	 * and node allocator of the new tree to be the same as the src tree.
-	 * Finally, the constructor calls the copy_nodes function to copy all the nodes from the src tree to the new tree.*/
+	 * Finally, the constructor calls the clone function to copy all the nodes from the src tree to the new tree.*/
 	Rbtree(const Rbtree &src)
 	    : _root(NULL), _alloc(src._alloc), _comp(src._comp),
-	      _node_alloc(src._node_alloc)
+	      _node_alloc(src._node_alloc), _rotations(0)
 	{
-		copy_nodes(src.get_root());
+		clone(src, 1, 0);
 	}
 
 	//operator=
@@ -153,14 +176,16 @@ class Rbtree
 	 * The function first destroys the nodes of the current tree by calling the destroy_nodes function 
 	 * with the root node of the current tree as an argument. Then it sets the root node of the current tree to NULL.
 	 * After that, it copies all the nodes of the source tree (passed as an argument to the function) 
-	 * to the current tree by calling the copy_nodes function with the root node of the source tree as an argument.
+	 * to the current tree by calling the clone function with the source tree as an argument.
 	 * Finally, the function returns the reference to the current tree.
 	*/
 	Rbtree &operator=(const Rbtree &src)
 	{
+		if (this == &src)
+			return (*this);
 		destroy_nodes(this->_root);
 		this->_root = NULL;
-		copy_nodes(src.get_root());
+		clone(src, 1, 0);
 		return (*this);
 	}
 
@@ -308,6 +333,57 @@ class Rbtree
 			return (_alloc);
 	}
 
+	/** returns a copy of the comparison object used to order the tree.*/
+	value_compare value_comp() const{
+		return (this->_comp);
+	}
+
+	/** Number of rotations performed by the balancing policy since construction.
+	 * Only meant for statistics and benchmarks.*/
+	size_type rotations() const{
+		return (this->_rotations);
+	}
+
+	/** Height of the tree, counted in real nodes (0 for an empty tree).*/
+	size_type height() const{
+		return (subtree_height(this->_root));
+	}
+
+	/* A walk along the parent pointers: no recursion on the depth.*/
+	static size_type subtree_height(const node_type *root){
+		if (!root || is_null_leaf(root))
+			return (0);
+		const node_type *node = root;
+		const node_type *from = root->parent;
+		size_type depth = 1;
+		size_type height = 0;
+
+		while (true)
+		{
+			const node_type *next = node->parent;
+			if (from == node->parent)
+			{
+				height = depth > height ? depth : height;
+				if (!is_null_leaf(node->left))
+					next = node->left;
+				else if (!is_null_leaf(node->right))
+					next = node->right;
+			}
+			else if (from == node->left && !is_null_leaf(node->right))
+				next = node->right;
+			if (next == node->parent)
+			{
+				if (node == root)
+					return (height);
+				depth--;
+			}
+			else
+				depth++;
+			from = node;
+			node = next;
+		}
+	}
+
 	// ###########################################################################
 	// #                            MEMBER FUNCTIONS                             #
 	// ###########################################################################
@@ -341,9 +417,9 @@ class Rbtree
 	*/
 	node_type *create_null_node(node_type *p)
 	{
-		//creates a new node using an object of type node_type with NULL data
-		node_type null_node(NULL);
-		node_type *node_ptr = _node_alloc.allocate(1);
+		//creates a new node using an object of type stored_node_type with NULL data
+		stored_node_type null_node(NULL);
+		stored_node_type *node_ptr = _node_alloc.allocate(1);
 		//The new node's parent field is set to p
 		null_node.parent = p;
 		//both its left and right fields are set to NULL
@@ -359,30 +435,82 @@ class Rbtree
 		return node_ptr;
 	}
 
-	/** inserts a new node into the red-black tree
-	 * The function takes as input a value of type T (value), 
-	 * which is the value to be inserted into the tree. 
-	*/
-	node_type *insert_value(T value)
+	/** Creates a new unlinked node holding a copy of value, without children.*/
+	node_type *create_bare_node(const T &value)
 	{
 		// first allocates memory for the new data using an object of type _alloc
 		T *node_data = _alloc.allocate(1);
 		// construct the new data in the allocated memory
 		_alloc.construct(node_data, value);
 		// allocates memory for the new node using an object of type _node_alloc
-		node_type *node_ptr = _node_alloc.allocate(1);
-		// creates a new object of type node_type with the new data
-		node_type node(node_data);
+		stored_node_type *node_ptr = _node_alloc.allocate(1);
+		// construct a new node with the new data in the allocated memory
+		_node_alloc.construct(node_ptr, stored_node_type(node_data));
+		return (node_ptr);
+	}
+
+	/** Creates a new unlinked node holding a copy of value, with two null leaves.*/
+	node_type *create_node(const T &value)
+	{
+		node_type *node_ptr = create_bare_node(value);
 		// sets its left and right fields to be two new null leaf nodes
-		node.left = create_null_node(node_ptr);
-		node.right = create_null_node(node_ptr);
-		// construct the new node in the allocated memory
-		_node_alloc.construct(node_ptr, node);
+		node_ptr->left = create_null_node(node_ptr);
+		node_ptr->right = create_null_node(node_ptr);
+		return (node_ptr);
+	}
+
+	/** Recomputes the augmentation summaries from node up to the root.*/
+	void update_path(node_type *node)
+	{
+		if (!Augment::enabled)
+			return;
+		for (; node; node = node->parent)
+			Augment::update(node);
+	}
+
+	/** Makes root, detached from any parent, the root of the tree.*/
+	void set_root(node_type *root)
+	{
+		root->parent = NULL;
+		this->_root = root;
+	}
+
+	/**
+	 * Links node in the place of spine (a node of the tree or its root), with
+	 * spine as its left child when spine_left, its right child otherwise, and
+	 * other as its other child. For the join hook of the balancing policies.
+	*/
+	void splice_join(node_type *spine, node_type *node, node_type *other, bool spine_left)
+	{
+		node_type *parent = spine->parent;
+
+		node->parent = parent;
+		if (!parent)
+			this->_root = node;
+		else if (parent->left == spine)
+			parent->left = node;
+		else
+			parent->right = node;
+		node->left = spine_left ? spine : other;
+		node->right = spine_left ? other : spine;
+		spine->parent = node;
+		other->parent = node;
+	}
+
+	/** inserts a new node into the red-black tree
+	 * The function takes as input a value of type T (value), 
+	 * which is the value to be inserted into the tree. 
+	*/
+	node_type *insert_value(T value)
+	{
+		// creates the node, its data and its two null leaves
+		node_type *node_ptr = create_node(value);
 		//calls the insert_BST function to insert the new node into the red-black tree
 		this->_root = insert_BST(this->_root, node_ptr);
-		// calls the fix_insert_RBT function to fix any violations of the red-black tree 
+		update_path(node_ptr);
+		// calls the balancing policy to fix any violations of the tree
 		//properties caused by the insertion of the new node
-		fix_insert_RBT(node_ptr);
+		Balance::fix_insert(*this, node_ptr);
 		// returns a pointer to the newly inserted node
 		return (node_ptr);
 	}
@@ -396,26 +524,20 @@ class Rbtree
 		 * value of the successor is less than the value. If this is true, 
 		 * it calls the insert_value function with just the value as input 
 		 * to insert the value in the standard manner.*/
-		if (!is_null_leaf(this->successor(pos)) &&
-		    this->_comp(*this->successor(pos)->data, value)){
+		if (!pos || is_null_leaf(pos) ||
+		    (!is_null_leaf(this->successor(pos)) &&
+		    this->_comp(*this->successor(pos)->data, value)) ||
+		    (this->predecessor(pos) && !is_null_leaf(this->predecessor(pos)) &&
+		    this->_comp(value, *this->predecessor(pos)->data))){
 			return insert_value(value);
 		}
-		//Otherwise, it allocates memory for the data of the node
-		T *node_data = _alloc.allocate(1);
-		// constructs the data in place
-		_alloc.construct(node_data, value);
-		// allocates memory for the node
-		node_type *node_ptr = _node_alloc.allocate(1);
-		// creates a new node with the data
-		node_type node(node_data);
-		// creates two null children for the node, both pointing to the parent
-		node.left = create_null_node(node_ptr);
-		node.right = create_null_node(node_ptr);
-		_node_alloc.construct(node_ptr, node);
+		//Otherwise, it creates the node with its data and two null children
+		node_type *node_ptr = create_node(value);
 		// inserts the node in the BST 
-		pos = insert_BST(pos, node_ptr);
-		// fixes the red-black tree properties
-		fix_insert_RBT(pos);
+		insert_BST(pos, node_ptr);
+		update_path(node_ptr);
+		// fixes the tree properties, starting from the new node
+		Balance::fix_insert(*this, node_ptr);
 		// returns a pointer to the newly inserted node
 		return (node_ptr);
 	}
@@ -444,6 +566,16 @@ class Rbtree
 		return (NULL);
 	}
 
+	/** Same search from a non const tree: a found node is handed to the balancing
+	 * policy, which lets splay_balance move it to the root.*/
+	node_type *lookup_value(T value)
+	{
+		node_type *node = static_cast<const Rbtree &>(*this).lookup_value(value);
+		if (node)
+			Balance::after_access(*this, node);
+		return (node);
+	}
+
 	/** a recursive function to look for a value in a binary search tree
 	 * Takes as input the root of the tree and the value to look for.
 	 * Uses the comparison function _comp defined in the class to compare 
@@ -451,22 +583,27 @@ class Rbtree
 	*/
 	node_type *lookup_value(node_type *root, const T value) const
 	{
-		/** Checks if the root is not null and if it is not a null leaf node.
-		 * If it is either null or a null leaf node, the function returns null, 
+		/** Walks down while the root is not null and not a null leaf node.
+		 * If it becomes either null or a null leaf node, the function returns null, 
 		 * indicating that the value is not present in the tree.
+		 * (A loop rather than recursion: unbalanced policies such as splay can
+		 * have linear height.)
 		 */
-		if (!root || is_null_leaf(root))
-			return (NULL);
-		/*If the value is smaller than the data stored in the root, 
-		/ it recursively calls lookup_value on the left subtree*/
-		if (this->_comp(value, *root->data))//menor
-			return (lookup_value(root->left, value));
-		/*If the value is greater than the data stored in the root, 
-		it recursively calls lookup_value on the right subtree.*/
-		else if (this->_comp(*root->data, value))//maior
-			return (lookup_value(root->right, value));
-		//If the value is equal to the data stored in the root, returns the root.
-		return (root);
+		while (root && !is_null_leaf(root))
+		{
+			/*If the value is smaller than the data stored in the root, 
+			/ it continues on the left subtree*/
+			if (this->_comp(value, *root->data))//menor
+				root = root->left;
+			/*If the value is greater than the data stored in the root, 
+			it continues on the right subtree.*/
+			else if (this->_comp(*root->data, value))//maior
+				root = root->right;
+			//If the value is equal to the data stored in the root, returns the root.
+			else
+				return (root);
+		}
+		return (NULL);
 	}
 
 	/**
@@ -480,28 +617,24 @@ class Rbtree
 	 * member variable _comp of the class that contains this function.
 	 * */
 	node_type *lower_bound(node_type *root, const T &value) const{
-		node_type *x;
-		//checking if the root of the tree is null or if it is a null leaf 
-		//(using the is_null_leaf function), and in this case returns NULL
-		if (!root || is_null_leaf(root))
-			return (NULL);
-		//Then compares the value value with the data stored in the root of the tree.
-		if (this->_comp(value, *root->data)){// menor
-			//If value is less, the function calls itself recursively with the left 
-			//subtree of the root and returns the result. 
-			x = lower_bound(root->left, value);
-			if (!x)
-				return root; 
-			return x;
-		}
-		//If value is greater, the function calls itself recursively with the right 
-		//subtree of the root and returns the result. 
-		if (this->_comp(*root->data, value)){// maior
-			return lower_bound(root->right, value);;
+		node_type *x = NULL;
+		/* As upper_bound(): a loop down from the root, remembering the last
+		node whose value is greater, so that degenerate trees do not overflow
+		the stack.*/
+		while (root && !is_null_leaf(root)){
+			//If value is less, the root is a candidate and the bound is on its left
+			if (this->_comp(value, *root->data)){// menor
+				x = root;
+				root = root->left;
+			}
+			//If value is greater, the bound is on the right
+			else if (this->_comp(*root->data, value))// maior
+				root = root->right;
+			//If value is equal to the data stored in the root, it is the bound
+			else
+				return (root);
 		}
-		//If value is equal to the data stored in the 
-		//root of the tree, the function returns the root.
-		return (root);
+		return (x);
 	}
 
 	/**
@@ -573,6 +706,7 @@ class Rbtree
 		std::swap(this->_root, src._root);
 		std::swap(this->_alloc, src._alloc);
 		std::swap(this->_comp, src._comp);
+		std::swap(this->_rotations, src._rotations);
 	}
 
 	/**the "clear" function of a data structure. 
@@ -607,6 +741,7 @@ class Rbtree
 		/*"right" is a pointer to the right child of the node "n"
 		/The operation starts by updating the right child of "n" to be the left child of "right"*/
 		node_type *right = n->right;
+		this->_rotations++;
 		n->right = right->left;
 		//updates the parent of the previous right child of n, if it exists
 		if (n->right)
@@ -627,6 +762,9 @@ class Rbtree
 		n->parent = right;
 		//the left child of "right" is updated to be "n"
 		right->left = n;
+		//the summaries of the two nodes that moved are recomputed, lower one first
+		Augment::update(n);
+		Augment::update(right);
 	}
 
 	//   P (nodeGoingUp) is going up and will replace Q (nodeGoingDown)
@@ -647,6 +785,7 @@ class Rbtree
 	{
 		//The left child of the node n is stored in the variable left
 		node_type *left = n->left;
+		this->_rotations++;
 		//The left child of n is updated to be the right child of left
 		n->left = left->right;
 		//If n->left is not NULL, its parent is updated to be n
@@ -667,6 +806,9 @@ class Rbtree
 		n->parent = left;
 		//The right child of left is updated to be n
 		left->right = n;
+		//the summaries of the two nodes that moved are recomputed, lower one first
+		Augment::update(n);
+		Augment::update(left);
 	}
 
 	/**
@@ -678,10 +820,9 @@ class Rbtree
 	 * If it is, the function destroys the node and returns value as the new root of the BST.
 	 * Next, compares the data stored in value with the data stored in root using the comparison function 
 	 * specified in the constructor of the Rbtree class. 
-	 * If the data stored in value is less than the data stored in root, inserts value as the left child of root 
-	 * by calling insert_BST recursively on the left subtree of root. 
-	 * If the data stored in value is greater than the data stored in root, inserts value as the right child of root 
-	 * by calling insert_BST recursively on the right subtree of root. 
+	 * Otherwise it walks down from root: left when the data stored in value is less than the data
+	 * of the current node, right when it is greater, until it reaches the null leaf where value belongs.
+	 * That null leaf is destroyed and value is linked in its place.
 	 * Finally, the function returns root to maintain the structure of the BST.
 	*/
 	node_type *insert_BST(node_type *root, node_type *value)
@@ -694,168 +835,28 @@ class Rbtree
 			destroy_node(root);
 			return (value);
 		}
-		//if value is less than root insert at root left
-		if (this->_comp(*value->data, *root->data))
+		node_type *node = root;
+		node_type **link;
+		while (true)
 		{
-			root->left = insert_BST(root->left, value);
-			root->left->parent = root;
-		}
-		//if value is greater than root insert at root right
-		else if (this->_comp(*root->data, *value->data))
-		{
-			root->right = insert_BST(root->right, value);
-			root->right->parent = root;
+			//if value is less than node go to node left
+			if (this->_comp(*value->data, *node->data))
+				link = &node->left;
+			//if value is greater than node go to node right
+			else if (this->_comp(*node->data, *value->data))
+				link = &node->right;
+			else
+				return (root);
+			if (!*link || is_null_leaf(*link))
+				break;
+			node = *link;
 		}
+		destroy_node(*link);
+		*link = value;
+		value->parent = node;
 		return (root);
 	}
 
-	/**
-	 * Function to fix an RBT (Red-Black Tree) after inserting a node in order 
-	 * to maintain its red-black properties. The red-black tree is a type of 
-	 * binary search tree that is balanced, meaning that its height is logarithmic 
-	 * in the number of nodes. This is achieved by color coding the nodes in the tree: black and red. 
-	 * There are specific rules that must be maintained for a red-black tree to remain balanced, 
-	 * and this function enforces these rules after an insertion has been made. 
-	 * The function takes a newly inserted node as input and adjusts the properties of the Red-Black 
-	 * tree to maintain balance and ensure that the tree still satisfies the properties of a Red-Black tree. T
-	 * he function does this by checking for any possible violations of the Red-Black tree properties and
-	 * fixing them by rotating nodes and changing the color of some nodes. The function continues to do this
-	 * until there are no more violations and the Red-Black tree remains balanced.
-	 * 
-	 * Takes in a pointer to a node in a Red-Black Tree and modifies the tree to ensure that it still 
-	 * satisfies the Red-Black Tree properties after the insertion of the new node.
-	*/
-	void fix_insert_RBT(node_type *node)
-	{
-		/**
-		 * The function starts by checking the color of the parent node of the newly inserted node. 
-		 * If the parent node is red, then we check the color of the uncle node (the sibling of the parent node). 
-		 * There are three cases:
-		 * 	Case 1: If the uncle node is red, then we change the color of the uncle node to black, 
-		 * 		the color of the parent node to black, and the color of the grandparent node to red. 
-		 * 		Then, we set the newly inserted node to be the grandparent node and repeat the same process.
-		 * 	Case 2: If the uncle node is black, and the newly inserted node is a left child of its parent, 
-		 * 		then we rotate the parent node to the right.
-		 * 	Case 3: If the uncle node is black, and the newly inserted node is a right child of its parent, 
-		 * 		then we rotate the grandparent node to the left and change the color of the parent node 
-		 * 		to black and the color of the grandparent node to red.
-		 * 	Finally, the function sets the color of the root node to black.
-		*/
-		//declares a pointer to a node type and initializes it to NULL
-		node_type *uncle = NULL;
-		/* starts a while loop that will continue to execute as long as node 
-		/is not the root of the tree and the color of node->parent is red.*/
-		while (node != this->_root && get_color(node->parent) == RED)
-		{
-			/*checks if the parent of node is the right child of its grandparent.*/
-			if (node->parent == node->parent->parent->right)
-			{
-				/**If the parent of node is the right child of its grandparent, 
-				 * sets uncle to be the left child of the grandparent.*/
-				uncle = node->parent->parent->left;
-				//checks if the color of uncle is red
-				if (get_color(uncle) == RED)
-				{
-					//std::cout << "Case 1a\n";
-					/**If the color of uncle is red, sets the color of uncle to black*/
-					set_color(uncle, BLACK);
-					/*If the color of uncle is red, sets the color of the parent of node to black.*/
-					set_color(node->parent, BLACK);
-					/* and sets the color of the grandparent of node to red*/
-					set_color(node->parent->parent, RED);
-					/**and sets node to be the grandparent of node*/
-					node = node->parent->parent;
-				}
-				else /*If the color of uncle is not red, the code inside the else statement will be executed.*/
-				{
-					// checks if node is the left child of node->parent
-					if (node == node->parent->left)
-					{
-						//std::cout << "Case 2a\n";
-						//If node is the left child of its parent, sets node to be its parent
-						node = node->parent;
-						//performs a right rotation on node
-						rotate_right(node);
-					}
-					//std::cout << "Case 3a\n";
-					//sets the color of the parent of node to black
-					set_color(node->parent, BLACK);
-					//sets the color of the grandparent of node to red
-					set_color(node->parent->parent, RED);
-					//performs a left rotation on the grandparent of node
-					rotate_left(node->parent->parent);
-				}
-			}
-			else/*else the parent of node is the not right child of its grandparent.*/
-			{
-				/** assigns uncle to the right sibling of the node's parent*/
-				uncle = node->parent->parent->right;
-				/*checks if the color of uncle is red*/
-				if (get_color(uncle) == RED)
-				{
-					//std::cout << "Case 1b\n";
-					/** if it is, the code changes the color of uncle to black, 
-					 * the color of node's parent to black, and the color of node's 
-					 * grandparent to red. Then, node is updated to be the grandparent.*/
-					set_color(uncle, BLACK);
-					set_color(node->parent, BLACK);
-					set_color(node->parent->parent, RED);
-					node = node->parent->parent;
-				}
-				else/*If uncle is not red*/
-				{
-					/*the next step is checking if the node is on the right of its parent*/
-					if (node == node->parent->right)
-					{
-						//std::cout << "Case 2b\n";
-						/*If it is, the code performs a left rotation on the node's parent, 
-						effectively moving the node to be its parent's left child*/
-						node = node->parent;
-						rotate_left(node);
-					}
-					// std::cout << "Case 3b\n";
-					/* changes the color of the node's parent to black,
-					 and the color of the node's grandparent to red.*/
-					set_color(node->parent, BLACK);
-					set_color(node->parent->parent, RED);
-					//performs a right rotation on the node's grandparent
-					rotate_right(node->parent->parent);
-				}
-			}
-		}
-		// std::cout << "Case 0\n" if is root;
-		//Sets the color of the root of the tree to black
-		set_color(this->_root, BLACK);
-		return;
-	}
-
-	/**
-	 * helper function that is used to determine the color of a node in a Red-Black Tree. 
-	 * If the node is NULL, it returns BLACK. 
-	 * If the node is not NULL, it returns the color attribute of the node. 
-	 * The color attribute of a node is either RED or BLACK. 
-	 * This function is used to check the color of the nodes in the tree, 
-	 * which is an important property of Red-Black Trees
-	*/
-	int get_color(node_type *node)
-	{
-		if (node == NULL)
-			return BLACK;
-		return (node->color);
-	}
-
-	/**Sets the color of a node in the red-black tree. 
-	 * The function takes two arguments: a pointer to the node (node) and the color to set (color).
-	 * Starts by checking if the node pointer is NULL. If it is, the function returns without doing anything.
-	 * If the node pointer is not NULL, the function sets the color member of the node to the value of the color argument. 
-	 * This updates the color of the node in the red-black tree.*/
-	void set_color(node_type *node, int color)
-	{
-		if (node == NULL)
-			return;
-		node->color = color;
-	}
-
 	/**transplant is a helper function that replaces one node in a tree with another node. 
 	 * The purpose of this function is to simplify the implementation of tree operations like delete and insert.
 	 * The function takes two parameters: u and v. 
@@ -878,146 +879,6 @@ class Rbtree
 			v->parent = u->parent;
 	}
 
-	/**
-	 * Used to restore the red-black tree properties after a node is deleted. 
-	 * It takes a single argument node, which is a pointer to the node that was deleted.
-	*/
-	void fix_delete_RBT(node_type *node)
-	{
-		node_type *sibling;
-		/*The function starts a loop and checks if the node is the root of the tree and its color is black. 
-		If these conditions are true, the loop continues, otherwise, it terminates.*/
-		while (node != this->_root && get_color(node) == BLACK)
-		{
-			/*The loop first checks if the node is a left child
-			Based on that, it sets the sibling node to the other child of the parent node.*/
-			if (node == node->parent->left)
-			{
-				sibling = node->parent->right;
-				/*If the sibling node's color is red, the function performs 
-				a color flip and a rotation to balance the tree.*/
-				if (get_color(sibling) == RED)
-				{
-					//std::cout << "Case 1a\n";
-					set_color(sibling, BLACK);
-					set_color(node->parent, RED);
-					rotate_left(node->parent);
-					sibling = node->parent->right;
-				}
-				/*If the sibling node's color is black and both of its children are also black, 
-				changes the color of the sibling node to red and sets the node to its parent.*/
-				if (get_color(sibling->left) == BLACK &&
-				    get_color(sibling->right) == BLACK)
-				{
-					//std::cout << "Case 2a\n";
-					set_color(sibling, RED);
-					node = node->parent;
-				}
-				else//or a right child of its parent
-				{
-					/**
-					 * If the sibling is black, and one of its children is red, 
-					 * the code performs the following actions:
-					 * 		Changes the color of the red child to black
-					 * 		Changes the color of the sibling to red
-					 * 		Performs a right rotation on the sibling node 
-					 * 		Updates the sibling reference to the new sibling
-					*/
-					if (get_color(sibling->right) == BLACK)
-					{
-						//std::cout << "Case 3a\n";
-						set_color(sibling->left, BLACK);
-						set_color(sibling, RED);
-						rotate_right(sibling);
-						sibling = node->parent->right;
-					}
-					/**If the sibling is black, and one of its children is red, 
-					 * the code performs the following actions:
-					 * 		Changes the color of the sibling to the color of the parent node
-					 * 		Changes the color of the parent node to black
-					 * 		Changes the color of the red child of the sibling to black
-					 * 		Performs a left rotation on the parent node.*/
-					//std::cout << "Case 4a\n";
-					set_color(sibling, get_color(node->parent));
-					set_color(node->parent, BLACK);
-					set_color(sibling->right, BLACK);
-					rotate_left(node->parent);
-					break;
-				}
-			}
-			else
-			{
-				sibling = node->parent->left;
-				/**
-				 * If the sibling is red, the code performs the following actions:
-				 * 		Changes the color of the sibling to black
-				 * 		Changes the color of the parent node to red
-				 * 		Performs a right rotation on the parent node
-				 * 		Updates the sibling reference to the new sibling
-				*/
-				if (get_color(sibling) == RED)
-				{
-					//std::cout << "Case 1b\n";
-					set_color(sibling, BLACK);
-					set_color(node->parent, RED);
-					rotate_right(node->parent);
-					sibling = node->parent->left;
-				}
-				/**
-				 * If the sibling is black, the code checks the colors of its children. 
-				 * If both the left and right children of the sibling are black, 
-				 * the code performs the following actions:
-				 * 		Changes the color of the sibling to red
-				 * 		Updates the node reference to the parent node
-				*/
-				if (get_color(sibling->right) == BLACK &&
-				    get_color(sibling->left) == BLACK)
-				{
-					//std::cout << "Case 2b\n";
-					set_color(sibling, RED);
-					node = node->parent;
-				}
-				else
-				{
-					/**
-					 * If the sibling is black, and one of its children is red, 
-					 * the code performs the following actions:
-					 * 		Changes the color of the red child to black
-					 * 		Changes the color of the sibling to red
-					 * 		Performs a left rotation on the sibling node 
-					 * 		Updates the sibling reference to the new sibling
-					*/
-					if (get_color(sibling->left) == BLACK)
-					{
-						//std::cout << "Case 3b\n";
-						set_color(sibling->right,
-							  BLACK);
-						set_color(sibling, RED);
-						rotate_left(sibling);
-						sibling = node->parent->left;
-					}
-					/**If the sibling is black, and one of its children is red, 
-					 * the code performs the following actions:
-					 * 		Changes the color of the sibling to the color of the parent node
-					 * 		Changes the color of the parent node to black
-					 * 		Changes the color of the red child of the sibling to black
-					 * 		Performs a right rotation on the parent node.*/
-					//std::cout << "Case 4b\n";
-					set_color(sibling,
-						  get_color(node->parent));
-					set_color(node->parent, BLACK);
-					set_color(sibling->left, BLACK);
-					rotate_right(node->parent);
-					break;
-				}
-			}
-		}
-		/*Finally, the function sets the color of the node to black and terminates the loop. 
-		/ This is to ensure that the root of the tree remains black.*/
-		//std::cout << "Case 5 - root\n";
-		set_color(node, BLACK);
-	}
-	
 	void delete_node(node_type *node)
 	{
 		if (!node)
@@ -1102,33 +963,42 @@ class Rbtree
 		}
 		/**
 		 * checks if the color of the node that was deleted was black. 
-		 * If so, it performs a fix-up operation to restore the red-black tree properties (fix_delete_RBT). 
+		 * If so, it performs a fix-up operation to restore the red-black tree properties (rb_balance::fix_delete). 
 		 * This operation ensures that the number of black nodes from the root to the leaves remains the same for every path, 
-		 * which is one of the properties of a red-black tree.
+		 * which is one of the properties of a red-black tree. Other policies rebalance from aux upwards.
 		*/
 		destroy_node(temp);
-		if (temp_original_color == BLACK)
-			fix_delete_RBT(aux);
+		update_path(aux->parent);
+		Balance::fix_delete(*this, aux, temp_original_color);
 	}
 
 	/**
-	 * a recursive function that is used to delete all nodes of a Red-Black tree. 
-	 * The function takes a pointer to the root node of the tree as an argument.
-	 * The function works as follows:
-	 * If the current node is a null leaf, the function returns immediately.
-	 * Recursively call the destroy_nodes function on the left child of the current node.
-	 * Recursively call the destroy_nodes function on the right child of the current node.
-	 * Call the destroy_node function on the current node.
-	 * This way, the function will traverse the tree in post-order and delete all nodes, 
-	 * starting from the leaves and working its way up to the root node.
+	 * Deletes all the nodes of the subtree of node, null leaves included.
+	 * A loop, not a recursion, so a tree of linear height (splay) does not
+	 * overflow the stack: while the current node has a left child, a right
+	 * rotation lifts that child above it; once it has none, the node is
+	 * freed and its right child is next. Every node is rotated at most once
+	 * per ancestor it has on its left, O(n) in total, and no memory is
+	 * needed. The parent pointers are ignored.
 	*/
 	void destroy_nodes(node_type *node)
 	{
-		if (!node)
-			return;
-		destroy_nodes(node->left);
-		destroy_nodes(node->right);
-		destroy_node(node);
+		while (node)
+		{
+			if (node->left)
+			{
+				node_type *left = node->left;
+				node->left = left->right;
+				left->right = node;
+				node = left;
+			}
+			else
+			{
+				node_type *right = node->right;
+				destroy_node(node);
+				node = right;
+			}
+		}
 	}
 
 	/**
@@ -1150,25 +1020,28 @@ class Rbtree
 			_alloc.destroy(node->data);
 			_alloc.deallocate(node->data, 1);
 		}
-		_node_alloc.destroy(node);
-		_node_alloc.deallocate(node, 1);
+		_node_alloc.destroy(static_cast<stored_node_type *>(node));
+		_node_alloc.deallocate(static_cast<stored_node_type *>(node), 1);
 	}
 
 	/**
 	 * Finds the in-order successor of a node in a binary search tree. 
 	 * The function first checks if the node is NULL or if its parent is NULL, in which case it returns NULL.
 	 * Then, it checks if the node is its parent's left child. If it is, the parent is the in-order successor.
-	 * Otherwise, the function recursively calls itself on the node's parent to find the in-order successor. 
+	 * Otherwise, the function moves up to the node's parent and checks again, in a loop
+	 * (a tree of linear height must not recurse on its depth).
 	 * The in-order successor of a node in a binary search tree is the node that comes 
 	 * immediately after the node in a in-order traversal of the tree.
 	*/
 	static node_type *find_successor(node_type *node)
 	{
-		if (!node || !node->parent)
-			return (NULL);
-		if (node->parent->left == node)
-			return (node->parent);
-		return (find_successor(node->parent));
+		while (node && node->parent)
+		{
+			if (node->parent->left == node)
+				return (node->parent);
+			node = node->parent;
+		}
+		return (NULL);
 	}
 
 	/**
@@ -1176,36 +1049,663 @@ class Rbtree
 	 * If the given node has a left child, then the predecessor of the node is the maximum node in the left subtree of the node. 
 	 * If the node does not have a left child, then the predecessor is the first ancestor of the node for which the node 
 	 * is in the right subtree of that ancestor. If the given node is NULL or its parent is NULL, the function returns NULL.
-	 * This function works by using recursion to traverse the tree up to the root. 
-	 * At each step of the recursion, the function checks whether the given node is the right child of its parent. 
+	 * This function works by using a loop to traverse the tree up to the root. 
+	 * At each step, the function checks whether the given node is the right child of its parent. 
 	 * If it is, then the parent node is returned as the predecessor. 
-	 * If it is not, then the function is called again with the parent node as the input, continuing the upward traversal.
+	 * If it is not, then the loop continues with the parent node, continuing the upward traversal.
 	*/
 	static node_type *find_predecessor(node_type *node)
 	{
-		if (!node || !node->parent)
-			return (NULL);
-		if (node->parent->right == node)
-			return (node->parent);
-		return (find_predecessor(node->parent));
+		while (node && node->parent)
+		{
+			if (node->parent->right == node)
+				return (node->parent);
+			node = node->parent;
+		}
+		return (NULL);
+	}
+
+	// ###########################################################################
+	// #                           CLONE AND TEARDOWN                            #
+	// ###########################################################################
+
+	/**
+	 * Copies src node for node, balance fields included, in O(n): no
+	 * comparison and no rebalancing, unlike inserting every element. The tree
+	 * must be empty. The subtrees are copied by up to threads threads, whose
+	 * allocators must then be usable from several threads at once; a subtree
+	 * is only forked while it holds ft::parallel_grain elements or more,
+	 * estimated from size, the element count of src, halved at each level.
+	*/
+	void clone(const Rbtree &src, size_t threads, size_type size)
+	{
+		if (src._root)
+			this->_root = clone_nodes(src._root, NULL, threads, size);
+	}
+
+	/** clear(), the subtrees freed by up to threads threads, cut off as in clone().*/
+	void clear(size_t threads, size_type size)
+	{
+		node_type *root = this->_root;
+
+		this->_root = NULL;
+		destroy_nodes(root, threads, size);
+	}
+
+	/**
+	 * Empties the tree at once, and frees its nodes on a background thread
+	 * (ft::background), or right away if no thread can be started. The
+	 * allocators must be usable from another thread.
+	*/
+	void clear_in_background(void)
+	{
+		teardown_job *job;
+
+		if (!this->_root)
+			return;
+		try
+		{
+			job = new teardown_job(*this);
+		}
+		catch (...)
+		{
+			clear();
+			return;
+		}
+		job->tree._root = this->_root;
+		this->_root = NULL;
+		ft::background::run(job);
+	}
+
+	private:
+	/* Owns the nodes of a cleared tree until a background thread frees them.*/
+	struct teardown_job
+	{
+		Rbtree	tree;
+
+		teardown_job(const Rbtree &src)
+			: tree(src._comp, src._alloc, src._node_alloc) {}
+
+		void operator()(void)
+		{
+			tree.clear();
+		}
+	};
+
+	/* Copies the subtree of src (about size elements) under parent, left half forked.*/
+	struct clone_task
+	{
+		Rbtree				*tree;
+		const node_type		*src;
+		node_type			*parent;
+		size_t				threads;
+		size_type			size;
+		node_type			*result;
+
+		clone_task(Rbtree *tree, const node_type *src, node_type *parent, size_t threads, size_type size)
+			: tree(tree), src(src), parent(parent), threads(threads), size(size), result(NULL) {}
+
+		void operator()(void)
+		{
+			result = tree->clone_nodes(src, parent, threads, size);
+		}
+	};
+
+	node_type *clone_nodes(const node_type *src, node_type *parent, size_t threads, size_type size)
+	{
+		if (threads < 2 || size < ft::parallel_grain || is_null_leaf(src))
+			return (clone_sequential(src, parent));
+		node_type *node = create_bare_node(*src->data);
+
+		node->parent = parent;
+		node->color = src->color;
+		try
+		{
+			clone_task left(this, src->left, node, threads / 2, size / 2);
+			ft::fork_task<clone_task> fork(left);
+			try
+			{
+				node->right = clone_nodes(src->right, node, threads - threads / 2, size / 2);
+			}
+			catch (...)
+			{
+				fork.join();
+				destroy_nodes(left.result);
+				throw;
+			}
+			if (!fork.join())
+			{
+				destroy_nodes(node->right);
+				throw std::bad_alloc();
+			}
+			node->left = left.result;
+		}
+		catch (...)
+		{
+			destroy_node(node);
+			throw;
+		}
+		if (Augment::enabled)
+			Augment::update(node);
+		return (node);
+	}
+
+	/* One node of src, its children left NULL for clone_sequential to fill.*/
+	node_type *clone_one(const node_type *src, node_type *parent)
+	{
+		node_type *node = is_null_leaf(src) ? create_null_node(parent) : create_bare_node(*src->data);
+
+		node->parent = parent;
+		node->color = src->color;
+		return (node);
+	}
+
+	/*
+	 * Copies the subtree of src under parent on this thread, walking down
+	 * the source and back up along the parent pointers of the copy: a loop,
+	 * so a tree of linear height (splay) does not overflow the stack. The
+	 * copy is freed if an allocation throws.
+	*/
+	node_type *clone_sequential(const node_type *src, node_type *parent)
+	{
+		node_type *root = clone_one(src, parent);
+		node_type *node = root;
+
+		try
+		{
+			while (true)
+			{
+				if (!is_null_leaf(src) && !node->left)
+				{
+					node->left = clone_one(src->left, node);
+					src = src->left;
+					node = node->left;
+				}
+				else if (!is_null_leaf(src) && !node->right)
+				{
+					node->right = clone_one(src->right, node);
+					src = src->right;
+					node = node->right;
+				}
+				else
+				{
+					if (Augment::enabled && !is_null_leaf(src))
+						Augment::update(node);
+					if (node == root)
+						return (root);
+					src = src->parent;
+					node = node->parent;
+				}
+			}
+		}
+		catch (...)
+		{
+			destroy_nodes(root);
+			throw;
+		}
+	}
+
+	/* Frees the subtree of node (about size elements), left half forked.*/
+	struct destroy_task
+	{
+		Rbtree		*tree;
+		node_type	*node;
+		size_t		threads;
+		size_type	size;
+
+		destroy_task(Rbtree *tree, node_type *node, size_t threads, size_type size)
+			: tree(tree), node(node), threads(threads), size(size) {}
+
+		void operator()(void)
+		{
+			tree->destroy_nodes(node, threads, size);
+		}
+	};
+
+	void destroy_nodes(node_type *node, size_t threads, size_type size)
+	{
+		if (threads < 2 || size < ft::parallel_grain || !node || is_null_leaf(node))
+		{
+			destroy_nodes(node);
+			return;
+		}
+		destroy_task left(this, node->left, threads / 2, size / 2);
+		{
+			ft::fork_task<destroy_task> fork(left);
+			destroy_nodes(node->right, threads - threads / 2, size / 2);
+		}
+		destroy_node(node);
 	}
 
+	public:
+	// ###########################################################################
+	// #                               BULK BUILD                                #
+	// ###########################################################################
+
 	/**
-	 * This function is called copy_nodes and is used to copy the nodes of a tree to another tree. 
-	 * It takes in a const pointer to a node of the tree to be copied as an argument. 
-	 * The function first checks if the node pointer is NULL or if it's a null leaf, and in either case returns without doing anything.
-	 * Otherwise, the function recursively copies the nodes in the left subtree of the node, 
-	 * then inserts the value stored in the current node into the target tree using the insert_value function. 
-	 * Finally, the function recursively copies the nodes in the right subtree of the node.
+	 * Builds the tree from n values already sorted and unique, in O(n). The tree
+	 * must be empty. Every node takes the middle of its range, so the null
+	 * leaves all sit on the last two levels, and the balancing policy sets the
+	 * balance fields from that shape (fix_build). The subtrees are built by up
+	 * to threads threads at once: the allocators must then be usable from
+	 * several threads, as std::allocator is.
+	 * @param values Pointers to the values, converted to T when copied.
 	*/
-	void copy_nodes(const node_type *node)
+	template <class Source>
+	void build(const Source *const *values, size_type n, size_t threads)
 	{
-		if (!node || is_null_leaf(node))
+		int full = 0;
+
+		if (n == 0)
 			return;
-		copy_nodes(node->left);
-		insert_value(*node->data);
-		copy_nodes(node->right);
+		// complete levels of an n nodes tree: floor(log2(n + 1))
+		while ((((size_type)2 << full) - 1) <= n)
+			full++;
+		this->_root = build_nodes(values, n, NULL, 0, full, threads);
 	}
+
+	private:
+	/* Builds the subtree of the n values under parent, left half forked.*/
+	template <class Source>
+	struct build_task
+	{
+		Rbtree					*tree;
+		const Source *const		*values;
+		size_type				n;
+		node_type				*parent;
+		int						depth;
+		int						full;
+		size_t					threads;
+		node_type				*result;
+
+		build_task(Rbtree *tree, const Source *const *values, size_type n,
+			node_type *parent, int depth, int full, size_t threads)
+			: tree(tree), values(values), n(n), parent(parent), depth(depth),
+			full(full), threads(threads), result(NULL) {}
+
+		void operator()(void)
+		{
+			result = tree->build_nodes(values, n, parent, depth, full, threads);
+		}
+	};
+
+	template <class Source>
+	node_type *build_nodes(const Source *const *values, size_type n, node_type *parent,
+		int depth, int full, size_t threads)
+	{
+		if (n == 0)
+			return (create_null_node(parent));
+		size_type mid = n / 2;
+		node_type *node = create_bare_node(*values[mid]);
+
+		node->parent = parent;
+		try
+		{
+			if (threads > 1 && n >= ft::parallel_grain)
+			{
+				build_task<Source> left(this, values, mid, node, depth + 1, full, threads / 2);
+				ft::fork_task<build_task<Source> > fork(left);
+				try
+				{
+					node->right = build_nodes(values + mid + 1, n - mid - 1, node,
+						depth + 1, full, threads - threads / 2);
+				}
+				catch (...)
+				{
+					fork.join();
+					destroy_nodes(left.result);
+					throw;
+				}
+				if (!fork.join())
+				{
+					destroy_nodes(node->right);
+					throw std::bad_alloc();
+				}
+				node->left = left.result;
+			}
+			else
+			{
+				node->left = build_nodes(values, mid, node, depth + 1, full, 1);
+				try
+				{
+					node->right = build_nodes(values + mid + 1, n - mid - 1, node,
+						depth + 1, full, 1);
+				}
+				catch (...)
+				{
+					destroy_nodes(node->left);
+					throw;
+				}
+			}
+		}
+		catch (...)
+		{
+			destroy_node(node);
+			throw;
+		}
+		Balance::fix_build(*this, node, depth, full);
+		if (Augment::enabled)
+			Augment::update(node);
+		return (node);
+	}
+
+	public:
+	// ###########################################################################
+	// #                               SET ALGEBRA                               #
+	// ###########################################################################
+
+	enum set_operation
+	{
+		algebra_union,			// elements of either tree
+		algebra_intersection,	// elements of this tree also in the other
+		algebra_difference		// elements of this tree not in the other
+	};
+
+	/**
+	 * Replaces the tree by op applied to it and other, moving the nodes of
+	 * other instead of copying them; other ends empty. An element of this tree
+	 * wins over an equivalent one of other.
+	 *
+	 * Join based (Blelloch, Ferizovic and Sun): the root of this tree splits
+	 * other, both halves are combined recursively, then joined back around the
+	 * root (Balance::join). O(m log(n / m + 1)) work for sizes m <= n, plus
+	 * the nodes dropped, and O(log n log m) span: the left halves go to forked
+	 * tasks while threads > 1. rb_balance keeps no black heights, so its
+	 * joins measure them down the spines: a log n factor more work. The allocators must compare equal, and be
+	 * usable from several threads at once when threads > 1. Trees whose
+	 * policy does not bound their height (splay_balance) are first rebuilt
+	 * balanced, in O(n + m), as split and join recurse along the height.
+	 * If an allocation fails, both trees are left empty.
+	 * @return The number of elements of this tree that other held too.
+	*/
+	size_type combine(set_operation op, Rbtree &other, size_t threads)
+	{
+		node_type *a = this->_root;
+		node_type *b = other._root;
+		size_type common = 0;
+
+		other._root = NULL;
+		if (!b)
+		{
+			if (op == algebra_intersection)
+				clear();
+			return (0);
+		}
+		if (!a)
+		{
+			if (op == algebra_union)
+				this->_root = b;
+			else
+				destroy_nodes(b);
+			return (0);
+		}
+		this->_root = NULL;
+		if (!Balance::bounded_height)
+		{
+			a = rebuild_nodes(a);
+			b = rebuild_nodes(b);
+		}
+		a = combine_nodes(op, a, b, threads, common);
+		if (is_null_leaf(a))
+			destroy_node(a);
+		else
+			this->_root = a;
+		return (common);
+	}
+
+	private:
+	/* Combines the detached subtrees a and b, left half forked.*/
+	struct combine_task
+	{
+		Rbtree			*tree;
+		set_operation	op;
+		node_type		*a;
+		node_type		*b;
+		size_t			threads;
+		size_type		common;
+		node_type		*result;
+
+		combine_task(Rbtree *tree, set_operation op, node_type *a, node_type *b, size_t threads)
+			: tree(tree), op(op), a(a), b(b), threads(threads), common(0), result(NULL) {}
+
+		void operator()(void)
+		{
+			result = tree->combine_nodes(op, a, b, threads, common);
+		}
+	};
+
+	/*
+	 * Consumes the detached subtrees a and b (null leaves when empty), even
+	 * when it throws, and returns the detached result.
+	*/
+	node_type *combine_nodes(set_operation op, node_type *a, node_type *b,
+		size_t threads, size_type &common)
+	{
+		if (is_null_leaf(a) || is_null_leaf(b))
+			return (combine_leaf(op, a, b));
+		node_type *below, *found, *above;
+		try
+		{
+			split(b, *a->data, below, found, above);
+		}
+		catch (...)
+		{
+			destroy_nodes(a);
+			destroy_nodes(b);
+			throw;
+		}
+		node_type *left = NULL;
+		node_type *right;
+		a->left->parent = NULL;
+		a->right->parent = NULL;
+		try
+		{
+			if (threads > 1)
+			{
+				combine_task task(this, op, a->left, below, threads / 2);
+				ft::fork_task<combine_task> fork(task);
+				try
+				{
+					right = combine_nodes(op, a->right, above, threads - threads / 2, common);
+				}
+				catch (...)
+				{
+					fork.join();
+					destroy_nodes(task.result);
+					throw;
+				}
+				if (!fork.join())
+				{
+					destroy_nodes(right);
+					throw std::bad_alloc();
+				}
+				left = task.result;
+				common += task.common;
+			}
+			else
+			{
+				left = combine_nodes(op, a->left, below, 1, common);
+				try
+				{
+					right = combine_nodes(op, a->right, above, 1, common);
+				}
+				catch (...)
+				{
+					destroy_nodes(left);
+					throw;
+				}
+			}
+		}
+		catch (...)
+		{
+			destroy_node(a);
+			destroy_node(found);
+			throw;
+		}
+		bool keep = op == algebra_union || (op == algebra_intersection) == (found != NULL);
+		common += (found != NULL);
+		destroy_node(found);
+		if (keep)
+			return (join(left, a, right));
+		destroy_node(a);
+		return (join2(left, right));
+	}
+
+	/*
+	 * Relinks the nodes of the detached subtree root in the shape build()
+	 * gives, without allocating: the subtree is first unrolled into a list
+	 * by right rotations, its null leaves set aside, then hung back level
+	 * by level. Returns the new root.
+	*/
+	node_type *rebuild_nodes(node_type *root)
+	{
+		node_type *vine = NULL;
+		node_type **tail = &vine;
+		node_type *leaves = NULL;
+		size_type n = 0;
+		int full = 0;
+
+		while (!is_null_leaf(root))
+		{
+			if (!is_null_leaf(root->left))
+			{
+				node_type *left = root->left;
+				root->left = left->right;
+				left->right = root;
+				root = left;
+				continue;
+			}
+			root->left->parent = leaves;
+			leaves = root->left;
+			*tail = root;
+			tail = &root->right;
+			root = root->right;
+			n++;
+		}
+		root->parent = leaves;
+		leaves = root;
+		while ((((size_type)2 << full) - 1) <= n)
+			full++;
+		return (relink_nodes(vine, leaves, n, NULL, 0, full));
+	}
+
+	/* Hangs the next n nodes of vine under parent, as build_nodes() would.*/
+	node_type *relink_nodes(node_type *&vine, node_type *&leaves, size_type n,
+		node_type *parent, int depth, int full)
+	{
+		if (n == 0)
+		{
+			node_type *leaf = leaves;
+			leaves = leaf->parent;
+			leaf->parent = parent;
+			return (leaf);
+		}
+		node_type *left = relink_nodes(vine, leaves, n / 2, NULL, depth + 1, full);
+		node_type *node = vine;
+
+		vine = node->right;
+		node->parent = parent;
+		node->color = RED;
+		node->left = left;
+		left->parent = node;
+		node->right = relink_nodes(vine, leaves, n - n / 2 - 1, node, depth + 1, full);
+		Balance::fix_build(*this, node, depth, full);
+		if (Augment::enabled)
+			Augment::update(node);
+		return (node);
+	}
+
+	/* combine_nodes when a or b is empty.*/
+	node_type *combine_leaf(set_operation op, node_type *a, node_type *b)
+	{
+		if (op == algebra_union && is_null_leaf(a))
+			std::swap(a, b);
+		else if (op == algebra_intersection && !is_null_leaf(a))
+			std::swap(a, b);
+		destroy_nodes(b);
+		return (a);
+	}
+
+	/*
+	 * Splits the detached subtree root around key: below and above get the
+	 * detached subtrees of the smaller and greater elements, found the node
+	 * equivalent to key, or NULL. Only allocates (one null leaf) before
+	 * touching anything, so the subtree is intact if it throws.
+	*/
+	void split(node_type *root, const T &key, node_type *&below, node_type *&found,
+		node_type *&above)
+	{
+		if (is_null_leaf(root))
+		{
+			above = create_null_node(NULL);
+			root->parent = NULL;
+			below = root;
+			found = NULL;
+		}
+		else if (_comp(key, *root->data))
+		{
+			split(root->left, key, below, found, above);
+			above = join(above, root, root->right);
+		}
+		else if (_comp(*root->data, key))
+		{
+			split(root->right, key, below, found, above);
+			below = join(root->left, root, below);
+		}
+		else
+		{
+			below = root->left;
+			above = root->right;
+			below->parent = NULL;
+			above->parent = NULL;
+			found = root;
+		}
+	}
+
+	/* Detached tree of left, node and right, every key in that order.*/
+	node_type *join(node_type *left, node_type *node, node_type *right)
+	{
+		Rbtree scratch(this->_comp, this->_alloc, this->_node_alloc);
+
+		Balance::join(scratch, left, node, right);
+		node_type *root = scratch._root;
+		scratch._root = NULL;
+		return (root);
+	}
+
+	/* join without a middle node: the last node of left takes its place.*/
+	node_type *join2(node_type *left, node_type *right)
+	{
+		if (is_null_leaf(right))
+		{
+			destroy_node(right);
+			return (left);
+		}
+		if (is_null_leaf(left))
+		{
+			destroy_node(left);
+			return (right);
+		}
+		node_type *last;
+		node_type *rest = split_last(left, last);
+		return (join(rest, last, right));
+	}
+
+	/* Detaches the last node of the non empty subtree root.*/
+	node_type *split_last(node_type *root, node_type *&last)
+	{
+		if (is_null_leaf(root->right))
+		{
+			destroy_node(root->right);
+			root->left->parent = NULL;
+			last = root;
+			return (root->left);
+		}
+		node_type *rest = split_last(root->right, last);
+		return (join(root->left, root, rest));
+	}
+
+	public:
 	// =================================================================================
 	//						DEBUG AND PRINT FUNCTIONS
 	// =================================================================================
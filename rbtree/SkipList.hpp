@@ -0,0 +1,379 @@
+#ifndef SKIPLIST_HPP
+#define SKIPLIST_HPP
+
+#include "../containers/epoch.hpp"
+#include <cstdlib>
+#include <new>
+#include <functional>
+
+/*
+Lock-free skip list, for ft::concurrent_skiplist_map and _set.
+
+The algorithm is the one of Herlihy and Shavit (The Art of Multiprocessor
+Programming, 14.4), after Fraser: the links of every level are updated with
+compare-and-swap only, and an element is erased by marking the low bit of its
+next pointers, from the top level down to level 0. The thread that marks level
+0 owns the erase. Traversals unlink the marked nodes they meet, and the erasing
+thread traverses once more before retiring the node to ft::epoch. No thread
+ever waits on another, and nothing is rebalanced.
+
+An insert whose upper levels are still being linked when the node gets marked
+notices it after its own CAS and traverses once more to unlink it. Until then
+the node may be linked again at an upper level after the eraser's traversal,
+so it is only retired once both are done: each node counts two owners, the
+inserting thread and the erasing one, and the last to let go retires it.
+
+Towers are allocated on cache line boundaries (posix_memalign) and sized up to
+whole lines: a node never shares a line with another node, which keeps the
+CAS traffic of neighbours apart.
+
+Every member must be called from inside an ft::epoch::guard, except the
+constructor and the destructor, which must not run concurrently with anything.
+*/
+
+namespace ft
+{
+	template <typename T>
+	struct SkipNode
+	{
+		T			value;
+		int			height;
+		int			owners;	// the inserter until linked, the eraser once unlinked
+		SkipNode	*next[1]; // height entries, low bit: the node is erased at that level
+
+		SkipNode(const T &val, int h) : value(val), height(h), owners(2) {}
+	};
+
+	template <typename T, class Compare = std::less<T> >
+	class SkipList
+	{
+	public:
+		typedef T						value_type;
+		typedef Compare					value_compare;
+		typedef SkipNode<T>				node_type;
+
+		static const int max_height = 32;
+
+	private:
+		static const size_t cache_line = 64;
+
+		node_type		*_head; // sentinel, no value, max_height links
+		value_compare	_comp;
+		size_t			_size;
+
+		SkipList(const SkipList &);
+		SkipList &operator=(const SkipList &);
+
+	public:
+		SkipList(value_compare comp = value_compare()) : _comp(comp), _size(0)
+		{
+			_head = static_cast<node_type *>(allocate(max_height));
+			for (int i = 0; i < max_height; i++)
+				_head->next[i] = NULL;
+			_head->height = max_height;
+		}
+
+		~SkipList(void)
+		{
+			node_type *node = unmarked(_head->next[0]);
+
+			while (node)
+			{
+				node_type *next = unmarked(node->next[0]);
+				destroy(node);
+				node = next;
+			}
+			free(_head);
+		}
+
+		/** Approximate while writers run.*/
+		size_t size(void) const
+		{
+			return (__atomic_load_n(&_size, __ATOMIC_RELAXED));
+		}
+
+		value_compare value_comp(void) const
+		{
+			return (_comp);
+		}
+
+		// #############################################################################
+		// #                                 LOOKUP                                    #
+		// #############################################################################
+
+		/** The node equivalent to value, NULL if none.*/
+		node_type *lookup_value(const value_type &value) const
+		{
+			node_type *node = lower_bound(value);
+
+			if (node && !_comp(value, node->value))
+				return (node);
+			return (NULL);
+		}
+
+		/**
+		 * The first node not less than value. Read only: unlike search(), it
+		 * steps over the marked nodes instead of unlinking them.
+		*/
+		node_type *lower_bound(const value_type &value) const
+		{
+			node_type *pred = _head;
+			node_type *curr = NULL;
+
+			for (int level = max_height - 1; level >= 0; level--)
+			{
+				curr = unmarked(load(pred->next[level]));
+				while (curr)
+				{
+					node_type *succ = load(curr->next[level]);
+					if (is_marked(succ))
+						curr = unmarked(succ);
+					else if (_comp(curr->value, value))
+					{
+						pred = curr;
+						curr = succ;
+					}
+					else
+						break;
+				}
+			}
+			return (curr);
+		}
+
+		/** The first node whose value is greater than value.*/
+		node_type *upper_bound(const value_type &value) const
+		{
+			node_type *node = lower_bound(value);
+
+			if (node && !_comp(value, node->value))
+				node = next(node);
+			return (node);
+		}
+
+		node_type *first(void) const
+		{
+			return (next(_head));
+		}
+
+		/** The next node in order that is not erased, NULL at the end.*/
+		static node_type *next(node_type *node)
+		{
+			node = unmarked(load(node->next[0]));
+			while (node && is_marked(load(node->next[0])))
+				node = unmarked(load(node->next[0]));
+			return (node);
+		}
+
+		// #############################################################################
+		// #                                 UPDATES                                   #
+		// #############################################################################
+
+		/** Links value unless an equivalent one is there. @return true if linked.*/
+		bool insert_value(const value_type &value)
+		{
+			node_type *preds[max_height];
+			node_type *succs[max_height];
+			int height = random_height();
+			node_type *node = NULL;
+
+			while (true)
+			{
+				if (search(value, preds, succs))
+				{
+					if (node)
+						destroy(node); // never published
+					return (false);
+				}
+				if (!node)
+					node = create(value, height);
+				for (int level = 0; level < height; level++)
+					node->next[level] = succs[level];
+				if (__sync_bool_compare_and_swap(&preds[0]->next[0], succs[0], node))
+					break;
+			}
+			__sync_fetch_and_add(&_size, 1);
+			link_upper(value, node, preds, succs);
+			release(node);
+			return (true);
+		}
+
+		/** Erases the element equivalent to value. @return true if this call erased it.*/
+		bool delete_value(const value_type &value)
+		{
+			node_type *preds[max_height];
+			node_type *succs[max_height];
+
+			if (!search(value, preds, succs))
+				return (false);
+			node_type *node = succs[0];
+			for (int level = node->height - 1; level > 0; level--)
+			{
+				node_type *succ = load(node->next[level]);
+				while (!is_marked(succ))
+				{
+					__sync_bool_compare_and_swap(&node->next[level], succ, marked(succ));
+					succ = load(node->next[level]);
+				}
+			}
+			node_type *succ = load(node->next[0]);
+			while (true)
+			{
+				if (is_marked(succ))
+					return (false); // another thread erased it first
+				if (__sync_bool_compare_and_swap(&node->next[0], succ, marked(succ)))
+					break;
+				succ = load(node->next[0]);
+			}
+			__sync_fetch_and_sub(&_size, 1);
+			search(value, preds, succs); // unlinks the node at every level
+			release(node);
+			return (true);
+		}
+
+	private:
+		/*
+		Links the levels of node above 0, stopping when it gets erased
+		meanwhile, after which it makes sure the node is unlinked again.
+		*/
+		void link_upper(const value_type &value, node_type *node, node_type **preds, node_type **succs)
+		{
+			for (int level = 1; level < node->height; level++)
+			{
+				while (true)
+				{
+					node_type *succ = load(node->next[level]);
+					if (is_marked(succ))
+						return; // erased meanwhile, stop linking
+					if (succ != succs[level] &&
+						!__sync_bool_compare_and_swap(&node->next[level], succ, succs[level]))
+						continue;
+					if (__sync_bool_compare_and_swap(&preds[level]->next[level], succs[level], node))
+						break;
+					search(value, preds, succs);
+					if (succs[0] != node)
+						return; // erased and unlinked meanwhile
+				}
+				if (is_marked(load(node->next[level])))
+				{
+					// marked after our link: make sure it is unlinked again
+					search(value, preds, succs);
+					return;
+				}
+			}
+		}
+
+		/* Drops one owner of node; the last one retires it.*/
+		static void release(node_type *node)
+		{
+			if (__sync_sub_and_fetch(&node->owners, 1) == 0)
+				epoch::retire(node, &deleter);
+		}
+
+		/*
+		Fills preds / succs with the nodes around value at every level, unlinking
+		the marked nodes on the way. @return Whether succs[0] is equivalent to value.
+		*/
+		bool search(const value_type &value, node_type **preds, node_type **succs)
+		{
+		retry:
+			node_type *pred = _head;
+			for (int level = max_height - 1; level >= 0; level--)
+			{
+				node_type *curr = unmarked(load(pred->next[level]));
+				while (curr)
+				{
+					node_type *succ = load(curr->next[level]);
+					if (is_marked(succ))
+					{
+						if (!__sync_bool_compare_and_swap(&pred->next[level], curr, unmarked(succ)))
+							goto retry;
+						curr = unmarked(succ);
+					}
+					else if (_comp(curr->value, value))
+					{
+						pred = curr;
+						curr = succ;
+					}
+					else
+						break;
+				}
+				preds[level] = pred;
+				succs[level] = curr;
+			}
+			return (succs[0] && !_comp(value, succs[0]->value));
+		}
+
+		static node_type *load(node_type *const &link)
+		{
+			return (__atomic_load_n(&link, __ATOMIC_ACQUIRE));
+		}
+
+		static bool is_marked(node_type *link)
+		{
+			return (reinterpret_cast<size_t>(link) & 1);
+		}
+
+		static node_type *marked(node_type *link)
+		{
+			return (reinterpret_cast<node_type *>(reinterpret_cast<size_t>(link) | 1));
+		}
+
+		static node_type *unmarked(node_type *link)
+		{
+			return (reinterpret_cast<node_type *>(reinterpret_cast<size_t>(link) & ~(size_t)1));
+		}
+
+		/* Geometric, p = 1/2, from a per thread xorshift generator.*/
+		static int random_height(void)
+		{
+			static __thread unsigned int state = 0;
+
+			if (state == 0)
+				state = 2463534242U ^ (unsigned int)(size_t)&state;
+			state ^= state << 13;
+			state ^= state >> 17;
+			state ^= state << 5;
+			int height = __builtin_ctz(state | (1U << (max_height - 1))) + 1;
+			return (height);
+		}
+
+		/* A whole number of cache lines, aligned on a line.*/
+		static void *allocate(int height)
+		{
+			size_t bytes = sizeof(node_type) + (height - 1) * sizeof(node_type *);
+			void *ptr;
+
+			bytes = (bytes + cache_line - 1) / cache_line * cache_line;
+			if (posix_memalign(&ptr, cache_line, bytes))
+				throw std::bad_alloc();
+			return (ptr);
+		}
+
+		static node_type *create(const value_type &value, int height)
+		{
+			void *ptr = allocate(height);
+			try
+			{
+				return (new (ptr) node_type(value, height));
+			}
+			catch (...)
+			{
+				free(ptr);
+				throw;
+			}
+		}
+
+		static void destroy(node_type *node)
+		{
+			node->~node_type();
+			free(node);
+		}
+
+		static void deleter(void *node)
+		{
+			destroy(static_cast<node_type *>(node));
+		}
+	};
+}
+
+#endif
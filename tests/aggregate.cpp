@@ -0,0 +1,94 @@
+#include "extensions.hpp"
+#include <map>
+#include <cstdlib>
+
+template <class Monoid, class Balance>
+static void test_monoid(const std::string &name){
+	typedef ft::map<int, long, std::less<int>, std::allocator<ft::pair<const int, long> >,
+		Balance, Monoid> map_type;
+	map_type map;
+	std::map<int, long> ref;
+	bool ranges = true;
+	bool whole = true;
+
+	srand(7);
+	for (int i = 0; i < 6000; i++){
+		int key = rand() % 1500;
+		if (rand() % 3 == 0){
+			map.erase(key);
+			ref.erase(key);
+		}
+		else if (rand() % 2){
+			map.insert(ft::make_pair(key, (long)(rand() % 1000) - 500));
+			ref.insert(std::make_pair(key, map.find(key)->second));
+		}
+		else{
+			long value = (long)(rand() % 1000) - 500;
+			map[key] = value;
+			map.update_aggregate(map.find(key));
+			ref[key] = value;
+		}
+		int lo = rand() % 1600 - 50;
+		int hi = lo + rand() % 400;
+		long expected = Monoid::identity();
+		for (std::map<int, long>::iterator it = ref.lower_bound(lo); it != ref.end() && it->first < hi; ++it)
+			expected = Monoid::combine(expected, it->second);
+		if (map.aggregate(lo, hi) != expected)
+			ranges = false;
+		expected = Monoid::identity();
+		for (std::map<int, long>::iterator it = ref.begin(); it != ref.end(); ++it)
+			expected = Monoid::combine(expected, it->second);
+		if (map.aggregate() != expected)
+			whole = false;
+	}
+	CHECK(name + " range aggregate", ranges);
+	CHECK(name + " whole aggregate", whole);
+	map.clear();
+	CHECK(name + " empty", map.aggregate(0, 100) == Monoid::identity());
+}
+
+/* Unsigned and floating point values: the identity of max is their lowest value.*/
+static bool lowest_max(void){
+	typedef ft::map<int, unsigned, std::less<int>, std::allocator<ft::pair<const int, unsigned> >,
+		ft::rb_balance, ft::max_monoid<unsigned> > unsigned_map;
+	typedef ft::map<int, double, std::less<int>, std::allocator<ft::pair<const int, double> >,
+		ft::avl_balance, ft::max_monoid<double> > double_map;
+	unsigned_map counts;
+	double_map levels;
+	bool ok = counts.aggregate() == 0 && ft::max_monoid<unsigned>::combine(ft::max_monoid<unsigned>::identity(), 0u) == 0;
+	counts.insert(ft::make_pair(1, 0u));
+	counts.insert(ft::make_pair(2, 0u));
+	ok = ok && counts.aggregate() == 0 && counts.aggregate(0, 2) == 0;
+	counts.insert(ft::make_pair(3, 4000000000u));
+	ok = ok && counts.aggregate() == 4000000000u && counts.aggregate(5, 9) == 0;
+	levels.insert(ft::make_pair(1, -2.5));
+	levels.insert(ft::make_pair(2, -7.0));
+	return (ok && levels.aggregate() == -2.5 && levels.aggregate(2, 3) == -7.0);
+}
+
+void test_aggregate(void){
+	std::cout << "==============================" << std::endl;
+	std::cout << "          aggregates          " << std::endl;
+	std::cout << "==============================" << std::endl;
+	ft::map<std::string, int, std::less<std::string>,
+		std::allocator<ft::pair<const std::string, int> >, ft::rb_balance, ft::sum_monoid<int> > stock;
+	stock["apple"] = 3;
+	stock["banana"] = 5;
+	stock["cherry"] = 7;
+	stock["date"] = 11;
+	std::cout << "sum [banana, date): " << stock.aggregate("banana", "date") << std::endl;
+	std::cout << "sum [a, z): " << stock.aggregate("a", "z") << std::endl;
+	stock["apple"] = 30;
+	stock.update_aggregate(stock.find("apple"));
+	std::cout << "sum after stock[apple] = 30: " << stock.aggregate() << std::endl;
+	stock.erase("banana");
+	std::cout << "sum after erase(banana): " << stock.aggregate() << std::endl;
+	test_monoid<ft::sum_monoid<long>, ft::rb_balance>("sum rb");
+	test_monoid<ft::min_monoid<long>, ft::rb_balance>("min rb");
+	test_monoid<ft::max_monoid<long>, ft::rb_balance>("max rb");
+	test_monoid<ft::sum_monoid<long>, ft::avl_balance>("sum avl");
+	test_monoid<ft::min_monoid<long>, ft::wavl_balance>("min wavl");
+	test_monoid<ft::max_monoid<long>, ft::splay_balance>("max splay");
+	CHECK("max of unsigned and double values", lowest_max());
+	std::cout << "------------------------------------" << std::endl;
+}
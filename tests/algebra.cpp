@@ -0,0 +1,269 @@
+#include "extensions.hpp"
+#include <algorithm>
+#include <iterator>
+#include <map>
+#include <set>
+#include <vector>
+#include <cstdlib>
+
+typedef ft::Node<int> int_node;
+typedef ft::Rbtree<int, std::less<int> > any_tree;
+
+/* checks links and order, appends the values in order */
+static void walk(const int_node *node, const int_node *parent, std::vector<int> &out, bool &ok){
+	if (any_tree::is_null_leaf(node)){
+		ok = ok && node->parent == parent;
+		return;
+	}
+	ok = ok && node->parent == parent;
+	walk(node->left, node, out, ok);
+	if (!out.empty() && out.back() >= *node->data)
+		ok = false;
+	out.push_back(*node->data);
+	walk(node->right, node, out, ok);
+}
+
+/* black height, or -1 on a red-black violation */
+static int check_rb(const int_node *node){
+	if (any_tree::is_null_leaf(node))
+		return (node->color == BLACK ? 1 : -1);
+	if (node->color == RED && (node->left->color == RED || node->right->color == RED))
+		return (-1);
+	int left = check_rb(node->left);
+	int right = check_rb(node->right);
+	if (left < 0 || left != right)
+		return (-1);
+	return (left + (node->color == BLACK));
+}
+
+/* height, or -1 on an AVL violation */
+static int check_avl(const int_node *node){
+	if (any_tree::is_null_leaf(node))
+		return (node->color == 0 ? 0 : -1);
+	int left = check_avl(node->left);
+	int right = check_avl(node->right);
+	if (left < 0 || right < 0 || left - right > 1 || right - left > 1)
+		return (-1);
+	int height = (left > right ? left : right) + 1;
+	return (node->color == height ? height : -1);
+}
+
+/* true when every rank difference is 1 or 2 and leaves have rank 1 */
+static bool check_wavl(const int_node *node){
+	if (any_tree::is_null_leaf(node))
+		return (node->color == 0);
+	int left = node->color - node->left->color;
+	int right = node->color - node->right->color;
+	if (left < 1 || left > 2 || right < 1 || right > 2)
+		return (false);
+	if (any_tree::is_null_leaf(node->left) && any_tree::is_null_leaf(node->right) && node->color != 1)
+		return (false);
+	return (check_wavl(node->left) && check_wavl(node->right));
+}
+
+static bool check_policy(const int_node *root, ft::rb_balance){
+	return (root->color == BLACK && check_rb(root) >= 0);
+}
+static bool check_policy(const int_node *root, ft::avl_balance){
+	return (check_avl(root) >= 0);
+}
+static bool check_policy(const int_node *root, ft::wavl_balance){
+	return (check_wavl(root));
+}
+static bool check_policy(const int_node *, ft::splay_balance){
+	return (true);
+}
+
+/*
+Combines random trees of sizes from empty to lopsided with every operation,
+on 1 and 4 threads, against the std algorithms.
+*/
+template <class Policy>
+static bool combine_valid(void){
+	typedef ft::Rbtree<int, std::less<int>, std::allocator<int>,
+		std::allocator<int_node>, Policy> tree_type;
+	static const int sizes[][2] = {{0, 0}, {0, 5}, {5, 0}, {1, 1}, {3, 200},
+		{200, 3}, {1000, 1000}, {10, 20000}, {20000, 10}, {15000, 15000}};
+	bool ok = true;
+
+	srand(11);
+	for (size_t s = 0; s < sizeof(sizes) / sizeof(sizes[0]); s++)
+		for (int op = 0; op < 3; op++)
+			for (size_t threads = 1; threads <= 4; threads += 3){
+				tree_type a;
+				tree_type b;
+				std::set<int> ref_a;
+				std::set<int> ref_b;
+				for (int i = 0; i < sizes[s][0]; i++){
+					int v = rand() % 40000;
+					if (ref_a.insert(v).second)
+						a.insert_value(v);
+				}
+				for (int i = 0; i < sizes[s][1]; i++){
+					int v = rand() % 40000;
+					if (ref_b.insert(v).second)
+						b.insert_value(v);
+				}
+				std::vector<int> expected;
+				if (op == tree_type::algebra_union)
+					std::set_union(ref_a.begin(), ref_a.end(), ref_b.begin(), ref_b.end(),
+						std::back_inserter(expected));
+				else if (op == tree_type::algebra_intersection)
+					std::set_intersection(ref_a.begin(), ref_a.end(), ref_b.begin(), ref_b.end(),
+						std::back_inserter(expected));
+				else
+					std::set_difference(ref_a.begin(), ref_a.end(), ref_b.begin(), ref_b.end(),
+						std::back_inserter(expected));
+				a.combine((typename tree_type::set_operation)op, b, threads);
+				std::vector<int> got;
+				if (a.get_root()){
+					walk(a.get_root(), NULL, got, ok);
+					ok = ok && check_policy(a.get_root(), Policy());
+				}
+				ok = ok && got == expected && b.get_root() == NULL;
+			}
+	return (ok);
+}
+
+typedef ft::set<int, std::less<int>, std::allocator<int>, ft::splay_balance> splay_set;
+
+/* [from, to) inserted in order: a splay tree that is one long path.*/
+static void fill_path(splay_set &set, int from, int to){
+	for (int i = from; i < to; i++)
+		set.insert(i);
+}
+
+/* Every element of set, in order, is the next of [from, to).*/
+static bool holds_range(const splay_set &set, int from, int to){
+	if (set.size() != (size_t)(to - from))
+		return (false);
+	for (splay_set::const_iterator it = set.begin(); it != set.end(); ++it, ++from)
+		if (*it != from)
+			return (false);
+	return (true);
+}
+
+/* Splay sets of n sorted inserts each, overlapping by half, combined.*/
+static bool degenerate_splay(int n){
+	splay_set a;
+	splay_set b;
+	fill_path(a, 0, n);
+	fill_path(b, n / 2, n + n / 2);
+	a.union_with(b);
+	bool ok = holds_range(a, 0, n + n / 2) && b.empty();
+
+	splay_set c;
+	fill_path(c, n / 2, n);
+	splay_set d;
+	fill_path(d, 0, n);
+	d.intersect_with(c);
+	ok = ok && holds_range(d, n / 2, n) && c.empty();
+
+	splay_set e;
+	splay_set f;
+	fill_path(e, 0, n);
+	fill_path(f, n / 2, n + n / 2);
+	e.difference_with(f);
+	return (ok && holds_range(e, 0, n / 2) && f.empty());
+}
+
+void test_algebra(void){
+	std::cout << "==============================" << std::endl;
+	std::cout << "          set algebra         " << std::endl;
+	std::cout << "==============================" << std::endl;
+	CHECK("combine rb", combine_valid<ft::rb_balance>());
+	CHECK("combine avl", combine_valid<ft::avl_balance>());
+	CHECK("combine wavl", combine_valid<ft::wavl_balance>());
+	CHECK("combine splay", combine_valid<ft::splay_balance>());
+	CHECK("splay paths of 300000 combined", degenerate_splay(300000));
+
+	ft::map<int, int> map;
+	ft::map<int, int> other;
+	std::map<int, int> ref;
+	std::map<int, int> ref_other;
+	for (int i = 0; i < 30000; i++){
+		int k = rand() % 60000;
+		map[k] = i;
+		ref[k] = i;
+		k = rand() % 60000;
+		other[k] = -i;
+		ref_other[k] = -i;
+	}
+	std::map<int, int> expected(ref);
+	expected.insert(ref_other.begin(), ref_other.end());
+	ft::map<int, int> copy(map);
+	ft::map<int, int> copy_other(other);
+	map.union_with(other, ft::parallel(4));
+	bool same = map.size() == expected.size() && other.empty() && other.begin() == other.end();
+	std::map<int, int>::iterator rit = expected.begin();
+	for (ft::map<int, int>::iterator it = map.begin(); it != map.end() && same; ++it, ++rit)
+		same = it->first == rit->first && it->second == rit->second;
+	CHECK("map union_with, values of the map kept", same);
+
+	map = copy;
+	other = copy_other;
+	map.intersect_with(other, ft::parallel(4));
+	same = other.empty();
+	size_t count = 0;
+	for (std::map<int, int>::iterator it = ref.begin(); it != ref.end() && same; ++it)
+		if (ref_other.count(it->first)){
+			ft::map<int, int>::iterator found = map.find(it->first);
+			same = found != map.end() && found->second == it->second;
+			count++;
+		}
+	CHECK("map intersect_with", same && map.size() == count);
+
+	map = copy;
+	other = copy_other;
+	map.difference_with(other);
+	same = other.empty() && map.size() == ref.size() - count;
+	for (ft::map<int, int>::iterator it = map.begin(); it != map.end() && same; ++it)
+		same = ref.count(it->first) && !ref_other.count(it->first);
+	map[-1] = 1;
+	map.erase(map.begin()->first);
+	CHECK("map difference_with, then updates", same && map.size() == ref.size() - count);
+
+	ft::map<int, int, std::less<int>, std::allocator<ft::pair<const int, int> >,
+		ft::avl_balance, ft::sum_monoid<long> > sums;
+	ft::map<int, int, std::less<int>, std::allocator<ft::pair<const int, int> >,
+		ft::avl_balance, ft::sum_monoid<long> > more;
+	for (int i = 0; i < 20000; i++){
+		sums.insert(ft::make_pair(i * 2, i));
+		more.insert(ft::make_pair(i * 3, 1));
+	}
+	sums.union_with(more, ft::parallel(2));
+	long expected_sum = 0;
+	long expected_range = 0;
+	for (ft::map<int, int>::iterator it = sums.begin(); it != sums.end(); ++it){
+		expected_sum += it->second;
+		if (it->first >= 500 && it->first < 7000)
+			expected_range += it->second;
+	}
+	CHECK("aggregates after union_with", sums.aggregate() == expected_sum
+		&& sums.aggregate(500, 7000) == expected_range);
+
+	ft::set<int> set;
+	ft::set<int> evens;
+	std::set<int> ref_set;
+	for (int i = 0; i < 10000; i++){
+		set.insert(i * 3);
+		evens.insert(i * 2);
+		if ((i * 3) % 2 || i * 3 >= 20000)
+			ref_set.insert(i * 3);
+	}
+	set.difference_with(evens, ft::parallel(4));
+	CHECK("set difference_with", set.size() == ref_set.size() && evens.empty()
+		&& ft::equal(set.begin(), set.end(), ref_set.begin()));
+
+	set.union_with(set);
+	set.intersect_with(set);
+	CHECK("set with itself", set.size() == ref_set.size()
+		&& ft::equal(set.begin(), set.end(), ref_set.begin()));
+
+	ft::set<int> none;
+	none.union_with(set);
+	size_t moved = none.size();
+	none.intersect_with(evens);
+	std::cout << "with empty sets: " << moved << " " << set.size() << " " << none.size()
+		<< ", begin == end: " << (none.begin() == none.end()) << std::endl;
+}
@@ -0,0 +1,54 @@
+#include "extensions.hpp"
+#include <vector.hpp>
+#include <aligned_allocator.hpp>
+
+template <class Vector>
+static bool aligned_growth(size_t n, size_t alignment){
+	Vector v;
+	bool ok = true;
+
+	for (size_t i = 0; i < n && ok; i++){
+		v.push_back((typename Vector::value_type)i);
+		ok = (size_t)&v[0] % alignment == 0;
+	}
+	for (size_t i = 0; i < n && ok; i++)
+		ok = v[i] == (typename Vector::value_type)i;
+	Vector copy(v);
+	return (ok && copy == v && (size_t)&copy[0] % alignment == 0);
+}
+
+void test_aligned(void){
+	std::cout << "==============================" << std::endl;
+	std::cout << "      aligned allocators      " << std::endl;
+	std::cout << "==============================" << std::endl;
+	typedef ft::huge_page_allocator<double> huge;
+	const size_t huge_page = huge::huge_page_size;
+
+	CHECK("64 bytes aligned through growth", (aligned_growth<ft::vector<float, ft::aligned_allocator<float> > >(5000, 64)));
+	CHECK("page aligned", (aligned_growth<ft::vector<char, ft::aligned_allocator<char, 4096> > >(10000, 4096)));
+	CHECK("huge pages, small blocks 64 bytes aligned", (aligned_growth<ft::vector<double, huge> >(1000, 64)));
+
+	ft::vector<double, huge> big(3 * huge_page / sizeof(double), 1.5);
+	bool ok = (size_t)&big[0] % huge_page == 0 && big.back() == 1.5;
+	big.push_back(2.5);
+	ok = ok && (size_t)&big[0] % huge_page == 0 && big.back() == 2.5 && big[0] == 1.5;
+	big.resize(10);
+	big.shrink_to_fit();
+	CHECK("huge pages, large blocks 2 MiB aligned", ok && big.size() == 10 && big[9] == 1.5
+		&& (size_t)&big[0] % 64 == 0);
+
+	ft::vector<int, ft::huge_page_allocator<int, true> > explicit_pages(huge_page, 3);
+	CHECK("explicit huge pages, or the fallback", (size_t)&explicit_pages[0] % huge_page == 0
+		&& explicit_pages[huge_page - 1] == 3);
+
+	typedef ft::vector<float, ft::aligned_allocator<float> > row;
+	ft::vector<row> rows(3, row(100, 1.0f));
+	rows.reserve(100);
+	ok = ft::is_trivially_relocatable<row>::value && rows[2].size() == 100;
+	for (size_t i = 0; i < rows.size() && ok; i++)
+		ok = (size_t)&rows[i][0] % 64 == 0 && rows[i][99] == 1.0f;
+	CHECK("vectors of aligned vectors are relocatable", ok);
+	ft::aligned_allocator<float> fa;
+	ft::aligned_allocator<double> da(fa);
+	CHECK("stateless", fa == ft::aligned_allocator<float>(da) && !(huge() != huge()));
+}
@@ -0,0 +1,190 @@
+#include "extensions.hpp"
+#include <map>
+#include <cstdlib>
+
+template <class Policy>
+struct tree_of{
+	typedef ft::Rbtree<int, std::less<int>, std::allocator<int>,
+		std::allocator<ft::Node<int> >, Policy> type;
+};
+
+typedef ft::Node<int> int_node;
+
+/* checks links and order, returns the number of real nodes */
+static int check_links(const int_node *node, const int *low, const int *high, bool &ok){
+	if (ft::Rbtree<int, std::less<int> >::is_null_leaf(node))
+		return (0);
+	if ((low && *node->data <= *low) || (high && *node->data >= *high))
+		ok = false;
+	if (node->left->parent != node || node->right->parent != node)
+		ok = false;
+	return (check_links(node->left, low, node->data, ok) + 1
+		+ check_links(node->right, node->data, high, ok));
+}
+
+/* black height, or -1 on a red-black violation */
+static int check_rb(const int_node *node){
+	if (ft::Rbtree<int, std::less<int> >::is_null_leaf(node))
+		return (node->color == BLACK ? 1 : -1);
+	if (node->color == RED && (node->left->color == RED || node->right->color == RED))
+		return (-1);
+	int left = check_rb(node->left);
+	int right = check_rb(node->right);
+	if (left < 0 || left != right)
+		return (-1);
+	return (left + (node->color == BLACK));
+}
+
+/* height, or -1 on an AVL violation */
+static int check_avl(const int_node *node){
+	if (ft::Rbtree<int, std::less<int> >::is_null_leaf(node))
+		return (node->color == 0 ? 0 : -1);
+	int left = check_avl(node->left);
+	int right = check_avl(node->right);
+	if (left < 0 || right < 0 || left - right > 1 || right - left > 1)
+		return (-1);
+	int height = (left > right ? left : right) + 1;
+	return (node->color == height ? height : -1);
+}
+
+/* true when every rank difference is 1 or 2 and leaves have rank 1 */
+static bool check_wavl(const int_node *node){
+	if (ft::Rbtree<int, std::less<int> >::is_null_leaf(node))
+		return (node->color == 0);
+	int left = node->color - node->left->color;
+	int right = node->color - node->right->color;
+	if (left < 1 || left > 2 || right < 1 || right > 2)
+		return (false);
+	if (ft::Rbtree<int, std::less<int> >::is_null_leaf(node->left)
+		&& ft::Rbtree<int, std::less<int> >::is_null_leaf(node->right) && node->color != 1)
+		return (false);
+	return (check_wavl(node->left) && check_wavl(node->right));
+}
+
+static bool check_policy(const int_node *root, ft::rb_balance){
+	return (!root || check_rb(root) >= 0);
+}
+static bool check_policy(const int_node *root, ft::avl_balance){
+	return (!root || check_avl(root) >= 0);
+}
+static bool check_policy(const int_node *root, ft::wavl_balance){
+	return (!root || check_wavl(root));
+}
+static bool check_policy(const int_node *, ft::splay_balance){
+	return (true);
+}
+
+template <class Policy>
+static void test_policy(const std::string &name){
+	typedef typename tree_of<Policy>::type tree_type;
+	tree_type tree;
+	std::map<int, int> ref;
+	bool links = true;
+	bool policy = true;
+	bool found = true;
+
+	srand(42);
+	for (int i = 0; i < 20000; i++){
+		int key = rand() % 2000;
+		int op = rand() % 3;
+		if (op == 0){
+			tree.delete_value(key);
+			ref.erase(key);
+		}
+		else if (op == 1){
+			if (!tree.lookup_value(key))
+				tree.insert_value(key);
+			ref[key] = key;
+		}
+		else if ((tree.lookup_value(key) != NULL) != (ref.count(key) == 1))
+			found = false;
+		if (i % 1000 == 0 || i > 19900){
+			bool ok = true;
+			int count = tree.get_root() ? check_links(tree.get_root(), NULL, NULL, ok) : 0;
+			if (!ok || count != (int)ref.size() || (tree.get_root() && tree.get_root()->parent))
+				links = false;
+			if (!check_policy(tree.get_root(), Policy()))
+				policy = false;
+		}
+	}
+	CHECK(name + " links and order", links);
+	CHECK(name + " invariants", policy);
+	CHECK(name + " lookups", found);
+
+	ft::map<int, std::string, std::less<int>,
+		std::allocator<ft::pair<const int, std::string> >, Policy> map;
+	std::map<int, std::string> ref_map;
+	for (int i = 0; i < 500; i++){
+		int key = (i * 7919) % 1000;
+		map[key] = "v";
+		ref_map[key] = "v";
+		if (i % 3 == 0){
+			map.erase((i * 104729) % 1000);
+			ref_map.erase((i * 104729) % 1000);
+		}
+	}
+	for (int i = 0; i < 1000; i += 3){
+		map.find(i);
+		map.count(i);
+	}
+	bool same = map.size() == ref_map.size();
+	std::map<int, std::string>::iterator ref_it = ref_map.begin();
+	for (typename ft::map<int, std::string, std::less<int>,
+		std::allocator<ft::pair<const int, std::string> >, Policy>::iterator it = map.begin();
+		same && it != map.end(); ++it, ++ref_it)
+		same = (it->first == ref_it->first);
+	CHECK(name + " map iteration", same);
+
+	ft::set<int, std::less<int>, std::allocator<int>, Policy> set;
+	for (int i = 0; i < 100; i++)
+		set.insert(i);
+	for (int i = 0; i < 100; i += 2)
+		set.erase(i);
+	bool odd = set.size() == 50;
+	int expected = 1;
+	for (typename ft::set<int, std::less<int>, std::allocator<int>, Policy>::iterator it = set.begin();
+		it != set.end(); ++it, expected += 2)
+		odd = odd && (*it == expected);
+	CHECK(name + " set iteration", odd);
+}
+
+/* Sequential inserts leave a splay tree as a path: copy, height, walk and
+teardown must not recurse on its depth.*/
+static bool degenerate_splay(int n){
+	typedef ft::set<int, std::less<int>, std::allocator<int>, ft::splay_balance> splay_set;
+	bool ok;
+	{
+		splay_set set;
+		for (int i = 0; i < n; i++)
+			set.insert(set.end(), i);
+		splay_set copy(set);
+		ok = copy.size() == (size_t)n && *copy.begin() == 0 && *copy.rbegin() == n - 1;
+		int expected = n - 1;
+		splay_set::reverse_iterator last = copy.rend();	// rend() descends the whole path
+		for (splay_set::reverse_iterator it = copy.rbegin(); ok && it != last; ++it, --expected)
+			ok = *it == expected;
+		copy = set;
+		ok = ok && copy.size() == (size_t)n;
+		const splay_set &path = set;	// const searches do not splay: the whole path is walked
+		ft::pair<splay_set::iterator, splay_set::iterator> range = path.equal_range(n / 2);
+		ok = ok && *path.lower_bound(0) == 0 && *path.lower_bound(-1) == 0 && *path.upper_bound(-1) == 0
+			&& *range.first == n / 2 && *range.second == n / 2 + 1;
+	}
+	tree_of<ft::splay_balance>::type tree;
+	for (int i = 0; i < n; i++)
+		tree.insert_value(i);
+	tree_of<ft::splay_balance>::type copy(tree);
+	return (ok && tree.height() == (size_t)n && copy.height() == (size_t)n);
+}
+
+void test_balance(void){
+	std::cout << "==============================" << std::endl;
+	std::cout << "         tree balance         " << std::endl;
+	std::cout << "==============================" << std::endl;
+	test_policy<ft::rb_balance>("rb_balance");
+	test_policy<ft::avl_balance>("avl_balance");
+	test_policy<ft::wavl_balance>("wavl_balance");
+	test_policy<ft::splay_balance>("splay_balance");
+	CHECK("splay_balance degenerate copy, teardown and bounds", degenerate_splay(1000000));
+	std::cout << "------------------------------------" << std::endl;
+}
@@ -0,0 +1,109 @@
+#include "extensions.hpp"
+#include <map>
+#include <set>
+#include <cstdlib>
+
+typedef ft::Node<int> int_node;
+typedef ft::Rbtree<int, std::less<int> > any_tree;
+
+/* true when both subtrees have the same shape, values and balance fields,
+and the copy has consistent parent links */
+static bool same_tree(const int_node *a, const int_node *b, const int_node *parent){
+	if (any_tree::is_null_leaf(a) || any_tree::is_null_leaf(b))
+		return (any_tree::is_null_leaf(a) && any_tree::is_null_leaf(b)
+			&& b->parent == parent && a->color == b->color);
+	return (*a->data == *b->data && a->color == b->color && a->data != b->data
+		&& b->parent == parent && same_tree(a->left, b->left, b)
+		&& same_tree(a->right, b->right, b));
+}
+
+/* Copies trees of every policy, serial and on 4 threads, then updates the copies.*/
+template <class Policy>
+static bool clone_valid(void){
+	typedef ft::Rbtree<int, std::less<int>, std::allocator<int>,
+		std::allocator<int_node>, Policy> tree_type;
+	tree_type tree;
+	bool ok = true;
+
+	for (int i = 0; i < 30000; i++)
+		tree.insert_value((i * 7919) % 30011);
+	tree_type copy(tree);
+	ok = same_tree(tree.get_root(), copy.get_root(), NULL);
+	for (size_t threads = 1; threads <= 8 && ok; threads *= 2){
+		tree_type parallel;
+		parallel.clone(tree, threads, 30000);
+		ok = same_tree(tree.get_root(), parallel.get_root(), NULL);
+		for (int i = 0; i < 30000 && ok; i += 5)
+			parallel.delete_value((i * 7919) % 30011);
+		parallel.clear(threads, 24000);
+		ok = ok && parallel.get_root() == NULL;
+	}
+	copy = copy;
+	ok = ok && same_tree(tree.get_root(), copy.get_root(), NULL);
+	return (ok);
+}
+
+void test_clone(void){
+	std::cout << "==============================" << std::endl;
+	std::cout << "     clone and teardown       " << std::endl;
+	std::cout << "==============================" << std::endl;
+	CHECK("clone rb", clone_valid<ft::rb_balance>());
+	CHECK("clone avl", clone_valid<ft::avl_balance>());
+	CHECK("clone wavl", clone_valid<ft::wavl_balance>());
+	CHECK("clone splay", clone_valid<ft::splay_balance>());
+
+	ft::map<int, int> map;
+	std::map<int, int> ref;
+	srand(5);
+	for (int i = 0; i < 50000; i++){
+		int k = rand() % 100000;
+		map[k] = i;
+		ref[k] = i;
+	}
+	ft::map<int, int> copy(map, ft::parallel(4));
+	bool same = copy.size() == ref.size();
+	std::map<int, int>::iterator rit = ref.begin();
+	for (ft::map<int, int>::iterator it = copy.begin(); it != copy.end() && same; ++it, ++rit)
+		same = it->first == rit->first && it->second == rit->second;
+	for (int k = 0; k < 100000; k += 3){
+		copy.erase(k);
+		copy[k + 1] = k;
+	}
+	same = same && map.size() == ref.size();
+	rit = ref.begin();
+	for (ft::map<int, int>::iterator it = map.begin(); it != map.end() && same; ++it, ++rit)
+		same = it->first == rit->first && it->second == rit->second;
+	CHECK("parallel map copy, independent of the source", same);
+
+	copy.clear(ft::parallel(4));
+	copy[1] = 1;
+	CHECK("parallel map clear", copy.size() == 1 && copy.begin()->first == 1);
+
+	ft::map<int, int, std::less<int>, std::allocator<ft::pair<const int, int> >,
+		ft::wavl_balance, ft::sum_monoid<long> > sums;
+	for (int i = 0; i < 20000; i++)
+		sums.insert(ft::make_pair(i, i % 13));
+	ft::map<int, int, std::less<int>, std::allocator<ft::pair<const int, int> >,
+		ft::wavl_balance, ft::sum_monoid<long> > sums_copy(sums, ft::parallel(4));
+	sums_copy.erase(100);
+	CHECK("aggregates of a parallel copy", sums_copy.aggregate() == sums.aggregate() - 100 % 13
+		&& sums_copy.aggregate(0, 5000) == sums.aggregate(0, 5000) - 100 % 13);
+
+	ft::set<int> set;
+	for (int i = 0; i < 40000; i++)
+		set.insert(i * 2);
+	ft::set<int> set_copy(set, ft::parallel(4));
+	CHECK("parallel set copy", set_copy == set);
+
+	set.clear(ft::background());
+	set_copy.clear(ft::background());
+	map.clear(ft::background());
+	bool empty_now = set.empty() && set.begin() == set.end() && map.empty();
+	set.insert(3);
+	ft::background::wait();
+	CHECK("background clear", empty_now && set.size() == 1 && *set.begin() == 3);
+	ft::set<int> none;
+	none.clear(ft::background());
+	ft::background::wait();
+	std::cout << "empty background clear: " << none.size() << std::endl;
+}
@@ -0,0 +1,88 @@
+#include "extensions.hpp"
+#include <concurrent_map.hpp>
+#include <pthread.h>
+#include <map>
+
+typedef ft::concurrent_map<int, int> cmap;
+
+struct worker
+{
+	cmap	*map;
+	int		id;
+	bool	ok;
+};
+
+/* Writers own the keys k with k % 2 == id: set, then erase every third one.*/
+static void *write_keys(void *arg){
+	worker *w = static_cast<worker *>(arg);
+
+	for (int round = 0; round < 3; round++)
+		for (int k = w->id; k < 4000; k += 2)
+			w->map->set(k, k * 10 + round);
+	for (int k = w->id; k < 4000; k += 6)
+		w->map->erase(k);
+	return (NULL);
+}
+
+/* Readers check that every snapshot is sorted and self-consistent, and that
+values never go backwards.*/
+static void *read_keys(void *arg){
+	worker *w = static_cast<worker *>(arg);
+	std::map<int, int> seen;
+
+	for (int i = 0; i < 300; i++){
+		cmap::snapshot_type snap = w->map->snapshot();
+		size_t n = 0;
+		int prev = -1;
+		for (cmap::snapshot_type::iterator it = snap.begin(); it != snap.end(); ++it, ++n){
+			if (it->first <= prev || it->second / 10 != it->first)
+				w->ok = false;
+			prev = it->first;
+		}
+		if (n != snap.size())
+			w->ok = false;
+		for (int k = i; k < 4000; k += 97){
+			int value;
+			if (w->map->find(k, value)){
+				if (value / 10 != k || (seen.count(k) && value < seen[k]))
+					w->ok = false;
+				seen[k] = value;
+			}
+		}
+	}
+	return (NULL);
+}
+
+void test_concurrent(void){
+	std::cout << "==============================" << std::endl;
+	std::cout << "        concurrent map        " << std::endl;
+	std::cout << "==============================" << std::endl;
+	cmap map;
+	pthread_t threads[4];
+	worker workers[4];
+
+	map.set(1, 10);
+	map.insert(ft::make_pair(2, 20));
+	cmap::snapshot_type before = map.snapshot();
+	map.erase(1);
+	std::cout << "snapshot keeps erased key: " << before.count(1) << ", map: " << map.count(1) << std::endl;
+	map.clear();
+
+	for (int i = 0; i < 4; i++){
+		workers[i].map = &map;
+		workers[i].id = i % 2;
+		workers[i].ok = true;
+		pthread_create(&threads[i], NULL, i < 2 ? &write_keys : &read_keys, &workers[i]);
+	}
+	for (int i = 0; i < 4; i++)
+		pthread_join(threads[i], NULL);
+
+	bool contents = true;
+	for (int k = 0; k < 4000; k++){
+		int value = -1;
+		bool found = map.find(k, value);
+		contents = contents && found == (k % 6 >= 2) && (!found || value == k * 10 + 2);
+	}
+	CHECK("concurrent readers consistent", workers[2].ok && workers[3].ok);
+	CHECK("concurrent final contents", contents && map.size() == 4000 - 4000 / 3 - 1);
+}
@@ -0,0 +1,194 @@
+#include "extensions.hpp"
+#include <cow_vector.hpp>
+#include <stack.hpp>
+#include <vector>
+#include <cstdlib>
+#include <pthread.h>
+
+namespace
+{
+	long g_allocations = 0;
+
+	/* std::allocator counting the allocations, to check what is copied.*/
+	template <class T>
+	struct counting_allocator : public std::allocator<T>
+	{
+		template <class U>
+		struct rebind { typedef counting_allocator<U> other; };
+
+		counting_allocator() {}
+		counting_allocator(const counting_allocator &src) : std::allocator<T>(src) {}
+		template <class U>
+		counting_allocator(const counting_allocator<U> &src) : std::allocator<T>(src) {}
+
+		T *allocate(size_t n, const void * = 0){
+			g_allocations++;
+			return (std::allocator<T>::allocate(n));
+		}
+	};
+}
+
+typedef ft::cow_vector<std::string> cow_strings;
+
+/*
+Copies of v taken now and then, and v made a copy of one of them, so that
+edits land on shared buffers: every copy keeps its own contents.
+*/
+struct cow_copies
+{
+	std::vector<cow_strings>				*copies;
+	std::vector<std::vector<std::string> >	*refs;
+
+	bool operator()(cow_strings &v, std::vector<std::string> &ref) const {
+		size_t k = rand() % 12;
+		switch (rand() % 8){
+			case 0:
+				if (k < copies->size())
+					(*copies)[k] = v, (*refs)[k] = ref;
+				else
+					copies->push_back(v), refs->push_back(ref);
+				break;
+			case 1:
+				if (k < copies->size())
+					v = (*copies)[k], ref = (*refs)[k];
+		}
+		for (size_t c = 0; c < copies->size(); c++)
+			if (!same_elements((*copies)[c].view(), (*refs)[c]))
+				return (false);
+		return (true);
+	}
+};
+
+static bool cow_random(int ops){
+	cow_strings v;
+	std::vector<std::string> ref;
+	std::vector<cow_strings> copies;
+	std::vector<std::vector<std::string> > refs;
+	cow_copies check = {&copies, &refs};
+
+	return (vector_like_random(v, ref, ops, check));
+}
+
+struct stage
+{
+	ft::cow_vector<int>	input;
+	long				sum;
+	bool				ok;
+};
+
+/* A pipeline stage: reads its copy, changes it, and drops it.*/
+static void *run_stage(void *arg){
+	stage *s = static_cast<stage *>(arg);
+
+	for (int round = 0; round < 200; round++){
+		ft::cow_vector<int> local(s->input);
+		const ft::cow_vector<int> &read = local;
+		long sum = 0;
+		for (size_t i = 0; i < read.size(); i++)
+			sum += read[i];
+		if (round % 2){
+			local.push_back(round);
+			local[0] = -1;
+			s->ok = s->ok && local.use_count() == 1 && local.back() == round;
+		}
+		s->ok = s->ok && sum == s->sum;
+	}
+	return (NULL);
+}
+
+void test_cow_vector(void){
+	std::cout << "==============================" << std::endl;
+	std::cout << "          cow vector          " << std::endl;
+	std::cout << "==============================" << std::endl;
+	srand(50);
+	CHECK("random operations on shared copies against std::vector", cow_random(20000));
+
+	typedef ft::cow_vector<int, counting_allocator<int> > counted;
+	counted a(100000, 7);
+	counted c;
+	g_allocations = 0;
+	counted b(a);
+	c = b;
+	const counted &ref = c;
+	long sum = 0;
+	for (counted::const_iterator it = ref.begin(); it != ref.end(); ++it)
+		sum += *it;
+	bool ok = g_allocations == 0 && &a.view() == &c.view() && a.use_count() == 3 && sum == 700000
+		&& ref[99999] == 7 && a == c;
+	CHECK("copies share the buffer, const reads do not copy", ok);
+
+	g_allocations = 0;
+	c.push_back(8);
+	ok = g_allocations == 2 && !c.is_shared() && a.use_count() == 2 && a.size() == 100000
+		&& c.size() == 100001 && c.back() == 8 && a.back() == 7 && a != c && a < c;
+	b[0] = 1;
+	CHECK("first modification copies once, the others keep theirs", ok && b.front() == 1 && a.front() == 7
+		&& a.use_count() == 1 && b.use_count() == 1);
+
+	b = a;
+	g_allocations = 0;
+	b.reserve(200000);
+	ok = g_allocations == 2 && b.capacity() == 200000 && !a.is_shared();
+	b = a;
+	c = a;
+	g_allocations = 0;
+	b.clear();
+	c.assign((size_t)3, 9);
+	ok = ok && g_allocations == 3 && b.empty() && c.size() == 3 && a.size() == 100000 && a.use_count() == 1;
+	CHECK("reserve detaches in one allocation, clear and assign drop without copying", ok);
+
+	counted d(a);
+	g_allocations = 0;
+	d.detach();
+	ok = g_allocations == 2 && !d.is_shared() && !a.is_shared();
+	g_allocations = 0;
+	d.edit().push_back(1);
+	d[5] = 3;
+	ok = ok && g_allocations == 1 && d[5] == 3 && a[5] == 7;
+	counted e(d);
+	e.swap(a);
+	CHECK("detach and edit", ok && e.size() == 100000 && a.size() == 100001 && a.use_count() == 2);
+
+	counted::vector_type source(100000, 4);
+	g_allocations = 0;
+	counted f(source);
+	CHECK("from a vector, the elements copied once", g_allocations == 2 && f.size() == 100000
+		&& f.back() == 4 && &f.view() != &source);
+
+	ft::cow_vector<int> numbers;
+	for (int i = 0; i < 1000; i++)
+		numbers.push_back(i);
+	ft::cow_vector<int> before(numbers);
+	numbers.insert(before.cbegin() + 500, 3, -1);
+	numbers.erase(numbers.cbegin() + 10);
+	ok = numbers.size() == 1002 && numbers[9] == 9 && numbers[10] == 11 && numbers[499] == -1
+		&& numbers[502] == 500 && before.size() == 1000 && before[500] == 500;
+	CHECK("insert at a position in the shared buffer", ok);
+
+	ft::vector<int> large(200000, 1);
+	stage stages[4];
+	pthread_t threads[4];
+	for (int i = 0; i < 4; i++){
+		stages[i].input = ft::cow_vector<int>(large);
+		stages[i].sum = 200000;
+		stages[i].ok = true;
+	}
+	stages[1].input = stages[0].input;
+	stages[3].input = stages[2].input;
+	for (int i = 0; i < 4; i++)
+		pthread_create(&threads[i], NULL, &run_stage, &stages[i]);
+	ok = true;
+	for (int i = 0; i < 4; i++){
+		pthread_join(threads[i], NULL);
+		ok = ok && stages[i].ok;
+	}
+	CHECK("stages in threads share and detach", ok && stages[0].input.use_count() == 2
+		&& stages[0].input.view()[0] == 1);
+
+	ft::stack<int, ft::cow_vector<int> > stack;
+	for (int i = 0; i < 10000; i++)
+		stack.push(i);
+	ft::stack<int, ft::cow_vector<int> > copy(stack);
+	copy.pop();
+	CHECK("ft::stack", stack.top() == 9999 && copy.top() == 9998 && stack.size() == 10000);
+}
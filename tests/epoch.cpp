@@ -0,0 +1,133 @@
+#include "extensions.hpp"
+#include <epoch.hpp>
+#include <pthread.h>
+
+static const int g_alive = 0x600d;
+
+struct object
+{
+	int	magic;
+	int	value;
+};
+
+static size_t g_made = 0;
+static size_t g_freed = 0;
+
+static void free_object(void *ptr){
+	object *obj = static_cast<object *>(ptr);
+
+	obj->magic = 0;
+	delete obj;
+	__sync_fetch_and_add(&g_freed, 1);
+}
+
+static object *make_object(int value){
+	object *obj = new object;
+
+	obj->magic = g_alive;
+	obj->value = value;
+	__sync_fetch_and_add(&g_made, 1);
+	return (obj);
+}
+
+static object *g_shared = NULL;
+static int g_state = 0;
+static int g_done = 0;
+
+/* Holds a guard until told to leave.*/
+static void *hold_guard(void *){
+	ft::epoch::guard guard;
+
+	__atomic_store_n(&g_state, 1, __ATOMIC_SEQ_CST);
+	while (__atomic_load_n(&g_state, __ATOMIC_SEQ_CST) != 2)
+		;
+	return (NULL);
+}
+
+struct worker
+{
+	int		id;
+	bool	ok;
+};
+
+/* Replaces the shared object and retires the old one, or reads it, in guards.*/
+static void *swap_shared(void *arg){
+	worker *w = static_cast<worker *>(arg);
+
+	for (int i = 0; i < 20000; i++){
+		ft::epoch::guard guard;
+		if (w->id % 2 == 0){
+			object *old = __atomic_exchange_n(&g_shared, make_object(i), __ATOMIC_SEQ_CST);
+			ft::epoch::retire(old, &free_object);
+		}
+		else{
+			object *obj = __atomic_load_n(&g_shared, __ATOMIC_SEQ_CST);
+			if (obj->magic != g_alive)
+				w->ok = false;
+		}
+	}
+	// flush once nobody is left inside a guard
+	__sync_fetch_and_add(&g_done, 1);
+	while (__atomic_load_n(&g_done, __ATOMIC_SEQ_CST) != 4)
+		;
+	ft::epoch::flush();
+	return (NULL);
+}
+
+void test_epoch(void){
+	std::cout << "==============================" << std::endl;
+	std::cout << "      epoch reclamation       " << std::endl;
+	std::cout << "==============================" << std::endl;
+	size_t freed = g_freed;
+	pthread_t holder;
+
+	pthread_create(&holder, NULL, &hold_guard, NULL);
+	while (__atomic_load_n(&g_state, __ATOMIC_SEQ_CST) != 1)
+		;
+	ft::epoch::retire(make_object(0), &free_object);
+	ft::epoch::flush();
+	bool kept = g_freed == freed;
+	__atomic_store_n(&g_state, 2, __ATOMIC_SEQ_CST);
+	pthread_join(holder, NULL);
+	ft::epoch::flush();
+	CHECK("epoch keeps what a guard may see", kept);
+	CHECK("epoch frees once the guard is gone", g_freed == freed + 1);
+
+	size_t peak = 0;
+	freed = g_freed;
+	for (int i = 0; i < 100000; i++){
+		ft::epoch::guard guard;
+		ft::epoch::retire(make_object(i), &free_object);
+		if (i + 1 - (g_freed - freed) > peak)
+			peak = i + 1 - (g_freed - freed);
+	}
+	std::cout << "peak pending over 100000 retires: " << peak << std::endl;
+	CHECK("epoch bounded garbage", peak <= 4 * ft::epoch::advance_every);
+
+	for (int i = 0; i < 10; i++){
+		ft::epoch::guard guard;
+		ft::epoch::retire(make_object(i), &free_object);
+	}
+	for (size_t i = 0; i < 4 * ft::epoch::advance_every; i++)
+		ft::epoch::guard guard;
+	CHECK("epoch frees for idle retirers", g_freed == g_made);
+
+	pthread_t threads[4];
+	worker workers[4];
+	g_shared = make_object(-1);
+	freed = g_freed;
+	for (int i = 0; i < 4; i++){
+		workers[i].id = i;
+		workers[i].ok = true;
+		pthread_create(&threads[i], NULL, &swap_shared, &workers[i]);
+	}
+	for (int i = 0; i < 4; i++)
+		pthread_join(threads[i], NULL);
+	ft::epoch::flush();
+	CHECK("epoch concurrent readers never see freed objects", workers[1].ok && workers[3].ok);
+	CHECK("epoch concurrent retires all freed", g_freed == freed + 40000);
+	free_object(g_shared);
+
+	ft::epoch::stats s = ft::epoch::statistics();
+	CHECK("epoch statistics", s.retired - s.freed == s.pending && s.retired >= 140011);
+}
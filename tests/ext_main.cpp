@@ -0,0 +1,95 @@
+#include "extensions.hpp"
+#include <cstring>
+
+int main(int argc, char **argv){
+	if (argc > 2){
+		std::cout << "invalid number os arguments\n" <<
+		"Use: ./ft_containers_ext [ balance | aggregate | interval | small_map | frozen | persistent | concurrent | skiplist | epoch | parallel | algebra | clone | tree_range | mapped | paged | relocation | vector_insert | growth | small_vector | vector_range | aligned | vm_vector | mapped_vector | uninitialized | cow_vector ] " << std::endl;
+		return (1);
+	}
+	if (argc == 1){
+		test_balance();
+		test_aggregate();
+		test_interval();
+		test_small_map();
+		test_frozen();
+		test_persistent();
+		test_concurrent();
+		test_skiplist();
+		test_epoch();
+		test_parallel();
+		test_algebra();
+		test_clone();
+		test_tree_range();
+		test_mapped();
+		test_paged();
+		test_relocation();
+		test_vector_insert();
+		test_growth();
+		test_small_vector();
+		test_vector_range();
+		test_aligned();
+		test_vm_vector();
+		test_mapped_vector();
+		test_uninitialized();
+		test_cow_vector();
+	}
+	else{
+		if (strcmp(argv[1], "balance") == 0)
+			test_balance();
+		else if (strcmp(argv[1], "aggregate") == 0)
+			test_aggregate();
+		else if (strcmp(argv[1], "interval") == 0)
+			test_interval();
+		else if (strcmp(argv[1], "small_map") == 0)
+			test_small_map();
+		else if (strcmp(argv[1], "frozen") == 0)
+			test_frozen();
+		else if (strcmp(argv[1], "persistent") == 0)
+			test_persistent();
+		else if (strcmp(argv[1], "concurrent") == 0)
+			test_concurrent();
+		else if (strcmp(argv[1], "skiplist") == 0)
+			test_skiplist();
+		else if (strcmp(argv[1], "epoch") == 0)
+			test_epoch();
+		else if (strcmp(argv[1], "parallel") == 0)
+			test_parallel();
+		else if (strcmp(argv[1], "algebra") == 0)
+			test_algebra();
+		else if (strcmp(argv[1], "clone") == 0)
+			test_clone();
+		else if (strcmp(argv[1], "tree_range") == 0)
+			test_tree_range();
+		else if (strcmp(argv[1], "mapped") == 0)
+			test_mapped();
+		else if (strcmp(argv[1], "paged") == 0)
+			test_paged();
+		else if (strcmp(argv[1], "relocation") == 0)
+			test_relocation();
+		else if (strcmp(argv[1], "vector_insert") == 0)
+			test_vector_insert();
+		else if (strcmp(argv[1], "growth") == 0)
+			test_growth();
+		else if (strcmp(argv[1], "small_vector") == 0)
+			test_small_vector();
+		else if (strcmp(argv[1], "vector_range") == 0)
+			test_vector_range();
+		else if (strcmp(argv[1], "aligned") == 0)
+			test_aligned();
+		else if (strcmp(argv[1], "vm_vector") == 0)
+			test_vm_vector();
+		else if (strcmp(argv[1], "mapped_vector") == 0)
+			test_mapped_vector();
+		else if (strcmp(argv[1], "uninitialized") == 0)
+			test_uninitialized();
+		else if (strcmp(argv[1], "cow_vector") == 0)
+			test_cow_vector();
+		else
+		{
+			std::cout << "Invalid test name\n" <<
+			"Use: ./ft_containers_ext [ balance | aggregate | interval | small_map | frozen | persistent | concurrent | skiplist | epoch | parallel | algebra | clone | tree_range | mapped | paged | relocation | vector_insert | growth | small_vector | vector_range | aligned | vm_vector | mapped_vector | uninitialized | cow_vector ] " << std::endl;
+			return (1);
+		}
+	}
+}
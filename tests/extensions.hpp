@@ -0,0 +1,162 @@
+#ifndef FT_EXTENSIONS_HPP
+# define FT_EXTENSIONS_HPP
+
+/*
+Tests for the ft only extensions (no std counterpart to diff against).
+Each test prints its results and compares itself to a reference built with the
+std containers, printing OK or KO per check.
+*/
+
+#include <iostream>
+#include <string>
+#include <sstream>
+#include <vector>
+#include <cstdlib>
+#include <unistd.h>
+#include <vector.hpp>
+#include <pair.hpp>
+#include <map.hpp>
+#include <stack.hpp>
+#include <set.hpp>
+
+# define CHECK(name, cond) \
+	std::cout << (name) << ": " << ((cond) ? "OK" : "KO") << std::endl
+
+/* A file name under /tmp for this process, for the file backed containers.*/
+inline std::string temp_path(const char *name){
+	std::ostringstream path;
+	path << "/tmp/ft_" << name << "_" << getpid();
+	return (path.str());
+}
+
+/* The i-th value of the random tests, by type.*/
+inline int make_value(int i, int){
+	return (i);
+}
+
+inline std::string make_value(int i, std::string){
+	std::ostringstream out;
+	out << "value " << i;
+	return (out.str());
+}
+
+inline ft::vector<int> make_value(int i, ft::vector<int>){
+	return (ft::vector<int>(i % 5 + 1, i));
+}
+
+template <class V, class T>
+bool same_elements(const V &v, const std::vector<T> &ref){
+	if (v.size() != ref.size())
+		return (false);
+	for (size_t i = 0; i < ref.size(); i++)
+		if (!(v[i] == ref[i]))
+			return (false);
+	return (true);
+}
+
+/* For vector_like_random() when the container has nothing of its own to check.*/
+struct no_check
+{
+	template <class V, class T>
+	bool operator()(V &, std::vector<T> &) const { return (true); }
+};
+
+/*
+Random push_back, pop_back, insert and erase of every form, including of
+the container's own elements, and resize on a vector like container,
+against std::vector. check(v, ref) runs after every operation, for what is
+particular to the container; it may also change both of them alike.
+*/
+template <class V, class Check>
+bool vector_like_random(V &v, std::vector<typename V::value_type> &ref, int ops, Check check){
+	typedef typename V::value_type T;
+	bool ok = true;
+
+	for (int i = 0; i < ops && ok; i++){
+		size_t at = ref.empty() ? 0 : rand() % (ref.size() + 1);
+		size_t n = rand() % 5;
+		T val = make_value(i, T());
+		switch (rand() % 10){
+			case 0:
+			case 1:
+				v.push_back(val);
+				ref.push_back(val);
+				break;
+			case 2:
+				if (!ref.empty())
+					v.pop_back(), ref.pop_back();
+				break;
+			case 3:
+				ok = *v.insert(v.begin() + at, val) == val;
+				ref.insert(ref.begin() + at, val);
+				break;
+			case 4:
+				v.insert(v.begin() + at, n, val);
+				ref.insert(ref.begin() + at, n, val);
+				break;
+			case 5:{
+				std::vector<T> range;
+				for (size_t k = 0; k < n; k++)
+					range.push_back(make_value(i * 10 + k, T()));
+				v.insert(v.begin() + at, range.begin(), range.end());
+				ref.insert(ref.begin() + at, range.begin(), range.end());
+				break;
+			}
+			case 6:
+				if (!ref.empty()){
+					// the value inserted is an element that moves
+					size_t from = rand() % ref.size();
+					if (n % 2)
+						v.push_back(v[from]), ref.push_back(T(ref[from]));
+					else
+						v.insert(v.begin() + at, n, v[from]), ref.insert(ref.begin() + at, n, T(ref[from]));
+				}
+				break;
+			case 7:
+				if (at < ref.size()){
+					ok = v.erase(v.begin() + at) == v.begin() + at;
+					ref.erase(ref.begin() + at);
+				}
+				break;
+			case 8:{
+				size_t last = at + rand() % (ref.size() - at + 1);
+				ok = v.erase(v.begin() + at, v.begin() + last) == v.begin() + at;
+				ref.erase(ref.begin() + at, ref.begin() + last);
+				break;
+			}
+			default:
+				v.resize(at + n / 2, val);
+				ref.resize(at + n / 2, val);
+		}
+		ok = ok && same_elements(v, ref) && check(v, ref);
+	}
+	return (ok);
+}
+
+void test_balance(void);
+void test_aggregate(void);
+void test_interval(void);
+void test_small_map(void);
+void test_frozen(void);
+void test_persistent(void);
+void test_concurrent(void);
+void test_skiplist(void);
+void test_epoch(void);
+void test_parallel(void);
+void test_algebra(void);
+void test_clone(void);
+void test_tree_range(void);
+void test_mapped(void);
+void test_paged(void);
+void test_relocation(void);
+void test_vector_insert(void);
+void test_growth(void);
+void test_small_vector(void);
+void test_vector_range(void);
+void test_aligned(void);
+void test_vm_vector(void);
+void test_mapped_vector(void);
+void test_uninitialized(void);
+void test_cow_vector(void);
+
+#endif
@@ -0,0 +1,106 @@
+#include "extensions.hpp"
+#include <frozen_map.hpp>
+#include <map>
+#include <vector>
+#include <sstream>
+#include <cstdlib>
+
+/* Walks a std::vector once: copies share the position, as the copies of an
+istream_iterator share the stream.*/
+class single_pass
+{
+	public:
+	typedef std::input_iterator_tag iterator_category;
+	typedef ft::pair<int, char> value_type;
+	typedef std::ptrdiff_t difference_type;
+	typedef const value_type *pointer;
+	typedef const value_type &reference;
+
+	single_pass() : _items(NULL), _pos(NULL) {}
+	single_pass(const std::vector<value_type> &items, size_t *pos) : _items(&items), _pos(pos) {}
+
+	reference operator*() const { return ((*_items)[*_pos]); }
+	single_pass &operator++() { ++*_pos; return (*this); }
+	bool operator==(const single_pass &other) const { return (at_end() == other.at_end()); }
+	bool operator!=(const single_pass &other) const { return (!(*this == other)); }
+
+	private:
+	bool at_end() const { return (!_items || *_pos == _items->size()); }
+
+	const std::vector<value_type>	*_items;
+	size_t							*_pos;
+};
+
+/* Checks every query of a frozen map of n random keys against std::map.*/
+static void test_frozen_size(size_t n){
+	ft::map<int, int> map;
+	std::map<int, int> ref;
+
+	for (size_t i = 0; i < n; i++){
+		int k = rand() % (4 * n + 1);
+		map[k] = (int)i;
+		ref[k] = (int)i;
+	}
+	ft::frozen_map<int, int> frozen = map.freeze();
+	bool order = frozen.size() == ref.size();
+	std::map<int, int>::iterator rit = ref.begin();
+	for (ft::frozen_map<int, int>::iterator it = frozen.begin(); order && it != frozen.end(); ++it, ++rit)
+		order = it->first == rit->first && it->second == rit->second;
+	std::map<int, int>::reverse_iterator rrit = ref.rbegin();
+	for (ft::frozen_map<int, int>::reverse_iterator it = frozen.rbegin(); order && it != frozen.rend(); ++it, ++rrit)
+		order = it->first == rrit->first;
+
+	bool queries = true;
+	for (int q = -1; q <= (int)(4 * n + 1) && queries; q++){
+		std::map<int, int>::iterator lo = ref.lower_bound(q);
+		std::map<int, int>::iterator hi = ref.upper_bound(q);
+		ft::frozen_map<int, int>::iterator flo = frozen.lower_bound(q);
+		ft::frozen_map<int, int>::iterator fhi = frozen.upper_bound(q);
+		queries = (lo == ref.end()) == (flo == frozen.end())
+			&& (hi == ref.end()) == (fhi == frozen.end())
+			&& (lo == ref.end() || flo->first == lo->first)
+			&& (hi == ref.end() || fhi->first == hi->first)
+			&& frozen.count(q) == ref.count(q)
+			&& (frozen.find(q) == frozen.end()) == (ref.find(q) == ref.end());
+	}
+	std::ostringstream name;
+	name << "frozen n=" << n;
+	CHECK(name.str() + " iteration", order);
+	CHECK(name.str() + " find / bounds", queries);
+}
+
+void test_frozen(void){
+	std::cout << "==============================" << std::endl;
+	std::cout << "          frozen map          " << std::endl;
+	std::cout << "==============================" << std::endl;
+	ft::map<std::string, int> routes;
+	routes["/"] = 0;
+	routes["/api"] = 1;
+	routes["/static"] = 2;
+	routes["/api/v2"] = 3;
+	ft::frozen_map<std::string, int> table = routes.freeze();
+	for (ft::frozen_map<std::string, int>::iterator it = table.begin(); it != table.end(); ++it)
+		std::cout << it->first << " -> " << it->second << std::endl;
+	std::cout << "at(/api/v2): " << table.at("/api/v2") << std::endl;
+	std::cout << "lower_bound(/b): " << table.lower_bound("/b")->first << std::endl;
+
+	srand(3);
+	size_t sizes[] = { 0, 1, 2, 3, 7, 8, 100, 1000 };
+	for (size_t i = 0; i < sizeof(sizes) / sizeof(*sizes); i++)
+		test_frozen_size(sizes[i]);
+
+	std::vector<ft::pair<int, char> > sorted;
+	for (int i = 0; i < 26; i++)
+		sorted.push_back(ft::make_pair(i * 2, (char)('a' + i)));
+	ft::frozen_map<int, char> letters(sorted.begin(), sorted.end());
+	ft::frozen_map<int, char> copy(letters);
+	CHECK("frozen from sorted range", letters.size() == 26 && letters.at(10) == 'f'
+		&& letters.upper_bound(11)->second == 'g' && copy == letters);
+	size_t pos = 0;
+	ft::frozen_map<int, char> once(single_pass(sorted, &pos), single_pass());
+	CHECK("frozen from an input range", once == letters && pos == 26);
+	bool thrown = false;
+	try { letters.at(11); }
+	catch (std::out_of_range &) { thrown = true; }
+	CHECK("frozen at throws", thrown);
+}
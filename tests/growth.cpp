@@ -0,0 +1,74 @@
+#include "extensions.hpp"
+#include <vector.hpp>
+#include <stack.hpp>
+#include <sstream>
+
+struct triple
+{
+	long	a, b, c;
+};
+
+/* The capacities push_back goes through while reaching n elements.*/
+template <class Vector>
+static std::string capacities(size_t n, const typename Vector::value_type &val){
+	Vector v;
+	std::ostringstream out;
+	size_t last = 0;
+
+	for (size_t i = 0; i < n; i++){
+		v.push_back(val);
+		if (v.capacity() != last)
+			out << (last ? " " : "") << v.capacity();
+		last = v.capacity();
+	}
+	return (out.str());
+}
+
+void test_growth(void){
+	std::cout << "==============================" << std::endl;
+	std::cout << "    vector growth policies    " << std::endl;
+	std::cout << "==============================" << std::endl;
+	typedef std::allocator<int> int_alloc;
+	typedef std::allocator<triple> triple_alloc;
+	triple t = {1, 2, 3};
+
+	CHECK("double", (capacities<ft::vector<int> >(20, 1) == "1 2 4 8 16 32"));
+	CHECK("golden", (capacities<ft::vector<int, int_alloc, ft::growth_golden> >(20, 1)
+		== "1 2 3 4 6 9 13 19 28"));
+	CHECK("chunk", (capacities<ft::vector<int, int_alloc, ft::growth_chunk<100> > >(250, 1)
+		== "100 200 300"));
+	CHECK("pages", (capacities<ft::vector<triple, triple_alloc, ft::growth_pages<> > >(300, t)
+		== "1 2 4 8 16 32 64 128 341"));
+	ft::vector<int> big;
+	big.insert(big.begin(), (size_t)1000, 3);
+	big.push_back(4);
+	ft::vector<int, int_alloc, ft::growth_pages<ft::growth_golden> > paged(1000, 3);
+	paged.push_back(4);
+	CHECK("growth of inserts", big.capacity() == 2000 && paged.capacity() == 2048);
+
+	ft::vector<int> v;
+	for (int i = 0; i < 1000; i++)
+		v.push_back(i);
+	bool ok = v.capacity() == 1024 && v.slack() == 24;
+	v.shrink_to_fit();
+	ok = ok && v.capacity() == 1000 && v.slack() == 0 && v[999] == 999;
+	v.resize(10);
+	v.shrink_to_fit();
+	ok = ok && v.capacity() == 10 && v.back() == 9;
+	v.clear();
+	v.shrink_to_fit();
+	ok = ok && v.capacity() == 0;
+	v.push_back(5);
+	CHECK("slack and shrink_to_fit", ok && v.capacity() == 1 && v[0] == 5);
+
+	typedef ft::vector<int, int_alloc, ft::growth_golden> golden_vector;
+	golden_vector a(5, 1);
+	golden_vector b(a);
+	b.push_back(2);
+	ft::swap(a, b);
+	ft::stack<int, golden_vector> stack;
+	for (int i = 0; i < 10; i++)
+		stack.push(i);
+	CHECK("policies keep the interface", a.size() == 6 && b < a && a != b && stack.top() == 9
+		&& stack.size() == 10);
+}
@@ -0,0 +1,89 @@
+#include "extensions.hpp"
+#include <interval_map.hpp>
+#include <interval_set.hpp>
+#include <map>
+#include <vector>
+#include <iterator>
+#include <cstdlib>
+
+template <class Balance>
+static void test_interval_map(const std::string &name){
+	typedef ft::interval_map<int, int, std::less<int>,
+		std::allocator<ft::pair<const ft::pair<int, int>, int> >, Balance> map_type;
+	map_type map;
+	std::map<std::pair<int, int>, int> ref;
+	bool any = true;
+	bool all = true;
+	bool found = true;
+
+	srand(11);
+	for (int i = 0; i < 4000; i++){
+		int lo = rand() % 10000;
+		int hi = lo + 1 + rand() % 300;
+		if (rand() % 4 == 0 && !ref.empty()){
+			std::map<std::pair<int, int>, int>::iterator victim = ref.lower_bound(std::make_pair(lo, 0));
+			if (victim == ref.end())
+				victim = ref.begin();
+			map.erase(ft::make_pair(victim->first.first, victim->first.second));
+			ref.erase(victim);
+		}
+		else{
+			map.insert(lo, hi, i);
+			ref.insert(std::make_pair(std::make_pair(lo, hi), i));
+		}
+		int a = rand() % 10000;
+		int b = a + rand() % 200;
+		std::vector<std::pair<int, int> > expected;
+		for (std::map<std::pair<int, int>, int>::iterator it = ref.begin(); it != ref.end(); ++it)
+			if (it->first.first < b && a < it->first.second)
+				expected.push_back(it->first);
+		std::vector<typename map_type::iterator> result;
+		map.overlapping(a, b, std::back_inserter(result));
+		if (result.size() != expected.size())
+			all = false;
+		for (size_t j = 0; all && j < result.size(); j++)
+			all = result[j]->first.first == expected[j].first && result[j]->first.second == expected[j].second;
+		if (map.overlaps(a, b) != !expected.empty())
+			any = false;
+		typename map_type::iterator hit = map.find_overlap(a, b);
+		if (hit != map.end() && !(hit->first.first < b && a < hit->first.second))
+			found = false;
+	}
+	CHECK(name + " size", map.size() == ref.size());
+	CHECK(name + " overlaps", any);
+	CHECK(name + " find_overlap", found);
+	CHECK(name + " overlapping", all);
+}
+
+void test_interval(void){
+	std::cout << "==============================" << std::endl;
+	std::cout << "          intervals           " << std::endl;
+	std::cout << "==============================" << std::endl;
+	ft::interval_map<int, std::string> windows;
+	windows.insert(0, 10, "boot");
+	windows.insert(5, 20, "load");
+	windows.insert(30, 40, "serve");
+	windows[ft::make_pair(15, 35)] = "drain";
+	std::vector<ft::interval_map<int, std::string>::iterator> hits;
+	windows.overlapping(18, 31, std::back_inserter(hits));
+	std::cout << "overlapping [18, 31):";
+	for (size_t i = 0; i < hits.size(); i++)
+		std::cout << " " << hits[i]->second;
+	std::cout << std::endl;
+	std::cout << "overlaps [20, 30): " << windows.overlaps(20, 30) << std::endl;
+	std::cout << "overlaps [40, 50): " << windows.overlaps(40, 50) << std::endl;
+	windows.erase(ft::make_pair(15, 35));
+	std::cout << "overlaps [20, 30) after erase: " << windows.overlaps(20, 30) << std::endl;
+
+	ft::interval_set<double> ranges;
+	ranges.insert(0.5, 1.5);
+	ranges.insert(2.0, 2.5);
+	std::cout << "set overlaps [1.5, 2.0): " << ranges.overlaps(1.5, 2.0) << std::endl;
+	std::cout << "set find_overlap [1.0, 3.0): [" << ranges.find_overlap(1.0, 3.0)->first
+		<< ", " << ranges.find_overlap(1.0, 3.0)->second << ")" << std::endl;
+
+	test_interval_map<ft::rb_balance>("interval_map rb");
+	test_interval_map<ft::avl_balance>("interval_map avl");
+	test_interval_map<ft::splay_balance>("interval_map splay");
+	std::cout << "------------------------------------" << std::endl;
+}
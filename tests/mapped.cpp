@@ -0,0 +1,160 @@
+#include "extensions.hpp"
+#include <mapped_map.hpp>
+#include <mapped_set.hpp>
+#include <frozen_map.hpp>
+#include <map>
+#include <set>
+#include <cstdlib>
+#include <cstdio>
+#include <vector>
+#include <unistd.h>
+
+struct point
+{
+	double	x;
+	double	y;
+};
+
+/* Every query of a mapped map of about n keys against std::map.*/
+static bool mapped_valid(size_t n, const std::string &path){
+	ft::map<int, point> map;
+	std::map<int, point> ref;
+
+	for (size_t i = 0; i < n; i++){
+		int k = rand() % (4 * n + 1);
+		point p = {(double)i, -(double)k};
+		map[k] = p;
+		ref[k] = p;
+	}
+	ft::mapped_map<int, point>::write(path.c_str(), map);
+	ft::mapped_map<int, point> mapped(path.c_str());
+	bool ok = mapped.size() == ref.size();
+	std::map<int, point>::iterator rit = ref.begin();
+	for (ft::mapped_map<int, point>::iterator it = mapped.begin(); ok && it != mapped.end(); ++it, ++rit)
+		ok = it->first == rit->first && it->second.x == rit->second.x && it->second.y == rit->second.y;
+	std::map<int, point>::reverse_iterator rrit = ref.rbegin();
+	for (ft::mapped_map<int, point>::reverse_iterator it = mapped.rbegin(); ok && it != mapped.rend(); ++it, ++rrit)
+		ok = it->first == rrit->first;
+	for (int q = -1; q <= (int)(4 * n + 1) && ok; q++){
+		std::map<int, point>::iterator lo = ref.lower_bound(q);
+		std::map<int, point>::iterator hi = ref.upper_bound(q);
+		ft::mapped_map<int, point>::iterator mlo = mapped.lower_bound(q);
+		ft::mapped_map<int, point>::iterator mhi = mapped.upper_bound(q);
+		ok = (lo == ref.end()) == (mlo == mapped.end())
+			&& (hi == ref.end()) == (mhi == mapped.end())
+			&& (lo == ref.end() || mlo->first == lo->first)
+			&& (hi == ref.end() || mhi->first == hi->first)
+			&& mapped.count(q) == ref.count(q)
+			&& (!ref.count(q) || mapped.at(q).x == ref[q].x);
+	}
+	return (ok);
+}
+
+void test_mapped(void){
+	std::cout << "==============================" << std::endl;
+	std::cout << "      memory mapped files     " << std::endl;
+	std::cout << "==============================" << std::endl;
+	std::string path = temp_path("mapped_map");
+	std::string set_path = temp_path("mapped_set");
+
+	srand(9);
+	CHECK("mapped map n=0", mapped_valid(0, path));
+	CHECK("mapped map n=1", mapped_valid(1, path));
+	CHECK("mapped map n=1000", mapped_valid(1000, path));
+	CHECK("mapped map n=50000", mapped_valid(50000, path));
+
+	ft::map<int, int> small;
+	for (int i = 0; i < 100; i++)
+		small[i] = i * i;
+	ft::mapped_map<int, int>::write(path.c_str(), small);
+	ft::mapped_map<int, int> before(path.c_str());
+	small[1000] = 1;
+	ft::mapped_map<int, int>::write(path.c_str(), small.freeze());
+	ft::mapped_map<int, int> after(path.c_str());
+	CHECK("rewrite: open views keep the old file", before.size() == 100 && before.at(99) == 9801
+		&& after.size() == 101 && after.at(1000) == 1 && after.at(99) == 9801);
+
+	bool refused = false;
+	try{
+		ft::mapped_map<int, double> wrong(path.c_str());
+	}
+	catch (std::runtime_error &e){
+		refused = true;
+	}
+	bool missing = false;
+	try{
+		ft::mapped_map<int, int> none((path + ".none").c_str());
+	}
+	catch (std::runtime_error &e){
+		missing = true;
+	}
+	CHECK("wrong types and missing files throw", refused && missing);
+
+	ft::set<long> set;
+	std::set<long> ref_set;
+	for (int i = 0; i < 20000; i++){
+		long v = rand() % 100000;
+		set.insert(v);
+		ref_set.insert(v);
+	}
+	ft::mapped_set<long>::write(set_path.c_str(), set);
+	ft::mapped_set<long> mapped_set(set_path.c_str());
+	bool same = mapped_set.size() == ref_set.size()
+		&& ft::equal(mapped_set.begin(), mapped_set.end(), ref_set.begin());
+	for (long q = -1; q < 100001 && same; q += 7)
+		same = mapped_set.count(q) == ref_set.count(q)
+			&& (ref_set.lower_bound(q) == ref_set.end()) == (mapped_set.lower_bound(q) == mapped_set.end());
+	CHECK("mapped set", same);
+
+	bool wrong_kind = false;
+	try{
+		ft::mapped_map<long, long> as_map(set_path.c_str());
+	}
+	catch (std::runtime_error &e){
+		wrong_kind = true;
+	}
+	CHECK("set file opened as a map throws", wrong_kind);
+
+	std::vector<ft::pair<int, int> > unsorted;
+	for (int i = 0; i < 10; i++)
+		unsorted.push_back(ft::make_pair(i == 6 ? 2 : i, i));
+	bool unordered = false;
+	try{
+		ft::mapped_map<int, int>::write(path.c_str(), unsorted.begin(), unsorted.size());
+	}
+	catch (std::invalid_argument &e){
+		unordered = true;
+	}
+	long twice[] = {1, 2, 2, 3};
+	bool duplicate = false;
+	try{
+		ft::mapped_set<long>::write(set_path.c_str(), twice, 4);
+	}
+	catch (std::invalid_argument &e){
+		duplicate = true;
+	}
+	ft::mapped_map<int, int> kept(path.c_str());
+	CHECK("unsorted or repeated keys throw, the old file kept", unordered && duplicate
+		&& kept.size() == 101 && access((path + ".tmp").c_str(), F_OK) != 0);
+
+	// an element count whose sizes overflow back to a header only file
+	ft::mapped_header crafted = ft::mapped_format::describe(sizeof(int),
+		sizeof(ft::pair<const int, int>), ((size_t)1 << 62) - 1);
+	std::string crafted_path = temp_path("mapped_crafted");
+	FILE *file = fopen(crafted_path.c_str(), "w");
+	fwrite(&crafted, sizeof(crafted), 1, file);
+	for (size_t i = sizeof(crafted); i < crafted.bytes; i++)
+		fputc(0, file);
+	fclose(file);
+	bool overflow = false;
+	try{
+		ft::mapped_map<int, int> huge(crafted_path.c_str());
+	}
+	catch (std::runtime_error &e){
+		overflow = true;
+	}
+	CHECK("element count past the file size throws", overflow);
+	unlink(crafted_path.c_str());
+	unlink(path.c_str());
+	unlink(set_path.c_str());
+}
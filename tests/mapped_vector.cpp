@@ -0,0 +1,99 @@
+#include "extensions.hpp"
+#include <mapped_vector.hpp>
+#include <vector>
+#include <cstdlib>
+#include <unistd.h>
+
+struct log_record
+{
+	long	id;
+	double	value;
+	char	tag[16];
+};
+
+/* Random edits against std::vector, checked again after reopening the file.*/
+static bool mapped_vector_random(const std::string &path, int ops){
+	std::vector<int> ref;
+	bool ok;
+	{
+		ft::mapped_vector<int> v(path.c_str());
+		ok = vector_like_random(v, ref, ops, no_check());
+	}
+	ft::mapped_vector<int> v(path.c_str());
+	return (ok && same_elements(v, ref));
+}
+
+static size_t file_size(const std::string &path){
+	struct stat st;
+	return (stat(path.c_str(), &st) == 0 ? st.st_size : 0);
+}
+
+void test_mapped_vector(void){
+	std::cout << "==============================" << std::endl;
+	std::cout << "        mapped vector         " << std::endl;
+	std::cout << "==============================" << std::endl;
+	std::string path = temp_path("mapped_vector");
+
+	srand(48);
+	CHECK("random edits, then reopened", mapped_vector_random(path, 20000));
+	unlink(path.c_str());
+
+	{
+		ft::mapped_vector<log_record> log(path.c_str());
+		for (long i = 0; i < 100000; i++){
+			log_record r = {i, i * 0.5, "append"};
+			log.push_back(r);
+		}
+		log.flush();
+		log.sync();
+		CHECK("append", log.size() == 100000 && log.back().id == 99999 && log.capacity() >= log.size()
+			&& (size_t)&log[0] % 64 == 0);
+	}
+	{
+		ft::mapped_vector<log_record> log(path.c_str());
+		bool ok = log.size() == 100000 && log.at(12345).value == 12345 * 0.5
+			&& std::string(log[99999].tag) == "append" && (log.rbegin())->id == 99999;
+		log_record r = {-1, 0, "more"};
+		log.push_back(r);
+		log.shrink_to_fit();
+		CHECK("reopened, appended, shrunk to fit", ok && log.capacity() == 100001
+			&& file_size(path) == 64 + 100001 * sizeof(log_record) && log.back().id == -1);
+		log.resize(10);
+		log.clear();
+		CHECK("clear keeps the file", log.empty() && log.begin() == log.end() && log.capacity() == 100001);
+	}
+
+	bool refused = false;
+	try{
+		ft::mapped_vector<int> wrong(path.c_str());
+	}
+	catch (std::runtime_error &e){
+		refused = true;
+	}
+	bool missing = false;
+	try{
+		ft::mapped_vector<int> nowhere("/nonexistent/ft_mapped_vector");
+	}
+	catch (std::runtime_error &e){
+		missing = true;
+	}
+	CHECK("wrong type and bad path throw", refused && missing);
+	unlink(path.c_str());
+
+	std::string other = path + ".other";
+	{
+		ft::mapped_vector<int> a(path.c_str());
+		ft::mapped_vector<int> b(other.c_str());
+		a.assign((size_t)3, 7);
+		b.push_back(1);
+		bool ok = b < a && a != b;
+		a.swap(b);
+		CHECK("swap, relational", ok && a.size() == 1 && b.size() == 3 && b.path() == path && b[2] == 7);
+	}
+	{
+		ft::mapped_vector<int> b(path.c_str());
+		CHECK("swapped files persist", b.size() == 3 && b.front() == 7);
+	}
+	unlink(path.c_str());
+	unlink(other.c_str());
+}
@@ -0,0 +1,140 @@
+#include "extensions.hpp"
+#include <paged_map.hpp>
+#include <map>
+#include <cstdlib>
+#include <unistd.h>
+
+struct record
+{
+	long	id;
+	char	name[24];
+};
+
+struct oversized
+{
+	char	bytes[2000];
+};
+
+/* Same elements, in the same order, and the same bounds on a sample of keys.*/
+template <class Map>
+static bool paged_equal(const Map &map, const std::map<int, long> &ref, int range){
+	bool ok = map.size() == ref.size();
+	std::map<int, long>::const_iterator rit = ref.begin();
+	for (typename Map::iterator it = map.begin(); ok && it != map.end(); ++it, ++rit)
+		ok = rit != ref.end() && it->first == rit->first && it->second == rit->second;
+	for (int q = -1; ok && q <= range; q += 13){
+		std::map<int, long>::const_iterator lo = ref.lower_bound(q);
+		std::map<int, long>::const_iterator hi = ref.upper_bound(q);
+		typename Map::iterator mlo = map.lower_bound(q);
+		typename Map::iterator mhi = map.upper_bound(q);
+		ok = (lo == ref.end() ? mlo == map.end() : mlo != map.end() && mlo->first == lo->first)
+			&& (hi == ref.end() ? mhi == map.end() : mhi != map.end() && mhi->first == hi->first)
+			&& map.count(q) == ref.count(q);
+	}
+	return (ok);
+}
+
+/* Random inserts, assignments and erases through a pool of min_frames pages.*/
+static bool paged_random(const std::string &path, int ops, int range){
+	ft::paged_map<int, long> map(path.c_str(), 0);
+	std::map<int, long> ref;
+	bool ok = true;
+
+	for (int i = 0; i < ops && ok; i++){
+		int k = rand() % range;
+		switch (rand() % 4){
+			case 0:
+			case 1:
+				ok = map.insert(ft::make_pair(k, (long)i)).second == ref.insert(std::make_pair(k, (long)i)).second;
+				break;
+			case 2:
+				map.insert_or_assign(k, -i);
+				ref[k] = -i;
+				break;
+			default:
+				ok = map.erase(k) == ref.erase(k);
+		}
+	}
+	return (ok && paged_equal(map, ref, range));
+}
+
+void test_paged(void){
+	std::cout << "==============================" << std::endl;
+	std::cout << "           paged map          " << std::endl;
+	std::cout << "==============================" << std::endl;
+	std::string path = temp_path("paged_map");
+
+	srand(11);
+	CHECK("random operations, small range", paged_random(path, 20000, 500));
+	unlink(path.c_str());
+	CHECK("random operations, 16 frame pool", paged_random(path, 200000, 100000));
+	unlink(path.c_str());
+
+	std::map<int, long> ref;
+	{
+		ft::paged_map<int, long> map(path.c_str(), 0, 2);
+		for (int i = 0; i < 100000; i++){
+			int k = rand() % 1000000;
+			map.insert(ft::make_pair(k, (long)k * 3));
+			ref.insert(std::make_pair(k, (long)k * 3));
+		}
+		CHECK("misses once the tree outgrows the pool", map.pool().misses() > 0 && map.pool().writes() > 0);
+	}
+	{
+		ft::paged_map<int, long> map(path.c_str(), 1 << 20);
+		CHECK("reopened file", paged_equal(map, ref, 1000000));
+		int k = ref.begin()->first;
+		bool thrown = false;
+		try{
+			map.at(-1);
+		}
+		catch (std::out_of_range &e){
+			thrown = true;
+		}
+		CHECK("at", map.at(k) == (long)k * 3 && thrown);
+
+		size_t pages = map.pool().head().pages;
+		for (std::map<int, long>::iterator it = ref.begin(); it != ref.end(); ++it)
+			map.erase(it->first);
+		bool emptied = map.empty() && map.begin() == map.end() && map.find(k) == map.end();
+		std::map<int, long> half;
+		for (std::map<int, long>::iterator it = ref.begin(); it != ref.end(); ++it)
+			if (it->first % 2)
+				half.insert(*it);
+		for (std::map<int, long>::iterator it = half.begin(); it != half.end(); ++it)
+			map.insert(ft::make_pair(it->first, it->second));
+		CHECK("erase all, then freed pages are reused", emptied
+			&& map.pool().head().pages == pages && paged_equal(map, half, 1000000));
+		map.clear();
+		CHECK("clear", map.empty() && map.begin() == map.end() && map.pool().head().pages == 1);
+	}
+	unlink(path.c_str());
+
+	{
+		ft::paged_map<int, record> records(path.c_str());
+		for (long i = 0; i < 5000; i++){
+			record r = {i * 7 % 5000, "record"};
+			records.insert_or_assign((int)r.id, r);
+		}
+		ft::paged_map<int, record>::iterator it = records.find(4999);
+		CHECK("struct values", records.size() == 5000 && it != records.end()
+			&& it->second.id == 4999 && std::string(it->second.name) == "record");
+	}
+	bool refused = false;
+	try{
+		ft::paged_map<int, long> wrong(path.c_str());
+	}
+	catch (std::runtime_error &e){
+		refused = true;
+	}
+	bool too_large = false;
+	try{
+		ft::paged_map<int, oversized> large((path + ".large").c_str());
+	}
+	catch (std::length_error &e){
+		too_large = true;
+	}
+	CHECK("wrong types and oversized values throw", refused && too_large);
+	unlink(path.c_str());
+	unlink((path + ".large").c_str());
+}
@@ -0,0 +1,168 @@
+#include "extensions.hpp"
+#include <map>
+#include <set>
+#include <cstdlib>
+
+typedef ft::Node<int> int_node;
+
+/* checks links and order, returns the number of real nodes */
+static int check_links(const int_node *node, const int *low, const int *high, bool &ok){
+	if (ft::Rbtree<int, std::less<int> >::is_null_leaf(node))
+		return (0);
+	if ((low && *node->data <= *low) || (high && *node->data >= *high))
+		ok = false;
+	if (node->left->parent != node || node->right->parent != node)
+		ok = false;
+	return (check_links(node->left, low, node->data, ok) + 1
+		+ check_links(node->right, node->data, high, ok));
+}
+
+/* black height, or -1 on a red-black violation */
+static int check_rb(const int_node *node){
+	if (ft::Rbtree<int, std::less<int> >::is_null_leaf(node))
+		return (node->color == BLACK ? 1 : -1);
+	if (node->color == RED && (node->left->color == RED || node->right->color == RED))
+		return (-1);
+	int left = check_rb(node->left);
+	int right = check_rb(node->right);
+	if (left < 0 || left != right)
+		return (-1);
+	return (left + (node->color == BLACK));
+}
+
+/* height, or -1 on an AVL violation */
+static int check_avl(const int_node *node){
+	if (ft::Rbtree<int, std::less<int> >::is_null_leaf(node))
+		return (node->color == 0 ? 0 : -1);
+	int left = check_avl(node->left);
+	int right = check_avl(node->right);
+	if (left < 0 || right < 0 || left - right > 1 || right - left > 1)
+		return (-1);
+	int height = (left > right ? left : right) + 1;
+	return (node->color == height ? height : -1);
+}
+
+/* true when every rank difference is 1 or 2 and leaves have rank 1 */
+static bool check_wavl(const int_node *node){
+	if (ft::Rbtree<int, std::less<int> >::is_null_leaf(node))
+		return (node->color == 0);
+	int left = node->color - node->left->color;
+	int right = node->color - node->right->color;
+	if (left < 1 || left > 2 || right < 1 || right > 2)
+		return (false);
+	if (ft::Rbtree<int, std::less<int> >::is_null_leaf(node->left)
+		&& ft::Rbtree<int, std::less<int> >::is_null_leaf(node->right) && node->color != 1)
+		return (false);
+	return (check_wavl(node->left) && check_wavl(node->right));
+}
+
+static bool check_policy(const int_node *root, ft::rb_balance){
+	return (root->color == BLACK && check_rb(root) >= 0);
+}
+static bool check_policy(const int_node *root, ft::avl_balance){
+	return (check_avl(root) >= 0);
+}
+static bool check_policy(const int_node *root, ft::wavl_balance){
+	return (check_wavl(root));
+}
+static bool check_policy(const int_node *, ft::splay_balance){
+	return (true);
+}
+
+/* Builds trees of every size up to 300, and a large one on 4 threads.*/
+template <class Policy>
+static bool build_valid(void){
+	typedef ft::Rbtree<int, std::less<int>, std::allocator<int>,
+		std::allocator<int_node>, Policy> tree_type;
+	ft::vector<int> values;
+	ft::vector<const int *> sorted;
+	bool ok = true;
+
+	for (int i = 0; i < 20000; i++)
+		values.push_back(i * 3);
+	for (int i = 0; i < 20000; i++)
+		sorted.push_back(&values[i]);
+	for (int n = 1; n <= 300 && ok; n++){
+		tree_type tree;
+		tree.build(&sorted[0], n, 1);
+		ok = check_links(tree.get_root(), NULL, NULL, ok) == n && check_policy(tree.get_root(), Policy());
+	}
+	tree_type tree;
+	tree.build(&sorted[0], 20000, 4);
+	ok = ok && check_links(tree.get_root(), NULL, NULL, ok) == 20000 && check_policy(tree.get_root(), Policy());
+	for (int i = 0; i < 20000 && ok; i += 7){
+		tree.delete_value(values[i]);
+		tree.insert_value(values[i] + 1);
+	}
+	return (ok && check_policy(tree.get_root(), Policy()));
+}
+
+void test_parallel(void){
+	std::cout << "==============================" << std::endl;
+	std::cout << "      parallel construction   " << std::endl;
+	std::cout << "==============================" << std::endl;
+	CHECK("parallel build rb", build_valid<ft::rb_balance>());
+	CHECK("parallel build avl", build_valid<ft::avl_balance>());
+	CHECK("parallel build wavl", build_valid<ft::wavl_balance>());
+	CHECK("parallel build splay", build_valid<ft::splay_balance>());
+
+	ft::vector<ft::pair<int, int> > input;
+	srand(7);
+	for (int i = 0; i < 100000; i++)
+		input.push_back(ft::make_pair(rand() % 50000, i));
+	std::map<int, int> ref;
+	for (size_t i = 0; i < input.size(); i++)
+		ref.insert(std::make_pair(input[i].first, input[i].second));
+
+	bool same = true;
+	for (size_t threads = 1; threads <= 8; threads *= 2){
+		ft::map<int, int> map(input.begin(), input.end(), ft::parallel(threads));
+		ft::map<int, int>::iterator it = map.begin();
+		std::map<int, int>::iterator rit = ref.begin();
+		for (; it != map.end() && rit != ref.end(); ++it, ++rit)
+			same = same && it->first == rit->first && it->second == rit->second;
+		same = same && it == map.end() && rit == ref.end() && map.size() == ref.size();
+	}
+	CHECK("parallel map, first of duplicates kept", same);
+
+	ft::map<int, int> map(input.begin(), input.end(), ft::parallel(4));
+	for (int k = 0; k < 50000; k += 3){
+		map.erase(k);
+		ref.erase(k);
+		map[k + 50000] = k;
+		ref[k + 50000] = k;
+	}
+	same = map.size() == ref.size();
+	std::map<int, int>::iterator rit = ref.begin();
+	for (ft::map<int, int>::iterator it = map.begin(); it != map.end() && same; ++it, ++rit)
+		same = it->first == rit->first && it->second == rit->second;
+	CHECK("parallel map updates after build", same);
+
+	ft::map<int, int, std::less<int>, std::allocator<ft::pair<const int, int> >,
+		ft::rb_balance, ft::sum_monoid<long> > sums(input.begin(), input.end(), ft::parallel(4));
+	long expected = 0;
+	long expected_range = 0;
+	for (ft::map<int, int>::iterator it = sums.begin(); it != sums.end(); ++it){
+		expected += it->second;
+		if (it->first >= 1000 && it->first < 30000)
+			expected_range += it->second;
+	}
+	CHECK("parallel map aggregates", sums.aggregate() == expected
+		&& sums.aggregate(1000, 30000) == expected_range);
+
+	ft::vector<int> keys;
+	std::set<int> ref_set;
+	for (int i = 0; i < 50000; i++){
+		keys.push_back(rand() % 20000);
+		ref_set.insert(keys.back());
+	}
+	ft::set<int> set(keys.begin(), keys.end(), ft::parallel(4));
+	same = set.size() == ref_set.size() && ft::equal(set.begin(), set.end(), ref_set.begin());
+	CHECK("parallel set", same);
+
+	ft::vector<int> none;
+	ft::map<int, int> empty(input.begin(), input.begin(), ft::parallel(2));
+	ft::set<int> empty_set(none.begin(), none.end(), ft::parallel(2));
+	std::cout << "empty builds: " << empty.size() << " " << empty_set.size()
+		<< ", begin == end: " << (empty.begin() == empty.end()) << std::endl;
+}
@@ -0,0 +1,135 @@
+#include "extensions.hpp"
+#include <persistent_map.hpp>
+#include <map>
+#include <vector>
+#include <cmath>
+#include <cstdlib>
+
+static long g_live_nodes = 0;
+static long g_allocated_nodes = 0;
+
+/* std::allocator keeping track of the live nodes.*/
+template <class T>
+struct node_counter : public std::allocator<T>
+{
+	template <class U>
+	struct rebind { typedef node_counter<U> other; };
+
+	node_counter() {}
+	node_counter(const node_counter &src) : std::allocator<T>(src) {}
+	template <class U>
+	node_counter(const node_counter<U> &src) : std::allocator<T>(src) {}
+
+	T *allocate(size_t n, const void * = 0){
+		g_live_nodes += n;
+		g_allocated_nodes += n;
+		return (std::allocator<T>::allocate(n));
+	}
+	void deallocate(T *p, size_t n){
+		g_live_nodes -= n;
+		std::allocator<T>::deallocate(p, n);
+	}
+};
+
+typedef ft::persistent_map<int, int, std::less<int>,
+	node_counter<ft::pair<const int, int> > > pmap;
+
+static bool same(const pmap &map, const std::map<int, int> &ref){
+	if (map.size() != ref.size())
+		return (false);
+	std::map<int, int>::const_iterator it = ref.begin();
+	for (pmap::iterator pit = map.begin(); pit != map.end(); ++pit, ++it)
+		if (pit->first != it->first || pit->second != it->second)
+			return (false);
+	std::map<int, int>::const_reverse_iterator rit = ref.rbegin();
+	for (pmap::reverse_iterator pit = map.rbegin(); pit != map.rend(); ++pit, ++rit)
+		if (pit->first != rit->first)
+			return (false);
+	return (true);
+}
+
+static void test_persistent_versions(void){
+	std::vector<pmap> versions;
+	std::vector<std::map<int, int> > expected;
+	bool ok = true;
+	bool bounds = true;
+	bool balanced = true;
+	bool path_only = true;
+	{
+		pmap map;
+		std::map<int, int> ref;
+
+		srand(17);
+		for (int i = 0; i < 6000; i++){
+			int k = rand() % 1500;
+			long before = g_allocated_nodes;
+			switch (rand() % 4){
+				case 0:
+				case 1:
+					map.insert(ft::make_pair(k, i));
+					ref.insert(std::make_pair(k, i));
+					break;
+				case 2:
+					map.set(k, -i);
+					ref[k] = -i;
+					break;
+				default:
+					if (map.erase(k) != ref.erase(k))
+						ok = false;
+			}
+			// a path and the nodes of at most two rotations per level
+			if (g_allocated_nodes - before > 3 * (map.height() + 2))
+				path_only = false;
+			if (map.height() > 1.45 * std::log(map.size() + 2.0) / std::log(2.0))
+				balanced = false;
+			std::map<int, int>::iterator lo = ref.lower_bound(k);
+			pmap::iterator plo = map.lower_bound(k);
+			std::map<int, int>::iterator hi = ref.upper_bound(k);
+			pmap::iterator phi = map.upper_bound(k);
+			if ((lo == ref.end()) != (plo == map.end()) || (lo != ref.end() && plo->first != lo->first)
+				|| (hi == ref.end()) != (phi == map.end()) || (hi != ref.end() && phi->first != hi->first)
+				|| map.count(k) != ref.count(k))
+				bounds = false;
+			if (i % 500 == 0){
+				versions.push_back(map.snapshot());
+				expected.push_back(ref);
+			}
+		}
+		ok = ok && same(map, ref);
+		map.erase(map.lower_bound(100), map.upper_bound(900));
+		ref.erase(ref.lower_bound(100), ref.upper_bound(900));
+		ok = ok && same(map, ref);
+	}
+	bool snapshots = true;
+	for (size_t i = 0; i < versions.size(); i++)
+		snapshots = snapshots && same(versions[i], expected[i]);
+	CHECK("persistent random ops", ok);
+	CHECK("persistent bounds", bounds);
+	CHECK("persistent balanced", balanced);
+	CHECK("persistent O(log n) nodes per update", path_only);
+	CHECK("persistent snapshots unchanged", snapshots);
+	versions.clear();
+	CHECK("persistent no leak", g_live_nodes == 0);
+}
+
+void test_persistent(void){
+	std::cout << "==============================" << std::endl;
+	std::cout << "        persistent map        " << std::endl;
+	std::cout << "==============================" << std::endl;
+	ft::persistent_map<std::string, int> prices;
+	prices.set("apple", 3);
+	prices.set("pear", 4);
+	ft::persistent_map<std::string, int> monday = prices.snapshot();
+	prices.set("apple", 5);
+	prices.erase("pear");
+	prices.insert(ft::make_pair(std::string("plum"), 2));
+	std::cout << "monday:";
+	for (ft::persistent_map<std::string, int>::iterator it = monday.begin(); it != monday.end(); ++it)
+		std::cout << " " << it->first << "=" << it->second;
+	std::cout << std::endl << "now:";
+	for (ft::persistent_map<std::string, int>::iterator it = prices.begin(); it != prices.end(); ++it)
+		std::cout << " " << it->first << "=" << it->second;
+	std::cout << std::endl;
+
+	test_persistent_versions();
+}
@@ -0,0 +1,106 @@
+#include "extensions.hpp"
+#include <vector.hpp>
+#include <small_vector.hpp>
+#include <vm_vector.hpp>
+#include <cow_vector.hpp>
+
+struct sample
+{
+	int		id;
+	double	weight;
+
+	bool operator==(const sample &other) const{
+		return (id == other.id && weight == other.weight);
+	}
+};
+
+/* Counts its live instances, to check the element by element paths.*/
+struct counted
+{
+	static long	live;
+	int			value;
+
+	counted(int v = 0) : value(v) { live++; }
+	counted(const counted &src) : value(src.value) { live++; }
+	~counted(void) { live--; }
+	counted &operator=(const counted &other) { value = other.value; return (*this); }
+};
+
+long counted::live = 0;
+
+template <class T>
+static bool all_equal(const ft::vector<T> &v, size_t n, const T &val){
+	bool ok = v.size() == n;
+	for (size_t i = 0; ok && i < n; i++)
+		ok = v[i] == val;
+	return (ok);
+}
+
+/* assign(n, v[i]): val is one of the elements the assignment destroys.*/
+template <class Vector>
+static bool assign_own_element(Vector v){
+	std::string y(100, 'y');
+
+	v.push_back(std::string(100, 'x'));
+	v.push_back(y);
+	v.assign(3, v[1]);
+	return (v.size() == 3 && v[0] == y && v[2] == y);
+}
+
+void test_relocation(void){
+	std::cout << "==============================" << std::endl;
+	std::cout << "   trivially relocatable types" << std::endl;
+	std::cout << "==============================" << std::endl;
+	CHECK("traits of trivial types", ft::is_trivially_copyable<int>::value
+		&& ft::is_trivially_copyable<sample>::value && ft::is_trivially_destructible<sample>::value
+		&& ft::is_trivially_relocatable<sample *>::value);
+	bool owning = !ft::is_trivially_copyable<std::string>::value
+		&& !ft::is_trivially_relocatable<counted>::value && !ft::is_trivially_destructible<counted>::value
+		&& ft::is_trivially_relocatable<ft::vector<int> >::value;
+	typedef ft::pair<int, ft::vector<int> > relocatable_pair;
+	typedef ft::pair<int, counted> copied_pair;
+	owning = owning && ft::is_trivially_relocatable<relocatable_pair>::value
+		&& !ft::is_trivially_relocatable<copied_pair>::value;
+	CHECK("traits of owning types", owning);
+
+	ft::vector<int> zeros(1000);
+	ft::vector<int> sevens(1000, 7);
+	ft::vector<char> chars(1000, 'x');
+	sample s = {3, 0.5};
+	ft::vector<sample> samples(1000, s);
+	CHECK("fill", all_equal(zeros, 1000, 0) && all_equal(sevens, 1000, 7)
+		&& all_equal(chars, 1000, 'x') && all_equal(samples, 1000, s));
+	sevens.resize(3000, -1);
+	ft::vector<int> copy(sevens);
+	zeros = sevens;
+	samples.assign(10, sample());
+	bool ok = copy == sevens && zeros == sevens && copy[999] == 7 && copy[1000] == -1
+		&& copy[2999] == -1 && all_equal(samples, 10, sample());
+	CHECK("resize, copy, operator= and assign", ok);
+
+	ft::vector<ft::vector<int> > nested;
+	for (int i = 0; i < 1000; i++)
+		nested.push_back(ft::vector<int>(i % 7 + 1, i));
+	nested.reserve(5000);
+	ok = nested.size() == 1000;
+	for (int i = 0; ok && i < 1000; i++)
+		ok = nested[i].size() == (size_t)(i % 7 + 1) && nested[i].back() == i;
+	ft::vector<ft::vector<int> > nested_copy(nested);
+	nested.clear();
+	CHECK("vectors of vectors move their buffers", ok && nested_copy[999][0] == 999);
+
+	{
+		ft::vector<counted> values(100, counted(1));
+		for (int i = 0; i < 1000; i++)
+			values.push_back(counted(i));
+		ft::vector<counted> other(values);
+		other.assign(50, counted(2));
+		values.resize(10);
+		ok = counted::live == 60 && values[9].value == 1 && other[49].value == 2;
+	}
+	CHECK("other types still construct and destroy each element", ok && counted::live == 0);
+	CHECK("assign from one of the elements", assign_own_element(ft::vector<std::string>())
+		&& assign_own_element(ft::small_vector<std::string, 1>())
+		&& assign_own_element(ft::vm_vector<std::string>())
+		&& assign_own_element(ft::cow_vector<std::string>()));
+}
@@ -0,0 +1,185 @@
+#include "extensions.hpp"
+#include <concurrent_skiplist_map.hpp>
+#include <concurrent_skiplist_set.hpp>
+#include <pthread.h>
+#include <cstdlib>
+#include <map>
+
+typedef ft::concurrent_skiplist_map<int, int> smap;
+
+struct worker
+{
+	smap	*map;
+	int		id;
+	bool	ok;
+};
+
+/* Writers own the keys k with k % 4 == id: insert them all, erase half, twice.*/
+static void *churn_keys(void *arg){
+	worker *w = static_cast<worker *>(arg);
+
+	for (int round = 0; round < 2; round++){
+		for (int k = w->id; k < 8000; k += 4)
+			w->map->insert(ft::make_pair(k, k * 10));
+		for (int k = w->id; k < 8000; k += 8)
+			if (w->map->erase(k) != 1)
+				w->ok = false;
+	}
+	return (NULL);
+}
+
+/* Readers iterate while the writers run: keys strictly increase, values match.*/
+static void *scan_keys(void *arg){
+	worker *w = static_cast<worker *>(arg);
+
+	for (int i = 0; i < 50; i++){
+		ft::epoch::guard guard;
+		int prev = -1;
+		for (smap::iterator it = w->map->begin(); it != w->map->end(); ++it){
+			if (it->first <= prev || it->second != it->first * 10)
+				w->ok = false;
+			prev = it->first;
+		}
+		smap::iterator it = w->map->lower_bound(i * 100 + 1);
+		if (it != w->map->end() && it->first <= i * 100)
+			w->ok = false;
+	}
+	return (NULL);
+}
+
+typedef ft::concurrent_skiplist_set<int> iset;
+
+struct racer
+{
+	iset	*set;
+	int		role;	// 0 inserts, 1 erases, 2 scans
+	long	done;	// inserts or erases that took effect
+	bool	ok;
+};
+
+/*
+Inserts, erases or scans the same few keys over and over: erases land while
+the upper levels of the nodes are still being linked.
+*/
+static void *race_keys(void *arg){
+	racer *r = static_cast<racer *>(arg);
+
+	for (int round = 0; round < 3000; round++){
+		if (r->role == 2){
+			ft::epoch::guard guard;
+			int prev = -1;
+			for (iset::iterator it = r->set->begin(); it != r->set->end(); ++it){
+				r->ok = r->ok && *it > prev && *it < 32;
+				prev = *it;
+			}
+			continue;
+		}
+		for (int k = 0; k < 32; k++)
+			r->done += r->role ? r->set->erase(k) : r->set->insert(k);
+	}
+	return (NULL);
+}
+
+static bool race_insert_erase(void){
+	iset set;
+	pthread_t threads[6];
+	racer racers[6];
+	for (int i = 0; i < 6; i++){
+		racers[i].set = &set;
+		racers[i].role = i % 3;
+		racers[i].done = 0;
+		racers[i].ok = true;
+		pthread_create(&threads[i], NULL, &race_keys, &racers[i]);
+	}
+	long inserted = 0;
+	long erased = 0;
+	bool ok = true;
+	for (int i = 0; i < 6; i++){
+		pthread_join(threads[i], NULL);
+		(racers[i].role ? erased : inserted) += racers[i].done;
+		ok = ok && racers[i].ok;
+	}
+	ft::epoch::guard guard;
+	size_t found = 0;
+	for (iset::iterator it = set.begin(); it != set.end(); ++it)
+		found++;
+	return (ok && inserted - erased == (long)set.size() && found == set.size());
+}
+
+void test_skiplist(void){
+	std::cout << "==============================" << std::endl;
+	std::cout << "      concurrent skiplist     " << std::endl;
+	std::cout << "==============================" << std::endl;
+	smap map;
+	std::map<int, int> ref;
+	bool same = true;
+
+	srand(42);
+	for (int i = 0; i < 20000; i++){
+		int k = rand() % 2000;
+		if (rand() % 3)
+			same = same && map.insert(ft::make_pair(k, k)) == ref.insert(std::make_pair(k, k)).second;
+		else
+			same = same && map.erase(k) == ref.erase(k);
+	}
+	CHECK("skiplist insert / erase", same && map.size() == ref.size());
+
+	{
+		ft::epoch::guard guard;
+		smap::iterator it = map.begin();
+		std::map<int, int>::iterator rit = ref.begin();
+		for (; it != map.end() && rit != ref.end(); ++it, ++rit)
+			same = same && it->first == rit->first && it->second == rit->second;
+		CHECK("skiplist ordered iteration", same && it == map.end() && rit == ref.end());
+
+		bool bounds = true;
+		for (int k = -1; k <= 2001; k += 7){
+			smap::iterator lb = map.lower_bound(k);
+			smap::iterator ub = map.upper_bound(k);
+			std::map<int, int>::iterator rlb = ref.lower_bound(k);
+			std::map<int, int>::iterator rub = ref.upper_bound(k);
+			bounds = bounds && (lb == map.end() ? rlb == ref.end() : lb->first == rlb->first);
+			bounds = bounds && (ub == map.end() ? rub == ref.end() : ub->first == rub->first);
+			bounds = bounds && (map.find(k) != map.end()) == (ref.count(k) == 1);
+		}
+		CHECK("skiplist lower_bound / upper_bound / find", bounds);
+	}
+
+	int value = -1;
+	std::cout << "find 5: " << map.find(5, value) << " " << value << ", count 5: " << map.count(5) << std::endl;
+
+	ft::concurrent_skiplist_set<std::string> words;
+	words.insert("pear");
+	words.insert("apple");
+	words.insert("fig");
+	words.insert("apple");
+	words.erase("fig");
+	{
+		ft::epoch::guard guard;
+		for (ft::concurrent_skiplist_set<std::string>::iterator it = words.begin(); it != words.end(); ++it)
+			std::cout << *it << " ";
+		std::cout << "(" << words.size() << ")" << std::endl;
+	}
+
+	smap shared;
+	pthread_t threads[6];
+	worker workers[6];
+	for (int i = 0; i < 6; i++){
+		workers[i].map = &shared;
+		workers[i].id = i;
+		workers[i].ok = true;
+		pthread_create(&threads[i], NULL, i < 4 ? &churn_keys : &scan_keys, &workers[i]);
+	}
+	for (int i = 0; i < 6; i++)
+		pthread_join(threads[i], NULL);
+
+	bool contents = true;
+	for (int k = 0; k < 8000; k++)
+		contents = contents && shared.count(k) == (size_t)(k % 8 >= 4);
+	bool ok = true;
+	for (int i = 0; i < 6; i++)
+		ok = ok && workers[i].ok;
+	CHECK("skiplist concurrent writers and readers", ok);
+	CHECK("skiplist concurrent final contents", contents && shared.size() == 4000);
+	CHECK("skiplist insert racing erase of the same keys", race_insert_erase());
+}
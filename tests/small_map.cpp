@@ -0,0 +1,166 @@
+#include "extensions.hpp"
+#include <small_map.hpp>
+#include <small_set.hpp>
+#include <map>
+#include <set>
+#include <cstdlib>
+
+static long g_allocations = 0;
+
+/* std::allocator counting the allocations, to check the inline storage.*/
+template <class T>
+struct counting_allocator : public std::allocator<T>
+{
+	template <class U>
+	struct rebind { typedef counting_allocator<U> other; };
+
+	counting_allocator() {}
+	counting_allocator(const counting_allocator &src) : std::allocator<T>(src) {}
+	template <class U>
+	counting_allocator(const counting_allocator<U> &src) : std::allocator<T>(src) {}
+
+	T *allocate(size_t n, const void * = 0){
+		g_allocations++;
+		return (std::allocator<T>::allocate(n));
+	}
+};
+
+template <class Small, class Ref>
+static bool same(const Small &small, const Ref &ref){
+	if (small.size() != ref.size())
+		return (false);
+	typename Ref::const_iterator it = ref.begin();
+	for (typename Small::iterator sit = small.begin(); sit != small.end(); ++sit, ++it)
+		if (sit->first != it->first || sit->second != it->second)
+			return (false);
+	typename Ref::const_reverse_iterator rit = ref.rbegin();
+	for (typename Small::reverse_iterator sit = small.rbegin(); sit != small.rend(); ++sit, ++rit)
+		if (sit->first != rit->first)
+			return (false);
+	return (true);
+}
+
+static void test_small_random(void){
+	typedef ft::small_map<int, int, 6> small_type;
+	small_type map;
+	std::map<int, int> ref;
+	bool ok = true;
+	bool bounds = true;
+
+	srand(5);
+	for (int i = 0; i < 5000 && ok; i++){
+		int k = rand() % 20;
+		switch (rand() % 5){
+			case 0:
+			case 1:
+				map.insert(ft::make_pair(k, i));
+				ref.insert(std::make_pair(k, i));
+				break;
+			case 2:
+				map[k] = i;
+				ref[k] = i;
+				break;
+			case 3:
+				if (map.erase(k) != ref.erase(k))
+					ok = false;
+				break;
+			default:
+				if (rand() % 8 == 0){
+					map.erase(map.lower_bound(k), map.upper_bound(k + 4));
+					ref.erase(ref.lower_bound(k), ref.upper_bound(k + 4));
+				}
+		}
+		ok = ok && same(map, ref);
+		std::map<int, int>::iterator lo = ref.lower_bound(k);
+		small_type::iterator slo = map.lower_bound(k);
+		if ((lo == ref.end()) != (slo == map.end()) || (slo != map.end() && slo->first != lo->first))
+			bounds = false;
+		if (map.count(k) != ref.count(k))
+			bounds = false;
+		if ((map.is_inline() && map.size() > 6) || (map.empty() && !map.is_inline()))
+			ok = false;
+	}
+	CHECK("small_map random ops", ok);
+	CHECK("small_map bounds", bounds);
+}
+
+static void test_small_spill(void){
+	typedef ft::small_map<int, std::string, 4, std::less<int>,
+		counting_allocator<ft::pair<const int, std::string> > > small_type;
+	small_type map;
+
+	g_allocations = 0;
+	for (int i = 4; i > 0; i--)
+		map[i * 10] = "inline";
+	CHECK("no allocation up to N", g_allocations == 0 && map.is_inline() && map.size() == 4);
+	map.insert(ft::make_pair(25, std::string("spill")));
+	CHECK("spills past N", g_allocations > 0 && !map.is_inline() && map.size() == 5);
+	CHECK("order kept through the spill", map.begin()->first == 10 && (--map.end())->first == 40
+		&& map.find(25)->second == "spill");
+
+	small_type copy(map);
+	small_type other;
+	other[1] = "one";
+	other.swap(copy);
+	CHECK("swap inline / spilled", other == map && copy.size() == 1 && copy.is_inline()
+		&& copy.at(1) == "one" && !other.is_inline());
+	CHECK("relational", copy < map && map != copy);
+
+	map.clear();
+	g_allocations = 0;
+	map[7] = "again";
+	CHECK("inline again after clear", map.is_inline() && g_allocations == 0);
+}
+
+static void test_small_set(void){
+	ft::small_set<int, 5> set;
+	std::set<int> ref;
+	bool ok = true;
+
+	srand(9);
+	for (int i = 0; i < 3000 && ok; i++){
+		int v = rand() % 16;
+		if (rand() % 3)
+			ok = set.insert(v).second == ref.insert(v).second;
+		else
+			ok = set.erase(v) == ref.erase(v);
+		ok = ok && set.size() == ref.size() && (!set.is_inline() || set.size() <= 5);
+		std::set<int>::iterator rit = ref.begin();
+		for (ft::small_set<int, 5>::iterator it = set.begin(); ok && it != set.end(); ++it, ++rit)
+			ok = *it == *rit;
+	}
+	CHECK("small_set random ops", ok);
+
+	ft::small_set<int, 5> a;
+	ft::small_set<int, 5> b;
+	for (int i = 0; i < 3; i++)
+		a.insert(i);
+	for (int i = 10; i < 14; i++)
+		b.insert(i);
+	a.swap(b);
+	CHECK("small_set swap inline", a.size() == 4 && *a.begin() == 10 && b.size() == 3 && *b.rbegin() == 2);
+}
+
+void test_small_map(void){
+	std::cout << "==============================" << std::endl;
+	std::cout << "          small map           " << std::endl;
+	std::cout << "==============================" << std::endl;
+	ft::small_map<std::string, int, 4> words;
+	words["delta"] = 4;
+	words["alpha"] = 1;
+	words["charlie"] = 3;
+	words["bravo"] = 2;
+	std::cout << "inline:";
+	for (ft::small_map<std::string, int, 4>::iterator it = words.begin(); it != words.end(); ++it)
+		std::cout << " " << it->first << "=" << it->second;
+	std::cout << " (" << (words.is_inline() ? "inline" : "tree") << ")" << std::endl;
+	words["echo"] = 5;
+	std::cout << "spilled:";
+	for (ft::small_map<std::string, int, 4>::reverse_iterator it = words.rbegin(); it != words.rend(); ++it)
+		std::cout << " " << it->first;
+	std::cout << " (" << (words.is_inline() ? "inline" : "tree") << ")" << std::endl;
+
+	test_small_random();
+	test_small_spill();
+	test_small_set();
+}
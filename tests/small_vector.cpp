@@ -0,0 +1,132 @@
+#include "extensions.hpp"
+#include <small_vector.hpp>
+#include <stack.hpp>
+#include <vector>
+#include <cstdlib>
+
+namespace
+{
+	long g_allocations = 0;
+
+	/* std::allocator counting the allocations, to check the inline storage.*/
+	template <class T>
+	struct counting_allocator : public std::allocator<T>
+	{
+		template <class U>
+		struct rebind { typedef counting_allocator<U> other; };
+
+		counting_allocator() {}
+		counting_allocator(const counting_allocator &src) : std::allocator<T>(src) {}
+		template <class U>
+		counting_allocator(const counting_allocator<U> &src) : std::allocator<T>(src) {}
+
+		T *allocate(size_t n, const void * = 0){
+			g_allocations++;
+			return (std::allocator<T>::allocate(n));
+		}
+	};
+}
+
+/*
+Inline exactly when the capacity is N, reverse iteration included; the
+size stays around N, shrink_to_fit() bringing it back inline.
+*/
+struct small_inline
+{
+	template <class Small>
+	bool operator()(Small &v, std::vector<typename Small::value_type> &ref) const {
+		if (ref.size() > 3 * Small::inline_capacity)
+			v.resize(Small::inline_capacity / 2), ref.resize(v.size());
+		if (rand() % 8 == 0)
+			v.shrink_to_fit();
+		typename std::vector<typename Small::value_type>::const_reverse_iterator rit = ref.rbegin();
+		for (typename Small::const_reverse_iterator it = v.rbegin(); it != v.rend(); ++it, ++rit)
+			if (*it != *rit)
+				return (false);
+		return (v.is_inline() == (v.capacity() == Small::inline_capacity));
+	}
+};
+
+/* Random operations on strings, growing past N and shrinking back.*/
+static bool small_random(int ops){
+	ft::small_vector<std::string, 4> v;
+	std::vector<std::string> ref;
+
+	return (vector_like_random(v, ref, ops, small_inline()));
+}
+
+static void small_copies(void){
+	typedef ft::small_vector<std::string, 3> small_type;
+	small_type inl;
+	small_type heap;
+	for (int i = 0; i < 2; i++)
+		inl.push_back(std::string(i + 1, 'i'));
+	for (int i = 0; i < 7; i++)
+		heap.push_back(std::string(i + 1, 'h'));
+	small_type inl_copy(inl);
+	small_type heap_copy(heap);
+	CHECK("copies", inl_copy == inl && inl_copy.is_inline() && heap_copy == heap && !heap_copy.is_inline());
+
+	small_type a(inl);
+	small_type b(heap);
+	a.swap(b);
+	bool ok = a == heap && !a.is_inline() && b == inl && b.is_inline();
+	small_type c(inl);
+	c.pop_back();
+	ft::swap(b, c);
+	ok = ok && b.size() == 1 && c == inl && b.is_inline() && c.is_inline();
+	a.swap(heap_copy);
+	ok = ok && a == heap && heap_copy == heap;
+	CHECK("swap inline / heap", ok);
+
+	small_type d;
+	d = heap;
+	ok = d == heap && !d.is_inline();
+	d = inl;
+	ok = ok && d == inl && !d.is_inline();
+	d.shrink_to_fit();
+	ok = ok && d == inl && d.is_inline() && d.capacity() == 3;
+	CHECK("assign, shrink_to_fit back inline", ok);
+	CHECK("relational", heap < inl && inl > heap && inl != heap && inl <= inl_copy && inl >= inl_copy);
+}
+
+void test_small_vector(void){
+	std::cout << "==============================" << std::endl;
+	std::cout << "         small vector         " << std::endl;
+	std::cout << "==============================" << std::endl;
+	srand(44);
+	CHECK("random operations against std::vector", small_random(20000));
+	small_copies();
+
+	typedef ft::small_vector<int, 8, counting_allocator<int> > counted_type;
+	counted_type v;
+	g_allocations = 0;
+	for (int i = 0; i < 8; i++)
+		v.insert(v.begin(), i);
+	bool ok = g_allocations == 0 && v.is_inline() && v.front() == 7 && v.back() == 0;
+	v.push_back(v[0]);
+	CHECK("no allocation up to N, spills past N", ok && g_allocations == 1 && !v.is_inline()
+		&& v.capacity() == 16 && v.back() == 7);
+	counted_type::iterator it = v.begin() + 3;
+	CHECK("random access iterators", v.end() - v.begin() == 9 && it[1] == 3 && *(it - 1) == 5
+		&& v.at(4) == 3);
+	bool thrown = false;
+	try{
+		v.at(9);
+	}
+	catch (std::out_of_range &e){
+		thrown = true;
+	}
+	CHECK("at throws", thrown);
+
+	typedef ft::stack<int, counted_type> stack_type;
+	g_allocations = 0;
+	stack_type s;
+	for (int i = 0; i < 8; i++)
+		s.push(i);
+	stack_type t(s);
+	t.pop();
+	ok = g_allocations == 0 && s.size() == 8 && s.top() == 7 && t.top() == 6 && t < s;
+	s.push(8);
+	CHECK("ft::stack over a small_vector", ok && g_allocations == 1 && s.top() == 8);
+}
@@ -0,0 +1,152 @@
+#include "extensions.hpp"
+#include <tree_range.hpp>
+#include <map>
+#include <vector>
+#include <cstdlib>
+#include <pthread.h>
+
+typedef ft::map<int, int>::iterator map_iterator;
+
+/* Splits down to depth, appending the leaf ranges in order. */
+static void split_all(ft::tree_range<map_iterator> range, int depth,
+	std::vector<ft::tree_range<map_iterator> > &out){
+	if (depth == 0 || !range.is_divisible()){
+		out.push_back(range);
+		return;
+	}
+	ft::tree_range<map_iterator> upper = range.split();
+	split_all(range, depth - 1, out);
+	split_all(upper, depth - 1, out);
+}
+
+struct add_to
+{
+	long	*sum;
+	add_to(long *sum) : sum(sum) {}
+	void operator()(const ft::pair<const int, int> &value) const {
+		__atomic_add_fetch(sum, value.second, __ATOMIC_RELAXED);
+	}
+};
+
+/* Clears *same when called on another thread than caller.*/
+struct on_caller
+{
+	pthread_t	caller;
+	bool		*same;
+	on_caller(pthread_t caller, bool *same) : caller(caller), same(same) {}
+	void operator()(const ft::pair<const int, int> &) const {
+		if (!pthread_equal(pthread_self(), caller))
+			*same = false;
+	}
+};
+
+static long add_second(long sum, const ft::pair<const int, int> &value){
+	return (sum + value.second);
+}
+
+static long add(long a, long b){
+	return (a + b);
+}
+
+/* keys in visit order: a fold that is not commutative */
+static std::vector<int> push_key(std::vector<int> keys, const ft::pair<const int, int> &value){
+	keys.push_back(value.first);
+	return (keys);
+}
+
+static std::vector<int> append(std::vector<int> a, const std::vector<int> &b){
+	a.insert(a.end(), b.begin(), b.end());
+	return (a);
+}
+
+static int add_key(int sum, const int &key){
+	return (sum + key);
+}
+
+static int add_int(int a, int b){
+	return (a + b);
+}
+
+void test_tree_range(void){
+	std::cout << "==============================" << std::endl;
+	std::cout << "       splittable ranges      " << std::endl;
+	std::cout << "==============================" << std::endl;
+	ft::map<int, int> map;
+	std::map<int, int> ref;
+	srand(3);
+	for (int i = 0; i < 100000; i++){
+		int k = rand() % 1000000;
+		map[k] = i % 1000;
+		ref[k] = i % 1000;
+	}
+
+	std::vector<ft::tree_range<map_iterator> > parts;
+	split_all(ft::tree_range<map_iterator>(map.begin(), map.end()), 4, parts);
+	bool covered = parts.size() == 16 && parts.front().begin() == map.begin()
+		&& parts.back().end() == map.end();
+	size_t smallest = ref.size();
+	size_t largest = 0;
+	for (size_t i = 0; i < parts.size() && covered; i++){
+		size_t n = 0;
+		for (map_iterator it = parts[i].begin(); it != parts[i].end(); ++it)
+			n++;
+		smallest = n < smallest ? n : smallest;
+		largest = n > largest ? n : largest;
+		if (i > 0)
+			covered = parts[i - 1].end() == parts[i].begin();
+	}
+	CHECK("split covers the map in order", covered);
+	CHECK("split parts within a factor of 4", smallest > 0 && largest <= 4 * smallest);
+
+	long expected = 0;
+	std::vector<int> keys;
+	for (std::map<int, int>::iterator it = ref.begin(); it != ref.end(); ++it){
+		expected += it->second;
+		keys.push_back(it->first);
+	}
+	bool same = true;
+	for (size_t threads = 1; threads <= 8; threads *= 2){
+		long sum = 0;
+		ft::parallel_for_each(map.begin(), map.end(), add_to(&sum), ft::parallel(threads));
+		same = same && sum == expected;
+		same = same && ft::parallel_reduce(map.begin(), map.end(), 0L, add_second, add,
+			ft::parallel(threads)) == expected;
+	}
+	CHECK("parallel_for_each and parallel_reduce sums", same);
+
+	std::vector<int> visited = ft::parallel_reduce(map.begin(), map.end(), std::vector<int>(),
+		push_key, append, ft::parallel(8));
+	CHECK("parallel_reduce keeps key order", visited == keys);
+
+	map_iterator lo = map.lower_bound(250000);
+	map_iterator hi = map.lower_bound(750000);
+	long expected_range = 0;
+	for (std::map<int, int>::iterator it = ref.lower_bound(250000); it != ref.lower_bound(750000); ++it)
+		expected_range += it->second;
+	CHECK("parallel_reduce over a sub-range", ft::parallel_reduce(lo, hi, 0L, add_second, add,
+		ft::parallel(4)) == expected_range);
+
+	map_iterator small_end = map.begin();
+	for (size_t i = 0; i < ft::parallel_grain - 1; i++)
+		++small_end;
+	bool in_place = true;
+	ft::parallel_for_each(map.begin(), small_end, on_caller(pthread_self(), &in_place), ft::parallel(8));
+	CHECK("ranges under the grain are not split", in_place);
+
+	ft::set<int> set;
+	int expected_keys = 0;
+	for (int i = 0; i < 5000; i++){
+		set.insert(i);
+		expected_keys += i;
+	}
+	CHECK("parallel_reduce over a set", ft::parallel_reduce(set.begin(), set.end(), 0,
+		add_key, add_int, ft::parallel(4)) == expected_keys);
+
+	ft::map<int, int> single;
+	single[7] = 7;
+	long one = ft::parallel_reduce(single.begin(), single.end(), 0L, add_second, add, ft::parallel(4));
+	long none = ft::parallel_reduce(map.begin(), map.begin(), 0L, add_second, add, ft::parallel(4));
+	std::cout << "single element: " << one << ", empty range: " << none
+		<< ", divisible: " << ft::tree_range<map_iterator>(single.begin(), single.end()).is_divisible()
+		<< std::endl;
+}
@@ -0,0 +1,94 @@
+#include "extensions.hpp"
+#include <vector.hpp>
+#include <small_vector.hpp>
+#include <vm_vector.hpp>
+#include <mapped_vector.hpp>
+#include <sstream>
+#include <cstring>
+#include <unistd.h>
+#include <sys/wait.h>
+
+/* Everything readable from fd, appended in chunks straight into the buffer.*/
+template <class Buffer>
+static void read_all(int fd, Buffer &buffer, size_t chunk){
+	while (true){
+		char *slots = buffer.append_uninitialized(chunk);
+		ssize_t got = read(fd, slots, chunk);
+		buffer.resize_uninitialized(buffer.size() - chunk + (got > 0 ? got : 0));
+		if (got <= 0)
+			return;
+	}
+}
+
+/* A pipe filled by a child, read back into buffer.*/
+template <class Buffer>
+static bool read_pipe(Buffer &buffer, size_t bytes, size_t chunk){
+	int fds[2];
+	if (pipe(fds) != 0)
+		return (false);
+	pid_t pid = fork();
+	if (pid == 0){
+		close(fds[0]);
+		for (size_t i = 0; i < bytes; i++){
+			char c = 'a' + i % 26;
+			if (write(fds[1], &c, 1) != 1)
+				_exit(1);
+		}
+		_exit(0);
+	}
+	close(fds[1]);
+	read_all(fds[0], buffer, chunk);
+	close(fds[0]);
+	waitpid(pid, NULL, 0);
+	bool ok = buffer.size() == bytes;
+	for (size_t i = 0; ok && i < bytes; i++)
+		ok = buffer[i] == (char)('a' + i % 26);
+	return (ok);
+}
+
+void test_uninitialized(void){
+	std::cout << "==============================" << std::endl;
+	std::cout << "    uninitialized resize      " << std::endl;
+	std::cout << "==============================" << std::endl;
+
+	ft::vector<char> v;
+	ft::small_vector<char, 64> small;
+	ft::vm_vector<char> vm;
+	CHECK("read from a pipe into ft::vector", read_pipe(v, 100000, 4096));
+	CHECK("read from a pipe into small_vector", read_pipe(small, 100000, 1000) && !small.is_inline());
+	CHECK("read from a pipe into vm_vector", read_pipe(vm, 100000, 65536));
+
+	ft::vector<int> numbers;
+	size_t reallocations = 0;
+	const int *last = NULL;
+	for (int i = 0; i < 100000; i++){
+		int *slot = numbers.append_uninitialized(1);
+		*slot = i;
+		reallocations += &numbers[0] != last;
+		last = &numbers[0];
+	}
+	bool ok = reallocations < 40 && numbers.capacity() < 2 * numbers.size() + 2;
+	for (int i = 0; ok && i < 100000; i++)
+		ok = numbers[i] == i;
+	CHECK("append_uninitialized grows geometrically, keeps the contents", ok);
+
+	numbers.resize_uninitialized(10);
+	size_t capacity = numbers.capacity();
+	numbers.resize_uninitialized(50000);
+	ok = numbers.size() == 50000 && numbers.capacity() == capacity && numbers[9] == 9 && numbers[49999] == 49999;
+	numbers.resize_uninitialized(0);
+	CHECK("shrinking and growing within capacity", ok && numbers.empty() && numbers.capacity() == capacity);
+
+	std::ostringstream path;
+	path << "/tmp/ft_uninitialized_" << getpid();
+	{
+		ft::mapped_vector<char> file(path.str().c_str());
+		memcpy(file.append_uninitialized(5), "hello", 5);
+		memcpy(file.append_uninitialized(6), " world", 6);
+	}
+	{
+		ft::mapped_vector<char> file(path.str().c_str());
+		CHECK("mapped_vector", file.size() == 11 && std::string(&file[0], file.size()) == "hello world");
+	}
+	unlink(path.str().c_str());
+}
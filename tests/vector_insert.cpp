@@ -0,0 +1,32 @@
+#include "extensions.hpp"
+#include <vector.hpp>
+#include <vector>
+#include <cstdlib>
+
+/* Random inserts and erases of every form, against std::vector.*/
+template <class T>
+static bool edit_valid(int ops){
+	ft::vector<T> v;
+	std::vector<T> ref;
+
+	return (vector_like_random(v, ref, ops, no_check()) && v.capacity() >= v.size());
+}
+
+void test_vector_insert(void){
+	std::cout << "==============================" << std::endl;
+	std::cout << "    vector insert and erase   " << std::endl;
+	std::cout << "==============================" << std::endl;
+	srand(5);
+	CHECK("int", edit_valid<int>(3000));
+	CHECK("std::string", edit_valid<std::string>(3000));
+	CHECK("ft::vector<int>", edit_valid<ft::vector<int> >(3000));
+
+	ft::vector<int> v(4, 1);
+	size_t capacity = v.capacity();
+	v.insert(v.begin() + 2, 100, 7);
+	bool once = v.capacity() == 104 && capacity == 4;
+	v.reserve(200);
+	int values[] = {1, 2, 3};
+	v.insert(v.begin(), values, values + 3);
+	CHECK("one allocation, or none", once && v.capacity() == 200 && v[0] == 1 && v[2] == 3 && v[3] == 1);
+}
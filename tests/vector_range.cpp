@@ -0,0 +1,92 @@
+#include "extensions.hpp"
+#include <vector.hpp>
+#include <small_vector.hpp>
+#include <map.hpp>
+#include <list>
+#include <sstream>
+#include <iterator>
+
+namespace
+{
+	long g_allocations = 0;
+
+	/* std::allocator counting the allocations, to check they are exact.*/
+	template <class T>
+	struct counting_allocator : public std::allocator<T>
+	{
+		template <class U>
+		struct rebind { typedef counting_allocator<U> other; };
+
+		counting_allocator() {}
+		counting_allocator(const counting_allocator &src) : std::allocator<T>(src) {}
+		template <class U>
+		counting_allocator(const counting_allocator<U> &src) : std::allocator<T>(src) {}
+
+		T *allocate(size_t n, const void * = 0){
+			g_allocations++;
+			return (std::allocator<T>::allocate(n));
+		}
+	};
+}
+
+template <class Vector>
+static std::string joined(const Vector &v){
+	std::ostringstream out;
+	for (size_t i = 0; i < v.size(); i++)
+		out << (i ? " " : "") << v[i];
+	return (out.str());
+}
+
+void test_vector_range(void){
+	std::cout << "==============================" << std::endl;
+	std::cout << "     vector range dispatch    " << std::endl;
+	std::cout << "==============================" << std::endl;
+	typedef ft::map<int, int>::value_type entry;
+	ft::map<int, int> map;
+	for (int i = 0; i < 1000; i++)
+		map[i * 7 % 1000] = i;
+
+	g_allocations = 0;
+	ft::vector<entry, counting_allocator<entry> > entries(map.begin(), map.end());
+	bool ok = g_allocations == 1 && entries.size() == 1000 && entries.capacity() == 1000;
+	for (size_t i = 0; ok && i < entries.size(); i++)
+		ok = entries[i].first == (int)i && entries[i].second == map[(int)i];
+	CHECK("from an ft::map, one exact allocation", ok);
+
+	std::list<int> list;
+	for (int i = 0; i < 300; i++)
+		list.push_back(i);
+	ft::vector<int, counting_allocator<int> > v(10, 1);
+	g_allocations = 0;
+	v.assign(list.begin(), list.end());
+	ok = g_allocations == 1 && v.capacity() == 300 && v.size() == 300 && v[299] == 299;
+	v.assign(list.begin(), ++list.begin());
+	CHECK("assign from a list, exact and reused", ok && g_allocations == 1 && v.size() == 1 && v.capacity() == 300);
+
+	std::istringstream numbers("1 2 3 4 5 6 7 8 9 10");
+	ft::vector<int> read((std::istream_iterator<int>(numbers)), std::istream_iterator<int>());
+	CHECK("from an input iterator, geometric", joined(read) == "1 2 3 4 5 6 7 8 9 10" && read.capacity() == 16);
+
+	std::istringstream more("20 30 40");
+	read.insert(read.begin() + 2, std::istream_iterator<int>(more), std::istream_iterator<int>());
+	ok = joined(read) == "1 2 20 30 40 3 4 5 6 7 8 9 10" && read.capacity() == 16;
+	std::istringstream again("5 6");
+	read.assign(std::istream_iterator<int>(again), std::istream_iterator<int>());
+	ok = ok && read.size() == 2 && read[1] == 6;
+	std::istringstream tail("7 8");
+	read.insert(read.end(), std::istream_iterator<int>(tail), std::istream_iterator<int>());
+	CHECK("insert and assign from input iterators, rotated into place", ok && joined(read) == "5 6 7 8");
+
+	int raw[] = {4, 3, 2, 1};
+	ft::vector<int> from_array(raw, raw + 4);
+	ft::vector<int> filled(4, 2);
+	CHECK("pointers and integers", joined(from_array) == "4 3 2 1" && from_array.capacity() == 4
+		&& joined(filled) == "2 2 2 2");
+
+	std::istringstream few("1 2 3");
+	ft::small_vector<int, 4> small((std::istream_iterator<int>(few)), std::istream_iterator<int>());
+	ft::small_vector<entry, 4> spilled(map.begin(), map.end());
+	small.insert(small.begin(), list.begin(), ++(++list.begin()));
+	CHECK("small_vector", joined(small) == "0 1 1 2 3" && spilled.capacity() == 1000
+		&& spilled.back().first == 999);
+}
@@ -0,0 +1,80 @@
+#include "extensions.hpp"
+#include <vm_vector.hpp>
+#include <stack.hpp>
+#include <vector>
+#include <sstream>
+#include <iterator>
+#include <cstdlib>
+
+/* The storage never moves, shrink_to_fit() or not.*/
+struct vm_stays
+{
+	std::string *base;
+
+	bool operator()(ft::vm_vector<std::string> &v, std::vector<std::string> &) const {
+		if (rand() % 50 == 0)
+			v.shrink_to_fit();
+		return (&*v.begin() == base && v.capacity() >= v.size());
+	}
+};
+
+static bool vm_random(int ops){
+	ft::vm_vector<std::string> v;
+	std::vector<std::string> ref;
+	vm_stays check = {&*v.begin()};
+
+	return (vector_like_random(v, ref, ops, check));
+}
+
+void test_vm_vector(void){
+	std::cout << "==============================" << std::endl;
+	std::cout << "          vm vector           " << std::endl;
+	std::cout << "==============================" << std::endl;
+	srand(47);
+	CHECK("random operations against std::vector, storage never moves", vm_random(20000));
+
+	ft::vm_vector<long> v;
+	v.push_back(0);
+	long *first = &v[0];
+	bool ok = true;
+	for (long i = 1; i < 3000000; i++)
+		v.push_back(i);
+	for (long i = 0; ok && i < 3000000; i++)
+		ok = v[i] == i;
+	CHECK("push_back keeps addresses", ok && &v[0] == first && v.back() == 2999999);
+	size_t capacity = v.capacity();
+	v.resize(1000);
+	v.shrink_to_fit();
+	ok = v.capacity() < capacity && v.capacity() >= 1000 && v[999] == 999 && &v[0] == first;
+	v.resize(2000000, -1);
+	CHECK("shrink_to_fit, then grow again in place", ok && v[1999999] == -1 && v[999] == 999 && &v[0] == first);
+
+	ft::vm_vector<int> bounded(1000);
+	bool thrown = false;
+	try{
+		while (true)
+			bounded.push_back(1);
+	}
+	catch (std::length_error &e){
+		thrown = true;
+	}
+	CHECK("reservation bound", thrown && bounded.size() == bounded.max_size() && bounded.max_size() >= 1000);
+
+	ft::vm_vector<int> a(5, 3);
+	ft::vm_vector<int> b(a);
+	b.push_back(4);
+	ft::vm_vector<int> c;
+	c = b;
+	ok = a < b && b == c && b != a && c.size() == 6 && c.back() == 4;
+	int *pa = &a[0];
+	a.swap(c);
+	CHECK("copy, assign, swap", ok && a.size() == 6 && c.size() == 5 && &c[0] == pa);
+
+	std::istringstream numbers("1 2 3 4");
+	ft::vm_vector<int> read((std::istream_iterator<int>(numbers)), std::istream_iterator<int>());
+	ft::stack<int, ft::vm_vector<int> > stack;
+	for (int i = 0; i < 100000; i++)
+		stack.push(i);
+	CHECK("input ranges, ft::stack", read.size() == 4 && read[3] == 4 && stack.top() == 99999
+		&& stack.size() == 100000);
+}